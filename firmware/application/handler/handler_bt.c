@@ -30,6 +30,26 @@ static char *PROFILES[] = {
     "MAP"
 };
 
+/**
+ * HandlerBTTELStatusCallerID()
+ *     Description:
+ *         Write the caller ID to the telephone status text, in the character
+ *         set of the display that the UI mode drives
+ *     Params:
+ *         HandlerContext_t *context - The handler context
+ *     Returns:
+ *         void
+ */
+static void HandlerBTTELStatusCallerID(HandlerContext_t *context)
+{
+    char callerId[BT_CALLER_ID_FIELD_SIZE];
+    UtilsStrncpy(callerId, context->bt->callerId, BT_CALLER_ID_FIELD_SIZE);
+    if (context->uiMode != CONFIG_UI_BMBT) {
+        UtilsConvertTextCharset(callerId, UTILS_CHARSET_IBUS);
+    }
+    IBusCommandTELStatusText(context->ibus, callerId, 0);
+}
+
 void HandlerBTInit(HandlerContext_t *context)
 {
     EventRegisterCallback(
@@ -87,6 +107,11 @@ void HandlerBTInit(HandlerContext_t *context)
         context,
         TIMER_TASK_DISABLED
     );
+    TimerRegisterScheduledTask(
+        &HandlerTimerBTPBAPCacheSync,
+        context,
+        HANDLER_INT_PBAP_CACHE_SYNC
+    );
     if (context->bt->type == BT_BTM_TYPE_BC127) {
         EventRegisterCallback(
             BT_EVENT_BOOT,
@@ -221,10 +246,12 @@ static void HandlerBTConnect(HandlerContext_t *context)
  */
 void HandlerBTCallStatus(void *ctx, uint8_t *data)
 {
+    HandlerContext_t *context = (HandlerContext_t *) ctx;
+    // The call lists change with the call, so pages pulled ahead are stale
+    BTPBAPPrefetchClearHistory(context->bt);
     if (ConfigGetSetting(CONFIG_SETTING_HFP) == CONFIG_SETTING_OFF) {
         return;
     }
-    HandlerContext_t *context = (HandlerContext_t *) ctx;
     // If we were playing before the call, try to resume playback
     if (context->bt->callStatus == BT_CALL_INACTIVE &&
         context->bt->playbackStatus == BT_AVRCP_STATUS_PLAYING
@@ -314,7 +341,7 @@ void HandlerBTCallStatus(void *ctx, uint8_t *data)
             }
             LogDebug(LOG_SOURCE_SYSTEM, "Call > 1");
             if (strlen(context->bt->callerId) > 0 && context->uiMode != CONFIG_UI_CD53) {
-                IBusCommandTELStatusText(context->ibus, context->bt->callerId, 0);
+                HandlerBTTELStatusCallerID(context);
             }
             if (volume > CONFIG_SETTING_TEL_VOL_OFFSET_MAX) {
                 volume = CONFIG_SETTING_TEL_VOL_OFFSET_MAX;
@@ -399,7 +426,7 @@ void HandlerBTCallerID(void *ctx, uint8_t *data)
     HandlerContext_t *context = (HandlerContext_t *) ctx;
     if (context->telStatus == IBUS_TEL_STATUS_ACTIVE_POWER_CALL_HANDSFREE) {
         LogDebug(LOG_SOURCE_SYSTEM, "Call > ID: %s", context->bt->callerId);
-        IBusCommandTELStatusText(context->ibus, context->bt->callerId, 0);
+        HandlerBTTELStatusCallerID(context);
     }
 }
 
@@ -520,6 +547,9 @@ void HandlerBTDeviceLinkConnected(void *ctx, uint8_t *data)
                 }
             } else {
                 IBusCommandTELLED(context->ibus, IBUS_TEL_LED_GREEN_ON);
+                // Index the cached phonebook now rather than when the
+                // first call comes in, for the caller ID lookups
+                BTPBAPCacheLoad(context->bt);
                 if (context->bt->type == BT_BTM_TYPE_BC127) {
                     // Set the device character set to UTF-8
                     BC127CommandATSet(context->bt, "CSCS", "\"UTF-8\"");
@@ -862,6 +892,42 @@ void HandlerBTBM83BootStatus(void *ctx, uint8_t *data)
 }
 
 /* Timers */
+/**
+ * HandlerTimerBTPBAPCacheSync()
+ *     Description:
+ *         Pull the phonebook into the phonebook cache one page at a time,
+ *         whenever the PBAP session is not busy with a request from the UI.
+ *         A UI request that had to wait on a background pull goes first,
+ *         then the pages either side of the one on screen, as someone is
+ *         likely to turn to them soon.
+ *     Params:
+ *         void *ctx - The context provided at registration
+ *     Returns:
+ *         void
+ */
+void HandlerTimerBTPBAPCacheSync(void *ctx)
+{
+    HandlerContext_t *context = (HandlerContext_t *) ctx;
+    if (
+        context->bt->pbap.active == 0 ||
+        context->bt->pbap.status != BT_PBAP_STATUS_IDLE
+    ) {
+        return;
+    }
+    if (context->bt->pbap.requestQueued == 1) {
+        BTCommandPBAPGetPhonebook(
+            context->bt,
+            context->bt->pbap.queuedPhonebook,
+            context->bt->pbap.queuedOffset,
+            context->bt->pbap.queuedMaxList
+        );
+    } else if (BTPBAPPrefetchNextPage(context->bt) != BT_PBAP_PREFETCH_NONE) {
+        BTCommandPBAPPrefetchPhonebook(context->bt);
+    } else if (context->bt->pbap.cache.status == BT_PBAP_CACHE_STATUS_SYNCING) {
+        BTCommandPBAPSyncPhonebook(context->bt);
+    }
+}
+
 /**
  * HandlerTimerBTScanDevices()
  *     Description:
@@ -1054,7 +1120,9 @@ void HandlerTimerBC127VolumeManagement(void *ctx)
 /**
  * HandlerTimerBTBM83AVRCPManager()
  *     Description:
- *         Register the track change event notifier or grab the metadata
+ *         Register the track change event notifier and grab the metadata.
+ *         Both requests are handed to the command queue at once, which
+ *         releases the second as soon as the BM83 acknowledges the first.
  *     Params:
  *         void *ctx - The context provided at registration
  *     Returns:
@@ -1063,35 +1131,22 @@ void HandlerTimerBC127VolumeManagement(void *ctx)
 void HandlerTimerBTBM83AVRCPManager(void *ctx)
 {
     HandlerContext_t *context = (HandlerContext_t *) ctx;
-    if (context->bt->avrcpUpdates != 0x00) {
-        if (UTILS_CHECK_BIT(context->bt->avrcpUpdates, BT_AVRCP_ACTION_SET_TRACK_CHANGE_NOTIF) > 0) {
-            context->bt->avrcpUpdates = UTILS_CLEAR_BIT(
-                context->bt->avrcpUpdates,
-                BT_AVRCP_ACTION_SET_TRACK_CHANGE_NOTIF
-            );
-            BM83CommandAVRCPRegisterNotification(
-                context->bt,
-                BM83_AVRCP_EVT_PLAYBACK_TRACK_CHANGED
-            );
-        } else if (UTILS_CHECK_BIT(context->bt->avrcpUpdates, BT_AVRCP_ACTION_GET_METADATA) > 0) {
-            context->bt->avrcpUpdates = UTILS_CLEAR_BIT(
-                context->bt->avrcpUpdates,
-                BT_AVRCP_ACTION_GET_METADATA
-            );
-            BM83CommandAVRCPGetElementAttributesAll(context->bt);
-        }
-        // Set the timeout to 250ms from now if we still need to get metadata
-        if (UTILS_CHECK_BIT(context->bt->avrcpUpdates, BT_AVRCP_ACTION_GET_METADATA) > 0) {
-            TimerSetTaskInterval(
-                context->avrcpRegisterStatusNotifierTimerId,
-                HANDLER_INT_BT_AVRCP_UPDATER_METADATA
-            );
-        } else {
-            TimerSetTaskInterval(
-                context->avrcpRegisterStatusNotifierTimerId,
-                HANDLER_INT_BT_AVRCP_UPDATER
-            );
-        }
+    if (UTILS_CHECK_BIT(context->bt->avrcpUpdates, BT_AVRCP_ACTION_SET_TRACK_CHANGE_NOTIF) > 0) {
+        context->bt->avrcpUpdates = UTILS_CLEAR_BIT(
+            context->bt->avrcpUpdates,
+            BT_AVRCP_ACTION_SET_TRACK_CHANGE_NOTIF
+        );
+        BM83CommandAVRCPRegisterNotification(
+            context->bt,
+            BM83_AVRCP_EVT_PLAYBACK_TRACK_CHANGED
+        );
+    }
+    if (UTILS_CHECK_BIT(context->bt->avrcpUpdates, BT_AVRCP_ACTION_GET_METADATA) > 0) {
+        context->bt->avrcpUpdates = UTILS_CLEAR_BIT(
+            context->bt->avrcpUpdates,
+            BT_AVRCP_ACTION_GET_METADATA
+        );
+        BM83CommandAVRCPGetElementAttributesAll(context->bt);
     }
 }
 
@@ -30,6 +30,7 @@ void HandlerBTBM83Boot(void *, uint8_t *);
 void HandlerBTBM83BootStatus(void *, uint8_t *);
 void HandlerBTBM83DSPStatus(void *, uint8_t *);
 
+void HandlerTimerBTPBAPCacheSync(void *);
 void HandlerTimerBTScanDevices(void *);
 void HandlerTimerBTTCUStateChange(void *);
 
@@ -52,7 +52,6 @@
 #define HANDLER_LCM_IO_TIMEOUT 15000
 #define HANDLER_INT_LIGHTING_STATE 1000
 #define HANDLER_INT_BT_AVRCP_UPDATER 1000
-#define HANDLER_INT_BT_AVRCP_UPDATER_METADATA 250
 #define HANDLER_INT_PROFILE_ERROR 2500
 #define HANDLER_INT_POWEROFF 1000
 #define HANDLER_INT_VOL_MGMT 500
@@ -60,6 +59,7 @@
 #define HANDLER_INT_BM83_POWER_MFB_ON 150
 #define HANDLER_INT_BM83_POWER_MFB_OFF 500
 #define HANDLER_INT_PDC_DISTANCE 750
+#define HANDLER_INT_PBAP_CACHE_SYNC 250
 #define HANDLER_LM_BLINK_OFF 0x00
 #define HANDLER_LM_BLINK_LEFT 0x01
 #define HANDLER_LM_BLINK_RIGHT 0x02
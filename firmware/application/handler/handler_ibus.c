@@ -7,11 +7,11 @@
 #include "handler_ibus.h"
 #include "handler_common.h"
 #include <stdint.h>
-#include <stdio.h>
 #include <string.h>
 #include "../lib/bt/bt_bc127.h"
 #include "../lib/bt.h"
 #include "../lib/event.h"
+#include "../lib/utils.h"
 #include "../ui/bmbt.h"
 #include "../ui/cd53.h"
 #include "../ui/mid.h"
@@ -1562,7 +1562,7 @@ void HandlerIBusPDCSensorUpdate(void *ctx, uint8_t *pkt)
                     HandlerIBusFormatPDCValue(valStrCL, rearValues[1]);
                     HandlerIBusFormatPDCValue(valStrCR, rearValues[2]);
                     HandlerIBusFormatPDCValue(valStrRR, rearValues[3]);
-                    snprintf(
+                    UtilsFormat(
                         pdcValues,
                         21,
                         "F:%s R:%s %s %s %s%s",
@@ -1579,7 +1579,7 @@ void HandlerIBusPDCSensorUpdate(void *ctx, uint8_t *pkt)
                     HandlerIBusFormatPDCValue(valStrCL, frontValues[1]);
                     HandlerIBusFormatPDCValue(valStrCR, frontValues[2]);
                     HandlerIBusFormatPDCValue(valStrRR, frontValues[3]);
-                    snprintf(
+                    UtilsFormat(
                         pdcValues,
                         21,
                         "F:%s %s %s %s R:%s%s",
@@ -5,7 +5,6 @@
  *     Implementation of the abstract Bluetooth Module API
  */
 #include "bt.h"
-#include <stdio.h>
 #include <string.h>
 #include "bt/bt_bc127.h"
 #include "bt/bt_bm83.h"
@@ -17,6 +16,8 @@
 #include "uart.h"
 #include "utils.h"
 
+static void BTCommandPBAPPull(BT_t *, uint8_t, uint16_t, uint8_t);
+
 /**
  * BTInit()
  *     Description:
@@ -142,7 +143,7 @@ void BTCommandDial(BT_t *bt, const char *number, const char *name)
         if (bt->type == BT_BTM_TYPE_BC127) {
             // @FIX
             char command[32] = {0};
-            snprintf(command, 32, "CALL %d OUTGOING %s", bt->activeDevice.hfpId, cleannum);
+            UtilsFormat(command, 32, "CALL %d OUTGOING %s", bt->activeDevice.hfpId, cleannum);
             BC127SendCommand(bt, command);
         } else {
             BM83CommandDial(bt, cleannum);
@@ -334,7 +335,9 @@ void BTCommandPBAPClose(BT_t *bt)
 /**
  * BTCommandPBAPGetPhonebook()
  *     Description:
- *         Download contacts from the phone via PBAP
+ *         Download contacts from the phone via PBAP. A background pull
+ *         that is running can not share the session, so the request is
+ *         queued until it is done and HandlerTimerBTPBAPCacheSync() sends it.
  *     Params:
  *         BT_t *bt - The Bluetooth context
  *         uint8_t phonebook - The phonebook to pull
@@ -344,6 +347,78 @@ void BTCommandPBAPClose(BT_t *bt)
  *         void
  */
 void BTCommandPBAPGetPhonebook(BT_t *bt, uint8_t phonebook, uint16_t startIndex, uint8_t maxList)
+{
+    bt->pbap.pageValid = 0;
+    if (
+        bt->pbap.status != BT_PBAP_STATUS_IDLE &&
+        (bt->pbap.requestSync || bt->pbap.requestPrefetch)
+    ) {
+        // The rest of its vCards would otherwise land in the contacts buffer
+        bt->pbap.requestQueued = 1;
+        bt->pbap.queuedPhonebook = phonebook;
+        bt->pbap.queuedOffset = startIndex;
+        bt->pbap.queuedMaxList = maxList;
+        LogDebug(LOG_SOURCE_BT, "BT: PBAP pull queued behind background pull");
+        return;
+    }
+    bt->pbap.requestQueued = 0;
+    bt->pbap.requestSync = 0;
+    bt->pbap.requestPrefetch = 0;
+    BTCommandPBAPPull(bt, phonebook, startIndex, maxList);
+}
+
+/**
+ * BTCommandPBAPPrefetchPhonebook()
+ *     Description:
+ *         Pull the prefetch page picked by BTPBAPPrefetchNextPage()
+ *     Params:
+ *         BT_t *bt - The Bluetooth context
+ *     Returns:
+ *         void
+ */
+void BTCommandPBAPPrefetchPhonebook(BT_t *bt)
+{
+    BTPBAPPage_t *page = BTPBAPPrefetchGetPage(bt);
+    bt->pbap.requestSync = 0;
+    bt->pbap.requestPrefetch = 1;
+    BTCommandPBAPPull(bt, page->phonebook, page->offset, BT_PBAP_MAX_CONTACTS);
+}
+
+/**
+ * BTCommandPBAPSyncPhonebook()
+ *     Description:
+ *         Pull the next page of the phonebook into the phonebook cache
+ *     Params:
+ *         BT_t *bt - The Bluetooth context
+ *     Returns:
+ *         void
+ */
+void BTCommandPBAPSyncPhonebook(BT_t *bt)
+{
+    bt->pbap.requestSync = 1;
+    bt->pbap.requestPrefetch = 0;
+    BTCommandPBAPPull(
+        bt,
+        BT_PBAP_OBJ_PHONEBOOK,
+        BTPBAPCacheSyncNextPage(bt),
+        BT_PBAP_MAX_CONTACTS
+    );
+}
+
+/**
+ * BTCommandPBAPPull()
+ *     Description:
+ *         Translate the abstract phonebook type and issue the pull on the
+ *         module in use
+ *     Params:
+ *         BT_t *bt - The Bluetooth context
+ *         uint8_t phonebook - The phonebook to pull
+ *         uint16_t startIndex - The starting index
+ *         uint8_t maxList - Maximum number of entries to download
+ *     Returns:
+ *         void
+ */
+static void BTCommandPBAPPull(BT_t *bt, uint8_t phonebook, uint16_t startIndex, uint8_t maxList)
 {
     uint8_t type;
     if (bt->type == BT_BTM_TYPE_BC127) {
@@ -24,6 +24,8 @@ void BTCommandPBAPAbort(BT_t *);
 void BTCommandPBAPClose(BT_t *);
 void BTCommandPBAPGetPhonebook(BT_t *, uint8_t, uint16_t, uint8_t);
 void BTCommandPBAPOpen(BT_t *);
+void BTCommandPBAPPrefetchPhonebook(BT_t *);
+void BTCommandPBAPSyncPhonebook(BT_t *);
 void BTCommandPlay(BT_t *);
 void BTCommandPlaybackToggle(BT_t *);
 void BTCommandPlaybackTrackFastforwardStart(BT_t *);
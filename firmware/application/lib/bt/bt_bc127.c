@@ -12,7 +12,6 @@
 #include "../utils.h"
 #include "bt_common.h"
 #include <stdint.h>
-#include <stdio.h>
 #include <string.h>
 
 /** BC127CVCGainTable
@@ -46,8 +45,8 @@ int8_t BTBC127MicGainTable[] = {
     39 // Technically 39.5 - D6
 };
 
-/* The literal 6-char escape sequence the BC127 uses for CRLF in PBAP data */
-static const char BC127_PBAP_DELIM[] = "\\0D\\0A";
+/* The RX line assembler state, which persists across calls to BC127Process() */
+static BC127RxState_t BC127Rx;
 
 /**
  * BC127ClearPairingErrors()
@@ -77,7 +76,7 @@ void BC127CommandAT(BT_t *bt, char *cmd)
     uint8_t commandLength = strlen(cmd) + 9;
     char command[commandLength];
     memset(command, 0, commandLength);
-    snprintf(
+    UtilsFormat(
         command,
         commandLength,
         "AT %d AT%s",
@@ -101,7 +100,7 @@ void BC127CommandATSet(BT_t *bt, char *param, char *value)
     uint8_t commandLength = 11 + strlen(param) + strlen(value);
     char command[commandLength];
     memset(command, 0, commandLength);
-    snprintf(
+    UtilsFormat(
         command,
         commandLength,
         "AT %d AT+%s=%s",
@@ -126,7 +125,7 @@ void BC127CommandBackward(BT_t *bt)
     if (bt->activeDevice.avrcpId != 0) {
         bt->metadataTimestamp = 0;
         char command[18] = {0};
-        snprintf(command, 18, "MUSIC %d BACKWARD", bt->activeDevice.avrcpId);
+        UtilsFormat(command, 18, "MUSIC %d BACKWARD", bt->activeDevice.avrcpId);
         BC127SendCommand(bt, command);
     } else {
         LogWarning("BT: Unable to BACKWARD - AVRCP link unopened");
@@ -146,7 +145,7 @@ void BC127CommandBackwardSeekPress(BT_t *bt)
 {
     if (bt->activeDevice.avrcpId != 0) {
         char command[19] = {0};
-        snprintf(command, 19, "MUSIC %d REW_PRESS", bt->activeDevice.avrcpId);
+        UtilsFormat(command, 19, "MUSIC %d REW_PRESS", bt->activeDevice.avrcpId);
         BC127SendCommand(bt, command);
     } else {
         LogWarning("BT: Unable to REW_PRESS - AVRCP link unopened");
@@ -166,7 +165,7 @@ void BC127CommandBackwardSeekRelease(BT_t *bt)
 {
     if (bt->activeDevice.avrcpId != 0) {
         char command[21] = {0};
-        snprintf(command, 21, "MUSIC %d REW_RELEASE", bt->activeDevice.avrcpId);
+        UtilsFormat(command, 21, "MUSIC %d REW_RELEASE", bt->activeDevice.avrcpId);
         BC127SendCommand(bt, command);
     } else {
         LogWarning("BT: Unable to REW_RELEASE - AVRCP link unopened");
@@ -185,7 +184,7 @@ void BC127CommandBackwardSeekRelease(BT_t *bt)
 void BC127CommandCallAnswer(BT_t *bt)
 {
     char command[15] = {0};
-    snprintf(command, 15, "CALL %d ANSWER", bt->activeDevice.hfpId);
+    UtilsFormat(command, 15, "CALL %d ANSWER", bt->activeDevice.hfpId);
     BC127SendCommand(bt, command);
 }
 
@@ -201,7 +200,7 @@ void BC127CommandCallAnswer(BT_t *bt)
 void BC127CommandCallEnd(BT_t *bt)
 {
     char command[12] = {0};
-    snprintf(command, 12, "CALL %d END", bt->activeDevice.hfpId);
+    UtilsFormat(command, 12, "CALL %d END", bt->activeDevice.hfpId);
     BC127SendCommand(bt, command);
 }
 
@@ -217,7 +216,7 @@ void BC127CommandCallEnd(BT_t *bt)
 void BC127CommandCallReject(BT_t *bt)
 {
     char command[15] = {0};
-    snprintf(command, 15, "CALL %d REJECT", bt->activeDevice.hfpId);
+    UtilsFormat(command, 15, "CALL %d REJECT", bt->activeDevice.hfpId);
     BC127SendCommand(bt, command);
 }
 
@@ -238,7 +237,7 @@ void BC127CommandClose(BT_t *bt, uint8_t id)
         BC127SendCommand(bt, command);
     } else {
         char command[9] = {0};
-        snprintf(command, 9, "CLOSE %d", id);
+        UtilsFormat(command, 9, "CLOSE %d", id);
         BC127SendCommand(bt, command);
     }
 }
@@ -260,9 +259,9 @@ void BC127CommandCVC(BT_t *bt, char *band, uint8_t index, uint8_t length)
 {
     char command[16] = {0};
     if (length == 0) {
-        snprintf(command, 16, "CVC_CFG %s", band);
+        UtilsFormat(command, 16, "CVC_CFG %s", band);
     } else {
-        snprintf(command, 16, "CVC_CFG %s %d %d", band, index, length);
+        UtilsFormat(command, 16, "CVC_CFG %s %d %d", band, index, length);
     }
     BC127SendCommand(bt, command);
 }
@@ -313,7 +312,7 @@ void BC127CommandCVC(BT_t *bt, char *band, uint8_t index, uint8_t length)
 void BC127CommandCVCParams(BT_t *bt, char *params)
 {
     char command[255] = {0};
-    snprintf(command, 255, "%s", params);
+    UtilsFormat(command, 255, "%s", params);
     BC127SendCommand(bt, command);
 }
 
@@ -345,7 +344,7 @@ void BC127CommandBtState(BT_t *bt, uint8_t connectable, uint8_t discoverable)
         UtilsStrncpy(discoverMode, "OFF", 4);
     }
     char command[17] = {0};
-    snprintf(command, 17, "BT_STATE %s %s", connectMode, discoverMode);
+    UtilsFormat(command, 17, "BT_STATE %s %s", connectMode, discoverMode);
     BC127SendCommand(bt, command);
 }
 
@@ -363,7 +362,7 @@ void BC127CommandForward(BT_t *bt)
     if (bt->activeDevice.avrcpId != 0) {
         bt->metadataTimestamp = 0;
         char command[17] = {0};
-        snprintf(command, 17, "MUSIC %d FORWARD", bt->activeDevice.avrcpId);
+        UtilsFormat(command, 17, "MUSIC %d FORWARD", bt->activeDevice.avrcpId);
         BC127SendCommand(bt, command);
     } else {
         LogWarning("BT: Unable to FORWARD - AVRCP link unopened");
@@ -383,7 +382,7 @@ void BC127CommandForwardSeekPress(BT_t *bt)
 {
     if (bt->activeDevice.avrcpId != 0) {
         char command[18] = {0};
-        snprintf(command, 18, "MUSIC %d FF_PRESS", bt->activeDevice.avrcpId);
+        UtilsFormat(command, 18, "MUSIC %d FF_PRESS", bt->activeDevice.avrcpId);
         BC127SendCommand(bt, command);
     } else {
         LogWarning("BT: Unable to SEEK FORWARD - AVRCP link unopened");
@@ -403,7 +402,7 @@ void BC127CommandForwardSeekRelease(BT_t *bt)
 {
     if (bt->activeDevice.avrcpId != 0) {
         char command[20] = {0};
-        snprintf(command, 20, "MUSIC %d FF_RELEASE", bt->activeDevice.avrcpId);
+        UtilsFormat(command, 20, "MUSIC %d FF_RELEASE", bt->activeDevice.avrcpId);
         BC127SendCommand(bt, command);
     } else {
         LogWarning("BT: Unable to SEEK FORWARD - AVRCP link unopened");
@@ -423,7 +422,7 @@ void BC127CommandForwardSeekRelease(BT_t *bt)
 void BC127CommandGetDeviceName(BT_t *bt, BTPairedDevice_t *dev)
 {
     char command[18] = {0};
-    snprintf(
+    UtilsFormat(
         command,
         18,
         "NAME %02X%02X%02X%02X%02X%02X",
@@ -450,7 +449,7 @@ void BC127CommandGetMetadata(BT_t *bt)
 {
     if (bt->activeDevice.avrcpId != 0) {
         char command[19] = {0};
-        snprintf(command, 19, "AVRCP_META_DATA %d", bt->activeDevice.avrcpId);
+        UtilsFormat(command, 19, "AVRCP_META_DATA %d", bt->activeDevice.avrcpId);
         BC127SendCommand(bt, command);
         bt->metadataTimestamp = TimerGetMillis();
     } else {
@@ -477,19 +476,19 @@ void BC127CommandLicense(
     // Get both license keys
     if (licenseType == 0 && licenseKey == 0) {
         char command[9] = {0};
-        snprintf(command, 8, "LICENSE");
+        UtilsFormat(command, 8, "LICENSE");
         BC127SendCommand(bt, command);
     }
     // Get a single license key
     if (licenseType != 0 && licenseKey == 0) {
         char command[14] = {0};
-        snprintf(command, 13, "LICENSE %s", licenseType);
+        UtilsFormat(command, 13, "LICENSE %s", licenseType);
         BC127SendCommand(bt, command);
     }
     // Set a single license key
     if (licenseType != 0 && licenseKey != 0) {
         char command[40] = {0};
-        snprintf(command, 39, "LICENSE %s=%s", licenseType, licenseKey);
+        UtilsFormat(command, 39, "LICENSE %s=%s", licenseType, licenseKey);
         BC127SendCommand(bt, command);
     }
 }
@@ -506,7 +505,7 @@ void BC127CommandLicense(
 void BC127CommandList(BT_t *bt)
 {
     char command[5] = {0};
-    snprintf(command, 5, "LIST");
+    UtilsFormat(command, 5, "LIST");
     BC127SendCommand(bt, command);
 }
 
@@ -523,7 +522,7 @@ void BC127CommandPBAPAbort(BT_t *bt)
 {
     if (bt->activeDevice.pbapId != 0) {
         char command[13] = {0};
-        snprintf(command, 13, "PB_ABORT %02X", bt->activeDevice.pbapId);
+        UtilsFormat(command, 13, "PB_ABORT %02X", bt->activeDevice.pbapId);
         BC127SendCommand(bt, command);
     } else {
         LogWarning("BT: Unable to PB_ABORT - PBAP link unopened");
@@ -569,12 +568,15 @@ void BC127CommandPBAPGetPhonebook(BT_t *bt, uint8_t phonebook, uint16_t startInd
 {
     if (bt->activeDevice.pbapId != 0) {
         bt->pbap.status = BT_PBAP_STATUS_PENDING;
-        bt->pbap.contactCount = 0;
-        bt->pbap.contactIdx = 0;
         memset(&bt->pbap.parser, 0, sizeof(bt->pbap.parser));
-        memset(bt->pbap.contacts, 0, sizeof(bt->pbap.contacts));
+        // Background pulls leave the contacts that the UI is showing alone
+        if (!bt->pbap.requestSync && !bt->pbap.requestPrefetch) {
+            bt->pbap.contactCount = 0;
+            bt->pbap.contactIdx = 0;
+            memset(bt->pbap.contacts, 0, sizeof(bt->pbap.contacts));
+        }
         char command[32] = {0};
-        snprintf(
+        UtilsFormat(
             command,
             32,
             "PB_PULL %d 1 %d %d %d 82",
@@ -624,7 +626,7 @@ void BC127CommandPause(BT_t *bt)
 {
     if (bt->activeDevice.avrcpId != 0) {
         char command[16] = {0};
-        snprintf(command, 16, "MUSIC %d PAUSE", bt->activeDevice.avrcpId);
+        UtilsFormat(command, 16, "MUSIC %d PAUSE", bt->activeDevice.avrcpId);
         BC127SendCommand(bt, command);
     } else {
         LogWarning("BT: Unable to PAUSE - AVRCP link unopened");
@@ -644,7 +646,7 @@ void BC127CommandPlay(BT_t *bt)
 {
     if (bt->activeDevice.avrcpId != 0) {
         char command[15] = {0};
-        snprintf(command, 15, "MUSIC %d PLAY", bt->activeDevice.avrcpId);
+        UtilsFormat(command, 15, "MUSIC %d PLAY", bt->activeDevice.avrcpId);
         BC127SendCommand(bt, command);
     } else {
         LogWarning("BT: Unable to PLAY - AVRCP link unopened");
@@ -664,7 +666,7 @@ void BC127CommandPlay(BT_t *bt)
 void BC127CommandProfileClose(BT_t *bt, uint8_t linkId)
 {
     char command[10] = {0};
-    snprintf(command, 10, "CLOSE %d", linkId);
+    UtilsFormat(command, 10, "CLOSE %d", linkId);
     BC127SendCommand(bt, command);
 }
 
@@ -682,7 +684,7 @@ void BC127CommandProfileClose(BT_t *bt, uint8_t linkId)
 void BC127CommandProfileOpen(BT_t *bt, BTPairedDevice_t *dev, char *profile)
 {
     char command[24] = {0};
-    snprintf(
+    UtilsFormat(
         command,
         24,
         "OPEN %02X%02X%02X%02X%02X%02X %s",
@@ -726,7 +728,7 @@ void BC127CommandReset(BT_t *bt)
  */
 void BC127CommandSetAudio(BT_t *bt, uint8_t input, uint8_t output) {
     char command[14] = {0};
-    snprintf(command, 14, "SET AUDIO=%d %d", input, output);
+    UtilsFormat(command, 14, "SET AUDIO=%d %d", input, output);
     BC127SendCommand(bt, command);
     BC127CommandWrite(bt);
 }
@@ -752,7 +754,7 @@ void BC127CommandSetAudioAnalog(
     char *enablePreamp
 ) {
     char command[29] = {0};
-    snprintf(
+    UtilsFormat(
         command,
         29,
         "SET AUDIO_ANALOG=%d %d %d %s",
@@ -786,7 +788,7 @@ void BC127CommandSetAudioDigital(
     char *p2
 ) {
     char command[40] = {0};
-    snprintf(command, 40, "SET AUDIO_DIGITAL=%s %s %s %s OFF", format, rate, p1, p2);
+    UtilsFormat(command, 40, "SET AUDIO_DIGITAL=%s %s %s %s OFF", format, rate, p1, p2);
     BC127SendCommand(bt, command);
     BC127CommandWrite(bt);
 }
@@ -804,7 +806,7 @@ void BC127CommandSetAudioDigital(
 void BC127CommandSetAutoConnect(BT_t *bt, uint8_t autoConnect)
 {
     char command[15] = {0};
-    snprintf(command, 15, "SET AUTOCONN=%d", autoConnect);
+    UtilsFormat(command, 15, "SET AUTOCONN=%d", autoConnect);
     BC127SendCommand(bt, command);
     BC127CommandWrite(bt);
 }
@@ -830,7 +832,7 @@ void BC127CommandSetBtState(
     uint8_t discoverMode
 ) {
     char command[24] = {0};
-    snprintf(command, 24, "SET BT_STATE_CONFIG=%d %d", connectMode, discoverMode);
+    UtilsFormat(command, 24, "SET BT_STATE_CONFIG=%d %d", connectMode, discoverMode);
     BC127SendCommand(bt, command);
     BC127CommandWrite(bt);
 }
@@ -856,7 +858,7 @@ void BC127CommandSetBtVolConfig(
     uint8_t volumeScaling
 ) {
     char command[30] = {0};
-    snprintf(
+    UtilsFormat(
         command,
         30,
         "SET BT_VOL_CONFIG=%X %d %d %d",
@@ -881,7 +883,7 @@ void BC127CommandSetBtVolConfig(
   */
 void BC127CommandSetCOD(BT_t *bt, uint32_t value) {
     char command[11] = {0};
-    snprintf(command, 11, "COD=%lu", value);
+    UtilsFormat(command, 11, "COD=%lu", value);
     BC127SendCommand(bt, command);
 }
 
@@ -898,7 +900,7 @@ void BC127CommandSetCOD(BT_t *bt, uint32_t value) {
   */
 void BC127CommandSetCodec(BT_t *bt, uint8_t bitmask, char *talkback) {
     char command[17] = {0};
-    snprintf(command, 17, "SET CODEC=%d %s", bitmask, talkback);
+    UtilsFormat(command, 17, "SET CODEC=%d %s", bitmask, talkback);
     BC127SendCommand(bt, command);
     BC127CommandWrite(bt);
 }
@@ -950,7 +952,7 @@ void BC127CommandSetMicGain(
     }
     BC127CommandCVC(bt, "NB", 0, 14);
     char params[70] = {0};
-    snprintf(
+    UtilsFormat(
         params,
         70,
         "2280 0000 1A00 %02X00 0000 %02X%02X 0000 0000 0000 0000 0000 0020 0000 %02X%02X",
@@ -962,7 +964,7 @@ void BC127CommandSetMicGain(
     );
     BC127CommandCVCParams(bt, params);
     BC127CommandCVC(bt, "WB", 0, 14);
-    snprintf(
+    UtilsFormat(
         params,
         70,
         "2284 0000 1A00 %02X00 0000 %02X%02X 0000 0000 0000 0000 0000 0020 0000 %02X%02X",
@@ -996,13 +998,13 @@ void BC127CommandSetMicGain(
 void BC127CommandSetModuleName(BT_t *bt, char *name)
 {
     char nameSetCommand[42] = {0};
-    snprintf(nameSetCommand, 42, "SET NAME=%s", name);
+    UtilsFormat(nameSetCommand, 42, "SET NAME=%s", name);
     BC127SendCommand(bt, nameSetCommand);
     // Set the "short" name
     char nameShortSetCommand[24] = {0};
     char shortName[9] = {0};
     UtilsStrncpy(shortName, name, BC127_SHORT_NAME_MAX_LEN);
-    snprintf(nameShortSetCommand, 24, "SET NAME_SHORT=%s", shortName);
+    UtilsFormat(nameShortSetCommand, 24, "SET NAME_SHORT=%s", shortName);
     BC127SendCommand(bt, nameShortSetCommand);
     BC127CommandWrite(bt);
 }
@@ -1020,7 +1022,7 @@ void BC127CommandSetModuleName(BT_t *bt, char *name)
 void BC127CommandSetPin(BT_t *bt, char *pin)
 {
     char command[13] = {0};
-    snprintf(command, 13, "SET PIN=%s", pin);
+    UtilsFormat(command, 13, "SET PIN=%s", pin);
     BC127SendCommand(bt, command);
     BC127CommandWrite(bt);
 }
@@ -1043,7 +1045,7 @@ void BC127CommandSetProfiles(
     uint8_t hfp
 ) {
     char command[37] = {0};
-    snprintf(
+    UtilsFormat(
         command,
         37,
         "SET PROFILES=%d 0 %d 0 %d %d 1 1 0 0 1 0",
@@ -1076,7 +1078,7 @@ void BC127CommandSetUART(
 ) {
     long long unsigned int baud = (long long unsigned int) baudRate;
     char command[29] = {0};
-    snprintf(
+    UtilsFormat(
         command,
         29,
         "SET UART_CONFIG=%llu %s %d",
@@ -1131,7 +1133,7 @@ void BC127CommandToggleVR(BT_t *bt)
 {
     if (bt->activeDevice.hfpId != 0) {
         char command[16] = {0};
-        snprintf(command, 16, "TOGGLE_VR %d", bt->activeDevice.hfpId);
+        UtilsFormat(command, 16, "TOGGLE_VR %d", bt->activeDevice.hfpId);
         BC127SendCommand(bt, command);
     } else {
         LogWarning("BT: Unable to TOGGLE_VR - HFP link unopened");
@@ -1151,7 +1153,7 @@ void BC127CommandToggleVR(BT_t *bt)
 void BC127CommandTone(BT_t *bt, char *params)
 {
     char command[128] = {0};
-    snprintf(command, 128, "TONE %s", params);
+    UtilsFormat(command, 128, "TONE %s", params);
     BC127SendCommand(bt, command);
 }
 
@@ -1205,7 +1207,7 @@ void BC127CommandVolume(BT_t *bt, uint8_t linkId, char *volume)
         BC127SendCommand(bt, command);
     } else {
         char command[15] = {0};
-        snprintf(command, 15, "VOLUME %d %s", linkId, volume);
+        UtilsFormat(command, 15, "VOLUME %d %s", linkId, volume);
         BC127SendCommand(bt, command);
     }
 }
@@ -1226,6 +1228,21 @@ void BC127CommandWrite(BT_t *bt)
     BC127SendCommand(bt, command);
 }
 
+/**
+ * BC127GetRxOverflows()
+ *     Description:
+ *         Get the number of lines that were dropped because they did not fit
+ *         in the RX line buffer
+ *     Params:
+ *         None
+ *     Returns:
+ *         uint16_t - The overflow count
+ */
+uint16_t BC127GetRxOverflows()
+{
+    return BC127Rx.overflows;
+}
+
 /**
  * BC127GetDeviceId()
  *     Description:
@@ -1338,10 +1355,7 @@ void BC127ProcessEventAT(BT_t *bt, char **msgBuf, uint8_t delimCount)
             }
         }
         if (strlen(callerId) > 0) {
-            // Clear the existing buffer
-            memset(bt->callerId, 0, BT_CALLER_ID_FIELD_SIZE);
-            UtilsStrncpy(bt->callerId, callerId, BT_CALLER_ID_FIELD_SIZE);
-            EventTriggerCallback(BT_EVENT_CALLER_ID_UPDATE, 0);
+            BTCallerIdSet(bt, callerId);
         }
     } else if (strcmp(msgBuf[3], "+CCLK:") == 0) {
         // Parse the returned date and time so we can update the vehicle
@@ -1433,40 +1447,28 @@ void BC127ProcessEventAVRCPMedia(BT_t *bt, char **msgBuf, char *msg)
     if (strcmp(msgBuf[2], "TITLE:") == 0) {
         char title[BT_METADATA_MAX_SIZE] = {0};
         UtilsNormalizeText(title, &msg[BC127_METADATA_TITLE_OFFSET], BT_METADATA_MAX_SIZE);
-        if(strncmp(bt->title, title, BT_METADATA_FIELD_SIZE) != 0) {
+        if (BTMetadataFieldEquals(bt, BT_METADATA_FIELD_TITLE, title) == 0) {
             bt->metadataStatus = BT_METADATA_STATUS_UPD;
-            memset(bt->title, 0, BT_METADATA_FIELD_SIZE);
-            memset(bt->artist, 0, BT_METADATA_FIELD_SIZE);
-            memset(bt->album, 0, BT_METADATA_FIELD_SIZE);
-            UtilsStrncpy(bt->title, title, BT_METADATA_FIELD_SIZE);
+            // A new title means the artist and album that follow belong to
+            // a new track, so they give up their space before it is written
+            BTMetadataSetTrack(bt, title, "", "");
         }
     } else if (strcmp(msgBuf[2], "ARTIST:") == 0) {
         char artist[BT_METADATA_MAX_SIZE] = {0};
         UtilsNormalizeText(artist, &msg[BC127_METADATA_ARTIST_OFFSET], BT_METADATA_MAX_SIZE);
-        if(strncmp(bt->artist, artist, BT_METADATA_FIELD_SIZE) != 0) {
+        if (BTMetadataSetField(bt, BT_METADATA_FIELD_ARTIST, artist) == 1) {
             bt->metadataStatus = BT_METADATA_STATUS_UPD;
-            memset(bt->artist, 0, BT_METADATA_FIELD_SIZE);
-            UtilsStrncpy(bt->artist, artist, BT_METADATA_FIELD_SIZE);
         }
     } else {
         if (strcmp(msgBuf[2], "ALBUM:") == 0) {
             char album[BT_METADATA_MAX_SIZE] = {0};
             UtilsNormalizeText(album, &msg[BC127_METADATA_ALBUM_OFFSET], BT_METADATA_MAX_SIZE);
-            if(strncmp(bt->album, album, BT_METADATA_FIELD_SIZE) != 0) {
+            if (BTMetadataSetField(bt, BT_METADATA_FIELD_ALBUM, album) == 1) {
                 bt->metadataStatus = BT_METADATA_STATUS_UPD;
-                memset(bt->album, 0, BT_METADATA_FIELD_SIZE);
-                UtilsStrncpy(bt->album, album, BT_METADATA_FIELD_SIZE);
             }
         }
         if (bt->metadataStatus == BT_METADATA_STATUS_UPD) {
-            LogDebug(
-                LOG_SOURCE_BT,
-                "BT: title=%s,artist=%s,album=%s",
-                bt->title,
-                bt->artist,
-                bt->album
-            );
-            EventTriggerCallback(BT_EVENT_METADATA_UPDATE, 0);
+            BTMetadataPublish(bt);
             bt->metadataStatus = BT_METADATA_STATUS_CUR;
         }
     }
@@ -1598,6 +1600,7 @@ void BC127ProcessEventCloseOk(BT_t *bt, char **msgBuf)
         if (strcmp(msgBuf[2], "PBAP") == 0) {
             bt->pbap.active = 0;
             bt->pbap.status = BT_PBAP_STATUS_IDLE;
+            BTPBAPPrefetchClear(bt);
             uint8_t pbapStatus = 0xFF;
             EventTriggerCallback(BT_EVENT_PBAP_SESSION_STATUS, &pbapStatus);
         }
@@ -1755,14 +1758,15 @@ void BC127ProcessEventList(BT_t *bt, char **msgBuf)
 void BC127ProcessEventName(BT_t *bt, char **msgBuf, char *msg)
 {
     char deviceName[BT_DEVICE_NAME_LEN] = {0};
-    uint8_t idx;
+    uint16_t idx;
     uint8_t strIdx = 0;
-    uint8_t nameLen = strlen(msg);
+    // The MAC ID is still null terminated, so measure from the joined name
+    uint16_t nameLen = (msgBuf[2] - msg) + strlen(msgBuf[2]);
     if (nameLen > BC127_DEVICE_NAME_OFFSET) {
         for (idx = 0; idx < nameLen - BC127_DEVICE_NAME_OFFSET; idx++) {
             char c = msg[idx + BC127_DEVICE_NAME_OFFSET];
             // 0x22 (") is the character that wraps the device name
-            if (c != 0x22) {
+            if (c != 0x22 && strIdx < BT_DEVICE_NAME_LEN - 1) {
                 deviceName[strIdx] = c;
                 strIdx++;
             }
@@ -1808,39 +1812,20 @@ void BC127ProcessEventOk(BT_t *bt, char **msgBuf)
         BC127CommandStatus(bt);
     }
     if (bt->pbap.status == BT_PBAP_STATUS_WAITING) {
-        // Flush any partial delimiter match into the line buffer
-        if (bt->pbap.parser.isDelim > 0) {
-            uint8_t j;
-            for (j = 0; j < bt->pbap.parser.isDelim; j++) {
-                if (bt->pbap.parser.bufferIdx < BT_PBAP_LINE_BUFFER_SIZE - 1) {
-                    bt->pbap.parser.buffer[bt->pbap.parser.bufferIdx++] =
-                        BC127_PBAP_DELIM[j];
-                }
+        // Pass through an escape that the data ended in the middle of
+        if (bt->pbap.parser.escapeIdx > 0) {
+            BTPBAPParseByte(bt, BC127_PBAP_ESCAPE);
+            if (bt->pbap.parser.escapeIdx == 2) {
+                BTPBAPParseByte(bt, bt->pbap.parser.escapeHigh);
             }
-            bt->pbap.parser.isDelim = 0;
+            bt->pbap.parser.escapeIdx = 0;
         }
-        // Flush any residual data left in the parser buffer (e.g. END:VCARD)
-        if (bt->pbap.parser.bufferIdx > 0) {
-            bt->pbap.parser.buffer[bt->pbap.parser.bufferIdx] = '\0';
-            BTPBAPParseVCard(bt);
-            bt->pbap.parser.bufferIdx = 0;
-        }
-        bt->pbap.status = BT_PBAP_STATUS_IDLE;
-        LogDebug(
-            LOG_SOURCE_BT,
-            "BT: PBAP complete, %d contacts",
-            bt->pbap.contactCount
-        );
-        EventTriggerCallback(BT_EVENT_PBAP_CONTACT_RECEIVED, 0);
+        BTPBAPPullComplete(bt);
     } else if (bt->pbap.status != BT_PBAP_STATUS_IDLE) {
-        bt->pbap.contactCount = 0;
-        bt->pbap.status = BT_PBAP_STATUS_IDLE;
-        LogDebug(
-            LOG_SOURCE_BT,
-            "BT: PBAP complete, %d contacts",
-            bt->pbap.contactCount
-        );
-        EventTriggerCallback(BT_EVENT_PBAP_CONTACT_RECEIVED, 0);
+        if (!bt->pbap.requestSync && !bt->pbap.requestPrefetch) {
+            bt->pbap.contactCount = 0;
+        }
+        BTPBAPPullComplete(bt);
     }
 }
 
@@ -1944,6 +1929,7 @@ void BC127ProcessEventOpenOk(BT_t *bt, char **msgBuf)
         linkType = BT_LINK_TYPE_PBAP;
         bt->pbap.active = 1;
         bt->pbap.status = BT_PBAP_STATUS_IDLE;
+        BTPBAPPrefetchClear(bt);
         uint8_t status = 0;
         EventTriggerCallback(BT_EVENT_PBAP_SESSION_STATUS, &status);
     }
@@ -1955,80 +1941,51 @@ void BC127ProcessEventOpenOk(BT_t *bt, char **msgBuf)
 }
 
 /**
- * BC127ProcessProcessEventPBPull()
+ * BC127ProcessEventPBPull()
  *     Description:
- *         Handle PB_PULL vCard data directly from the ring buffer into the
- *         parser, character by character.  This avoids allocating the entire
- *         message on the stack (which can be >800 bytes for large pulls)
- *         and drains the ring buffer quickly so the ISR has room to write
- *         the next UART line.
+ *         Feed one byte of PB_PULL vCard data into the parser. The RX line
+ *         assembler strips the "PB_PULL <linkId> <size> " header and streams
+ *         the payload through here as it arrives. The BC127 escapes bytes as
+ *         "\XX", so CRLF arrives as "\0D\0A". The escapes are decoded here
+ *         so that the parser sees the raw vCard data, and one that is not
+ *         followed by two hex characters is passed through as is.
  *     Params:
  *         BT_t *bt - A pointer to the module object
- *         char *msg - The string of characters in the queue
- *         uint8_t hasHeader - If we need to
+ *         uint8_t c - The next byte of vCard data
  *     Returns:
  *         void
  */
-void BC127ProcessEventPBPull(BT_t *bt, char *msg, uint8_t hasHeader)
+void BC127ProcessEventPBPull(BT_t *bt, uint8_t c)
 {
-    uint16_t i = 0;
-    uint16_t messageLength = strlen(msg);
-    if (hasHeader) {
-        // Skip past "PB_PULL <linkId> <size> "
-        if (memcmp(msg, "PB_PULL", 7) == 0) {
-            uint8_t spaceCount = 0;
-            while (i < messageLength) {
-                i++;
-                if (msg[i] == ' ') {
-                    spaceCount++;
-                    if (spaceCount == 3) {
-                        // Advance past the space
-                        i++;
-                        break;
-                    }
-                }
-            }
-        }
+    if (c == BC127_MSG_END_CHAR) {
+        return;
     }
-    // Feed remaining bytes directly into the vCard parser
-    while (i < messageLength) {
-        uint8_t c = msg[i];
-        if (c == BC127_MSG_END_CHAR) {
-            continue;
-        }
-        BTPBAPParserState_t *parser = &bt->pbap.parser;
-        if (c == BC127_PBAP_DELIM[parser->isDelim]) {
-            parser->isDelim++;
-            if (parser->isDelim == 6) {
-                // Full delimiter matched: null-terminate and parse the line
-                parser->buffer[parser->bufferIdx] = '\0';
-                BTPBAPParseVCard(bt);
-                parser->bufferIdx = 0;
-                parser->isDelim = 0;
-            }
-        } else if (parser->isDelim > 0) {
-            // Partial match failed — flush the matched chars into the line buffer
-            uint8_t j;
-            for (j = 0; j < parser->isDelim; j++) {
-                if (parser->bufferIdx < BT_PBAP_LINE_BUFFER_SIZE - 1) {
-                    parser->buffer[parser->bufferIdx++] = BC127_PBAP_DELIM[j];
-                }
-            }
-            parser->isDelim = 0;
-            // Re-check the current char against the start of the delimiter
-            if (c == BC127_PBAP_DELIM[0]) {
-                parser->isDelim = 1;
-            } else {
-                if (parser->bufferIdx < BT_PBAP_LINE_BUFFER_SIZE - 1) {
-                    parser->buffer[parser->bufferIdx++] = c;
-                }
-            }
+    BTPBAPParserState_t *parser = &bt->pbap.parser;
+    if (parser->escapeIdx == 0) {
+        if (c == BC127_PBAP_ESCAPE) {
+            parser->escapeIdx = 1;
         } else {
-            if (parser->bufferIdx < BT_PBAP_LINE_BUFFER_SIZE - 1) {
-                parser->buffer[parser->bufferIdx++] = c;
-            }
+            BTPBAPParseByte(bt, c);
         }
-        i++;
+        return;
+    }
+    if (UtilsHexToNibble((char) c) == UTILS_HEX_INVALID) {
+        BTPBAPParseByte(bt, BC127_PBAP_ESCAPE);
+        if (parser->escapeIdx == 2) {
+            BTPBAPParseByte(bt, parser->escapeHigh);
+        }
+        parser->escapeIdx = 0;
+        BC127ProcessEventPBPull(bt, c);
+    } else if (parser->escapeIdx == 1) {
+        parser->escapeHigh = (char) c;
+        parser->escapeIdx = 2;
+    } else {
+        parser->escapeIdx = 0;
+        BTPBAPParseByte(
+            bt,
+            (UtilsHexToNibble(parser->escapeHigh) << 4) |
+            UtilsHexToNibble((char) c)
+        );
     }
 }
 
@@ -2088,191 +2045,258 @@ void BC127ProcessEventState(BT_t *bt, char **msgBuf)
 }
 
 /**
- * BC127Process()
+ * BC127RxReset()
+ *     Description:
+ *         Discard the line that is currently being assembled
+ *     Params:
+ *         None
+ *     Returns:
+ *         void
+ */
+static void BC127RxReset()
+{
+    BC127Rx.mode = BC127_RX_MODE_LINE;
+    BC127Rx.tokenOpen = 0;
+    BC127Rx.overflow = 0;
+    BC127Rx.tokenCount = 0;
+    BC127Rx.lineLength = 0;
+}
+
+/**
+ * BC127RxFeed()
  *     Description:
- *         Read the RX queue and process the messages into meaningful data
+ *         Advance the RX line assembler by one byte. Tokens are split as the
+ *         delimiters arrive, complete lines are dispatched on the end of
+ *         message character and PB_PULL payloads are handed to the vCard
+ *         parser as soon as the header has been seen.
  *     Params:
  *         BT_t *bt - A pointer to the module object
+ *         char c - The byte read from the UART
  *     Returns:
  *         void
  */
-void BC127Process(BT_t *bt)
+static void BC127RxFeed(BT_t *bt, char c)
 {
-    uint16_t queueSize = CharQueueGetSize(&bt->uart.rxQueue);
-    uint16_t messageLength = CharQueueSeek(&bt->uart.rxQueue, BC127_MSG_END_CHAR);
-    // Message length is a misnomer, really. This should be hasEOLChar, but
-    // contextually it makes more sense to keep it as messageLength due to
-    // the way its value is subsequently used
-    if (messageLength > 0) {
-        // We received a valid message, so set the power & state to on
-        bt->powerState = BT_STATE_ON;
-        char msg[messageLength];
-        memset(msg, 0, messageLength);
-        uint16_t i;
-        uint16_t delimCount = 1;
-        for (i = 0; i < messageLength; i++) {
-            char c = CharQueueNext(&bt->uart.rxQueue);
-            if (c == BC127_MSG_DELIMETER) {
-                delimCount++;
-            }
-            if (c != BC127_MSG_END_CHAR) {
-                msg[i] = c;
-            } else {
-                // Convert to a string
-                msg[i] = '\0';
-            }
-        }
-        char tmpMsg[messageLength];
-        strcpy(tmpMsg, msg);
-        char *msgBuf[delimCount];
-        char delimeter[] = " ";
-        char *p = strtok(tmpMsg, delimeter);
-        i = 0;
-        while (p != 0x00) {
-            msgBuf[i++] = p;
-            p = strtok(0x00, delimeter);
+    char *line = (char *) BTRxBuffer;
+    if (BC127Rx.mode == BC127_RX_MODE_PB_PULL) {
+        if (c == BC127_MSG_END_CHAR) {
+            // End of this PB_PULL chunk. We stay in the waiting state until
+            // the next chunk or the closing "OK" arrives
+            bt->powerState = BT_STATE_ON;
+            BC127RxReset();
+        } else {
+            BC127ProcessEventPBPull(bt, c);
         }
-        LogDebug(LOG_SOURCE_BT, "BT: R: '%s'", msg);
-        if (strcmp(msgBuf[0], "A2DP_STREAM_SUSPEND") == 0) {
-            BC127ProcessEventA2DPStreamSuspend(bt, msgBuf);
-        } else if (strcmp(msgBuf[0], "ABS_VOL") == 0) {
-            BC127ProcessEventAbsVol(bt, msgBuf);
-        } else if (strcmp(msgBuf[0], "AT") == 0) {
-            BC127ProcessEventAT(bt, msgBuf, delimCount);
-        } else if (strcmp(msgBuf[0], "AVRCP_MEDIA") == 0) {
-            BC127ProcessEventAVRCPMedia(bt, msgBuf, msg);
-        } else if (strcmp(msgBuf[0], "AVRCP_PLAY") == 0) {
-            BC127ProcessEventAVRCPPlay(bt, msgBuf);
-        } else if (strcmp(msgBuf[0], "AVRCP_PAUSE") == 0) {
-            BC127ProcessEventAVRCPPause(bt, msgBuf);
-        } else if (strcmp(msgBuf[0], "AVRCP_STOP") == 0) {
-            BC127ProcessEventAVRCPPause(bt, msgBuf);
-        } else if (strcmp(msgBuf[0], "Build:") == 0) {
-            BC127ProcessEventBuild(bt, msgBuf);
-        } else if (strcmp(msgBuf[0], "CALL_ACTIVE") == 0) {
-            BC127ProcessEventCall(bt, (uint8_t)BT_CALL_ACTIVE);
-        } else if (strcmp(msgBuf[0], "CALL_END") == 0) {
-            BC127ProcessEventCall(bt, (uint8_t)BT_CALL_INACTIVE);
-        } else if (strcmp(msgBuf[0], "CALL_INCOMING") == 0) {
-            BC127ProcessEventCall(bt, (uint8_t)BT_CALL_INCOMING);
-        } else if (strcmp(msgBuf[0], "CALL_OUTGOING") == 0) {
-            BC127ProcessEventCall(bt, (uint8_t)BT_CALL_OUTGOING);
-        } else if (strcmp(msgBuf[0], "CLOSE_OK") == 0) {
-            BC127ProcessEventCloseOk(bt, msgBuf);
-        } else if (strcmp(msgBuf[0], "LINK") == 0) {
-            BC127ProcessEventLink(bt, msgBuf);
-        } else if (strcmp(msgBuf[0], "LINK_LOSS") == 0) {
-            BC127ProcessEventLinkLoss(bt, msgBuf);
-        } else if (strcmp(msgBuf[0], "LIST") == 0) {
-            BC127ProcessEventList(bt, msgBuf);
-        } else if (strcmp(msgBuf[0], "NAME") == 0) {
-            BC127ProcessEventName(bt, msgBuf, msg);
-        } else if (strcmp(msgBuf[0], "OK") == 0) {
-            BC127ProcessEventOk(bt, msgBuf);
-        } else if (strcmp(msgBuf[0], "OPEN_ERROR") == 0) {
-            BC127ProcessEventOpenError(bt, msgBuf);
-        } else if (strcmp(msgBuf[0], "OPEN_OK") == 0) {
-            BC127ProcessEventOpenOk(bt, msgBuf);
-        } else if (strcmp(msgBuf[0], "PENDING") == 0) {
-            if (bt->pbap.status == BT_PBAP_STATUS_PENDING) {
-                bt->pbap.status = BT_PBAP_STATUS_HEADER_WAIT;
+        return;
+    }
+    if (c == BC127_MSG_END_CHAR) {
+        line[BC127Rx.lineLength] = '\0';
+        if (BC127Rx.overflow == 1) {
+            // Handlers read fields at fixed offsets, so acting on a cut
+            // short line would do more harm than dropping it
+            BC127Rx.overflows++;
+            char *delimiter = strchr(line, BC127_MSG_DELIMETER);
+            if (delimiter != 0) {
+                *delimiter = '\0';
             }
-        } else if (strcmp(msgBuf[0], "PB_PULL") == 0) {
-            bt->pbap.status = BT_PBAP_STATUS_WAITING;
-            BC127ProcessEventPBPull(bt, msg, 1);
-        } else if (strcmp(msgBuf[0], "SCO_CLOSE") == 0) {
-            BC127ProcessEventSCO(bt, (uint8_t)BT_CALL_SCO_CLOSE);
-        } else if (strcmp(msgBuf[0], "SCO_OPEN") == 0) {
-            BC127ProcessEventSCO(bt, (uint8_t)BT_CALL_SCO_OPEN);
-        } else if (strcmp(msgBuf[0], "STATE") == 0) {
-            BC127ProcessEventState(bt, msgBuf);
-        } else {
-            // Parse any partial data
-            if (bt->pbap.status == BT_PBAP_STATUS_WAITING) {
-                BC127ProcessEventPBPull(bt, msg, 0);
-                // We had a BC127_MSG_END_CHAR, so we should expect
-                // that the next message will have the header prepended
-                bt->pbap.status = BT_PBAP_STATUS_HEADER_WAIT;
+            LogError(
+                "BT: RX Line Dropped: %s exceeds %d bytes",
+                line,
+                BC127_RX_LINE_SIZE - 1
+            );
+        } else if (BC127Rx.tokenCount > 0) {
+            LogDebug(LOG_SOURCE_BT, "BT: R: '%s'", line);
+            uint16_t i;
+            for (i = 0; i < BC127Rx.lineLength; i++) {
+                if (line[i] == BC127_MSG_DELIMETER) {
+                    line[i] = '\0';
+                }
             }
-        }
-        // Reset the age of the Rx queue
-        bt->rxQueueAge = 0;
-    } else if (queueSize > 0) {
-        // Handle expiry of the RX queue as required
-        if (bt->rxQueueAge == 0) {
-            bt->rxQueueAge = TimerGetMillis();
-        } else {
-            if ((TimerGetMillis() - bt->rxQueueAge) > BC127_RX_QUEUE_TIMEOUT) {
-                UARTRXQueueReset(&bt->uart);
-                bt->rxQueueAge = 0;
-                LogInfo(LOG_SOURCE_BT, "BT: RX Queue Timeout");
-                UARTReportErrors(&bt->uart);
-                return;
+            // Point unused tokens to an empty string so that handlers
+            // indexing past the end of short lines read nothing
+            for (i = BC127Rx.tokenCount; i < BC127_RX_TOKEN_MAX; i++) {
+                BC127Rx.tokens[i] = &line[BC127Rx.lineLength];
             }
+            // We received a valid message, so set the power & state to on
+            bt->powerState = BT_STATE_ON;
+            BC127ProcessLine(bt, line, BC127Rx.tokens, BC127Rx.tokenCount);
         }
-        // Important: We must stream PBAP data out of the UART ring buffer
-        // as it comes in so that it does not overflow
+        BC127RxReset();
+        return;
+    }
+    if (BC127Rx.lineLength >= BC127_RX_LINE_SIZE - 1) {
+        BC127Rx.overflow = 1;
+        return;
+    }
+    line[BC127Rx.lineLength] = c;
+    if (c == BC127_MSG_DELIMETER) {
         if (
-            bt->pbap.status == BT_PBAP_STATUS_IDLE ||
-            bt->pbap.status == BT_PBAP_STATUS_PENDING
+            BC127Rx.tokenOpen == 1 &&
+            BC127Rx.tokenCount == BC127_RX_PB_PULL_HEADER_TOKENS &&
+            strncmp(BC127Rx.tokens[0], "PB_PULL ", 8) == 0
         ) {
-            UARTReportErrors(&bt->uart);
+            // The header is complete, so everything up to the end of
+            // message character is vCard data
+            line[BC127Rx.lineLength] = '\0';
+            LogDebug(LOG_SOURCE_BT, "BT: R: '%s'", line);
+            bt->pbap.status = BT_PBAP_STATUS_WAITING;
+            BC127RxReset();
+            BC127Rx.mode = BC127_RX_MODE_PB_PULL;
             return;
         }
-        uint16_t i = 0;
-        if (bt->pbap.status == BT_PBAP_STATUS_HEADER_WAIT) {
-            // Check for the header
-            uint8_t delimCount = 0;
-            uint8_t header[BC127_PBAP_CMD_LEN + 1] = {0};
-            for (i = 0; i < queueSize; i++) {
-                char c = CharQueueGetOffset(&bt->uart.rxQueue, i);
-                if (i < BC127_PBAP_CMD_LEN) {
-                    header[i] = c;
-                } else if (c == ' ') {
-                    delimCount++;
-                }
-                if (delimCount == 3) {
-                    i++;
-                    break;
-                }
-            }
-            if (
-                memcmp(header, "PB_PULL", 7) == 0 &&
-                delimCount == 3
-            ) {
-                // Remove the header
-                while (i > 0) {
-                    i--;
-                    CharQueueNext(&bt->uart.rxQueue);
-                }
-                bt->pbap.status = BT_PBAP_STATUS_WAITING;
+        BC127Rx.tokenOpen = 0;
+    } else {
+        if (BC127Rx.tokenOpen == 0) {
+            BC127Rx.tokenOpen = 1;
+            if (BC127Rx.tokenCount < BC127_RX_TOKEN_MAX) {
+                BC127Rx.tokens[BC127Rx.tokenCount] =
+                    &line[BC127Rx.lineLength];
+                BC127Rx.tokenCount++;
             }
         }
-        if (bt->pbap.status == BT_PBAP_STATUS_WAITING) {
-            // Ensure we have the newest queue size
-            queueSize = CharQueueGetSize(&bt->uart.rxQueue);
-            char msg[queueSize + 1];
-            memset(&msg, 0, queueSize + 1);
-            for (i = 0; i < queueSize; i++) {
-                msg[i] = CharQueueNext(&bt->uart.rxQueue);
-                if (msg[i] == BC127_MSG_END_CHAR) {
-                    msg[i] = 0;
-                    bt->pbap.status = BT_PBAP_STATUS_HEADER_WAIT;
-                    break;
-                }
-            }
-            msg[i++] = '\0';
-            if (strlen(msg) > 0) {
-                // s = Streamed in
-                LogDebug(LOG_SOURCE_BT, "BT: R[s]: '%s'", msg);
-                BC127ProcessEventPBPull(bt, msg, 0);
-            }
+    }
+    BC127Rx.lineLength++;
+}
+
+/**
+ * BC127Process()
+ *     Description:
+ *         Drain the RX queue into the line assembler. Only the bytes that are
+ *         on the queue when we are called are consumed, and the assembler
+ *         keeps its state until the next call.
+ *     Params:
+ *         BT_t *bt - A pointer to the module object
+ *     Returns:
+ *         void
+ */
+void BC127Process(BT_t *bt)
+{
+    uint16_t queueSize = CharQueueGetSize(&bt->uart.rxQueue);
+    if (queueSize > 0) {
+        while (queueSize > 0) {
+            BC127RxFeed(bt, CharQueueNext(&bt->uart.rxQueue));
+            queueSize--;
+        }
+        // Track how long a partial line has been waiting on its terminator
+        if (BC127Rx.lineLength > 0 || BC127Rx.mode == BC127_RX_MODE_PB_PULL) {
+            bt->rxQueueAge = TimerGetMillis();
+        } else {
             bt->rxQueueAge = 0;
         }
+    } else if (bt->rxQueueAge != 0) {
+        // Handle expiry of a partial line as required
+        if ((TimerGetMillis() - bt->rxQueueAge) > BC127_RX_QUEUE_TIMEOUT) {
+            BC127RxReset();
+            bt->rxQueueAge = 0;
+            LogInfo(LOG_SOURCE_BT, "BT: RX Queue Timeout");
+        }
     }
     UARTReportErrors(&bt->uart);
 }
 
+/**
+ * BC127RxJoinTokens()
+ *     Description:
+ *         Put the delimiters back from the given token to the end of the line
+ *         that is being dispatched, so that handlers reading free text at a
+ *         fixed offset see it as it was received. The tokens before it stay
+ *         null terminated.
+ *     Params:
+ *         char **msgBuf - The tokens of the line
+ *         uint8_t start - The first token to join
+ *     Returns:
+ *         void
+ */
+static void BC127RxJoinTokens(char **msgBuf, uint8_t start)
+{
+    char *end = (char *) &BTRxBuffer[BC127Rx.lineLength];
+    char *c = msgBuf[start];
+    while (c < end) {
+        if (*c == '\0') {
+            *c = BC127_MSG_DELIMETER;
+        }
+        c++;
+    }
+}
+
+/**
+ * BC127ProcessLine()
+ *     Description:
+ *         Dispatch a complete line from the BC127 to its event handler
+ *     Params:
+ *         BT_t *bt - A pointer to the module object
+ *         char *msg - The line, without the end of message character. Its
+ *             delimiters are null until BC127RxJoinTokens() restores them
+ *         char **msgBuf - The line split into tokens using spaces as the
+ *             delimiter
+ *         uint8_t tokenCount - The number of tokens in msgBuf
+ *     Returns:
+ *         void
+ */
+void BC127ProcessLine(BT_t *bt, char *msg, char **msgBuf, uint8_t tokenCount)
+{
+    if (strcmp(msgBuf[0], "A2DP_STREAM_SUSPEND") == 0) {
+        BC127ProcessEventA2DPStreamSuspend(bt, msgBuf);
+    } else if (strcmp(msgBuf[0], "ABS_VOL") == 0) {
+        BC127ProcessEventAbsVol(bt, msgBuf);
+    } else if (strcmp(msgBuf[0], "AT") == 0) {
+        BC127ProcessEventAT(bt, msgBuf, tokenCount);
+    } else if (strcmp(msgBuf[0], "AVRCP_MEDIA") == 0) {
+        BC127RxJoinTokens(msgBuf, 3);
+        BC127ProcessEventAVRCPMedia(bt, msgBuf, msg);
+    } else if (strcmp(msgBuf[0], "AVRCP_PLAY") == 0) {
+        BC127ProcessEventAVRCPPlay(bt, msgBuf);
+    } else if (strcmp(msgBuf[0], "AVRCP_PAUSE") == 0) {
+        BC127ProcessEventAVRCPPause(bt, msgBuf);
+    } else if (strcmp(msgBuf[0], "AVRCP_STOP") == 0) {
+        BC127ProcessEventAVRCPPause(bt, msgBuf);
+    } else if (strcmp(msgBuf[0], "Build:") == 0) {
+        BC127ProcessEventBuild(bt, msgBuf);
+    } else if (strcmp(msgBuf[0], "CALL_ACTIVE") == 0) {
+        BC127ProcessEventCall(bt, (uint8_t)BT_CALL_ACTIVE);
+    } else if (strcmp(msgBuf[0], "CALL_END") == 0) {
+        BC127ProcessEventCall(bt, (uint8_t)BT_CALL_INACTIVE);
+    } else if (strcmp(msgBuf[0], "CALL_INCOMING") == 0) {
+        BC127ProcessEventCall(bt, (uint8_t)BT_CALL_INCOMING);
+    } else if (strcmp(msgBuf[0], "CALL_OUTGOING") == 0) {
+        BC127ProcessEventCall(bt, (uint8_t)BT_CALL_OUTGOING);
+    } else if (strcmp(msgBuf[0], "CLOSE_OK") == 0) {
+        BC127ProcessEventCloseOk(bt, msgBuf);
+    } else if (strcmp(msgBuf[0], "LINK") == 0) {
+        BC127ProcessEventLink(bt, msgBuf);
+    } else if (strcmp(msgBuf[0], "LINK_LOSS") == 0) {
+        BC127ProcessEventLinkLoss(bt, msgBuf);
+    } else if (strcmp(msgBuf[0], "LIST") == 0) {
+        BC127ProcessEventList(bt, msgBuf);
+    } else if (strcmp(msgBuf[0], "NAME") == 0) {
+        BC127RxJoinTokens(msgBuf, 2);
+        BC127ProcessEventName(bt, msgBuf, msg);
+    } else if (strcmp(msgBuf[0], "OK") == 0) {
+        BC127ProcessEventOk(bt, msgBuf);
+    } else if (strcmp(msgBuf[0], "OPEN_ERROR") == 0) {
+        BC127ProcessEventOpenError(bt, msgBuf);
+    } else if (strcmp(msgBuf[0], "OPEN_OK") == 0) {
+        BC127ProcessEventOpenOk(bt, msgBuf);
+    } else if (strcmp(msgBuf[0], "PB_PULL") == 0) {
+        // A PB_PULL without a payload, since the assembler streams the
+        // payload of every other PB_PULL straight to the vCard parser
+        bt->pbap.status = BT_PBAP_STATUS_WAITING;
+    } else if (strcmp(msgBuf[0], "SCO_CLOSE") == 0) {
+        BC127ProcessEventSCO(bt, (uint8_t)BT_CALL_SCO_CLOSE);
+    } else if (strcmp(msgBuf[0], "SCO_OPEN") == 0) {
+        BC127ProcessEventSCO(bt, (uint8_t)BT_CALL_SCO_OPEN);
+    } else if (strcmp(msgBuf[0], "STATE") == 0) {
+        BC127ProcessEventState(bt, msgBuf);
+    } else if (bt->pbap.status == BT_PBAP_STATUS_WAITING) {
+        // Parse any headerless vCard data
+        BC127RxJoinTokens(msgBuf, 0);
+        while (*msg != '\0') {
+            BC127ProcessEventPBPull(bt, *msg);
+            msg++;
+        }
+    }
+}
+
 /**
  * BC127SendCommand()
  *     Description:
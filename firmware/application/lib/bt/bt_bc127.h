@@ -17,19 +17,53 @@
 #define BC127_METADATA_ALBUM_OFFSET 22
 #define BC127_MSG_END_CHAR 0x0D
 #define BC127_MSG_DELIMETER 0x20
+#define BC127_PBAP_ESCAPE '\\'
 #define BC127_SHORT_NAME_MAX_LEN 8
 #define BC127_PROFILE_COUNT 9
 #define BC127_RX_QUEUE_TIMEOUT 750
+// The line is tokenized in place, so it may use the whole RX buffer
+#define BC127_RX_LINE_SIZE BT_RX_BUFFER_SIZE
+#define BC127_RX_TOKEN_MAX 24
+#define BC127_RX_MODE_LINE 0
+#define BC127_RX_MODE_PB_PULL 1
+#define BC127_RX_PB_PULL_HEADER_TOKENS 3
 #define BC127_LINK_A2DP 0
 #define BC127_LINK_AVRCP 1
 #define BC127_LINK_HFP 3
 #define BC127_LINK_BLE 4
 #define BC127_LINK_PBAP 6
 #define BC127_LINK_MAP 8
-#define BC127_PBAP_CMD_LEN 7
 
 extern int8_t BTBC127MicGainTable[];
 
+/**
+ * BC127RxState_t
+ *     Description:
+ *         Incremental line assembler for the BC127 RX stream. Bytes are
+ *         consumed from the UART queue as they arrive and the state is kept
+ *         across calls to BC127Process(), so every byte is only looked at once
+ *     Fields:
+ *         mode - BC127_RX_MODE_LINE or BC127_RX_MODE_PB_PULL, where the payload
+ *             is streamed straight into the vCard parser
+ *         tokenOpen - If the byte before the current one was part of a token
+ *         overflow - The line exceeded BC127_RX_LINE_SIZE and will be dropped
+ *         tokenCount - The number of tokens in the line so far
+ *         lineLength - The number of bytes in the line so far
+ *         overflows - The number of lines dropped because they were too long
+ *         tokens - Pointers to the start of each token in BTRxBuffer. The
+ *             line is kept as received until the end of message character
+ *             arrives, then its delimiters are set to null in place.
+ */
+typedef struct BC127RxState_t {
+    uint8_t mode: 1;
+    uint8_t tokenOpen: 1;
+    uint8_t overflow: 1;
+    uint8_t tokenCount;
+    uint16_t lineLength;
+    uint16_t overflows;
+    char *tokens[BC127_RX_TOKEN_MAX];
+} BC127RxState_t;
+
 void BTClearMetadata(BT_t *);
 void BC127ClearPairedDevices(BT_t *);
 void BC127ClearPairingErrors(BT_t *);
@@ -84,6 +118,7 @@ void BC127CommandVersion(BT_t *);
 void BC127CommandVolume(BT_t *, uint8_t, char *);
 void BC127CommandWrite(BT_t *);
 uint8_t BC127GetDeviceId(char *);
+uint16_t BC127GetRxOverflows();
 void BC127ProcessEventA2DPStreamSuspend(BT_t *, char **);
 void BC127ProcessEventAbsVol(BT_t *, char **);
 void BC127ProcessEventAT(BT_t *, char **, uint8_t);
@@ -102,9 +137,10 @@ void BC127ProcessEventOk(BT_t *, char **);
 void BC127ProcessEventOpenError(BT_t *, char **);
 void BC127ProcessEventOpenOk(BT_t *, char **);
 void BC127ProcessEventSCO(BT_t *, uint8_t);
-void BC127ProcessEventPBPull(BT_t *, char *, uint8_t);
+void BC127ProcessEventPBPull(BT_t *, uint8_t);
 void BC127ProcessEventState(BT_t *, char **);
 void BC127Process(BT_t *);
+void BC127ProcessLine(BT_t *, char *, char **, uint8_t);
 void BC127SendCommand(BT_t *, char *);
 void BC127SendCommandEmpty(BT_t *);
 
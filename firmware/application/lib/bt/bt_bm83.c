@@ -9,6 +9,7 @@
 #include <stdint.h>
 #include <string.h>
 #include "bt_common.h"
+#include "../config.h"
 #include "../event.h"
 #include "../locale.h"
 #include "../log.h"
@@ -34,6 +35,75 @@ int8_t BTBM83MicGainTable[] = {
     46
 };
 
+static BM83RxState_t BM83Rx;
+static BM83TxCommand_t BM83TxQueue[BM83_TX_QUEUE_SIZE];
+static uint8_t BM83TxQueueCount = 0;
+static BM83TxStats_t BM83TxStats;
+static BM83AVRCPCache_t BM83AVRCPCache;
+
+static uint8_t BM83AVRCPCacheIsCurrent(BT_t *);
+static void BM83AVRCPCacheSetTrackId(uint8_t *, uint16_t);
+static void BM83TxQueueAck(uint8_t, uint8_t);
+static void BM83TxQueueProcess(BT_t *);
+static void BM83TxQueueRemove(uint8_t);
+static void BM83WriteFrame(BT_t *, uint8_t *, size_t);
+
+/**
+ * BM83AVRCPCacheIsCurrent()
+ *     Description:
+ *         Check that the metadata cache still describes what we are showing.
+ *         The cache is stale once the device changes or the metadata has
+ *         been cleared, i.e. on disconnect.
+ *     Params:
+ *         BT_t *bt - A pointer to the module object
+ *     Returns:
+ *         uint8_t - 1 if the cache can be trusted, 0 otherwise
+ */
+static uint8_t BM83AVRCPCacheIsCurrent(BT_t *bt)
+{
+    if (
+        BM83AVRCPCache.deviceId != bt->activeDevice.deviceId ||
+        BTMetadataGetLength(bt, BT_METADATA_FIELD_TITLE) == 0
+    ) {
+        BM83AVRCPCache.fetchedIdValid = 0;
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * BM83AVRCPCacheSetTrackId()
+ *     Description:
+ *         Store the track identifier from a track changed notification.
+ *         An identifier of all 0x00 (no browsing support) or all 0xFF (no
+ *         track selected) does not tell tracks apart, so it is not used.
+ *     Params:
+ *         uint8_t *data - The AVC specific response data
+ *         uint16_t length - The length of the data
+ *     Returns:
+ *         void
+ */
+static void BM83AVRCPCacheSetTrackId(uint8_t *data, uint16_t length)
+{
+    BM83AVRCPCache.trackIdValid = 0;
+    if (length < BM83_FRAME_DB12 + BM83_AVRCP_TRACK_ID_SIZE) {
+        return;
+    }
+    uint8_t *trackId = &data[BM83_FRAME_DB12];
+    uint8_t i;
+    for (i = 0; i < BM83_AVRCP_TRACK_ID_SIZE; i++) {
+        if (trackId[i] != 0x00 && trackId[i] != 0xFF) {
+            BM83AVRCPCache.trackIdValid = 1;
+            break;
+        }
+        if (i > 0 && trackId[i] != trackId[0]) {
+            BM83AVRCPCache.trackIdValid = 1;
+            break;
+        }
+    }
+    memcpy(BM83AVRCPCache.trackId, trackId, BM83_AVRCP_TRACK_ID_SIZE);
+}
+
 /**
  * BM83CommandAVRCPGetCapabilities()
  *     Description:
@@ -68,6 +138,19 @@ void BM83CommandAVRCPGetCapabilities(BT_t *bt)
  */
 void BM83CommandAVRCPGetElementAttributesAll(BT_t *bt)
 {
+    if (
+        BM83AVRCPCacheIsCurrent(bt) == 1 &&
+        BM83AVRCPCache.trackIdValid == 1 &&
+        BM83AVRCPCache.fetchedIdValid == 1 &&
+        memcmp(
+            BM83AVRCPCache.trackId,
+            BM83AVRCPCache.fetchedTrackId,
+            BM83_AVRCP_TRACK_ID_SIZE
+        ) == 0
+    ) {
+        LogDebug(LOG_SOURCE_BT, "BT: AVRCP Metadata Cached");
+        return;
+    }
     uint8_t command[] = {
         BM83_CMD_AVC_VENDOR_DEPENDENT_CMD,
         bt->activeDevice.deviceId & 0xF, // Linked Database, the lower nibble
@@ -455,6 +538,7 @@ void BM83CommandPBAPGetPhonebook(BT_t *bt, uint8_t type, uint16_t offset, uint8_
         0x00,
         0x00
     };
+    bt->pbap.status = BT_PBAP_STATUS_PENDING;
     BM83SendCommand(bt, command, sizeof(command));
 }
 
@@ -768,6 +852,9 @@ void BM83ProcessEventAVCSpecificRsp(BT_t *bt, uint8_t *data, uint16_t length)
         case BM83_DATA_AVC_RSP_INTERIM: {
             uint8_t updateType = data[BM83_FRAME_DB11];
             LogDebug(LOG_SOURCE_BT, "BT: AVRCP Interim: %02X -> %02X", pduId, updateType);
+            if (updateType == BM83_AVRCP_EVT_PLAYBACK_TRACK_CHANGED) {
+                BM83AVRCPCacheSetTrackId(data, length);
+            }
             if (updateType == BM83_AVRCP_EVT_PLAYBACK_TRACK_CHANGED ||
                 updateType == BM83_AVRCP_EVT_NOW_PLAYING_CONTENT_CHANGED ||
                 updateType == BM83_AVRCP_EVT_ADDRESSED_PLAYER_CHANGED
@@ -800,6 +887,7 @@ void BM83ProcessEventAVCSpecificRsp(BT_t *bt, uint8_t *data, uint16_t length)
                     uint8_t updateData[2] = {updateType, status};
                     EventTriggerCallback(BT_EVENT_AVRCP_PDU_CHANGE, updateData);
                 } else if (updateType == BM83_AVRCP_EVT_PLAYBACK_TRACK_CHANGED) {
+                    BM83AVRCPCacheSetTrackId(data, length);
                     uint8_t updateData[2] = {updateType, status};
                     EventTriggerCallback(BT_EVENT_AVRCP_PDU_CHANGE, updateData);
                     LogDebug(LOG_SOURCE_BT, "BT: Track Changed");
@@ -1132,9 +1220,7 @@ void BM83ProcessEventCallerID(BT_t *bt, uint8_t *data, uint16_t length)
     for (i = 0; i < copyLen; i++) {
         callerId[i] = data[i + BM83_FRAME_DB1];
     }
-    memset(bt->callerId, 0, BT_CALLER_ID_FIELD_SIZE);
-    UtilsStrncpy(bt->callerId, callerId, BT_CALLER_ID_FIELD_SIZE);
-    EventTriggerCallback(BT_EVENT_CALLER_ID_UPDATE, 0);
+    BTCallerIdSet(bt, callerId);
 }
 
 /**
@@ -1170,6 +1256,7 @@ void BM83ProcessEventPBAP(BT_t *bt, uint8_t *data, uint16_t length)
                 uint8_t status = payload[2];
                 bt->pbap.active = (status == BM83_PBAP_SESSION_SUCCESS);
                 bt->pbap.status = BT_PBAP_STATUS_IDLE;
+                BTPBAPPrefetchClear(bt);
                 LogDebug(
                     LOG_SOURCE_BT,
                     "BT: PBAP Session %s",
@@ -1182,6 +1269,7 @@ void BM83ProcessEventPBAP(BT_t *bt, uint8_t *data, uint16_t length)
         if (bt->pbap.parser.subEvent == BM83_PBAP_EVT_SESSION_DISCONNECTED) {
             bt->pbap.active = 0;
             bt->pbap.status = BT_PBAP_STATUS_IDLE;
+            BTPBAPPrefetchClear(bt);
             LogDebug(LOG_SOURCE_BT, "BT: PBAP Session Disconnected");
             uint8_t status = 0xFF;
             EventTriggerCallback(BT_EVENT_PBAP_SESSION_STATUS, &status);
@@ -1210,10 +1298,13 @@ void BM83ProcessEventPBAP(BT_t *bt, uint8_t *data, uint16_t length)
             // Only reset contact state if this is a new operation, not a continuation
             if (bt->pbap.status != BT_PBAP_STATUS_WAITING) {
                 bt->pbap.status = BT_PBAP_STATUS_WAITING;
-                bt->pbap.contactCount = 0;
-                bt->pbap.contactIdx = 0;
                 memset(&bt->pbap.parser, 0, sizeof(bt->pbap.parser));
-                memset(bt->pbap.contacts, 0, sizeof(bt->pbap.contacts));
+                // Background pulls leave the contacts that the UI is showing alone
+                if (!bt->pbap.requestSync && !bt->pbap.requestPrefetch) {
+                    bt->pbap.contactCount = 0;
+                    bt->pbap.contactIdx = 0;
+                    memset(bt->pbap.contacts, 0, sizeof(bt->pbap.contacts));
+                }
                 // Reset the current sub-event
                 bt->pbap.parser.subEvent = payload[0];
             }
@@ -1227,33 +1318,10 @@ void BM83ProcessEventPBAP(BT_t *bt, uint8_t *data, uint16_t length)
                 dataOffset++;
             }
         }
-        // Process vCard data byte by byte
+        // Stream the vCard data through the parser
         uint16_t i;
         for (i = dataOffset; i < payloadLength; i++) {
-            uint8_t currByte = payload[i];
-            // CRLF reached, which means we have one line from the vCard
-            if (bt->pbap.parser.isDelim && currByte == '\n') {
-                bt->pbap.parser.isDelim = 0;
-                bt->pbap.parser.buffer[bt->pbap.parser.bufferIdx] = 0;
-                if (
-                    bt->pbap.parser.bufferIdx > 0 &&
-                    bt->pbap.parser.buffer[0] != ' ' &&
-                    bt->pbap.parser.buffer[0] != '\t'
-                ) {
-                    BTPBAPParseVCard(bt);
-                }
-                bt->pbap.parser.bufferIdx = 0;
-                continue;
-            }
-            bt->pbap.parser.isDelim = (currByte == BT_PBAP_FRAME_DELIM);
-            if (bt->pbap.parser.isDelim) {
-                continue;
-            }
-            if (bt->pbap.parser.bufferIdx < (BT_PBAP_LINE_BUFFER_SIZE - 1)) {
-                bt->pbap.parser.buffer[bt->pbap.parser.bufferIdx++] = currByte;
-            } else {
-                LogWarning("BT: PBAP Parser Buffer Overflow Guard");
-            }
+            BTPBAPParseByte(bt, payload[i]);
         }
         if (
             packetType == BM83_PBAP_PACKET_SINGLE ||
@@ -1261,13 +1329,7 @@ void BM83ProcessEventPBAP(BT_t *bt, uint8_t *data, uint16_t length)
         ) {
             if (bt->pbap.parser.isEndOfBody) {
                 // Transfer complete - trigger callback
-                bt->pbap.status = BT_PBAP_STATUS_IDLE;
-                LogDebug(
-                    LOG_SOURCE_BT,
-                    "BT: PBAP complete, %d contacts",
-                    bt->pbap.contactCount
-                );
-                EventTriggerCallback(BT_EVENT_PBAP_CONTACT_RECEIVED, 0);
+                BTPBAPPullComplete(bt);
             } else {
                 BM83CommandPBAPContinuation(bt);
             }
@@ -1491,12 +1553,24 @@ void BM83ProcessDataGetAllAttributes(
     uint8_t attributeCount,
     uint16_t bytePos
 ) {
-    uint8_t dataDiffers = 0;
     bt->metadataStatus = BT_METADATA_STATUS_CUR;
     uint8_t i = 0;
-    // Keep these out of the loop to limit stack pressure
+    if (bytePos < length) {
+        // Whatever we parse now belongs to the last announced track
+        memcpy(
+            BM83AVRCPCache.fetchedTrackId,
+            BM83AVRCPCache.trackId,
+            BM83_AVRCP_TRACK_ID_SIZE
+        );
+        BM83AVRCPCache.fetchedIdValid = BM83AVRCPCache.trackIdValid;
+        BM83AVRCPCache.deviceId = bt->activeDevice.deviceId;
+    }
+    // Keep these out of the loop to limit stack pressure. The fields are
+    // collected back to back in text and written together once all are in.
     char text[BT_METADATA_MAX_SIZE] = {0};
     char tempString[BT_METADATA_MAX_SIZE] = {0};
+    const char *fields[BT_METADATA_FIELD_COUNT] = {"", "", ""};
+    uint16_t textUsed = 0;
     for (i = 0; i < attributeCount; i++) {
         if (bytePos >= length) {
             LogDebug(LOG_SOURCE_BT, "BT: AVRCP Frame Overflow");
@@ -1510,205 +1584,630 @@ void BM83ProcessDataGetAllAttributes(
         uint16_t attributeLen = (data[bytePos + 1] & 0xFF) | (data[bytePos] << 8);
         // Skip over the length and to the beginning of the data
         bytePos = bytePos + 2;
-        memset(text, 0, BT_METADATA_MAX_SIZE);
-        if (
-            attributeType == BM83_AVRCP_DATA_ELEMENT_TYPE_ALBUM ||
-            attributeType == BM83_AVRCP_DATA_ELEMENT_TYPE_ARTIST ||
-            attributeType == BM83_AVRCP_DATA_ELEMENT_TYPE_TITLE
-        ) {
-            memset(tempString, 0, BT_METADATA_MAX_SIZE);
-            uint16_t j = 0;
-            for (j = 0; j < attributeLen; j++) {
-                if (j < BT_METADATA_MAX_SIZE - 1) {
-                    tempString[j] = data[bytePos];
-                }
-                bytePos++;
-            }
-            UtilsNormalizeText(text, tempString, BT_METADATA_MAX_SIZE);
-            if (strlen(text) == 0) {
-                dataDiffers = 1;
-            }
-        }
+        uint8_t fieldIdx = BT_METADATA_FIELD_COUNT;
         switch (attributeType) {
-            case BM83_AVRCP_DATA_ELEMENT_TYPE_TITLE: {
-                if (memcmp(text, bt->title, BT_METADATA_FIELD_SIZE) != 0) {
-                    dataDiffers = 1;
-                    memset(bt->title, 0, BT_METADATA_FIELD_SIZE);
-                    UtilsStrncpy(bt->title, text, BT_METADATA_FIELD_SIZE);
-                }
+            case BM83_AVRCP_DATA_ELEMENT_TYPE_TITLE:
+                fieldIdx = 0;
                 break;
-            }
-            case BM83_AVRCP_DATA_ELEMENT_TYPE_ARTIST: {
-                if (memcmp(text, bt->artist, BT_METADATA_FIELD_SIZE) != 0) {
-                    dataDiffers = 1;
-                    memset(bt->artist, 0, BT_METADATA_FIELD_SIZE);
-                    UtilsStrncpy(bt->artist, text, BT_METADATA_FIELD_SIZE);
-                }
+            case BM83_AVRCP_DATA_ELEMENT_TYPE_ARTIST:
+                fieldIdx = 1;
                 break;
-            }
-            case BM83_AVRCP_DATA_ELEMENT_TYPE_ALBUM: {
-                if (memcmp(text, bt->album, BT_METADATA_FIELD_SIZE) != 0) {
-                    dataDiffers = 1;
-                    memset(bt->album, 0, BT_METADATA_FIELD_SIZE);
-                    UtilsStrncpy(bt->album, text, BT_METADATA_FIELD_SIZE);
-                }
+            case BM83_AVRCP_DATA_ELEMENT_TYPE_ALBUM:
+                fieldIdx = 2;
                 break;
+        }
+        if (fieldIdx == BT_METADATA_FIELD_COUNT) {
+            bytePos = bytePos + attributeLen;
+            continue;
+        }
+        memset(tempString, 0, BT_METADATA_MAX_SIZE);
+        uint16_t j = 0;
+        for (j = 0; j < attributeLen; j++) {
+            if (j < BT_METADATA_MAX_SIZE - 1) {
+                tempString[j] = data[bytePos];
             }
-            default:
-                bytePos = bytePos + attributeLen;
-                break;
+            bytePos++;
+        }
+        // No field can hold more than BT_METADATA_FIELD_MAX_LEN, so that is
+        // all each one needs here
+        uint16_t size = BT_METADATA_MAX_SIZE - textUsed;
+        if (size > BT_METADATA_FIELD_MAX_LEN + 1) {
+            size = BT_METADATA_FIELD_MAX_LEN + 1;
+        }
+        if (size > 1) {
+            UtilsNormalizeText(&text[textUsed], tempString, size);
+            fields[fieldIdx] = &text[textUsed];
+            textUsed += strlen(&text[textUsed]) + 1;
         }
     }
-    if (dataDiffers == 1) {
-        LogDebug(
-            LOG_SOURCE_BT,
-            "BT: title=%s,artist=%s,album=%s",
-            bt->title,
-            bt->artist,
-            bt->album
-        );
-        EventTriggerCallback(BT_EVENT_METADATA_UPDATE, 0);
+    // The fields are compared byte for byte against what we hold, so a
+    // phone that sends the same track again does not cause an update
+    if (BTMetadataSetTrack(bt, fields[0], fields[1], fields[2]) == 0) {
+        LogDebug(LOG_SOURCE_BT, "BT: AVRCP Metadata Unchanged");
     }
+    BTMetadataPublish(bt);
 }
 
 /**
- * BM83Process()
+ * BM83GetRxChecksumErrors()
  *     Description:
- *         Read the RX queue and process the messages into meaningful data
+ *         Get the number of frames that were dropped because their checksum
+ *         did not match
+ *     Params:
+ *         None
+ *     Returns:
+ *         uint16_t - The checksum error count
+ */
+uint16_t BM83GetRxChecksumErrors()
+{
+    return BM83Rx.checksumErrors;
+}
+
+/**
+ * BM83GetRxResyncs()
+ *     Description:
+ *         Get the number of times the decoder lost the frame boundary and had
+ *         to hunt for the next start word
+ *     Params:
+ *         None
+ *     Returns:
+ *         uint16_t - The resync count
+ */
+uint16_t BM83GetRxResyncs()
+{
+    return BM83Rx.resyncs;
+}
+
+/**
+ * BM83GetTxStats()
+ *     Description:
+ *         Get the counters for the outbound command queue
+ *     Params:
+ *         None
+ *     Returns:
+ *         BM83TxStats_t * - The command queue counters
+ */
+BM83TxStats_t *BM83GetTxStats()
+{
+    return &BM83TxStats;
+}
+
+/**
+ * BM83RxLogFrame()
+ *     Description:
+ *         Log the frame that was just decoded in the same format the frame
+ *         appeared on the wire. The hex dump is built in chunks so that we
+ *         do not make a call into the logger for every byte.
+ *     Params:
+ *         None
+ *     Returns:
+ *         void
+ */
+static void BM83RxLogFrame()
+{
+    if (ConfigGetLog(LOG_SOURCE_BT) == 0) {
+        return;
+    }
+    char buffer[(BM83_FRAME_LOG_CHUNK * 3) + 1];
+    uint8_t bufferIdx = 0;
+    uint16_t i = 0;
+    long long unsigned int ts = (long long unsigned int) TimerGetMillis();
+    LogRawDebug(
+        LOG_SOURCE_BT,
+        "[%llu] DEBUG: BM83: RX: AA %02X %02X %02X ",
+        ts,
+        BM83Rx.frameLength >> 8,
+        BM83Rx.frameLength & 0xFF,
+        BM83Rx.opcode
+    );
+    for (i = 0; i < BM83Rx.dataLength; i++) {
+        UtilsFormat(&buffer[bufferIdx * 3], 4, "%02X ", BTRxBuffer[i]);
+        bufferIdx++;
+        if (bufferIdx == BM83_FRAME_LOG_CHUNK) {
+            LogRawDebug(LOG_SOURCE_BT, "%s", buffer);
+            bufferIdx = 0;
+        }
+    }
+    buffer[bufferIdx * 3] = '\0';
+    LogRawDebug(
+        LOG_SOURCE_BT,
+        "%s%02X\r\n",
+        buffer,
+        (uint8_t) (0x100 - BM83Rx.checksum)
+    );
+}
+
+/**
+ * BM83RxResync()
+ *     Description:
+ *         Drop the frame that is currently being decoded and go back to
+ *         looking for a start word
+ *     Params:
+ *         None
+ *     Returns:
+ *         void
+ */
+static void BM83RxResync()
+{
+    BM83Rx.state = BM83_RX_STATE_SYNC;
+    BM83Rx.resyncs++;
+}
+
+/**
+ * BM83RxFeed()
+ *     Description:
+ *         Advance the RX frame decoder by one byte. The checksum is summed as
+ *         the bytes arrive, and a complete frame is only acknowledged and
+ *         dispatched once its checksum has been verified.
  *     Params:
  *         BT_t *bt - A pointer to the module object
+ *         uint8_t byte - The byte read from the UART
  *     Returns:
  *         void
  */
-void BM83Process(BT_t *bt)
+static void BM83RxFeed(BT_t *bt, uint8_t byte)
 {
-    uint16_t hasStartWord = CharQueueSeek(&bt->uart.rxQueue, BM83_UART_START_WORD);
-    uint16_t queueSize = CharQueueGetSize(&bt->uart.rxQueue);
-    if (queueSize >= BM83_FRAME_SIZE_MIN && hasStartWord != 0) {
-        if (hasStartWord != 1) {
-            LogRawDebug(LOG_SOURCE_BT, "BT: Trash Bytes: ");
-            while (hasStartWord > 1) {
-                uint8_t byte = CharQueueNext(&bt->uart.rxQueue);
-                LogRawDebug(LOG_SOURCE_BT, "%02X ", byte);
-                hasStartWord--;
-            }
-            LogRawDebug(LOG_SOURCE_BT, "\r\n");
-        }
-        uint8_t lengthHigh = CharQueueGetOffset(&bt->uart.rxQueue, 1);
-        uint8_t lengthLow = CharQueueGetOffset(&bt->uart.rxQueue, 2);
-        uint16_t frameLength = (lengthLow & 0xFF) | (lengthHigh << 8);
-        // Get the queue size again in case it has changed
-        queueSize = CharQueueGetSize(&bt->uart.rxQueue) - BM83_FRAME_CTRL_BYTE_COUNT;
-        if (queueSize >= frameLength && frameLength > 0) {
-            uint16_t dataLength = frameLength - 1;
-            if (dataLength > BM83_FRAME_DATA_MAX) {
-                LogError("BT: Frame too large: %d", dataLength);
-                return;
-            }
-            long long unsigned int ts = (long long unsigned int) TimerGetMillis();
-            LogRawDebug(LOG_SOURCE_BT, "[%llu] DEBUG: BM83: RX: ", ts);
-            uint16_t frameSize = frameLength + BM83_FRAME_CTRL_BYTE_COUNT;
-            uint8_t eventData[BM83_FRAME_DATA_MAX];
-            memset(eventData, 0, dataLength);
-            uint8_t event = 0x00;
-            uint16_t i = 0;
-            uint16_t j = 0;
-            // lastIdx is the index of the checksum
-            uint16_t lastIdx = frameSize - 1;
-            // Get the data
-            for (i = 0; i < frameSize; i++) {
-                uint8_t byte = CharQueueNext(&bt->uart.rxQueue);
-                LogRawDebug(LOG_SOURCE_BT, "%02X ", byte);
-                if (i == BM83_OFFSET_EVENT_CODE) {
-                    event = byte;
-                }
-                if (i >= BM83_OFFSET_EVENT_DATA &&
-                    i < lastIdx
-                ) {
-                    eventData[j] = byte;
-                    j++;
+    switch (BM83Rx.state) {
+        case BM83_RX_STATE_SYNC:
+            if (byte == BM83_UART_START_WORD) {
+                if (BM83Rx.trashBytes > 0) {
+                    LogDebug(
+                        LOG_SOURCE_BT,
+                        "BT: Dropped %d Trash Bytes",
+                        BM83Rx.trashBytes
+                    );
+                    BM83Rx.trashBytes = 0;
                 }
+                BM83Rx.checksum = 0;
+                BM83Rx.state = BM83_RX_STATE_LENGTH_HIGH;
+            } else {
+                BM83Rx.trashBytes++;
             }
-            LogRawDebug(LOG_SOURCE_BT, "\r\n");
-            // Always acknowledge reception of the frame first
-            if (event != BM83_EVT_COMMAND_ACK) {
-                uint8_t ack[] = {BM83_CMD_EVENT_ACK, event};
-                BM83SendCommand(bt, ack, sizeof(ack));
+            break;
+        case BM83_RX_STATE_LENGTH_HIGH:
+            BM83Rx.frameLength = byte << 8;
+            BM83Rx.checksum += byte;
+            BM83Rx.state = BM83_RX_STATE_LENGTH_LOW;
+            break;
+        case BM83_RX_STATE_LENGTH_LOW:
+            BM83Rx.frameLength |= byte;
+            BM83Rx.checksum += byte;
+            // The frame length includes the opcode
+            if (BM83Rx.frameLength == 0 ||
+                BM83Rx.frameLength > BM83_FRAME_DATA_MAX + 1
+            ) {
+                LogError("BT: Invalid Frame Length: %d", BM83Rx.frameLength);
+                BM83RxResync();
+            } else {
+                BM83Rx.state = BM83_RX_STATE_OPCODE;
             }
-            if (event == BM83_EVT_AVC_SPECIFIC_RSP) {
-                BM83ProcessEventAVCSpecificRsp(bt, eventData, dataLength);
+            break;
+        case BM83_RX_STATE_OPCODE:
+            BM83Rx.opcode = byte;
+            BM83Rx.checksum += byte;
+            BM83Rx.dataLength = 0;
+            if (BM83Rx.frameLength == 1) {
+                BM83Rx.state = BM83_RX_STATE_CHECKSUM;
+            } else {
+                BM83Rx.state = BM83_RX_STATE_DATA;
             }
-            if (event == BM83_EVT_AVRCP_VENDOR_DEPENDENT_RSP) {
-                BM83ProcessEventAVCVendorDependentRsp(bt, eventData, dataLength);
+            break;
+        case BM83_RX_STATE_DATA:
+            BTRxBuffer[BM83Rx.dataLength++] = byte;
+            BM83Rx.checksum += byte;
+            if (BM83Rx.dataLength == BM83Rx.frameLength - 1) {
+                BM83Rx.state = BM83_RX_STATE_CHECKSUM;
             }
-            if (event == BM83_EVT_BTM_STATUS) {
-                BM83ProcessEventBTMStatus(bt, eventData, dataLength);
+            break;
+        case BM83_RX_STATE_CHECKSUM:
+            BM83Rx.state = BM83_RX_STATE_SYNC;
+            if ((uint8_t) (BM83Rx.checksum + byte) != 0) {
+                BM83Rx.checksumErrors++;
+                LogWarning(
+                    "BT: Checksum Mismatch for Event %02X [%d] (%d Total)",
+                    BM83Rx.opcode,
+                    BM83Rx.frameLength,
+                    BM83Rx.checksumErrors
+                );
+                BM83RxResync();
+                break;
             }
-            if (event == BM83_EVT_CALL_STATUS) {
-                BM83ProcessEventCallStatus(bt, eventData, dataLength);
+            BM83RxLogFrame();
+            BM83ProcessFrame(
+                bt,
+                BM83Rx.opcode,
+                BTRxBuffer,
+                BM83Rx.dataLength
+            );
+            break;
+    }
+}
+
+/**
+ * BM83Process()
+ *     Description:
+ *         Drain the RX queue into the frame decoder. Only the bytes that are
+ *         on the queue when we are called are consumed, and the decoder keeps
+ *         its state until the next call.
+ *     Params:
+ *         BT_t *bt - A pointer to the module object
+ *     Returns:
+ *         void
+ */
+void BM83Process(BT_t *bt)
+{
+    uint16_t queueSize = CharQueueGetSize(&bt->uart.rxQueue);
+    if (queueSize > 0) {
+        while (queueSize > 0) {
+            BM83RxFeed(bt, CharQueueNext(&bt->uart.rxQueue));
+            queueSize--;
+        }
+        // Track how long a partial frame has been waiting on its remainder
+        if (BM83Rx.state != BM83_RX_STATE_SYNC) {
+            bt->rxQueueAge = TimerGetMillis();
+        } else {
+            bt->rxQueueAge = 0;
+        }
+    } else if (bt->rxQueueAge != 0) {
+        // A frame that stalls part way through has lost bytes, so drop it
+        // rather than consume the start of the next frame as its data
+        if ((TimerGetMillis() - bt->rxQueueAge) > BM83_RX_QUEUE_TIMEOUT) {
+            LogInfo(
+                LOG_SOURCE_BT,
+                "BT: RX Frame Timeout for Event %02X",
+                BM83Rx.opcode
+            );
+            BM83RxResync();
+            bt->rxQueueAge = 0;
+        }
+    }
+    if (BM83TxQueueCount > 0) {
+        BM83TxQueueProcess(bt);
+    }
+    UARTReportErrors(&bt->uart);
+}
+
+/**
+ * BM83ProcessFrame()
+ *     Description:
+ *         Acknowledge a verified frame and dispatch it to its event handler
+ *     Params:
+ *         BT_t *bt - A pointer to the module object
+ *         uint8_t event - The event code
+ *         uint8_t *data - The event data, excluding the event code
+ *         uint16_t dataLength - The length of the event data
+ *     Returns:
+ *         void
+ */
+void BM83ProcessFrame(BT_t *bt, uint8_t event, uint8_t *data, uint16_t dataLength)
+{
+    // Always acknowledge reception of the frame first
+    if (event != BM83_EVT_COMMAND_ACK) {
+        uint8_t ack[] = {BM83_CMD_EVENT_ACK, event};
+        BM83SendCommand(bt, ack, sizeof(ack));
+    } else if (dataLength >= 2) {
+        BM83TxQueueAck(data[BM83_FRAME_DB0], data[BM83_FRAME_DB1]);
+        // A slot may have opened up for the next command
+        BM83TxQueueProcess(bt);
+    }
+    if (event == BM83_EVT_AVC_SPECIFIC_RSP) {
+        BM83ProcessEventAVCSpecificRsp(bt, data, dataLength);
+    }
+    if (event == BM83_EVT_AVRCP_VENDOR_DEPENDENT_RSP) {
+        BM83ProcessEventAVCVendorDependentRsp(bt, data, dataLength);
+    }
+    if (event == BM83_EVT_BTM_STATUS) {
+        BM83ProcessEventBTMStatus(bt, data, dataLength);
+    }
+    if (event == BM83_EVT_CALL_STATUS) {
+        BM83ProcessEventCallStatus(bt, data, dataLength);
+    }
+    if (event == BM83_EVT_CALLER_ID) {
+        BM83ProcessEventCallerID(bt, data, dataLength);
+    }
+    if (event == BM83_EVT_PBAPC_EVENT) {
+        BM83ProcessEventPBAP(bt, data, dataLength);
+    }
+    if (event == BM83_EVT_READ_LINK_STATUS_REPLY) {
+        BM83ProcessEventReadLinkStatus(bt, data, dataLength);
+    }
+    if (event == BM83_EVT_READ_LINKED_DEVICE_INFORMATION_REPLY) {
+        BM83ProcessEventReadLinkedDeviceInformation(
+            bt,
+            data,
+            dataLength
+        );
+    }
+    if (event == BM83_EVT_READ_PAIRED_DEVICE_RECORD_REPLY) {
+        BM83ProcessEventReadPairedDeviceRecord(
+            bt,
+            data,
+            dataLength
+        );
+    }
+    if (event == BM83_EVT_READ_LOCAL_BD_ADDRESS_REPLY) {
+        if (dataLength == 0x06) {
+            uint8_t address[6] = {
+                data[5],
+                data[4],
+                data[3],
+                data[2],
+                data[1],
+                data[0]
+            };
+            EventTriggerCallback(BT_EVENT_BTM_ADDRESS, address);
+        }
+    }
+    if (event == BM83_EVT_REPORT_BTM_INITIAL_STATUS) {
+        if (data[BM83_FRAME_DB0] ==
+            BM83_DATA_BTM_INITIAL_STATUS_BOOT_COMPLETE
+        ) {
+            // Anything sent before the reboot will never be acknowledged
+            BM83TxQueueFlush();
+            EventTriggerCallback(BT_EVENT_BOOT, 0);
+        }
+    }
+    if (event == BM83_EVT_REPORT_LINK_BACK_STATUS) {
+        BM83ProcessEventReportLinkBackStatus(
+            bt,
+            data,
+            dataLength
+        );
+    }
+    if (event == BM83_EVT_REPORT_TYPE_CODEC) {
+        BM83ProcessEventReportTypeCodec(bt, data, dataLength);
+    }
+}
+
+/**
+ * BM83TxCommandIsRetryable()
+ *     Description:
+ *         Check whether a command can be sent a second time without changing
+ *         the outcome. Commands that dial, answer, hang up, toggle playback
+ *         or step a level are not, because a lost ACK does not mean that the
+ *         BM83 did not carry them out.
+ *     Params:
+ *         uint8_t *data - The opcode followed by the command parameters
+ *         size_t size - The length of the command
+ *     Returns:
+ *         uint8_t - 1 if the command may be resent, 0 otherwise
+ */
+static uint8_t BM83TxCommandIsRetryable(uint8_t *data, size_t size)
+{
+    switch (data[0]) {
+        case BM83_CMD_MAKE_CALL:
+        case BM83_CMD_VENDOR_AT_COMMAND:
+            return 0;
+        case BM83_CMD_MMI_ACTION:
+            if (size < 3) {
+                return 1;
             }
-            if (event == BM83_EVT_CALLER_ID) {
-                BM83ProcessEventCallerID(bt, eventData, dataLength);
+            switch (data[2]) {
+                case BM83_CMD_MMI_ACTION_ACCEPT_CALL:
+                case BM83_CMD_MMI_ACTION_END_CALL:
+                case BM83_CMD_MMI_ACTION_REDIAL:
+                case BM83_CMD_MMI_ACTION_MIC_GAIN_UP:
+                case BM83_CMD_MMI_ACTION_MIC_GAIN_DOWN:
+                    return 0;
             }
-            if (event == BM83_EVT_PBAPC_EVENT) {
-                BM83ProcessEventPBAP(bt, eventData, dataLength);
+            return 1;
+        case BM83_CMD_MUSIC_CONTROL:
+            if (size < 3) {
+                return 1;
             }
-            if (event == BM83_EVT_READ_LINK_STATUS_REPLY) {
-                BM83ProcessEventReadLinkStatus(bt, eventData, dataLength);
+            switch (data[2]) {
+                case BM83_CMD_ACTION_PLAYBACK_TOGGLE:
+                case BM83_CMD_ACTION_NEXT:
+                case BM83_CMD_ACTION_PREVIOUS:
+                    return 0;
             }
-            if (event == BM83_EVT_READ_LINKED_DEVICE_INFORMATION_REPLY) {
-                BM83ProcessEventReadLinkedDeviceInformation(
-                    bt,
-                    eventData,
-                    dataLength
-                );
+            return 1;
+    }
+    return 1;
+}
+
+/**
+ * BM83SendCommand()
+ *     Description:
+ *         Queue a command for the BM83. The command is written to the UART
+ *         right away when the module has room for it, otherwise it is sent
+ *         by BM83TxQueueProcess() once the commands ahead of it have been
+ *         acknowledged. Event acknowledgements are never queued. Commands
+ *         that arrive while the queue is full are dropped.
+ *     Params:
+ *         BT_t *bt - A pointer to the module object
+ *         uint8_t *targetData - A command to send along with its data
+ *         size_t size - The target length of the frame
+ *     Returns:
+ *         void
+ */
+void BM83SendCommand(
+    BT_t *bt,
+    uint8_t *targetData,
+    size_t size
+) {
+    if (targetData[0] == BM83_CMD_EVENT_ACK || size > BM83_FRAME_TX_MAX) {
+        BM83WriteFrame(bt, targetData, size);
+        return;
+    }
+    if (BM83TxQueueCount == BM83_TX_QUEUE_SIZE) {
+        // Nothing is coming back from the module. Writing the command anyway
+        // would only add to what it has not acknowledged, so drop it
+        BM83TxStats.overflows++;
+        LogError("BT: TX Queue Full, dropped %02X", targetData[0]);
+        return;
+    }
+    BM83TxCommand_t *command = &BM83TxQueue[BM83TxQueueCount++];
+    command->state = BM83_TX_STATE_QUEUED;
+    command->retryable = BM83TxCommandIsRetryable(targetData, size);
+    command->busy = 0;
+    command->retries = 0;
+    command->size = size;
+    command->sentAt = 0;
+    memcpy(command->data, targetData, size);
+    BM83TxQueueProcess(bt);
+}
+
+/**
+ * BM83TxQueueAck()
+ *     Description:
+ *         Match a command acknowledgement to the oldest in flight command
+ *         with the same opcode and release its slot
+ *     Params:
+ *         uint8_t opcode - The opcode being acknowledged
+ *         uint8_t status - The BM83_DATA_ACK_* status
+ *     Returns:
+ *         void
+ */
+static void BM83TxQueueAck(uint8_t opcode, uint8_t status)
+{
+    uint8_t i;
+    for (i = 0; i < BM83TxQueueCount; i++) {
+        BM83TxCommand_t *command = &BM83TxQueue[i];
+        if (
+            command->state == BM83_TX_STATE_IN_FLIGHT &&
+            command->data[0] == opcode
+        ) {
+            if (
+                status == BM83_DATA_ACK_BUSY ||
+                status == BM83_DATA_ACK_MEMORY_FULL
+            ) {
+                // Leave it in flight so that it is resent on timeout
+                command->busy = 1;
+                LogDebug(LOG_SOURCE_BT, "BT: BM83 Busy for %02X", opcode);
+                return;
             }
-            if (event == BM83_EVT_READ_PAIRED_DEVICE_RECORD_REPLY) {
-                BM83ProcessEventReadPairedDeviceRecord(
-                    bt,
-                    eventData,
-                    dataLength
-                );
+            uint16_t latency = TimerGetMillis() - command->sentAt;
+            BM83TxStats.acks++;
+            BM83TxStats.lastOpcode = opcode;
+            BM83TxStats.lastLatency = latency;
+            if (latency > BM83TxStats.maxLatency) {
+                BM83TxStats.maxLatency = latency;
             }
-            if (event == BM83_EVT_READ_LOCAL_BD_ADDRESS_REPLY) {
-                if (dataLength == 0x06) {
-                    uint8_t data[6] = {
-                        eventData[5],
-                        eventData[4],
-                        eventData[3],
-                        eventData[2],
-                        eventData[1],
-                        eventData[0]
-                    };
-                    EventTriggerCallback(BT_EVENT_BTM_ADDRESS, data);
-                }
+            if (status != BM83_DATA_ACK_COMPLETE) {
+                BM83TxStats.rejects++;
+                LogWarning("BT: Command %02X Rejected: %02X", opcode, status);
+            } else {
+                LogDebug(LOG_SOURCE_BT, "BT: ACK %02X in %dms", opcode, latency);
             }
-            if (event == BM83_EVT_REPORT_BTM_INITIAL_STATUS) {
-                if (eventData[BM83_FRAME_DB0] ==
-                    BM83_DATA_BTM_INITIAL_STATUS_BOOT_COMPLETE
-                ) {
-                    EventTriggerCallback(BT_EVENT_BOOT, 0);
-                }
+            BM83TxQueueRemove(i);
+            return;
+        }
+    }
+}
+
+/**
+ * BM83TxQueueFlush()
+ *     Description:
+ *         Drop every queued and in flight command, for when the BM83 has
+ *         rebooted and will never acknowledge them
+ *     Params:
+ *         None
+ *     Returns:
+ *         void
+ */
+void BM83TxQueueFlush()
+{
+    BM83TxQueueCount = 0;
+}
+
+/**
+ * BM83TxQueueProcess()
+ *     Description:
+ *         Resend the retryable commands that have not been acknowledged in
+ *         time, drop the others, and send as many queued commands as the in
+ *         flight limit allows. A command is
+ *         held back while an older command with the same opcode is pending,
+ *         so that acknowledgements always match up with the right command
+ *         and commands with the same opcode reach the module in order.
+ *     Params:
+ *         BT_t *bt - A pointer to the module object
+ *     Returns:
+ *         void
+ */
+static void BM83TxQueueProcess(BT_t *bt)
+{
+    uint32_t now = TimerGetMillis();
+    uint8_t inFlight = 0;
+    uint8_t i = 0;
+    while (i < BM83TxQueueCount) {
+        BM83TxCommand_t *command = &BM83TxQueue[i];
+        if (
+            command->state == BM83_TX_STATE_IN_FLIGHT &&
+            (now - command->sentAt) > BM83_TX_ACK_TIMEOUT
+        ) {
+            if (command->retryable == 0 && command->busy == 0) {
+                // It may well have been carried out, so do not risk
+                // doing it twice
+                BM83TxStats.timeouts++;
+                LogWarning("BT: Command %02X Unacknowledged", command->data[0]);
+                BM83TxQueueRemove(i);
+                continue;
             }
-            if (event == BM83_EVT_REPORT_LINK_BACK_STATUS) {
-                BM83ProcessEventReportLinkBackStatus(
-                    bt,
-                    eventData,
-                    dataLength
-                );
+            if (command->retries == BM83_TX_RETRY_MAX) {
+                BM83TxStats.timeouts++;
+                LogWarning("BT: Command %02X Timed Out", command->data[0]);
+                BM83TxQueueRemove(i);
+                continue;
             }
-            if (event == BM83_EVT_REPORT_TYPE_CODEC) {
-                BM83ProcessEventReportTypeCodec(bt, eventData, dataLength);
+            BM83TxStats.retries++;
+            command->retries++;
+            command->busy = 0;
+            command->state = BM83_TX_STATE_QUEUED;
+        }
+        if (command->state == BM83_TX_STATE_IN_FLIGHT) {
+            inFlight++;
+        }
+        i++;
+    }
+    for (i = 0; i < BM83TxQueueCount && inFlight < BM83_TX_IN_FLIGHT_MAX; i++) {
+        BM83TxCommand_t *command = &BM83TxQueue[i];
+        if (command->state != BM83_TX_STATE_QUEUED) {
+            continue;
+        }
+        uint8_t isBlocked = 0;
+        uint8_t j;
+        for (j = 0; j < i; j++) {
+            if (BM83TxQueue[j].data[0] == command->data[0]) {
+                isBlocked = 1;
+                break;
             }
         }
+        if (isBlocked == 0) {
+            BM83WriteFrame(bt, command->data, command->size);
+            command->state = BM83_TX_STATE_IN_FLIGHT;
+            command->sentAt = TimerGetMillis();
+            inFlight++;
+        }
     }
-    UARTReportErrors(&bt->uart);
 }
 
 /**
- * BM83SendCommand()
+ * BM83TxQueueRemove()
+ *     Description:
+ *         Release the given queue slot, keeping the remaining commands in the
+ *         order they were queued in
+ *     Params:
+ *         uint8_t idx - The queue slot to release
+ *     Returns:
+ *         void
+ */
+static void BM83TxQueueRemove(uint8_t idx)
+{
+    BM83TxQueueCount--;
+    if (idx < BM83TxQueueCount) {
+        memmove(
+            &BM83TxQueue[idx],
+            &BM83TxQueue[idx + 1],
+            (BM83TxQueueCount - idx) * sizeof(BM83TxCommand_t)
+        );
+    }
+}
+
+/**
+ * BM83WriteFrame()
  *     Description:
- *         Send data over UART
+ *         Frame the given command and write it to the UART
  *     Params:
  *         BT_t *bt - A pointer to the module object
  *         uint8_t *targetData - A command to send along with its data
@@ -1716,7 +2215,7 @@ void BM83Process(BT_t *bt)
  *     Returns:
  *         void
  */
-void BM83SendCommand(
+static void BM83WriteFrame(
     BT_t *bt,
     uint8_t *targetData,
     size_t size
@@ -121,8 +121,10 @@ extern int8_t BTBM83MicGainTable[];
 
 #define BM83_FRAME_SIZE_MIN 0x05
 #define BM83_FRAME_CTRL_BYTE_COUNT 0x04
+// The data is decoded into BTRxBuffer, which must be able to hold it
 #define BM83_FRAME_DATA_MAX 636
 #define BM83_FRAME_TX_MAX 32
+#define BM83_FRAME_LOG_CHUNK 64
 
 #define BM83_OFFSET_EVENT_CODE 0x03
 #define BM83_OFFSET_EVENT_DATA 0x04
@@ -308,6 +310,13 @@ extern int8_t BTBM83MicGainTable[];
 
 #define BM83_DATA_BOOT_STATUS_POWER_ON 0x01
 
+#define BM83_DATA_ACK_COMPLETE 0x00
+#define BM83_DATA_ACK_DISALLOWED 0x01
+#define BM83_DATA_ACK_UNKNOWN_COMMAND 0x02
+#define BM83_DATA_ACK_INVALID_PARAMS 0x03
+#define BM83_DATA_ACK_BUSY 0x04
+#define BM83_DATA_ACK_MEMORY_FULL 0x05
+
 
 #define BM83_EVT_COMMAND_ACK 0x00
 #define BM83_EVT_BTM_STATUS 0x01
@@ -382,6 +391,127 @@ extern int8_t BTBM83MicGainTable[];
 
 #define BM83_UART_START_WORD 0xAA
 
+#define BM83_RX_STATE_SYNC 0
+#define BM83_RX_STATE_LENGTH_HIGH 1
+#define BM83_RX_STATE_LENGTH_LOW 2
+#define BM83_RX_STATE_OPCODE 3
+#define BM83_RX_STATE_DATA 4
+#define BM83_RX_STATE_CHECKSUM 5
+#define BM83_RX_QUEUE_TIMEOUT 250
+
+/**
+ * BM83RxState_t
+ *     Description:
+ *         Incremental frame decoder for the BM83 RX stream. Bytes are consumed
+ *         from the UART queue as they arrive and the state is kept across
+ *         calls to BM83Process(), so a frame never has to be fully buffered
+ *         in the queue before we can start on it
+ *     Fields:
+ *         state - The BM83_RX_STATE_* that the next byte belongs to
+ *         opcode - The event code of the frame being decoded
+ *         checksum - The running sum of the length, opcode and data bytes
+ *         frameLength - The frame length as given by the length bytes
+ *         dataLength - The number of data bytes received so far
+ *         trashBytes - Bytes discarded while looking for the start word
+ *         checksumErrors - Frames dropped due to a checksum mismatch
+ *         resyncs - The number of times we had to hunt for a start word
+ *     The event data, excluding the opcode and checksum, is collected in the
+ *     shared BTRxBuffer
+ */
+typedef struct BM83RxState_t {
+    uint8_t state;
+    uint8_t opcode;
+    uint8_t checksum;
+    uint16_t frameLength;
+    uint16_t dataLength;
+    uint16_t trashBytes;
+    uint16_t checksumErrors;
+    uint16_t resyncs;
+} BM83RxState_t;
+
+#define BM83_AVRCP_TRACK_ID_SIZE 8
+
+/**
+ * BM83AVRCPCache_t
+ *     Description:
+ *         Remembers which track the current metadata belongs to, so that a
+ *         phone announcing the same track again does not cost us another
+ *         attribute download, parse and metadata update
+ *     Fields:
+ *         trackIdValid - The phone gave us a usable track identifier
+ *         fetchedIdValid - The metadata was fetched for fetchedTrackId
+ *         deviceId - The device the cache was filled for
+ *         trackId - The identifier from the last track changed notification
+ *         fetchedTrackId - The identifier the current metadata belongs to
+ */
+typedef struct BM83AVRCPCache_t {
+    uint8_t trackIdValid: 1;
+    uint8_t fetchedIdValid: 1;
+    uint8_t deviceId;
+    uint8_t trackId[BM83_AVRCP_TRACK_ID_SIZE];
+    uint8_t fetchedTrackId[BM83_AVRCP_TRACK_ID_SIZE];
+} BM83AVRCPCache_t;
+
+#define BM83_TX_QUEUE_SIZE 8
+#define BM83_TX_IN_FLIGHT_MAX 3
+#define BM83_TX_ACK_TIMEOUT 200
+#define BM83_TX_RETRY_MAX 2
+#define BM83_TX_STATE_QUEUED 0
+#define BM83_TX_STATE_IN_FLIGHT 1
+
+/**
+ * BM83TxCommand_t
+ *     Description:
+ *         A command that is waiting to be sent to the BM83 or waiting on
+ *         the BM83 to acknowledge it
+ *     Fields:
+ *         state - BM83_TX_STATE_QUEUED or BM83_TX_STATE_IN_FLIGHT
+ *         retryable - The command may be resent when it is not acknowledged
+ *             in time. Commands that step or toggle something are not,
+ *             since the BM83 may have carried them out and lost the ACK
+ *         busy - The BM83 turned the command away as busy, so it is safe
+ *             to resend whether it is retryable or not
+ *         retries - The number of times the command has been resent
+ *         size - The length of the command, including the opcode
+ *         sentAt - The time the command was last written to the UART
+ *         data - The opcode followed by the command parameters
+ */
+typedef struct BM83TxCommand_t {
+    uint8_t state;
+    uint8_t retryable: 1;
+    uint8_t busy: 1;
+    uint8_t retries;
+    uint8_t size;
+    uint32_t sentAt;
+    uint8_t data[BM83_FRAME_TX_MAX];
+} BM83TxCommand_t;
+
+/**
+ * BM83TxStats_t
+ *     Description:
+ *         Counters for the outbound command queue
+ *     Fields:
+ *         acks - The number of commands that were acknowledged
+ *         rejects - Commands that the BM83 acknowledged with an error status
+ *         retries - Commands that were resent after a timeout or busy status
+ *         timeouts - Commands that were dropped after running out of retries,
+ *             or unacknowledged ones that could not be resent
+ *         overflows - Commands dropped because the queue was full
+ *         lastOpcode - The opcode of the last acknowledged command
+ *         lastLatency - The round trip time of the last acknowledged command
+ *         maxLatency - The longest round trip time seen
+ */
+typedef struct BM83TxStats_t {
+    uint16_t acks;
+    uint16_t rejects;
+    uint16_t retries;
+    uint16_t timeouts;
+    uint16_t overflows;
+    uint8_t lastOpcode;
+    uint16_t lastLatency;
+    uint16_t maxLatency;
+} BM83TxStats_t;
+
 /* Define commands */
 void BM83CommandAVRCPGetCapabilities(BT_t *);
 void BM83CommandAVRCPGetElementAttributesAll(BT_t *);
@@ -429,6 +559,11 @@ void BM83ProcessEventReportTypeCodec(BT_t *, uint8_t *, uint16_t);
 void BM83ProcessDataGetAllAttributes(BT_t *, uint8_t *, uint16_t, uint8_t, uint16_t);
 /* RX / TX */
 void BM83Process(BT_t *);
+void BM83ProcessFrame(BT_t *, uint8_t, uint8_t *, uint16_t);
+uint16_t BM83GetRxChecksumErrors();
+uint16_t BM83GetRxResyncs();
+BM83TxStats_t *BM83GetTxStats();
+void BM83TxQueueFlush();
 void BM83SendCommand(BT_t *, uint8_t *, size_t);
 
 #endif /* BM83_H */
@@ -5,7 +5,6 @@
  * Created on December 1, 2021, 9:12 PM
  */
 #include "bt_common.h"
-#include <stdio.h>
 #include <string.h>
 #include "../config.h"
 #include "../eeprom.h"
@@ -13,6 +12,49 @@
 #include "../log.h"
 #include "../utils.h"
 
+/* The receive buffer that the driver of the fitted module decodes into */
+uint8_t BTRxBuffer[BT_RX_BUFFER_SIZE];
+
+/*
+ * State that only the functions in this file touch. It is private to the file
+ * rather than part of BT_t, but it takes the same RAM either way: about 2.7KB,
+ * on top of the 480 byte contacts buffer and the phonebook cache in BTPBAP_t.
+ */
+// The metadata fields joined into the line that the displays show (255 bytes)
+static char BTMetadataDisplay[BT_METADATA_DISPLAY_SIZE];
+// Hash table from the last digits of each cached number to the record of
+// its contact in the low byte and a fingerprint of the digits in the high
+// byte, BT_PBAP_CACHE_NUMBER_EMPTY for free slots (1536 bytes)
+static uint16_t BTPBAPCacheNumberIndex[BT_PBAP_CACHE_NUMBER_SLOTS];
+// The pages either side of the one in the contacts buffer (972 bytes)
+static BTPBAPPage_t BTPBAPPrefetch[BT_PBAP_PREFETCH_PAGES];
+
+/**
+ * BTCallerIdSet()
+ *     Description:
+ *         Set the caller ID and let the displays know. A bare number that
+ *         belongs to a cached contact is shown as the contact name, for the
+ *         phones that do not send the name themselves.
+ *     Params:
+ *         BT_t *bt - A pointer to the module object
+ *         const char *callerId - The caller ID reported by the phone
+ *     Returns:
+ *         void
+ */
+void BTCallerIdSet(BT_t *bt, const char *callerId)
+{
+    char name[BT_PBAP_CONTACT_NAME_LEN];
+    if (
+        strspn(callerId, BT_CALLER_ID_NUMBER_CHARS) == strlen(callerId) &&
+        BTPBAPCacheFindNumber(bt, callerId, name) == 1
+    ) {
+        LogDebug(LOG_SOURCE_BT, "BT: Caller ID %s is %s", callerId, name);
+        callerId = name;
+    }
+    memset(bt->callerId, 0, BT_CALLER_ID_FIELD_SIZE);
+    UtilsStrncpy(bt->callerId, callerId, BT_CALLER_ID_FIELD_SIZE);
+    EventTriggerCallback(BT_EVENT_CALLER_ID_UPDATE, 0);
+}
 
 /**
  * BTClearActiveDevice()
@@ -26,6 +68,9 @@
 void BTClearActiveDevice(BT_t *bt)
 {
     bt->activeDevice = BTConnectionInit();
+    // Reload the phonebook cache on the next connection, so that it is
+    // synced again even if the same device comes back
+    bt->pbap.cache.loaded = 0;
 }
 
 /**
@@ -39,9 +84,14 @@ void BTClearActiveDevice(BT_t *bt)
  */
 void BTClearMetadata(BT_t *bt)
 {
-    memset(bt->title, 0, BT_METADATA_FIELD_SIZE);
-    memset(bt->artist, 0, BT_METADATA_FIELD_SIZE);
-    memset(bt->album, 0, BT_METADATA_FIELD_SIZE);
+    memset(bt->metadata, 0, BT_METADATA_ARENA_SIZE);
+    uint8_t i;
+    for (i = 0; i < BT_METADATA_FIELD_COUNT; i++) {
+        // Each empty field is its length prefix and null terminator
+        bt->metadataOffset[i] = i * BT_METADATA_ENTRY_OVERHEAD;
+    }
+    bt->metadataDirty = 0;
+    bt->metadataDisplayValid = 0;
 }
 
 /**
@@ -102,6 +152,313 @@ BTConnection_t BTConnectionInit()
 }
 
 
+/**
+ * BTMetadataFieldIndex()
+ *     Description:
+ *         Get the position of the given metadata field within the arena
+ *     Params:
+ *         uint8_t field - The BT_METADATA_FIELD_* bit
+ *     Returns:
+ *         uint8_t - The field index (0 - 2)
+ */
+static uint8_t BTMetadataFieldIndex(uint8_t field)
+{
+    if (field == BT_METADATA_FIELD_TITLE) {
+        return 0;
+    } else if (field == BT_METADATA_FIELD_ARTIST) {
+        return 1;
+    }
+    return 2;
+}
+
+/**
+ * BTMetadataGet()
+ *     Description:
+ *         Get the text of the given metadata field. The pointer is into the
+ *         metadata arena, so it must be treated as read only and it is only
+ *         valid until the metadata is next written.
+ *     Params:
+ *         BT_t *bt - A pointer to the module object
+ *         uint8_t field - The BT_METADATA_FIELD_* bit
+ *     Returns:
+ *         char * - The null terminated field text
+ */
+char *BTMetadataGet(BT_t *bt, uint8_t field)
+{
+    return &bt->metadata[bt->metadataOffset[BTMetadataFieldIndex(field)] + 1];
+}
+
+/**
+ * BTMetadataGetDisplayText()
+ *     Description:
+ *         Get the title, artist and album joined into the line that the
+ *         BMBT shows, leaving out the fields that are empty. The line is
+ *         built by the first caller after the metadata changes and reused
+ *         after that, so that the MID of a car that also has a BMBT shows
+ *         the same text without formatting it again. The MID and CD53 on
+ *         their own keep their "title - artist on album" wording.
+ *     Params:
+ *         BT_t *bt - A pointer to the module object
+ *     Returns:
+ *         char * - The null terminated line, which is only valid until the
+ *             metadata is next published
+ */
+char *BTMetadataGetDisplayText(BT_t *bt)
+{
+    if (bt->metadataDisplayValid == 1) {
+        return BTMetadataDisplay;
+    }
+    uint16_t length = 0;
+    uint8_t i;
+    BTMetadataDisplay[0] = '\0';
+    for (i = 0; i < BT_METADATA_FIELD_COUNT; i++) {
+        uint8_t field = 1 << i;
+        if (BTMetadataGetLength(bt, field) == 0) {
+            continue;
+        }
+        length += UtilsFormat(
+            &BTMetadataDisplay[length],
+            BT_METADATA_DISPLAY_SIZE - length,
+            length == 0 ? "%s" : " - %s",
+            BTMetadataGet(bt, field)
+        );
+        if (length >= BT_METADATA_DISPLAY_SIZE - 1) {
+            break;
+        }
+    }
+    bt->metadataDisplayValid = 1;
+    return BTMetadataDisplay;
+}
+
+/**
+ * BTMetadataGetLength()
+ *     Description:
+ *         Get the length of the given metadata field from its length prefix
+ *     Params:
+ *         BT_t *bt - A pointer to the module object
+ *         uint8_t field - The BT_METADATA_FIELD_* bit
+ *     Returns:
+ *         uint8_t - The length of the field text
+ */
+uint8_t BTMetadataGetLength(BT_t *bt, uint8_t field)
+{
+    return (uint8_t) bt->metadata[bt->metadataOffset[BTMetadataFieldIndex(field)]];
+}
+
+/**
+ * BTMetadataPublish()
+ *     Description:
+ *         Fire BT_EVENT_METADATA_UPDATE with the BT_METADATA_FIELD_* mask of
+ *         the fields that changed since the last call. BTMetadataSetField()
+ *         and BTMetadataSetTrack() only flag a field when its bytes differ,
+ *         so nothing is fired when the text is the same as before.
+ *     Params:
+ *         BT_t *bt - A pointer to the module object
+ *     Returns:
+ *         uint8_t - The mask of the changed fields
+ */
+uint8_t BTMetadataPublish(BT_t *bt)
+{
+    uint8_t changed = bt->metadataDirty;
+    bt->metadataDirty = 0;
+    if (changed != 0) {
+        bt->metadataDisplayValid = 0;
+        LogDebug(
+            LOG_SOURCE_BT,
+            "BT: title=%s,artist=%s,album=%s [%02X]",
+            BTMetadataGet(bt, BT_METADATA_FIELD_TITLE),
+            BTMetadataGet(bt, BT_METADATA_FIELD_ARTIST),
+            BTMetadataGet(bt, BT_METADATA_FIELD_ALBUM),
+            changed
+        );
+        EventTriggerCallback(BT_EVENT_METADATA_UPDATE, &changed);
+    }
+    return changed;
+}
+
+/**
+ * BTMetadataGetCapacity()
+ *     Description:
+ *         Get the longest text that a metadata field can hold right now. The
+ *         other fields keep at least BT_METADATA_FIELD_MIN_LEN each, even
+ *         while they are shorter, so that no field can be squeezed out.
+ *     Params:
+ *         BT_t *bt - A pointer to the module object
+ *         uint8_t idx - The field index
+ *     Returns:
+ *         uint16_t - The capacity in characters
+ */
+static uint16_t BTMetadataGetCapacity(BT_t *bt, uint8_t idx)
+{
+    uint16_t capacity = BT_METADATA_ARENA_SIZE -
+        (BT_METADATA_FIELD_COUNT * BT_METADATA_ENTRY_OVERHEAD);
+    uint8_t i;
+    for (i = 0; i < BT_METADATA_FIELD_COUNT; i++) {
+        if (i == idx) {
+            continue;
+        }
+        uint16_t length = (uint8_t) bt->metadata[bt->metadataOffset[i]];
+        if (length < BT_METADATA_FIELD_MIN_LEN) {
+            length = BT_METADATA_FIELD_MIN_LEN;
+        }
+        capacity -= length;
+    }
+    if (capacity > BT_METADATA_FIELD_MAX_LEN) {
+        capacity = BT_METADATA_FIELD_MAX_LEN;
+    }
+    return capacity;
+}
+
+/**
+ * BTMetadataWriteField()
+ *     Description:
+ *         Store text in a metadata field. The fields are stored back to back
+ *         as a length byte, the text and a null terminator, so the fields
+ *         after the one being written are moved to make room for it.
+ *     Params:
+ *         BT_t *bt - A pointer to the module object
+ *         uint8_t idx - The field index
+ *         const char *text - The text
+ *         uint16_t length - The number of characters of text to store
+ *     Returns:
+ *         void
+ */
+static void BTMetadataWriteField(
+    BT_t *bt,
+    uint8_t idx,
+    const char *text,
+    uint16_t length
+) {
+    uint8_t lastIdx = BT_METADATA_FIELD_COUNT - 1;
+    uint16_t entry = bt->metadataOffset[idx];
+    uint16_t oldLength = (uint8_t) bt->metadata[entry];
+    uint16_t used = bt->metadataOffset[lastIdx] +
+        (uint8_t) bt->metadata[bt->metadataOffset[lastIdx]] +
+        BT_METADATA_ENTRY_OVERHEAD;
+    // Move the fields that follow this one into place
+    uint16_t tail = entry + oldLength + BT_METADATA_ENTRY_OVERHEAD;
+    if (tail < used) {
+        memmove(
+            &bt->metadata[entry + length + BT_METADATA_ENTRY_OVERHEAD],
+            &bt->metadata[tail],
+            used - tail
+        );
+    }
+    bt->metadata[entry] = length;
+    memcpy(&bt->metadata[entry + 1], text, length);
+    bt->metadata[entry + 1 + length] = '\0';
+    uint8_t i;
+    for (i = idx + 1; i < BT_METADATA_FIELD_COUNT; i++) {
+        bt->metadataOffset[i] = bt->metadataOffset[i] + length - oldLength;
+    }
+}
+
+/**
+ * BTMetadataFieldEquals()
+ *     Description:
+ *         Check if a metadata field already holds the given text, allowing
+ *         for the text having been cut to the space the field had
+ *     Params:
+ *         BT_t *bt - A pointer to the module object
+ *         uint8_t field - The BT_METADATA_FIELD_* bit to compare
+ *         const char *text - The normalized text
+ *     Returns:
+ *         uint8_t - 1 if the field holds the text, 0 otherwise
+ */
+uint8_t BTMetadataFieldEquals(BT_t *bt, uint8_t field, const char *text)
+{
+    uint8_t idx = BTMetadataFieldIndex(field);
+    uint16_t entry = bt->metadataOffset[idx];
+    uint16_t storedLength = (uint8_t) bt->metadata[entry];
+    uint16_t length = strlen(text);
+    if (length > BT_METADATA_FIELD_MAX_LEN) {
+        length = BT_METADATA_FIELD_MAX_LEN;
+    }
+    if (memcmp(&bt->metadata[entry + 1], text, storedLength) != 0) {
+        return 0;
+    }
+    if (storedLength == length) {
+        return 1;
+    }
+    // The text was cut short because the field could not hold more
+    if (storedLength < length && storedLength == BTMetadataGetCapacity(bt, idx)) {
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * BTMetadataSetField()
+ *     Description:
+ *         Write a metadata field into the arena and flag it for the next
+ *         BTMetadataPublish(). Text that does not fit in the capacity of the
+ *         field is truncated.
+ *     Params:
+ *         BT_t *bt - A pointer to the module object
+ *         uint8_t field - The BT_METADATA_FIELD_* bit to write
+ *         const char *text - The normalized text
+ *     Returns:
+ *         uint8_t - 1 if the field differs from what it held, 0 otherwise
+ */
+uint8_t BTMetadataSetField(BT_t *bt, uint8_t field, const char *text)
+{
+    if (BTMetadataFieldEquals(bt, field, text) == 1) {
+        return 0;
+    }
+    uint8_t idx = BTMetadataFieldIndex(field);
+    uint16_t length = strlen(text);
+    uint16_t capacity = BTMetadataGetCapacity(bt, idx);
+    if (length > capacity) {
+        length = capacity;
+    }
+    BTMetadataWriteField(bt, idx, text, length);
+    bt->metadataDirty |= field;
+    return 1;
+}
+
+/**
+ * BTMetadataSetTrack()
+ *     Description:
+ *         Write all of the metadata fields of a track. Every field that
+ *         changes is released before any of them is written, so that the
+ *         text of the previous track does not take space from the new one.
+ *     Params:
+ *         BT_t *bt - A pointer to the module object
+ *         const char *title - The normalized title
+ *         const char *artist - The normalized artist
+ *         const char *album - The normalized album
+ *     Returns:
+ *         uint8_t - The BT_METADATA_FIELD_* mask of the fields that changed
+ */
+uint8_t BTMetadataSetTrack(
+    BT_t *bt,
+    const char *title,
+    const char *artist,
+    const char *album
+) {
+    const char *texts[BT_METADATA_FIELD_COUNT] = {title, artist, album};
+    uint8_t changed = 0;
+    uint8_t i;
+    for (i = 0; i < BT_METADATA_FIELD_COUNT; i++) {
+        if (BTMetadataFieldEquals(bt, 1 << i, texts[i]) == 0) {
+            changed = UTILS_SET_BIT(changed, i);
+            BTMetadataWriteField(bt, i, "", 0);
+        }
+    }
+    for (i = 0; i < BT_METADATA_FIELD_COUNT; i++) {
+        if (UTILS_CHECK_BIT(changed, i) != 0) {
+            uint16_t length = strlen(texts[i]);
+            uint16_t capacity = BTMetadataGetCapacity(bt, i);
+            if (length > capacity) {
+                length = capacity;
+            }
+            BTMetadataWriteField(bt, i, texts[i], length);
+        }
+    }
+    bt->metadataDirty |= changed;
+    return changed;
+}
+
 /**
  * BTPairedDeviceClearRecords()
  *     Description:
@@ -202,7 +559,7 @@ void BTPairedDeviceLoadRecord(BTPairedDevice_t *btDevice, uint8_t devIdx)
             UtilsStrncpy(btDevice->deviceName, storedName, BT_DEVICE_NAME_LEN);
         } else {
             memset(btDevice->deviceName, 0x00, BT_DEVICE_NAME_LEN);
-            snprintf(
+            UtilsFormat(
                 btDevice->deviceName,
                 13,
                 "%02X%02X%02X%02X%02X%02X",
@@ -268,218 +625,1692 @@ void BTPairedDeviceSave(uint8_t *macId, char *deviceName, uint8_t devIdx)
 }
 
 /**
- * BTPBAPDecodeQuotedPrintable()
+ * BTPBAPCacheRecordAddress()
  *     Description:
- *         Decode a quoted-printable encoded string in-place.
- *         Each =XX sequence is converted to the raw byte value.
+ *         Get the EEPROM address of a contact record. Every record starts on
+ *         an EEPROM page, so that it is written with a single write cycle.
  *     Params:
- *         char *str - The string to decode (modified in-place)
- *         uint8_t len - Length of the input string
+ *         uint8_t record - The record number
  *     Returns:
- *         uint8_t - New length after decoding
+ *         uint32_t - The EEPROM address of the record
  */
-static uint8_t BTPBAPDecodeQuotedPrintable(char *str, uint8_t len)
+static uint32_t BTPBAPCacheRecordAddress(uint8_t record)
 {
-    uint8_t readIdx = 0;
-    uint8_t writeIdx = 0;
-    while (readIdx < len) {
-        if (str[readIdx] == '=' && (readIdx + 2) < len) {
-            char hexBuf[3] = {str[readIdx + 1], str[readIdx + 2], '\0'};
-            str[writeIdx++] = (char) UtilsStrToHex(hexBuf);
-            readIdx += 3;
-        } else {
-            str[writeIdx++] = str[readIdx++];
-        }
-    }
-    str[writeIdx] = '\0';
-    return writeIdx;
+    return CONFIG_BT_PBAP_CACHE_EEPROM_BASE + BT_PBAP_CACHE_RECORD_OFFSET +
+        ((uint32_t) record * BT_PBAP_CACHE_RECORD_LEN);
 }
 
 /**
- * BTPBAPParseVCard()
+ * BTPBAPCacheReadName()
  *     Description:
- *         Process a single line from vCard data
+ *         Read the name of a contact record
  *     Params:
- *         BT_t *bt - A pointer to the module object
+ *         uint8_t record - The record number
+ *         char *name - The buffer to read the name into, which has to hold
+ *             BT_PBAP_CONTACT_NAME_LEN bytes
  *     Returns:
  *         void
  */
-void BTPBAPParseVCard(BT_t *bt)
+static void BTPBAPCacheReadName(uint8_t record, char *name)
+{
+    EEPROMReadBytes(
+        BTPBAPCacheRecordAddress(record),
+        (uint8_t *) name,
+        BT_PBAP_CONTACT_NAME_LEN
+    );
+    name[BT_PBAP_CONTACT_NAME_LEN - 1] = '\0';
+}
+
+/**
+ * BTPBAPCacheNumberSuffix()
+ *     Description:
+ *         Get the last BT_PBAP_CACHE_NUMBER_SUFFIX digits of a BCD number.
+ *         The suffix leaves out the country and trunk prefixes, so that
+ *         "+49 171 1234567" and "0171 1234567" give the same one.
+ *     Params:
+ *         const uint8_t *bcd - The BCD number
+ *         uint8_t *suffix - The buffer to write the digit values to, which
+ *             has to hold BT_PBAP_CACHE_NUMBER_SUFFIX bytes
+ *     Returns:
+ *         uint8_t - The number of digits in the suffix
+ */
+static uint8_t BTPBAPCacheNumberSuffix(const uint8_t *bcd, uint8_t *suffix)
 {
-    char *line = bt->pbap.parser.buffer;
-    uint8_t len = bt->pbap.parser.bufferIdx;
-    if (memcmp(line, "BEGIN:VCARD", 11) == 0) {
-        bt->pbap.parser.inVCard = 1;
-        bt->pbap.contactIdx = bt->pbap.contactCount;
-        if (bt->pbap.contactIdx < BT_PBAP_MAX_CONTACTS) {
-            memset(&bt->pbap.contacts[bt->pbap.contactIdx], 0, sizeof(BTPBAPContact_t));
+    uint8_t length = 0;
+    uint8_t i;
+    for (i = 0; i < (BT_PBAP_TEL_LEN - 1) * 2; i++) {
+        uint8_t nibble = bcd[i / 2] & 0x0F;
+        if ((i & 1) == 0) {
+            nibble = bcd[i / 2] >> 4;
         }
-        return;
-    }
-    if (memcmp(line, "END:VCARD", 9) == 0) {
-        if (
-            bt->pbap.parser.inVCard &&
-            bt->pbap.contactIdx < BT_PBAP_MAX_CONTACTS
-        ) {
-            bt->pbap.contactCount++;
+        if (nibble > 9) {
+            continue;
         }
-        bt->pbap.parser.inVCard = 0;
-        return;
+        if (length == BT_PBAP_CACHE_NUMBER_SUFFIX) {
+            memmove(suffix, suffix + 1, BT_PBAP_CACHE_NUMBER_SUFFIX - 1);
+            length--;
+        }
+        suffix[length++] = nibble;
     }
-    // Exit if we are not within a vCard
-    if (!bt->pbap.parser.inVCard) {
-        return;
+    return length;
+}
+
+/**
+ * BTPBAPCacheNumberSlot()
+ *     Description:
+ *         Get the number index slot that a number suffix hashes to
+ *     Params:
+ *         const uint8_t *suffix - The suffix digits
+ *         uint8_t length - The number of digits in the suffix
+ *     Returns:
+ *         uint16_t - The slot
+ */
+static uint16_t BTPBAPCacheNumberSlot(const uint8_t *suffix, uint8_t length)
+{
+    return UtilsHash(UTILS_HASH_SEED, suffix, length) % BT_PBAP_CACHE_NUMBER_SLOTS;
+}
+
+/**
+ * BTPBAPCacheNumberFingerprint()
+ *     Description:
+ *         Get the fingerprint that is stored with a number suffix in the
+ *         number index. It comes from a second pass over the digits, so that
+ *         suffixes that probe through the same slots seldom share it, and
+ *         their records do not have to be read back to tell them apart.
+ *     Params:
+ *         const uint8_t *suffix - The suffix digits
+ *         uint8_t length - The number of digits in the suffix
+ *     Returns:
+ *         uint8_t - The fingerprint
+ */
+static uint8_t BTPBAPCacheNumberFingerprint(const uint8_t *suffix, uint8_t length)
+{
+    uint16_t hash = UtilsHash(UTILS_HASH_SEED, suffix, length);
+    hash = UtilsHash(hash, suffix, length);
+    return (hash >> 8) ^ (hash & 0xFF);
+}
+
+/**
+ * BTPBAPCacheReadRecord()
+ *     Description:
+ *         Read a contact record
+ *     Params:
+ *         uint8_t record - The record number
+ *         BTPBAPContact_t *contact - The contact to read into
+ *     Returns:
+ *         void
+ */
+static void BTPBAPCacheReadRecord(uint8_t record, BTPBAPContact_t *contact)
+{
+    EEPROMReadBytes(
+        BTPBAPCacheRecordAddress(record),
+        (uint8_t *) contact,
+        sizeof(BTPBAPContact_t)
+    );
+    contact->name[BT_PBAP_CONTACT_NAME_LEN - 1] = '\0';
+    if (contact->numberCount > BT_PBAP_CONTACT_MAX_NUMBERS) {
+        contact->numberCount = BT_PBAP_CONTACT_MAX_NUMBERS;
     }
-    if (bt->pbap.contactIdx >= BT_PBAP_MAX_CONTACTS) {
-        return;
+}
+
+/**
+ * BTPBAPCacheT9Digit()
+ *     Description:
+ *         Get the T9 keypad digit for a character of a contact name
+ *     Params:
+ *         char c - The character
+ *     Returns:
+ *         uint8_t - The digit, or BT_PBAP_CACHE_T9_NONE for characters that
+ *             have no key, which the search skips
+ */
+static uint8_t BTPBAPCacheT9Digit(char c)
+{
+    static const char keypad[] = "22233344455566677778889999";
+    if (c >= 'a' && c <= 'z') {
+        return keypad[c - 'a'] - '0';
+    } else if (c >= 'A' && c <= 'Z') {
+        return keypad[c - 'A'] - '0';
+    } else if (c >= '0' && c <= '9') {
+        return c - '0';
     }
-    if (memcmp(line, "FN:", 3) == 0 || memcmp(line, "FN;", 3) == 0) {
-        // FN may have parameters (e.g. FN;CHARSET=UTF-8:Name)
-        int8_t colonIdx = UtilsCharIndex(line, ':');
-        if (colonIdx <= 0) {
-            return;
-        }
-        uint8_t nameStart = (uint8_t) colonIdx + 1;
-        uint8_t nameLen = len - nameStart;
-        BTPBAPContact_t *contact = &bt->pbap.contacts[bt->pbap.contactIdx];
-        if (UtilsSubstrExists(line, (uint8_t) colonIdx, "ENCODING=QUOTED-PRINTABLE", ';')) {
-            nameLen = BTPBAPDecodeQuotedPrintable(line + nameStart, nameLen);
+    return BT_PBAP_CACHE_T9_NONE;
+}
+
+/**
+ * BTPBAPCacheT9Key()
+ *     Description:
+ *         Pack the T9 digits of the first letters of a name into a key, so
+ *         that a search can reject most contacts without reading their names
+ *     Params:
+ *         const char *name - The contact name
+ *     Returns:
+ *         uint16_t - The key
+ */
+static uint16_t BTPBAPCacheT9Key(const char *name)
+{
+    uint16_t key = 0xFFFF;
+    uint8_t digits = 0;
+    while (*name != '\0' && digits < BT_PBAP_CACHE_T9_DIGITS) {
+        uint8_t digit = BTPBAPCacheT9Digit(*name++);
+        if (digit != BT_PBAP_CACHE_T9_NONE) {
+            uint8_t shift = (BT_PBAP_CACHE_T9_DIGITS - 1 - digits) * 4;
+            key = (key & ~((uint16_t) 0x0F << shift)) | ((uint16_t) digit << shift);
+            digits++;
         }
-        UtilsNormalizeText(contact->name, line + nameStart, BT_PBAP_CONTACT_NAME_LEN);
-        return;
     }
-    if (memcmp(line, "N:", 2) == 0 || memcmp(line, "N;", 2) == 0) {
-        // N may have parameters (e.g. N;CHARSET=UTF-8:Last;First;Middle;Prefix;Suffix)
-        int8_t colonIdx = UtilsCharIndex(line, ':');
-        if (colonIdx <= 0) {
-            return;
+    return key;
+}
+
+/**
+ * BTPBAPCacheT9Match()
+ *     Description:
+ *         Check if the T9 digits of a name start with the given digits
+ *     Params:
+ *         const char *name - The contact name
+ *         const char *digits - The digits entered, as ASCII
+ *     Returns:
+ *         uint8_t - 1 if the name matches, 0 otherwise
+ */
+static uint8_t BTPBAPCacheT9Match(const char *name, const char *digits)
+{
+    while (*digits != '\0') {
+        uint8_t digit = BT_PBAP_CACHE_T9_NONE;
+        while (*name != '\0' && digit == BT_PBAP_CACHE_T9_NONE) {
+            digit = BTPBAPCacheT9Digit(*name++);
         }
-        uint8_t nameStart = (uint8_t) colonIdx + 1;
-        uint8_t nameLen = len - nameStart;
-        if (UtilsSubstrExists(line, (uint8_t) colonIdx, "ENCODING=QUOTED-PRINTABLE", ';')) {
-            nameLen = BTPBAPDecodeQuotedPrintable(line + nameStart, nameLen);
-        }
-        if (nameLen >= BT_PBAP_CONTACT_NAME_LEN) {
-            nameLen = BT_PBAP_CONTACT_NAME_LEN - 1;
-        }
-        char nameValue[BT_PBAP_CONTACT_NAME_LEN] = {0};
-        memcpy(nameValue, line + nameStart, nameLen);
-        nameValue[nameLen] = '\0';
-        // Find semicolon separating Last;First in the value
-        int8_t semiIdx = UtilsCharIndex(nameValue, ';');
-        BTPBAPContact_t *contact = &bt->pbap.contacts[bt->pbap.contactIdx];
-        char composedName[BT_PBAP_CONTACT_NAME_LEN] = {0};
-        if (semiIdx < 0) {
-            // No semicolon - use the whole value as the name
-            memcpy(composedName, nameValue, nameLen);
-            composedName[nameLen] = '\0';
-        } else {
-            uint8_t lastLen = (uint8_t) semiIdx;
-            char *first = nameValue + semiIdx + 1;
-            // Terminate last name at the semicolon
-            nameValue[semiIdx] = '\0';
-            // First name ends at the next semicolon or end of string
-            int8_t nextSemi = UtilsCharIndex(first, ';');
-            uint8_t firstLen;
-            if (nextSemi >= 0) {
-                firstLen = (uint8_t) nextSemi;
-                first[nextSemi] = '\0';
-            } else {
-                firstLen = strlen(first);
-            }
-            uint8_t pos = 0;
-            if (firstLen > 0 && lastLen > 0) {
-                // "First Last"
-                memcpy(composedName, first, firstLen);
-                pos = firstLen;
-                composedName[pos++] = ' ';
-                uint8_t copyLen = lastLen;
-                if (pos + copyLen > BT_PBAP_CONTACT_NAME_LEN - 1) {
-                    copyLen = BT_PBAP_CONTACT_NAME_LEN - 1 - pos;
-                }
-                memcpy(composedName + pos, nameValue, copyLen);
-                pos += copyLen;
-            } else if (firstLen > 0) {
-                memcpy(composedName, first, firstLen);
-                pos = firstLen;
-            } else if (lastLen > 0) {
-                memcpy(composedName, nameValue, lastLen);
-                pos = lastLen;
-            }
-            composedName[pos] = '\0';
+        if (digit != *digits - '0') {
+            return 0;
         }
-        UtilsNormalizeText(contact->name, composedName, BT_PBAP_CONTACT_NAME_LEN);
-        return;
+        digits++;
     }
-    if (
-        memcmp(line, "TEL:", 4) == 0 ||
-        memcmp(line, "TEL;", 4) == 0
-    ) {
-        BTPBAPContact_t *contact = &bt->pbap.contacts[bt->pbap.contactIdx];
-        BTPBAPContactTelephone_t *tel = &contact->numbers[contact->numberCount];
-        // Parse type
-        uint8_t telType = BT_PBAP_TEL_TYPE_UNKNOWN;
-        int8_t numStart = UtilsCharIndex(line, ':');
-        if (numStart <= 0) {
-            return;
-        }
-        uint8_t numberStart = (uint8_t) numStart;
-        // We will reuse this counter
+    return 1;
+}
+
+/**
+ * BTPBAPCacheIndexRecords()
+ *     Description:
+ *         Rebuild the T9 keys and the number index from the stored records.
+ *         The number index is an open addressing hash table from number
+ *         suffixes to record numbers and fingerprints, so that a caller ID
+ *         lookup only reads back the records whose fingerprint matches. Only
+ *         the first BT_PBAP_CACHE_MAX_NUMBERS numbers are indexed, which
+ *         keeps the table at most half full.
+ *     Params:
+ *         BTPBAPCache_t *cache - The cache state
+ *     Returns:
+ *         void
+ */
+static void BTPBAPCacheIndexRecords(BTPBAPCache_t *cache)
+{
+    BTPBAPContact_t contact;
+    uint8_t suffix[BT_PBAP_CACHE_NUMBER_SUFFIX];
+    uint8_t record;
+    uint16_t numbers = 0;
+    uint16_t skipped = 0;
+    // Every byte of an empty slot is 0xFF
+    memset(BTPBAPCacheNumberIndex, 0xFF, sizeof(BTPBAPCacheNumberIndex));
+    // Records are written in phonebook order, so they are numbered from
+    // zero up to the contact count
+    for (record = 0; record < cache->count; record++) {
+        BTPBAPCacheReadRecord(record, &contact);
+        cache->t9Keys[record] = BTPBAPCacheT9Key(contact.name);
         uint8_t i;
-        // Check for type parameter
-        if (line[3] == ';' && numberStart > 3) {
-            int8_t typeDeclarationEnd = UtilsCharIndex(line, '=');
-            // 4 is right after the ';'
-            uint8_t typeStrIdx = 4;
-            if (typeDeclarationEnd > 0) {
-                typeStrIdx = typeDeclarationEnd + 1;
+        for (i = 0; i < contact.numberCount; i++) {
+            uint8_t length = BTPBAPCacheNumberSuffix(contact.numbers[i].number, suffix);
+            if (length == 0) {
+                continue;
             }
-            uint8_t typeLen = numberStart - typeStrIdx;
-            char telTypeStr[typeLen + 1];
-            memset(telTypeStr, 0, typeLen + 1);
-            for (i = 0; i < typeLen; i++) {
-                telTypeStr[i] = line[i + typeStrIdx];
+            if (numbers == BT_PBAP_CACHE_MAX_NUMBERS) {
+                skipped++;
+                continue;
             }
-            if (
-                UtilsStricmp(telTypeStr, "CELL") == 0 ||
-                UtilsStricmp(telTypeStr, "MOBILE") == 0
-            ) {
-                telType = BT_PBAP_TEL_TYPE_CELL;
-            } else if (UtilsStricmp(telTypeStr, "HOME") == 0) {
-                telType = BT_PBAP_TEL_TYPE_HOME;
-            } else if (UtilsStricmp(telTypeStr, "WORK") == 0) {
-                telType = BT_PBAP_TEL_TYPE_WORK;
+            // Half of the slots are free, so a free one always turns up
+            uint16_t slot = BTPBAPCacheNumberSlot(suffix, length);
+            while (BTPBAPCacheNumberIndex[slot] != BT_PBAP_CACHE_NUMBER_EMPTY) {
+                slot++;
+                if (slot == BT_PBAP_CACHE_NUMBER_SLOTS) {
+                    slot = 0;
+                }
             }
+            BTPBAPCacheNumberIndex[slot] =
+                ((uint16_t) BTPBAPCacheNumberFingerprint(suffix, length) << 8) |
+                record;
+            numbers++;
         }
-        numberStart++;
-        uint8_t numberLen = len - numberStart;
-        char number[numberLen + 1];
-        memset(number, 0, numberLen + 1);
-        for (i = 0; i < numberLen; i++) {
-            number[i] = line[i + numberStart];
-        }
-        tel->type = telType;
-        BTPBAPTelephoneToBCD(number, tel->number);
-        contact->numberCount++;
+    }
+    if (skipped > 0) {
+        LogWarning(
+            "BT: PBAP Cache indexed %d numbers, %d not matched on calls",
+            numbers,
+            skipped
+        );
     }
 }
 
-
 /**
- * BTPBAPTelephoneFromBCD()
+ * BTPBAPCacheWriteHeader()
  *     Description:
- *         Convert a BCD-encoded phone number to ASCII string
+ *         Write the cache header, which ties the stored phonebook to the
+ *         device in the cache state and records how many contacts it holds
  *     Params:
- *         const uint8_t *bcd - The BCD encoded number (7 bytes)
- *         char *ascii - Output buffer for ASCII string
- *         uint8_t maxLen - Maximum output length (including null terminator)
+ *         BTPBAPCache_t *cache - The cache state
  *     Returns:
  *         void
  */
-void BTPBAPTelephoneFromBCD(const uint8_t *bcd, char *ascii, uint8_t maxLen)
+static void BTPBAPCacheWriteHeader(BTPBAPCache_t *cache)
 {
-    uint8_t i;
-    uint8_t pos = 0;
+    uint8_t header[BT_PBAP_CACHE_HEADER_LEN] = {0};
+    header[0] = BT_PBAP_CACHE_VERSION;
+    memcpy(header + 1, cache->macId, BT_DEVICE_MAC_ID_LEN);
+    header[BT_PBAP_CACHE_HEADER_COUNT] = cache->count;
+    if (cache->truncated) {
+        header[BT_PBAP_CACHE_HEADER_FLAGS] |= BT_PBAP_CACHE_FLAG_TRUNCATED;
+    }
+    EEPROMWriteBytes(CONFIG_BT_PBAP_CACHE_EEPROM_BASE, header, BT_PBAP_CACHE_HEADER_LEN);
+}
+
+/**
+ * BTPBAPCacheInvalidate()
+ *     Description:
+ *         Empty the committed phonebook in EEPROM and in RAM, ahead of a
+ *         record that it points at being overwritten. Until the sync that
+ *         does so commits, the directory is paged over PBAP and caller ID
+ *         numbers are not resolved, so the wrong contact is never shown.
+ *     Params:
+ *         BTPBAPCache_t *cache - The cache state
+ *     Returns:
+ *         void
+ */
+static void BTPBAPCacheInvalidate(BTPBAPCache_t *cache)
+{
+    cache->count = 0;
+    cache->truncated = 0;
+    BTPBAPCacheWriteHeader(cache);
+    BTPBAPCacheIndexRecords(cache);
+}
+
+/**
+ * BTPBAPCacheLoad()
+ *     Description:
+ *         Make sure that the cache state belongs to the active device. The
+ *         header is read again whenever the active device changes, and the
+ *         sorted index is loaded and the search indexes are rebuilt if the
+ *         stored phonebook belongs to it. That reads back every record, so
+ *         it is done up front when the HFP link opens.
+ *     Params:
+ *         BT_t *bt - A pointer to the module object
+ *     Returns:
+ *         uint8_t - 1 if a device is connected, 0 otherwise
+ */
+uint8_t BTPBAPCacheLoad(BT_t *bt)
+{
+    BTPBAPCache_t *cache = &bt->pbap.cache;
+    if (
+        bt->activeDevice.status != BT_DEVICE_STATUS_CONNECTED ||
+        bt->activeDevice.deviceIndex >= bt->pairedDevicesCount
+    ) {
+        return 0;
+    }
+    uint8_t *macId = bt->pairedDevices[bt->activeDevice.deviceIndex].macId;
+    if (cache->loaded && memcmp(cache->macId, macId, BT_DEVICE_MAC_ID_LEN) == 0) {
+        return 1;
+    }
+    uint8_t header[BT_PBAP_CACHE_HEADER_LEN];
+    EEPROMReadBytes(CONFIG_BT_PBAP_CACHE_EEPROM_BASE, header, BT_PBAP_CACHE_HEADER_LEN);
+    memcpy(cache->macId, macId, BT_DEVICE_MAC_ID_LEN);
+    cache->loaded = 1;
+    cache->status = BT_PBAP_CACHE_STATUS_INVALID;
+    cache->count = 0;
+    cache->truncated = 0;
+    if (
+        header[0] == BT_PBAP_CACHE_VERSION &&
+        memcmp(header + 1, macId, BT_DEVICE_MAC_ID_LEN) == 0 &&
+        header[BT_PBAP_CACHE_HEADER_COUNT] <= BT_PBAP_CACHE_MAX_CONTACTS
+    ) {
+        cache->count = header[BT_PBAP_CACHE_HEADER_COUNT];
+        if ((header[BT_PBAP_CACHE_HEADER_FLAGS] & BT_PBAP_CACHE_FLAG_TRUNCATED) != 0) {
+            cache->truncated = 1;
+        }
+        EEPROMReadBytes(
+            CONFIG_BT_PBAP_CACHE_EEPROM_BASE + BT_PBAP_CACHE_INDEX_OFFSET,
+            cache->index,
+            cache->count
+        );
+        cache->status = BT_PBAP_CACHE_STATUS_STALE;
+    }
+    BTPBAPCacheIndexRecords(cache);
+    LogDebug(LOG_SOURCE_BT, "BT: PBAP Cache has %d contacts", cache->count);
+    return 1;
+}
+
+/**
+ * BTPBAPCacheFindNumber()
+ *     Description:
+ *         Find the name of the cached contact that a phone number belongs
+ *         to. Numbers are matched on their last BT_PBAP_CACHE_NUMBER_SUFFIX
+ *         digits through the number index. The cache is not loaded from
+ *         here, so a call that comes in before it was loaded is not matched.
+ *     Params:
+ *         BT_t *bt - A pointer to the module object
+ *         const char *number - The phone number, as ASCII
+ *         char *name - The buffer to copy the name to, which has to hold
+ *             BT_PBAP_CONTACT_NAME_LEN bytes
+ *     Returns:
+ *         uint8_t - 1 if the number belongs to a contact, 0 otherwise
+ */
+uint8_t BTPBAPCacheFindNumber(BT_t *bt, const char *number, char *name)
+{
+    if (bt->pbap.cache.loaded == 0 || bt->pbap.cache.count == 0) {
+        return 0;
+    }
+    uint8_t bcd[BT_PBAP_TEL_LEN - 1];
+    uint8_t suffix[BT_PBAP_CACHE_NUMBER_SUFFIX];
+    uint8_t candidate[BT_PBAP_CACHE_NUMBER_SUFFIX];
+    BTPBAPTelephoneToBCD(number, bcd);
+    uint8_t length = BTPBAPCacheNumberSuffix(bcd, suffix);
+    if (length == 0) {
+        return 0;
+    }
+    BTPBAPContact_t contact;
+    uint16_t slot = BTPBAPCacheNumberSlot(suffix, length);
+    uint8_t fingerprint = BTPBAPCacheNumberFingerprint(suffix, length);
+    uint16_t probes;
+    for (
+        probes = 0;
+        probes < BT_PBAP_CACHE_NUMBER_SLOTS &&
+        BTPBAPCacheNumberIndex[slot] != BT_PBAP_CACHE_NUMBER_EMPTY;
+        probes++
+    ) {
+        uint16_t entry = BTPBAPCacheNumberIndex[slot];
+        slot++;
+        if (slot == BT_PBAP_CACHE_NUMBER_SLOTS) {
+            slot = 0;
+        }
+        // Only read back the records that the number could belong to
+        if ((entry >> 8) != fingerprint) {
+            continue;
+        }
+        BTPBAPCacheReadRecord(entry & 0xFF, &contact);
+        uint8_t i;
+        for (i = 0; i < contact.numberCount; i++) {
+            if (
+                BTPBAPCacheNumberSuffix(contact.numbers[i].number, candidate) == length &&
+                memcmp(candidate, suffix, length) == 0
+            ) {
+                UtilsStrncpy(name, contact.name, BT_PBAP_CONTACT_NAME_LEN);
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+/**
+ * BTPBAPCacheGetContact()
+ *     Description:
+ *         Read a contact from the cache by its position in name order
+ *     Params:
+ *         BT_t *bt - A pointer to the module object
+ *         uint8_t idx - The position of the contact in name order
+ *         BTPBAPContact_t *contact - The contact to read into
+ *     Returns:
+ *         uint8_t - 1 if the contact was read, 0 if there is no such contact
+ */
+uint8_t BTPBAPCacheGetContact(BT_t *bt, uint8_t idx, BTPBAPContact_t *contact)
+{
+    if (BTPBAPCacheLoad(bt) == 0 || idx >= bt->pbap.cache.count) {
+        return 0;
+    }
+    BTPBAPCacheReadRecord(bt->pbap.cache.index[idx], contact);
+    return 1;
+}
+
+/**
+ * BTPBAPCacheGetCount()
+ *     Description:
+ *         Get the number of contacts cached for the active device
+ *     Params:
+ *         BT_t *bt - A pointer to the module object
+ *     Returns:
+ *         uint8_t - The number of cached contacts
+ */
+uint8_t BTPBAPCacheGetCount(BT_t *bt)
+{
+    if (BTPBAPCacheLoad(bt) == 0) {
+        return 0;
+    }
+    return bt->pbap.cache.count;
+}
+
+/**
+ * BTPBAPCacheHasPhonebook()
+ *     Description:
+ *         Check if the cache holds the whole phonebook of the active device,
+ *         so that the directory and its search can be served from it. A
+ *         phonebook larger than the cache is only used to resolve caller ID
+ *         numbers, and the directory pages it over PBAP instead.
+ *     Params:
+ *         BT_t *bt - A pointer to the module object
+ *     Returns:
+ *         uint8_t - 1 if the cache holds the whole phonebook, 0 otherwise
+ */
+uint8_t BTPBAPCacheHasPhonebook(BT_t *bt)
+{
+    if (BTPBAPCacheGetCount(bt) == 0 || bt->pbap.cache.truncated) {
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * BTPBAPCacheLoadPage()
+ *     Description:
+ *         Fill the contacts buffer with a page of cached contacts in name
+ *         order, the same way a PBAP pull of that page would
+ *     Params:
+ *         BT_t *bt - A pointer to the module object
+ *         uint16_t offset - The position of the first contact of the page
+ *     Returns:
+ *         uint8_t - The number of contacts in the page
+ */
+uint8_t BTPBAPCacheLoadPage(BT_t *bt, uint16_t offset)
+{
+    memset(bt->pbap.contacts, 0, sizeof(bt->pbap.contacts));
+    bt->pbap.contactCount = 0;
+    bt->pbap.contactIdx = 0;
+    bt->pbap.pageValid = 0;
+    uint8_t count = BTPBAPCacheGetCount(bt);
+    while (
+        bt->pbap.contactCount < BT_PBAP_MAX_CONTACTS &&
+        offset + bt->pbap.contactCount < count
+    ) {
+        BTPBAPCacheGetContact(
+            bt,
+            offset + bt->pbap.contactCount,
+            &bt->pbap.contacts[bt->pbap.contactCount]
+        );
+        bt->pbap.contactCount++;
+    }
+    return bt->pbap.contactCount;
+}
+
+/**
+ * BTPBAPCacheLoadSearchPage()
+ *     Description:
+ *         Fill the contacts buffer with a page of the cached contacts that
+ *         match the given T9 digits, in name order
+ *     Params:
+ *         BT_t *bt - A pointer to the module object
+ *         const char *digits - The digits entered, as ASCII
+ *         uint16_t offset - The number of matches ahead of the page
+ *     Returns:
+ *         uint8_t - The number of contacts in the page
+ */
+uint8_t BTPBAPCacheLoadSearchPage(BT_t *bt, const char *digits, uint16_t offset)
+{
+    memset(bt->pbap.contacts, 0, sizeof(bt->pbap.contacts));
+    bt->pbap.contactCount = 0;
+    bt->pbap.contactIdx = 0;
+    bt->pbap.pageValid = 0;
+    uint8_t idx = BTPBAPCacheSearchT9(bt, digits, 0);
+    while (idx != BT_PBAP_CACHE_SEARCH_NONE && offset > 0) {
+        idx = BTPBAPCacheSearchT9(bt, digits, idx + 1);
+        offset--;
+    }
+    while (
+        idx != BT_PBAP_CACHE_SEARCH_NONE &&
+        bt->pbap.contactCount < BT_PBAP_MAX_CONTACTS
+    ) {
+        BTPBAPCacheGetContact(bt, idx, &bt->pbap.contacts[bt->pbap.contactCount]);
+        bt->pbap.contactCount++;
+        idx = BTPBAPCacheSearchT9(bt, digits, idx + 1);
+    }
+    return bt->pbap.contactCount;
+}
+
+/**
+ * BTPBAPCacheSearchName()
+ *     Description:
+ *         Find the first cached contact whose name starts with the given
+ *         text, ignoring case. The matches follow it in name order.
+ *     Params:
+ *         BT_t *bt - A pointer to the module object
+ *         const char *prefix - The text to look for
+ *     Returns:
+ *         uint8_t - The position of the contact in name order, or
+ *             BT_PBAP_CACHE_SEARCH_NONE if no name starts with the text
+ */
+uint8_t BTPBAPCacheSearchName(BT_t *bt, const char *prefix)
+{
+    uint8_t count = BTPBAPCacheGetCount(bt);
+    char name[BT_PBAP_CONTACT_NAME_LEN];
+    uint8_t low = 0;
+    uint8_t high = count;
+    while (low < high) {
+        uint8_t mid = (low + high) / 2;
+        BTPBAPCacheReadName(bt->pbap.cache.index[mid], name);
+        if (UtilsStricmp(name, prefix) < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    if (low == count) {
+        return BT_PBAP_CACHE_SEARCH_NONE;
+    }
+    BTPBAPCacheReadName(bt->pbap.cache.index[low], name);
+    if (UtilsStrnicmp(name, prefix, strlen(prefix)) != 0) {
+        return BT_PBAP_CACHE_SEARCH_NONE;
+    }
+    return low;
+}
+
+/**
+ * BTPBAPCacheSearchT9()
+ *     Description:
+ *         Find the next cached contact whose name starts with the letters
+ *         of the given T9 keypad digits. The first digits are compared to
+ *         the keys held in RAM, so that only the names of the contacts that
+ *         pass have to be read from the EEPROM.
+ *     Params:
+ *         BT_t *bt - A pointer to the module object
+ *         const char *digits - The digits entered, as ASCII
+ *         uint8_t start - The position in name order to search from
+ *     Returns:
+ *         uint8_t - The position of the contact in name order, or
+ *             BT_PBAP_CACHE_SEARCH_NONE if no further contact matches
+ */
+uint8_t BTPBAPCacheSearchT9(BT_t *bt, const char *digits, uint8_t start)
+{
+    uint8_t count = BTPBAPCacheGetCount(bt);
+    uint8_t length = strlen(digits);
+    if (length == 0) {
+        return BT_PBAP_CACHE_SEARCH_NONE;
+    }
+    uint16_t key = 0;
+    uint16_t mask = 0;
+    uint8_t i;
+    for (i = 0; i < length && i < BT_PBAP_CACHE_T9_DIGITS; i++) {
+        if (digits[i] < '0' || digits[i] > '9') {
+            return BT_PBAP_CACHE_SEARCH_NONE;
+        }
+        uint8_t shift = (BT_PBAP_CACHE_T9_DIGITS - 1 - i) * 4;
+        key |= (uint16_t) (digits[i] - '0') << shift;
+        mask |= (uint16_t) 0x0F << shift;
+    }
+    char name[BT_PBAP_CONTACT_NAME_LEN];
+    for (i = start; i < count; i++) {
+        uint8_t record = bt->pbap.cache.index[i];
+        if ((bt->pbap.cache.t9Keys[record] & mask) != key) {
+            continue;
+        }
+        if (length <= BT_PBAP_CACHE_T9_DIGITS) {
+            return i;
+        }
+        BTPBAPCacheReadName(record, name);
+        if (BTPBAPCacheT9Match(name, digits) == 1) {
+            return i;
+        }
+    }
+    return BT_PBAP_CACHE_SEARCH_NONE;
+}
+
+/**
+ * BTPBAPCacheStoreContact()
+ *     Description:
+ *         Store the contact that the vCard parser just completed as the next
+ *         record of the running sync, and insert it into the sorted index.
+ *         The record is only written if it changed, which is the common case
+ *         for a resync and spares both the write cycle and the EEPROM wear.
+ *         The committed phonebook is invalidated before the first write to
+ *         a record that it still points at.
+ *     Params:
+ *         BT_t *bt - A pointer to the module object
+ *     Returns:
+ *         void
+ */
+void BTPBAPCacheStoreContact(BT_t *bt)
+{
+    BTPBAPCache_t *cache = &bt->pbap.cache;
+    if (
+        cache->status != BT_PBAP_CACHE_STATUS_SYNCING ||
+        cache->syncCount >= BT_PBAP_CACHE_MAX_CONTACTS
+    ) {
+        return;
+    }
+    uint8_t record = cache->syncCount;
+    uint32_t address = BTPBAPCacheRecordAddress(record);
+    uint8_t stored[sizeof(BTPBAPContact_t)];
+    EEPROMReadBytes(address, stored, sizeof(stored));
+    if (memcmp(stored, &cache->contact, sizeof(stored)) != 0) {
+        if (record < cache->count) {
+            LogDebug(LOG_SOURCE_BT, "BT: PBAP Cache invalid until the sync completes");
+            BTPBAPCacheInvalidate(cache);
+        }
+        EEPROMWriteBytes(address, (uint8_t *) &cache->contact, sizeof(BTPBAPContact_t));
+    }
+    cache->t9Keys[record] = BTPBAPCacheT9Key(cache->contact.name);
+    // Binary search for the insertion point. Equal names keep their
+    // phonebook order, since the new record goes after them
+    char name[BT_PBAP_CONTACT_NAME_LEN];
+    uint8_t low = 0;
+    uint8_t high = cache->syncCount;
+    while (low < high) {
+        uint8_t mid = (low + high) / 2;
+        BTPBAPCacheReadName(cache->syncIndex[mid], name);
+        if (UtilsStricmp(name, cache->contact.name) <= 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    memmove(
+        &cache->syncIndex[low + 1],
+        &cache->syncIndex[low],
+        cache->syncCount - low
+    );
+    cache->syncIndex[low] = record;
+    cache->syncCount++;
+}
+
+/**
+ * BTPBAPCacheSyncNextPage()
+ *     Description:
+ *         Get the phonebook offset that the sync should pull next. Whatever
+ *         an interrupted pull of that page stored is dropped, so that the
+ *         page can be pulled again from the start.
+ *     Params:
+ *         BT_t *bt - A pointer to the module object
+ *     Returns:
+ *         uint16_t - The phonebook offset to pull
+ */
+uint16_t BTPBAPCacheSyncNextPage(BT_t *bt)
+{
+    BTPBAPCache_t *cache = &bt->pbap.cache;
+    if (cache->syncCount > cache->syncOffset) {
+        uint8_t i;
+        uint8_t kept = 0;
+        for (i = 0; i < cache->syncCount; i++) {
+            if (cache->syncIndex[i] < cache->syncOffset) {
+                cache->syncIndex[kept++] = cache->syncIndex[i];
+            }
+        }
+        cache->syncCount = kept;
+    }
+    return cache->syncOffset;
+}
+
+/**
+ * BTPBAPCacheSyncPageComplete()
+ *     Description:
+ *         Move the sync on to the next page, or commit the new index once a
+ *         short page shows that the end of the phonebook was reached
+ *     Params:
+ *         BT_t *bt - A pointer to the module object
+ *     Returns:
+ *         void
+ */
+void BTPBAPCacheSyncPageComplete(BT_t *bt)
+{
+    BTPBAPCache_t *cache = &bt->pbap.cache;
+    if (cache->status != BT_PBAP_CACHE_STATUS_SYNCING) {
+        return;
+    }
+    uint8_t received = cache->syncCount - cache->syncOffset;
+    if (
+        received == BT_PBAP_MAX_CONTACTS &&
+        cache->syncCount < BT_PBAP_CACHE_MAX_CONTACTS
+    ) {
+        cache->syncOffset += received;
+        return;
+    }
+    // A full page at the limit means that the phonebook goes on. One of
+    // exactly BT_PBAP_CACHE_MAX_CONTACTS contacts looks the same, and is
+    // paged over PBAP as well.
+    cache->truncated = 0;
+    if (received == BT_PBAP_MAX_CONTACTS) {
+        cache->truncated = 1;
+        LogWarning(
+            "BT: PBAP Cache holds the first %d contacts only",
+            cache->syncCount
+        );
+    }
+    if (cache->count != cache->syncCount) {
+        LogDebug(
+            LOG_SOURCE_BT,
+            "BT: PBAP Cache count changed from %d to %d",
+            cache->count,
+            cache->syncCount
+        );
+    }
+    cache->count = cache->syncCount;
+    memcpy(cache->index, cache->syncIndex, cache->count);
+    uint8_t i;
+    for (i = 0; i < cache->count; i += EEPROM_PAGE_SIZE) {
+        uint8_t length = cache->count - i;
+        if (length > EEPROM_PAGE_SIZE) {
+            length = EEPROM_PAGE_SIZE;
+        }
+        EEPROMWriteBytes(
+            CONFIG_BT_PBAP_CACHE_EEPROM_BASE + BT_PBAP_CACHE_INDEX_OFFSET + i,
+            &cache->index[i],
+            length
+        );
+    }
+    BTPBAPCacheWriteHeader(cache);
+    BTPBAPCacheIndexRecords(cache);
+    cache->status = BT_PBAP_CACHE_STATUS_CURRENT;
+    LogDebug(LOG_SOURCE_BT, "BT: PBAP Cache synced %d contacts", cache->count);
+}
+
+/**
+ * BTPBAPCacheSyncStart()
+ *     Description:
+ *         Schedule a sync of the phonebook into the cache, unless it already
+ *         ran on this connection. The pulls themselves are issued in the
+ *         background by the BT handler while the PBAP session is idle.
+ *     Params:
+ *         BT_t *bt - A pointer to the module object
+ *     Returns:
+ *         void
+ */
+void BTPBAPCacheSyncStart(BT_t *bt)
+{
+    BTPBAPCache_t *cache = &bt->pbap.cache;
+    if (
+        BTPBAPCacheLoad(bt) == 0 ||
+        cache->status == BT_PBAP_CACHE_STATUS_SYNCING ||
+        cache->status == BT_PBAP_CACHE_STATUS_CURRENT
+    ) {
+        return;
+    }
+    if (cache->status == BT_PBAP_CACHE_STATUS_INVALID) {
+        // Claim the store for this device before any record is overwritten,
+        // so that the contacts of the previous device can never be shown
+        BTPBAPCacheInvalidate(cache);
+    }
+    cache->status = BT_PBAP_CACHE_STATUS_SYNCING;
+    cache->syncCount = 0;
+    cache->syncOffset = 0;
+}
+
+/**
+ * BTPBAPPrefetchFind()
+ *     Description:
+ *         Find the prefetch page that holds, or is set to hold, the given page
+ *     Params:
+ *         BT_t *bt - A pointer to the module object
+ *         uint8_t phonebook - The BT_PBAP_OBJ_* of the page
+ *         uint16_t offset - The position of the first contact of the page
+ *     Returns:
+ *         uint8_t - The prefetch page, or BT_PBAP_PREFETCH_NONE
+ */
+static uint8_t BTPBAPPrefetchFind(BT_t *bt, uint8_t phonebook, uint16_t offset)
+{
+    uint8_t idx;
+    for (idx = 0; idx < BT_PBAP_PREFETCH_PAGES; idx++) {
+        BTPBAPPage_t *page = &BTPBAPPrefetch[idx];
+        if (
+            page->status != BT_PBAP_PAGE_STATUS_EMPTY &&
+            page->phonebook == phonebook &&
+            page->offset == offset
+        ) {
+            return idx;
+        }
+    }
+    return BT_PBAP_PREFETCH_NONE;
+}
+
+/**
+ * BTPBAPPrefetchShow()
+ *     Description:
+ *         Swap a prefetch page with the contacts buffer. The page that was
+ *         on screen takes the place of the prefetch page, so that turning
+ *         back to it is served from memory as well.
+ *     Params:
+ *         BT_t *bt - A pointer to the module object
+ *         uint8_t idx - The prefetch page to show
+ *     Returns:
+ *         void
+ */
+static void BTPBAPPrefetchShow(BT_t *bt, uint8_t idx)
+{
+    BTPBAPPage_t *page = &BTPBAPPrefetch[idx];
+    BTPBAPContact_t contact;
+    uint8_t i;
+    for (i = 0; i < BT_PBAP_MAX_CONTACTS; i++) {
+        contact = bt->pbap.contacts[i];
+        bt->pbap.contacts[i] = page->contacts[i];
+        page->contacts[i] = contact;
+    }
+    uint8_t phonebook = bt->pbap.pagePhonebook;
+    uint16_t offset = bt->pbap.pageOffset;
+    uint8_t count = bt->pbap.contactCount;
+    bt->pbap.pagePhonebook = page->phonebook;
+    bt->pbap.pageOffset = page->offset;
+    bt->pbap.contactCount = page->count;
+    bt->pbap.contactIdx = 0;
+    page->status = BT_PBAP_PAGE_STATUS_EMPTY;
+    if (bt->pbap.pageValid) {
+        page->phonebook = phonebook;
+        page->offset = offset;
+        page->count = count;
+        page->status = BT_PBAP_PAGE_STATUS_READY;
+    }
+    page->show = 0;
+    bt->pbap.pageValid = 1;
+}
+
+/**
+ * BTPBAPPrefetchPageComplete()
+ *     Description:
+ *         Finish a prefetch pull. The page is kept for later unless the UI
+ *         is already waiting on it.
+ *     Params:
+ *         BT_t *bt - A pointer to the module object
+ *     Returns:
+ *         uint8_t - 1 if the page replaced the contacts buffer, 0 otherwise
+ */
+static uint8_t BTPBAPPrefetchPageComplete(BT_t *bt)
+{
+    BTPBAPPage_t *page = &BTPBAPPrefetch[bt->pbap.prefetchIdx];
+    // The prefetch pages were dropped while the pull was running
+    if (page->status != BT_PBAP_PAGE_STATUS_PULLING) {
+        return 0;
+    }
+    if (page->show) {
+        BTPBAPPrefetchShow(bt, bt->pbap.prefetchIdx);
+        return 1;
+    }
+    // A failed pull and one past the end look the same, so neither is kept
+    if (page->count > 0) {
+        page->status = BT_PBAP_PAGE_STATUS_READY;
+    } else {
+        page->status = BT_PBAP_PAGE_STATUS_EMPTY;
+    }
+    return 0;
+}
+
+/**
+ * BTPBAPPrefetchClear()
+ *     Description:
+ *         Drop every prefetch page and any queued pull, as they can not be
+ *         trusted once the PBAP session is gone
+ *     Params:
+ *         BT_t *bt - A pointer to the module object
+ *     Returns:
+ *         void
+ */
+void BTPBAPPrefetchClear(BT_t *bt)
+{
+    uint8_t idx;
+    for (idx = 0; idx < BT_PBAP_PREFETCH_PAGES; idx++) {
+        BTPBAPPrefetch[idx].status = BT_PBAP_PAGE_STATUS_EMPTY;
+        BTPBAPPrefetch[idx].show = 0;
+    }
+    bt->pbap.pageValid = 0;
+    bt->pbap.requestQueued = 0;
+}
+
+/**
+ * BTPBAPPrefetchIsHistory()
+ *     Description:
+ *         Check if a phonebook is one of the call history lists, which
+ *         change with every call
+ *     Params:
+ *         uint8_t phonebook - The BT_PBAP_OBJ_* to check
+ *     Returns:
+ *         uint8_t - 1 if the phonebook is a call history, 0 otherwise
+ */
+static uint8_t BTPBAPPrefetchIsHistory(uint8_t phonebook)
+{
+    if (phonebook >= BT_PBAP_OBJ_INCOMING && phonebook <= BT_PBAP_OBJ_COMBINED) {
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * BTPBAPPrefetchClearHistory()
+ *     Description:
+ *         Drop the prefetch pages of the call history lists, as they can
+ *         not be trusted once a call was made or received. The history page
+ *         in the contacts buffer is not kept when the UI turns away from it
+ *         either. A page that the UI is waiting on is left to its pull.
+ *     Params:
+ *         BT_t *bt - A pointer to the module object
+ *     Returns:
+ *         void
+ */
+void BTPBAPPrefetchClearHistory(BT_t *bt)
+{
+    uint8_t idx;
+    for (idx = 0; idx < BT_PBAP_PREFETCH_PAGES; idx++) {
+        BTPBAPPage_t *page = &BTPBAPPrefetch[idx];
+        if (BTPBAPPrefetchIsHistory(page->phonebook) == 1 && page->show == 0) {
+            page->status = BT_PBAP_PAGE_STATUS_EMPTY;
+        }
+    }
+    if (BTPBAPPrefetchIsHistory(bt->pbap.pagePhonebook) == 1) {
+        bt->pbap.pageValid = 0;
+    }
+}
+
+/**
+ * BTPBAPPrefetchGetPage()
+ *     Description:
+ *         Get the prefetch page that the running prefetch pull fills
+ *     Params:
+ *         BT_t *bt - A pointer to the module object
+ *     Returns:
+ *         BTPBAPPage_t * - The page at prefetchIdx
+ */
+BTPBAPPage_t *BTPBAPPrefetchGetPage(BT_t *bt)
+{
+    return &BTPBAPPrefetch[bt->pbap.prefetchIdx];
+}
+
+/**
+ * BTPBAPPrefetchLoadPage()
+ *     Description:
+ *         Serve a page of contacts from the prefetch pages. A page that is
+ *         in replaces the contacts buffer right away, while one that is still
+ *         being pulled does so when the pull completes. Either way the UI
+ *         hears about it through BT_EVENT_PBAP_CONTACT_RECEIVED, the same as
+ *         for a pull. If a prefetch pull is running, the page is queued
+ *         behind it rather than interrupting it.
+ *     Params:
+ *         BT_t *bt - A pointer to the module object
+ *         uint8_t phonebook - The BT_PBAP_OBJ_* of the page
+ *         uint16_t offset - The position of the first contact of the page
+ *     Returns:
+ *         uint8_t - 1 if the page will be delivered, 0 if it has to be pulled
+ */
+uint8_t BTPBAPPrefetchLoadPage(BT_t *bt, uint8_t phonebook, uint16_t offset)
+{
+    uint8_t idx = BTPBAPPrefetchFind(bt, phonebook, offset);
+    if (idx != BT_PBAP_PREFETCH_NONE) {
+        if (BTPBAPPrefetch[idx].status == BT_PBAP_PAGE_STATUS_READY) {
+            BTPBAPPrefetchShow(bt, idx);
+            EventTriggerCallback(BT_EVENT_PBAP_CONTACT_RECEIVED, 0);
+        } else {
+            BTPBAPPrefetch[idx].show = 1;
+        }
+        return 1;
+    }
+    if (bt->pbap.requestPrefetch == 0 || bt->pbap.status == BT_PBAP_STATUS_IDLE) {
+        return 0;
+    }
+    for (idx = 0; idx < BT_PBAP_PREFETCH_PAGES; idx++) {
+        BTPBAPPage_t *page = &BTPBAPPrefetch[idx];
+        if (page->status != BT_PBAP_PAGE_STATUS_PULLING) {
+            page->phonebook = phonebook;
+            page->offset = offset;
+            page->status = BT_PBAP_PAGE_STATUS_WANTED;
+            page->show = 1;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * BTPBAPPrefetchNextPage()
+ *     Description:
+ *         Pick the prefetch page that should be pulled next, putting a page
+ *         that the UI is waiting on first, and get it ready to be filled
+ *     Params:
+ *         BT_t *bt - A pointer to the module object
+ *     Returns:
+ *         uint8_t - The prefetch page, or BT_PBAP_PREFETCH_NONE if there is
+ *             nothing to pull
+ */
+uint8_t BTPBAPPrefetchNextPage(BT_t *bt)
+{
+    uint8_t next = BT_PBAP_PREFETCH_NONE;
+    uint8_t idx;
+    for (idx = 0; idx < BT_PBAP_PREFETCH_PAGES; idx++) {
+        BTPBAPPage_t *page = &BTPBAPPrefetch[idx];
+        if (page->status == BT_PBAP_PAGE_STATUS_WANTED) {
+            if (next == BT_PBAP_PREFETCH_NONE || page->show) {
+                next = idx;
+            }
+        }
+    }
+    if (next != BT_PBAP_PREFETCH_NONE) {
+        BTPBAPPage_t *page = &BTPBAPPrefetch[next];
+        memset(page->contacts, 0, sizeof(page->contacts));
+        page->count = 0;
+        page->status = BT_PBAP_PAGE_STATUS_PULLING;
+        bt->pbap.prefetchIdx = next;
+    }
+    return next;
+}
+
+/**
+ * BTPBAPPrefetchSchedule()
+ *     Description:
+ *         Note the page that the UI is showing and ask for the pages either
+ *         side of it to be pulled in the background. Pages that are no
+ *         longer next to the one on screen make way for the new ones.
+ *     Params:
+ *         BT_t *bt - A pointer to the module object
+ *         uint8_t phonebook - The BT_PBAP_OBJ_* of the page on screen
+ *         uint16_t offset - The position of the first contact on screen
+ *     Returns:
+ *         void
+ */
+void BTPBAPPrefetchSchedule(BT_t *bt, uint8_t phonebook, uint16_t offset)
+{
+    uint16_t offsets[BT_PBAP_PREFETCH_PAGES];
+    uint8_t wanted = 0;
+    bt->pbap.pagePhonebook = phonebook;
+    bt->pbap.pageOffset = offset;
+    bt->pbap.pageValid = 1;
+    // The next page first, as that is the way most people page
+    if (bt->pbap.contactCount == BT_PBAP_MAX_CONTACTS) {
+        offsets[wanted++] = offset + BT_PBAP_MAX_CONTACTS;
+    }
+    if (offset >= BT_PBAP_MAX_CONTACTS) {
+        offsets[wanted++] = offset - BT_PBAP_MAX_CONTACTS;
+    }
+    uint8_t idx;
+    for (idx = 0; idx < BT_PBAP_PREFETCH_PAGES; idx++) {
+        BTPBAPPage_t *page = &BTPBAPPrefetch[idx];
+        uint8_t i;
+        uint8_t keep = 0;
+        for (i = 0; i < wanted; i++) {
+            if (page->phonebook == phonebook && page->offset == offsets[i]) {
+                keep = 1;
+            }
+        }
+        if (keep == 0 && page->status != BT_PBAP_PAGE_STATUS_PULLING) {
+            page->status = BT_PBAP_PAGE_STATUS_EMPTY;
+        }
+        page->show = 0;
+    }
+    uint8_t i;
+    for (i = 0; i < wanted; i++) {
+        if (BTPBAPPrefetchFind(bt, phonebook, offsets[i]) != BT_PBAP_PREFETCH_NONE) {
+            continue;
+        }
+        for (idx = 0; idx < BT_PBAP_PREFETCH_PAGES; idx++) {
+            BTPBAPPage_t *page = &BTPBAPPrefetch[idx];
+            if (page->status == BT_PBAP_PAGE_STATUS_EMPTY) {
+                page->phonebook = phonebook;
+                page->offset = offsets[i];
+                page->status = BT_PBAP_PAGE_STATUS_WANTED;
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * BTPBAPTelephoneBCDNibble()
+ *     Description:
+ *         Get the BCD nibble for a character of a phone number
+ *     Params:
+ *         char c - The character
+ *     Returns:
+ *         uint8_t - The nibble, or BT_PBAP_BCD_UNUSED for characters that
+ *             are not part of the number (spaces, dashes, etc.)
+ */
+static uint8_t BTPBAPTelephoneBCDNibble(char c)
+{
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    } else if (c == '*') {
+        return BT_PBAP_BCD_STAR;
+    } else if (c == '#') {
+        return BT_PBAP_BCD_HASH;
+    } else if (c == '+') {
+        return BT_PBAP_BCD_PLUS;
+    }
+    return BT_PBAP_BCD_UNUSED;
+}
+
+/**
+ * BTPBAPParserGetContact()
+ *     Description:
+ *         Get the contact that the vCard being parsed is written to. A cache
+ *         sync parses into its own contact and a prefetch into its page, so
+ *         that the contacts buffer the UI is showing stays untouched.
+ *     Params:
+ *         BT_t *bt - A pointer to the module object
+ *     Returns:
+ *         BTPBAPContact_t * - The contact, or 0 if the buffer is full
+ */
+static BTPBAPContact_t *BTPBAPParserGetContact(BT_t *bt)
+{
+    if (bt->pbap.requestSync) {
+        return &bt->pbap.cache.contact;
+    }
+    if (bt->pbap.requestPrefetch) {
+        BTPBAPPage_t *page = &BTPBAPPrefetch[bt->pbap.prefetchIdx];
+        if (page->count >= BT_PBAP_MAX_CONTACTS) {
+            return 0;
+        }
+        return &page->contacts[page->count];
+    }
+    if (bt->pbap.contactIdx >= BT_PBAP_MAX_CONTACTS) {
+        return 0;
+    }
+    return &bt->pbap.contacts[bt->pbap.contactIdx];
+}
+
+/**
+ * BTPBAPParserGetProperty()
+ *     Description:
+ *         Identify the vCard properties that we decode
+ *     Params:
+ *         const char *name - The property name
+ *     Returns:
+ *         uint8_t - The BT_PBAP_PROPERTY_* value
+ */
+static uint8_t BTPBAPParserGetProperty(const char *name)
+{
+    if (UtilsStricmp(name, "BEGIN") == 0) {
+        return BT_PBAP_PROPERTY_BEGIN;
+    } else if (UtilsStricmp(name, "END") == 0) {
+        return BT_PBAP_PROPERTY_END;
+    } else if (UtilsStricmp(name, "FN") == 0) {
+        return BT_PBAP_PROPERTY_FN;
+    } else if (UtilsStricmp(name, "N") == 0) {
+        return BT_PBAP_PROPERTY_N;
+    } else if (UtilsStricmp(name, "TEL") == 0) {
+        return BT_PBAP_PROPERTY_TEL;
+    }
+    return BT_PBAP_PROPERTY_UNKNOWN;
+}
+
+/**
+ * BTPBAPParserTokenAppend()
+ *     Description:
+ *         Append a character to the token. A token too long to be one of the
+ *         keywords we look for is emptied, so that it cannot match any.
+ *     Params:
+ *         BTPBAPParserState_t *parser - The parser state
+ *         char c - The character
+ *     Returns:
+ *         void
+ */
+static void BTPBAPParserTokenAppend(BTPBAPParserState_t *parser, char c)
+{
+    if (parser->tokenIdx < BT_PBAP_PARSER_TOKEN_SIZE - 1) {
+        parser->token[parser->tokenIdx++] = c;
+        parser->token[parser->tokenIdx] = '\0';
+    } else {
+        parser->token[0] = '\0';
+    }
+}
+
+/**
+ * BTPBAPParserTokenReset()
+ *     Description:
+ *         Empty the token
+ *     Params:
+ *         BTPBAPParserState_t *parser - The parser state
+ *     Returns:
+ *         void
+ */
+static void BTPBAPParserTokenReset(BTPBAPParserState_t *parser)
+{
+    parser->tokenIdx = 0;
+    parser->token[0] = '\0';
+}
+
+/**
+ * BTPBAPParserParam()
+ *     Description:
+ *         Apply a property parameter, or one value of it. Parameters come as
+ *         "ENCODING=QUOTED-PRINTABLE", "TYPE=CELL,VOICE" or in the vCard 2.1
+ *         bare form "CELL", so the names and values are all looked at alone.
+ *     Params:
+ *         BTPBAPParserState_t *parser - The parser state
+ *     Returns:
+ *         void
+ */
+static void BTPBAPParserParam(BTPBAPParserState_t *parser)
+{
+    if (UtilsStricmp(parser->token, "QUOTED-PRINTABLE") == 0) {
+        parser->quotedPrintable = 1;
+    } else if (
+        parser->property == BT_PBAP_PROPERTY_TEL &&
+        parser->telType == BT_PBAP_TEL_TYPE_UNKNOWN
+    ) {
+        if (
+            UtilsStricmp(parser->token, "CELL") == 0 ||
+            UtilsStricmp(parser->token, "MOBILE") == 0
+        ) {
+            parser->telType = BT_PBAP_TEL_TYPE_CELL;
+        } else if (UtilsStricmp(parser->token, "HOME") == 0) {
+            parser->telType = BT_PBAP_TEL_TYPE_HOME;
+        } else if (UtilsStricmp(parser->token, "WORK") == 0) {
+            parser->telType = BT_PBAP_TEL_TYPE_WORK;
+        }
+    }
+}
+
+/**
+ * BTPBAPParserBeginValue()
+ *     Description:
+ *         Prepare the destination of the property value that follows
+ *     Params:
+ *         BT_t *bt - A pointer to the module object
+ *     Returns:
+ *         void
+ */
+static void BTPBAPParserBeginValue(BT_t *bt)
+{
+    BTPBAPParserState_t *parser = &bt->pbap.parser;
+    parser->state = BT_PBAP_PARSER_STATE_VALUE;
+    BTPBAPContact_t *contact = 0;
+    if (parser->inVCard) {
+        contact = BTPBAPParserGetContact(bt);
+    }
+    if (contact == 0) {
+        return;
+    }
+    if (
+        parser->property == BT_PBAP_PROPERTY_FN ||
+        parser->property == BT_PBAP_PROPERTY_N
+    ) {
+        // The name is taken from whichever of FN and N comes last
+        contact->name[0] = '\0';
+        parser->nameLength = 0;
+        parser->nameInsert = 0;
+        parser->nameSeparator = 0;
+        parser->component = 0;
+        parser->utf8Idx = 0;
+    } else if (
+        parser->property == BT_PBAP_PROPERTY_TEL &&
+        contact->numberCount < BT_PBAP_CONTACT_MAX_NUMBERS
+    ) {
+        memset(contact->numbers[contact->numberCount].number, 0xFF, BT_PBAP_TEL_LEN - 1);
+        parser->digitCount = 0;
+    }
+}
+
+/**
+ * BTPBAPParserEndProperty()
+ *     Description:
+ *         Act on a property once its line, and any folded continuation of
+ *         it, is complete. Then get ready for the next property.
+ *     Params:
+ *         BT_t *bt - A pointer to the module object
+ *     Returns:
+ *         void
+ */
+static void BTPBAPParserEndProperty(BT_t *bt)
+{
+    BTPBAPParserState_t *parser = &bt->pbap.parser;
+    if (parser->lineState == BT_PBAP_PARSER_STATE_VALUE) {
+        uint8_t isVCard = UtilsStricmp(parser->token, "VCARD") == 0;
+        BTPBAPContact_t *contact = 0;
+        switch (parser->property) {
+            case BT_PBAP_PROPERTY_BEGIN:
+                if (isVCard) {
+                    parser->inVCard = 1;
+                    bt->pbap.contactIdx = bt->pbap.contactCount;
+                    contact = BTPBAPParserGetContact(bt);
+                    if (contact != 0) {
+                        memset(contact, 0, sizeof(BTPBAPContact_t));
+                    }
+                }
+                break;
+            case BT_PBAP_PROPERTY_END:
+                if (isVCard && parser->inVCard) {
+                    if (bt->pbap.requestSync) {
+                        BTPBAPCacheStoreContact(bt);
+                    } else if (bt->pbap.requestPrefetch) {
+                        BTPBAPPage_t *page = &BTPBAPPrefetch[bt->pbap.prefetchIdx];
+                        if (page->count < BT_PBAP_MAX_CONTACTS) {
+                            page->count++;
+                        }
+                    } else if (bt->pbap.contactIdx < BT_PBAP_MAX_CONTACTS) {
+                        bt->pbap.contactCount++;
+                    }
+                }
+                parser->inVCard = 0;
+                break;
+            case BT_PBAP_PROPERTY_TEL:
+                if (parser->inVCard) {
+                    contact = BTPBAPParserGetContact(bt);
+                }
+                if (contact != 0 && contact->numberCount < BT_PBAP_CONTACT_MAX_NUMBERS) {
+                    contact->numbers[contact->numberCount].type = parser->telType;
+                    contact->numberCount++;
+                }
+                break;
+        }
+    }
+    parser->state = BT_PBAP_PARSER_STATE_NAME;
+    parser->lineState = BT_PBAP_PARSER_STATE_NAME;
+    parser->property = BT_PBAP_PROPERTY_UNKNOWN;
+    parser->telType = BT_PBAP_TEL_TYPE_UNKNOWN;
+    parser->quotedPrintable = 0;
+    parser->qpIdx = 0;
+    BTPBAPParserTokenReset(parser);
+}
+
+/**
+ * BTPBAPParserNameInsert()
+ *     Description:
+ *         Insert a display character into the contact name at the insert
+ *         position. Once the name is full, characters inserted ahead of the
+ *         end push the last ones out, and characters at the end are dropped.
+ *     Params:
+ *         BTPBAPParserState_t *parser - The parser state
+ *         char *name - The contact name
+ *         char c - The character
+ *     Returns:
+ *         void
+ */
+static void BTPBAPParserNameInsert(BTPBAPParserState_t *parser, char *name, char c)
+{
+    if (parser->nameSeparator) {
+        // The first name goes ahead of the last name, with a space between
+        parser->nameSeparator = 0;
+        BTPBAPParserNameInsert(parser, name, ' ');
+        parser->nameInsert = 0;
+    }
+    if (parser->nameLength == BT_PBAP_CONTACT_NAME_LEN - 1) {
+        if (parser->nameInsert == parser->nameLength) {
+            return;
+        }
+        parser->nameLength--;
+    }
+    memmove(
+        name + parser->nameInsert + 1,
+        name + parser->nameInsert,
+        parser->nameLength - parser->nameInsert
+    );
+    name[parser->nameInsert++] = c;
+    parser->nameLength++;
+    name[parser->nameLength] = '\0';
+}
+
+/**
+ * BTPBAPParserNameByte()
+ *     Description:
+ *         Add a decoded byte of the name. Multi-byte UTF-8 characters are
+ *         collected and normalized for the displays once they are complete.
+ *     Params:
+ *         BTPBAPParserState_t *parser - The parser state
+ *         char *name - The contact name
+ *         uint8_t c - The byte
+ *     Returns:
+ *         void
+ */
+static void BTPBAPParserNameByte(BTPBAPParserState_t *parser, char *name, uint8_t c)
+{
+    if (parser->utf8Idx == 0) {
+        if (c >= 0x20 && c <= 0x7E) {
+            BTPBAPParserNameInsert(parser, name, (char) c);
+            return;
+        }
+        parser->utf8Length = UtilsGetUnicodeByteLength(c);
+    }
+    parser->utf8[parser->utf8Idx++] = (char) c;
+    if (parser->utf8Idx < parser->utf8Length) {
+        return;
+    }
+    parser->utf8[parser->utf8Idx] = '\0';
+    parser->utf8Idx = 0;
+    char normalized[8];
+    UtilsNormalizeText(normalized, parser->utf8, sizeof(normalized));
+    uint8_t i;
+    for (i = 0; normalized[i] != '\0'; i++) {
+        BTPBAPParserNameInsert(parser, name, normalized[i]);
+    }
+}
+
+/**
+ * BTPBAPParserValueByte()
+ *     Description:
+ *         Decode a byte of a property value straight into the contact
+ *     Params:
+ *         BT_t *bt - A pointer to the module object
+ *         uint8_t c - The byte, with any transfer encoding already removed
+ *     Returns:
+ *         void
+ */
+static void BTPBAPParserValueByte(BT_t *bt, uint8_t c)
+{
+    BTPBAPParserState_t *parser = &bt->pbap.parser;
+    if (
+        parser->property == BT_PBAP_PROPERTY_BEGIN ||
+        parser->property == BT_PBAP_PROPERTY_END
+    ) {
+        BTPBAPParserTokenAppend(parser, (char) c);
+        return;
+    }
+    BTPBAPContact_t *contact = 0;
+    if (parser->inVCard) {
+        contact = BTPBAPParserGetContact(bt);
+    }
+    if (contact == 0) {
+        return;
+    }
+    if (parser->property == BT_PBAP_PROPERTY_N && c == ';') {
+        // N is "Last;First;Middle;Prefix;Suffix" and is shown as "First Last"
+        if (parser->component < 7) {
+            parser->component++;
+        }
+        if (parser->component == 1) {
+            parser->nameInsert = 0;
+            parser->nameSeparator = parser->nameLength > 0;
+        }
+        parser->utf8Idx = 0;
+    } else if (
+        parser->property == BT_PBAP_PROPERTY_FN ||
+        (parser->property == BT_PBAP_PROPERTY_N && parser->component <= 1)
+    ) {
+        BTPBAPParserNameByte(parser, contact->name, c);
+    } else if (
+        parser->property == BT_PBAP_PROPERTY_TEL &&
+        contact->numberCount < BT_PBAP_CONTACT_MAX_NUMBERS
+    ) {
+        uint8_t nibble = BTPBAPTelephoneBCDNibble((char) c);
+        if (nibble != BT_PBAP_BCD_UNUSED && parser->digitCount < 14) {
+            uint8_t *bcd = &contact->numbers[contact->numberCount].number[parser->digitCount / 2];
+            if ((parser->digitCount & 1) == 0) {
+                *bcd = (nibble << 4) | BT_PBAP_BCD_UNUSED;
+            } else {
+                *bcd = (*bcd & 0xF0) | nibble;
+            }
+            parser->digitCount++;
+        }
+    }
+}
+
+/**
+ * BTPBAPParserQuotedPrintable()
+ *     Description:
+ *         Decode a byte of a quoted-printable value. An "=" that does not
+ *         start a valid escape is dropped.
+ *     Params:
+ *         BT_t *bt - A pointer to the module object
+ *         uint8_t c - The byte
+ *     Returns:
+ *         void
+ */
+static void BTPBAPParserQuotedPrintable(BT_t *bt, uint8_t c)
+{
+    BTPBAPParserState_t *parser = &bt->pbap.parser;
+    if (parser->qpIdx == 0) {
+        if (c == '=') {
+            parser->qpIdx = 1;
+        } else {
+            BTPBAPParserValueByte(bt, c);
+        }
+        return;
+    }
+    uint8_t nibble = UtilsHexToNibble((char) c);
+    if (nibble == UTILS_HEX_INVALID) {
+        parser->qpIdx = 0;
+        BTPBAPParserQuotedPrintable(bt, c);
+    } else if (parser->qpIdx == 1) {
+        parser->qpHigh = nibble;
+        parser->qpIdx = 2;
+    } else {
+        parser->qpIdx = 0;
+        BTPBAPParserValueByte(bt, (parser->qpHigh << 4) | nibble);
+    }
+}
+
+/**
+ * BTPBAPParseByte()
+ *     Description:
+ *         Feed one byte of vCard data through the parser. The properties are
+ *         tokenized as the bytes arrive and their values decoded straight
+ *         into the contact, so no line is ever staged. A line that starts
+ *         with whitespace continues the one before it, and so does the line
+ *         after a quoted-printable soft line break.
+ *     Params:
+ *         BT_t *bt - A pointer to the module object
+ *         uint8_t c - The next byte of vCard data
+ *     Returns:
+ *         void
+ */
+void BTPBAPParseByte(BT_t *bt, uint8_t c)
+{
+    BTPBAPParserState_t *parser = &bt->pbap.parser;
+    if (c == '\r') {
+        return;
+    }
+    if (parser->state == BT_PBAP_PARSER_STATE_LINE_END) {
+        if (c == ' ' || c == '\t') {
+            parser->state = parser->lineState;
+            return;
+        }
+        BTPBAPParserEndProperty(bt);
+    }
+    if (c == '\n') {
+        if (parser->qpIdx == 1) {
+            parser->qpIdx = 0;
+        } else {
+            // Whether the property ends here depends on the next byte
+            parser->lineState = parser->state;
+            parser->state = BT_PBAP_PARSER_STATE_LINE_END;
+        }
+        return;
+    }
+    switch (parser->state) {
+        case BT_PBAP_PARSER_STATE_NAME:
+            if (c == ':' || c == ';') {
+                parser->property = BTPBAPParserGetProperty(parser->token);
+                BTPBAPParserTokenReset(parser);
+                if (c == ':') {
+                    BTPBAPParserBeginValue(bt);
+                } else {
+                    parser->state = BT_PBAP_PARSER_STATE_PARAM;
+                }
+            } else if (c == '.') {
+                // Drop the group prefix of properties like "item1.TEL"
+                BTPBAPParserTokenReset(parser);
+            } else {
+                BTPBAPParserTokenAppend(parser, (char) c);
+            }
+            break;
+        case BT_PBAP_PARSER_STATE_PARAM:
+            if (c == ';' || c == ',' || c == '=' || c == ':') {
+                BTPBAPParserParam(parser);
+                BTPBAPParserTokenReset(parser);
+                if (c == ':') {
+                    BTPBAPParserBeginValue(bt);
+                }
+            } else {
+                BTPBAPParserTokenAppend(parser, (char) c);
+            }
+            break;
+        case BT_PBAP_PARSER_STATE_VALUE:
+            if (parser->quotedPrintable) {
+                BTPBAPParserQuotedPrintable(bt, c);
+            } else {
+                BTPBAPParserValueByte(bt, c);
+            }
+            break;
+    }
+}
+
+/**
+ * BTPBAPParseFlush()
+ *     Description:
+ *         Complete the last property once the pull has ended, since its
+ *         line may not have been terminated
+ *     Params:
+ *         BT_t *bt - A pointer to the module object
+ *     Returns:
+ *         void
+ */
+void BTPBAPParseFlush(BT_t *bt)
+{
+    BTPBAPParserState_t *parser = &bt->pbap.parser;
+    if (parser->state != BT_PBAP_PARSER_STATE_LINE_END) {
+        parser->lineState = parser->state;
+    }
+    BTPBAPParserEndProperty(bt);
+}
+
+/**
+ * BTPBAPPullComplete()
+ *     Description:
+ *         Finish a phonebook pull once the module reports the end of it, and
+ *         let the UI know that the contacts are in
+ *     Params:
+ *         BT_t *bt - A pointer to the module object
+ *     Returns:
+ *         void
+ */
+void BTPBAPPullComplete(BT_t *bt)
+{
+    BTPBAPParseFlush(bt);
+    bt->pbap.status = BT_PBAP_STATUS_IDLE;
+    if (bt->pbap.requestSync) {
+        LogDebug(
+            LOG_SOURCE_BT,
+            "BT: PBAP sync complete, %d contacts",
+            bt->pbap.cache.syncCount - bt->pbap.cache.syncOffset
+        );
+        BTPBAPCacheSyncPageComplete(bt);
+    } else if (bt->pbap.requestPrefetch) {
+        LogDebug(
+            LOG_SOURCE_BT,
+            "BT: PBAP prefetch complete, %d contacts",
+            BTPBAPPrefetch[bt->pbap.prefetchIdx].count
+        );
+        // Nobody is waiting on the page yet, so there is nothing to redraw
+        if (BTPBAPPrefetchPageComplete(bt) == 0) {
+            return;
+        }
+    } else {
+        LogDebug(
+            LOG_SOURCE_BT,
+            "BT: PBAP complete, %d contacts",
+            bt->pbap.contactCount
+        );
+    }
+    EventTriggerCallback(BT_EVENT_PBAP_CONTACT_RECEIVED, 0);
+}
+
+
+/**
+ * BTPBAPTelephoneFromBCD()
+ *     Description:
+ *         Convert a BCD-encoded phone number to ASCII string
+ *     Params:
+ *         const uint8_t *bcd - The BCD encoded number (7 bytes)
+ *         char *ascii - Output buffer for ASCII string
+ *         uint8_t maxLen - Maximum output length (including null terminator)
+ *     Returns:
+ *         void
+ */
+void BTPBAPTelephoneFromBCD(const uint8_t *bcd, char *ascii, uint8_t maxLen)
+{
+    uint8_t i;
+    uint8_t pos = 0;
     for (i = 0; i < 7 && pos < maxLen - 1; i++) {
         uint8_t highNibble = (bcd[i] >> 4) & 0x0F;
         uint8_t lowNibble = bcd[i] & 0x0F;
@@ -532,17 +2363,8 @@ uint8_t BTPBAPTelephoneToBCD(const char *ascii, uint8_t *bcd)
         bcd[i] = 0xFF;
     }
     for (i = 0; ascii[i] != '\0' && digitCount < 14; i++) {
-        uint8_t nibble = BT_PBAP_BCD_UNUSED;
-        char c = ascii[i];
-        if (c >= '0' && c <= '9') {
-            nibble = c - '0';
-        } else if (c == '*') {
-            nibble = BT_PBAP_BCD_STAR;
-        } else if (c == '#') {
-            nibble = BT_PBAP_BCD_HASH;
-        } else if (c == '+') {
-            nibble = BT_PBAP_BCD_PLUS;
-        } else {
+        uint8_t nibble = BTPBAPTelephoneBCDNibble(ascii[i]);
+        if (nibble == BT_PBAP_BCD_UNUSED) {
             // Skip non-digit characters (spaces, dashes, etc.)
             continue;
         }
@@ -26,6 +26,7 @@
 #define BT_CALL_SCO_CLOSE 5
 #define BT_CALL_SCO_OPEN 6
 #define BT_CALLER_ID_FIELD_SIZE 32
+#define BT_CALLER_ID_NUMBER_CHARS "0123456789+*# -()."
 #define BT_DIAL_BUFFER_FIELD_SIZE 32
 #define BT_CLOSE_ALL 255
 
@@ -61,11 +62,27 @@
 #define BT_EVENT_PAIRING_STATUS 22
 
 #define BT_LEN_MAC_ID 6
+// Only one module is fitted, so its driver has the RX buffer to itself
+#define BT_RX_BUFFER_SIZE 768
 
 #define BT_MAX_PAIRINGS 8
 #define BT_DEVICE_NAME_LEN 32
 #define BT_METADATA_MAX_SIZE 384
-#define BT_METADATA_FIELD_SIZE 128
+#define BT_METADATA_DISPLAY_SIZE 255
+#define BT_METADATA_ENTRY_OVERHEAD 2
+// Every field can always grow to the minimum, which is the 127 characters
+// that the fixed buffers held, and one field can grow to the maximum while
+// the other two hold theirs
+#define BT_METADATA_FIELD_MIN_LEN 127
+#define BT_METADATA_FIELD_MAX_LEN 192
+#define BT_METADATA_FIELD_COUNT 3
+#define BT_METADATA_ARENA_SIZE (BT_METADATA_FIELD_MAX_LEN + \
+    ((BT_METADATA_FIELD_COUNT - 1) * BT_METADATA_FIELD_MIN_LEN) + \
+    (BT_METADATA_FIELD_COUNT * BT_METADATA_ENTRY_OVERHEAD))
+#define BT_METADATA_FIELD_TITLE 0x01
+#define BT_METADATA_FIELD_ARTIST 0x02
+#define BT_METADATA_FIELD_ALBUM 0x04
+#define BT_METADATA_FIELD_ALL 0x07
 // BC127-specific
 #define BT_METADATA_STATUS_CUR 0
 #define BT_METADATA_STATUS_UPD 1
@@ -94,10 +111,37 @@
 #define BT_DEVICE_NAME_LEN 32
 #define BT_DEVICE_RECORD_LEN (BT_DEVICE_MAC_ID_LEN + BT_DEVICE_NAME_LEN)
 
+#define BT_PBAP_CACHE_FLAG_TRUNCATED 0x01
+#define BT_PBAP_CACHE_HEADER_COUNT 7
+#define BT_PBAP_CACHE_HEADER_FLAGS 8
+#define BT_PBAP_CACHE_HEADER_LEN 9
+#define BT_PBAP_CACHE_INDEX_OFFSET 0x40
+#define BT_PBAP_CACHE_MAX_CONTACTS 192
+#define BT_PBAP_CACHE_MAX_NUMBERS 384
+#define BT_PBAP_CACHE_NUMBER_EMPTY 0xFFFF
+// Twice as many slots as indexed numbers, so that at least half of them are
+// always free and the probe sequences stay short
+#define BT_PBAP_CACHE_NUMBER_SLOTS (BT_PBAP_CACHE_MAX_NUMBERS * 2)
+#define BT_PBAP_CACHE_NUMBER_SUFFIX 7
+#define BT_PBAP_CACHE_RECORD_LEN 64
+#define BT_PBAP_CACHE_RECORD_OFFSET 0x100
+#define BT_PBAP_CACHE_SEARCH_NONE 0xFF
+#define BT_PBAP_CACHE_STATUS_INVALID 0
+#define BT_PBAP_CACHE_STATUS_STALE 1
+#define BT_PBAP_CACHE_STATUS_SYNCING 2
+#define BT_PBAP_CACHE_STATUS_CURRENT 3
+#define BT_PBAP_CACHE_T9_DIGITS 4
+#define BT_PBAP_CACHE_T9_NONE 0x0F
+#define BT_PBAP_CACHE_VERSION 0x02
 #define BT_PBAP_CONTACT_MAX_NUMBERS 3
 #define BT_PBAP_CONTACT_NAME_LEN 32
-#define BT_PBAP_LINE_BUFFER_SIZE 128
 #define BT_PBAP_MAX_CONTACTS 8
+#define BT_PBAP_PAGE_STATUS_EMPTY 0
+#define BT_PBAP_PAGE_STATUS_WANTED 1
+#define BT_PBAP_PAGE_STATUS_PULLING 2
+#define BT_PBAP_PAGE_STATUS_READY 3
+#define BT_PBAP_PREFETCH_NONE 0xFF
+#define BT_PBAP_PREFETCH_PAGES 2
 
 #define BT_PBAP_OBJ_PHONEBOOK 0x00
 #define BT_PBAP_OBJ_INCOMING 0x01
@@ -107,12 +151,22 @@
 #define BT_PBAP_OBJ_FAVORITES 0x05
 #define BT_PBAP_OBJ_SPEEDDIAL 0x06
 
-#define BT_PBAP_FRAME_DELIM 0x0D // <CR>
+#define BT_PBAP_PARSER_STATE_NAME 0
+#define BT_PBAP_PARSER_STATE_PARAM 1
+#define BT_PBAP_PARSER_STATE_VALUE 2
+#define BT_PBAP_PARSER_STATE_LINE_END 3
+#define BT_PBAP_PARSER_TOKEN_SIZE 17
+
+#define BT_PBAP_PROPERTY_UNKNOWN 0
+#define BT_PBAP_PROPERTY_BEGIN 1
+#define BT_PBAP_PROPERTY_END 2
+#define BT_PBAP_PROPERTY_FN 3
+#define BT_PBAP_PROPERTY_N 4
+#define BT_PBAP_PROPERTY_TEL 5
 
 #define BT_PBAP_STATUS_IDLE 0
 #define BT_PBAP_STATUS_PENDING 1
-#define BT_PBAP_STATUS_HEADER_WAIT 2
-#define BT_PBAP_STATUS_WAITING 3
+#define BT_PBAP_STATUS_WAITING 2
 
 #define BT_PBAP_BCD_STAR 0x0A
 #define BT_PBAP_BCD_HASH 0x0B
@@ -162,25 +216,125 @@ typedef struct BTPBAPContact_t {
 /**
  * BTPBAPParserState_t
  *     Description:
- *         PBAP Parser State Machine
+ *         PBAP vCard parser state machine. The vCard data is fed in a byte at
+ *         a time and decoded straight into the contact being parsed.
  *     Fields:
  *         subEvent - Sub-event code for fragmented packets
  *         inVCard - Currently parsing a vCard
- *         isDelim - Previous char was CR (for CRLF handling)
  *         isEndOfBody - At the END:VCARD of the vCard
- *         bufferIdx - Current line buffer length
- *         buffer - Buffer for incomplete line
+ *         state - BT_PBAP_PARSER_STATE_* of the current property line
+ *         lineState - The state the line was in when its LF was received,
+ *             which a folded continuation line resumes from
+ *         quotedPrintable - The value is quoted-printable encoded
+ *         qpIdx - Position within a quoted-printable "=XX" escape
+ *         escapeIdx - Position within a BC127 "\XX" escape
+ *         nameSeparator - A space is due ahead of the next name character
+ *         property - BT_PBAP_PROPERTY_* of the current property
+ *         telType - BT_PBAP_TEL_TYPE_* given by the TEL parameters
+ *         component - The ";" separated component of the N value
+ *         qpHigh - The high nibble of a quoted-printable escape
+ *         escapeHigh - The first hex character of a BC127 escape
+ *         tokenIdx - Current token length
+ *         nameLength - Current contact name length
+ *         nameInsert - Where the next name character is inserted
+ *         digitCount - The number of BCD digits in the current number
+ *         utf8Idx - The number of bytes collected of a UTF-8 character
+ *         utf8Length - The length of the UTF-8 character being collected
+ *         utf8 - The UTF-8 character being collected
+ *         token - The property name, parameter or BEGIN / END value
  */
 typedef struct BTPBAPParserState_t {
     uint8_t subEvent;
     uint8_t inVCard: 1;
-    uint8_t isDelim: 3;
     uint8_t isEndOfBody: 1;
-    uint8_t bufferIdx;
-    char buffer[BT_PBAP_LINE_BUFFER_SIZE];
-
+    uint8_t state: 2;
+    uint8_t lineState: 2;
+    uint8_t quotedPrintable: 1;
+    uint8_t qpIdx: 2;
+    uint8_t escapeIdx: 2;
+    uint8_t nameSeparator: 1;
+    uint8_t property: 3;
+    uint8_t telType: 2;
+    uint8_t component: 3;
+    uint8_t qpHigh;
+    char escapeHigh;
+    uint8_t tokenIdx;
+    uint8_t nameLength;
+    uint8_t nameInsert;
+    uint8_t digitCount;
+    uint8_t utf8Idx;
+    uint8_t utf8Length;
+    char utf8[5];
+    char token[BT_PBAP_PARSER_TOKEN_SIZE];
 } BTPBAPParserState_t;
 
+/**
+ * BTPBAPCache_t
+ *     Description:
+ *         The phonebook of the active device, kept in EEPROM so that the
+ *         contact menus can page through it without a PBAP pull. The EEPROM
+ *         region at CONFIG_BT_PBAP_CACHE_EEPROM_BASE is laid out as:
+ *             0x00 - Header: version, device MAC ID, contact count, flags
+ *             BT_PBAP_CACHE_INDEX_OFFSET - Record numbers sorted by name
+ *             BT_PBAP_CACHE_RECORD_OFFSET - One page aligned record per contact
+ *         The store belongs to one device at a time, so a different device
+ *         connecting invalidates it.
+ *     Fields:
+ *         status - BT_PBAP_CACHE_STATUS_INVALID, STALE (loaded from EEPROM
+ *             but not yet synced on this connection), SYNCING or CURRENT
+ *         loaded - If the header was read for the device in macId
+ *         truncated - The phonebook holds more than BT_PBAP_CACHE_MAX_CONTACTS
+ *             contacts, so the cache only has the first of them and can not
+ *             stand in for the directory or search it
+ *         count - The number of contacts in the committed index
+ *         syncCount - The number of records written by the running sync
+ *         syncOffset - The phonebook offset of the page being synced
+ *         macId - The MAC ID of the device that the cache belongs to
+ *         index - The committed record numbers, sorted by name
+ *         syncIndex - The sorted record numbers of the running sync, which
+ *             replace the index once the whole phonebook has been pulled
+ *         t9Keys - The T9 digits of the first BT_PBAP_CACHE_T9_DIGITS letters
+ *             of each record's name, one nibble per digit from the most
+ *             significant one and padded with BT_PBAP_CACHE_T9_NONE
+ *         contact - The contact that the vCard parser fills during a sync
+ */
+typedef struct BTPBAPCache_t {
+    uint8_t status: 2;
+    uint8_t loaded: 1;
+    uint8_t truncated: 1;
+    uint8_t count;
+    uint8_t syncCount;
+    uint16_t syncOffset;
+    uint8_t macId[BT_DEVICE_MAC_ID_LEN];
+    uint8_t index[BT_PBAP_CACHE_MAX_CONTACTS];
+    uint8_t syncIndex[BT_PBAP_CACHE_MAX_CONTACTS];
+    uint16_t t9Keys[BT_PBAP_CACHE_MAX_CONTACTS];
+    BTPBAPContact_t contact;
+} BTPBAPCache_t;
+
+/**
+ * BTPBAPPage_t
+ *     Description:
+ *         A page of contacts pulled ahead of the UI asking for it, so that
+ *         turning to it does not wait on a PBAP round-trip
+ *     Fields:
+ *         phonebook - The BT_PBAP_OBJ_* that the page belongs to
+ *         status - BT_PBAP_PAGE_STATUS_EMPTY, WANTED, PULLING or READY
+ *         show - The UI is waiting on the page, so it replaces the contacts
+ *             buffer as soon as it is in
+ *         count - The number of contacts in the page
+ *         offset - The position of the first contact of the page
+ *         contacts - The contacts of the page
+ */
+typedef struct BTPBAPPage_t {
+    uint8_t phonebook;
+    uint8_t status: 2;
+    uint8_t show: 1;
+    uint8_t count;
+    uint16_t offset;
+    BTPBAPContact_t contacts[BT_PBAP_MAX_CONTACTS];
+} BTPBAPPage_t;
+
 /**
  * BTPBAP_t
  *     Description:
@@ -188,17 +342,42 @@ typedef struct BTPBAPParserState_t {
  *     Fields:
  *         active - Is a PBAP session active
  *         status - BT_PBAP_STATUS_IDLE, BT_PBAP_STATUS_WAITING
+ *         requestSync - The running pull belongs to the cache sync, so its
+ *             contacts go to the cache rather than the contacts buffer
+ *         requestPrefetch - The running pull fills the prefetch page at
+ *             prefetchIdx rather than the contacts buffer
+ *         pageValid - The contacts buffer holds the page at pageOffset of
+ *             pagePhonebook
+ *         requestQueued - A pull for the contacts buffer is waiting on the
+ *             background pull that is running to finish
+ *         pagePhonebook - The BT_PBAP_OBJ_* of the page in the contacts buffer
+ *         pageOffset - The position of the first contact in the buffer
+ *         queuedPhonebook, queuedOffset, queuedMaxList - The queued pull
+ *         prefetchIdx - The prefetch page that the running pull fills
  *         contactCount - Number of contacts in buffer
  *         contactIdx - The index of the contact we are currently copying
  *         contacts - Buffer for contact entries
+ *         parser - The vCard parser state
+ *         cache - The persistent phonebook cache
  */
 typedef struct BTPBAP_t {
     uint8_t active: 1;
     uint8_t status: 2;
+    uint8_t requestSync: 1;
+    uint8_t requestPrefetch: 1;
+    uint8_t pageValid: 1;
+    uint8_t requestQueued: 1;
+    uint8_t pagePhonebook;
+    uint16_t pageOffset;
+    uint8_t queuedPhonebook;
+    uint8_t queuedMaxList;
+    uint16_t queuedOffset;
+    uint8_t prefetchIdx;
     uint8_t contactCount;
     uint8_t contactIdx;
     BTPBAPContact_t contacts[BT_PBAP_MAX_CONTACTS];
     BTPBAPParserState_t parser;
+    BTPBAPCache_t cache;
 } BTPBAP_t;
 
 /**
@@ -278,6 +457,10 @@ typedef struct BTConnection_t {
  *         discoverable - The current discoverable state (0 = Off, 1 = On)
  *         avrcpStatus - The required AVRCP updates
  *         metadataStatus - Tracks if the metadata is new, so we can publish it
+ *         metadataDirty - The BT_METADATA_FIELD_* bits of the fields that
+ *             were written since the metadata was last published
+ *         metadataDisplayValid - The line that BTMetadataGetDisplayText()
+ *             returns matches the published fields
  *         playbackStatus - If we're paused or playing
  *         vrStatus- If Voice Recognition is on or off
  *         callStatus - The call status
@@ -293,8 +476,13 @@ typedef struct BTConnection_t {
  *             in error. This is used to track what profiles we need to re-attempt
  *             a connection with.
  *         metadataTimestamp - The last time we got metadata of any kind
- *         rxQueueAge - Used to track how long data has been sitting on the
- *             RX queue without getting a MSG_END_CHAR.
+ *         metadataOffset - The position of the title, artist and album
+ *             entries within the metadata arena
+ *         metadata - The metadata arena. The title, artist and album are
+ *             stored back to back, each as a length byte followed by the
+ *             null terminated text. Use BTMetadataGet() to read it.
+ *         rxQueueAge - Used to track how long a partially received line
+ *             has been waiting on its MSG_END_CHAR.
  *         lastConnection - The last time a connection was initiated. This
  *             allows us to add some backpressure to connection attempts
  */
@@ -307,6 +495,8 @@ typedef struct BT_t {
     uint8_t discoverable: 1;
     uint8_t avrcpUpdates: 2;
     uint8_t metadataStatus: 1;
+    uint8_t metadataDirty: 3;
+    uint8_t metadataDisplayValid: 1;
     uint8_t playbackStatus: 1;
     uint8_t vrStatus: 1;
     uint8_t callStatus: 3;
@@ -319,25 +509,55 @@ typedef struct BT_t {
     uint32_t lastConnection;
     uint32_t metadataTimestamp;
     uint32_t rxQueueAge;
-    char title[BT_METADATA_FIELD_SIZE];
-    char artist[BT_METADATA_FIELD_SIZE];
-    char album[BT_METADATA_FIELD_SIZE];
+    uint16_t metadataOffset[BT_METADATA_FIELD_COUNT];
+    char metadata[BT_METADATA_ARENA_SIZE];
     char callerId[BT_CALLER_ID_FIELD_SIZE];
     char dialBuffer[BT_DIAL_BUFFER_FIELD_SIZE];
     BTPBAP_t pbap;
     UART_t uart;
 } BT_t;
 
+extern uint8_t BTRxBuffer[];
+
+void BTCallerIdSet(BT_t *, const char *);
 void BTClearActiveDevice(BT_t *);
 void BTClearMetadata(BT_t *);
 void BTClearPairedDevices(BT_t *);
 BTConnection_t BTConnectionInit();
+char *BTMetadataGet(BT_t *, uint8_t);
+uint8_t BTMetadataFieldEquals(BT_t *, uint8_t, const char *);
+char *BTMetadataGetDisplayText(BT_t *);
+uint8_t BTMetadataGetLength(BT_t *, uint8_t);
+uint8_t BTMetadataPublish(BT_t *);
+uint8_t BTMetadataSetField(BT_t *, uint8_t, const char *);
+uint8_t BTMetadataSetTrack(BT_t *, const char *, const char *, const char *);
 void BTPairedDeviceClearRecords(void);
 uint8_t BTPairedDeviceFind(BT_t *, uint8_t *);
 void BTPairedDeviceInit(BT_t *, uint8_t *, uint8_t);
 void BTPairedDeviceLoadRecord(BTPairedDevice_t *, uint8_t);
 void BTPairedDeviceSave(uint8_t *, char *, uint8_t);
-void BTPBAPParseVCard(BT_t *);
+uint8_t BTPBAPCacheFindNumber(BT_t *, const char *, char *);
+uint8_t BTPBAPCacheGetContact(BT_t *, uint8_t, BTPBAPContact_t *);
+uint8_t BTPBAPCacheGetCount(BT_t *);
+uint8_t BTPBAPCacheHasPhonebook(BT_t *);
+uint8_t BTPBAPCacheLoad(BT_t *);
+uint8_t BTPBAPCacheLoadPage(BT_t *, uint16_t);
+uint8_t BTPBAPCacheLoadSearchPage(BT_t *, const char *, uint16_t);
+uint8_t BTPBAPCacheSearchName(BT_t *, const char *);
+uint8_t BTPBAPCacheSearchT9(BT_t *, const char *, uint8_t);
+void BTPBAPCacheStoreContact(BT_t *);
+uint16_t BTPBAPCacheSyncNextPage(BT_t *);
+void BTPBAPCacheSyncPageComplete(BT_t *);
+void BTPBAPCacheSyncStart(BT_t *);
+void BTPBAPPrefetchClear(BT_t *);
+void BTPBAPPrefetchClearHistory(BT_t *);
+BTPBAPPage_t *BTPBAPPrefetchGetPage(BT_t *);
+uint8_t BTPBAPPrefetchLoadPage(BT_t *, uint8_t, uint16_t);
+uint8_t BTPBAPPrefetchNextPage(BT_t *);
+void BTPBAPPrefetchSchedule(BT_t *, uint8_t, uint16_t);
+void BTPBAPParseByte(BT_t *, uint8_t);
+void BTPBAPParseFlush(BT_t *);
+void BTPBAPPullComplete(BT_t *);
 void BTPBAPTelephoneFromBCD(const uint8_t *, char *, uint8_t);
 uint8_t BTPBAPTelephoneToBCD(const char *, uint8_t *);
 #endif /* BT_COMMON_H */
@@ -6,7 +6,8 @@
  */
 #include "config.h"
 #include "eeprom.h"
-#include <stdio.h>
+#include "locale.h"
+#include "utils.h"
 
 uint8_t CONFIG_SETTING_CACHE[CONFIG_SETTING_CACHE_SIZE] = {0};
 uint8_t CONFIG_VALUE_CACHE[CONFIG_VALUE_CACHE_SIZE] = {0};
@@ -46,6 +47,66 @@ static int8_t CONFIG_TIMEZONE_OFFSETS[CONFIG_TIMEZONE_COUNT] = {
     +1 * (12 * 60 + 0) / 15, // +12:00
 };
 
+static const uint8_t CONFIG_VALUES_OFF_ON_LIST[] = {
+    CONFIG_SETTING_OFF,
+    CONFIG_SETTING_ON
+};
+
+static const uint8_t CONFIG_VALUES_COMFORT_LOCK_LIST[] = {
+    CONFIG_SETTING_OFF,
+    CONFIG_SETTING_COMFORT_LOCK_10KM,
+    CONFIG_SETTING_COMFORT_LOCK_20KM
+};
+
+static const uint8_t CONFIG_VALUES_COMFORT_UNLOCK_LIST[] = {
+    CONFIG_SETTING_OFF,
+    CONFIG_SETTING_COMFORT_UNLOCK_POS_1,
+    CONFIG_SETTING_COMFORT_UNLOCK_POS_0
+};
+
+static const uint8_t CONFIG_VALUES_DSP_INPUT_LIST[] = {
+    CONFIG_SETTING_OFF,
+    CONFIG_SETTING_DSP_INPUT_SPDIF,
+    CONFIG_SETTING_DSP_INPUT_ANALOG
+};
+
+static const uint8_t CONFIG_VALUES_PDC_LIST[] = {
+    CONFIG_SETTING_OFF,
+    CONFIG_SETTING_PDC_CLUSTER,
+    CONFIG_SETTING_PDC_RADIO,
+    CONFIG_SETTING_PDC_BOTH
+};
+
+static const uint8_t CONFIG_VALUES_TEL_MODE_LIST[] = {
+    CONFIG_SETTING_TEL_MODE_DEFAULT,
+    CONFIG_SETTING_TEL_MODE_TCU,
+    CONFIG_SETTING_TEL_MODE_NO_MUTE,
+    CONFIG_SETTING_TEL_MODE_ANALOG
+};
+
+const ConfigValueSet_t CONFIG_VALUES_OFF_ON = {
+    sizeof(CONFIG_VALUES_OFF_ON_LIST), 0, 0, 0, CONFIG_VALUES_OFF_ON_LIST
+};
+const ConfigValueSet_t CONFIG_VALUES_COMFORT_BLINKERS = {0, 1, 8, 1, 0};
+const ConfigValueSet_t CONFIG_VALUES_COMFORT_LOCK = {
+    sizeof(CONFIG_VALUES_COMFORT_LOCK_LIST), 0, 0, 0, CONFIG_VALUES_COMFORT_LOCK_LIST
+};
+const ConfigValueSet_t CONFIG_VALUES_COMFORT_UNLOCK = {
+    sizeof(CONFIG_VALUES_COMFORT_UNLOCK_LIST), 0, 0, 0, CONFIG_VALUES_COMFORT_UNLOCK_LIST
+};
+const ConfigValueSet_t CONFIG_VALUES_DSP_INPUT = {
+    sizeof(CONFIG_VALUES_DSP_INPUT_LIST), 0, 0, 0, CONFIG_VALUES_DSP_INPUT_LIST
+};
+const ConfigValueSet_t CONFIG_VALUES_PDC = {
+    sizeof(CONFIG_VALUES_PDC_LIST), 0, 0, 0, CONFIG_VALUES_PDC_LIST
+};
+const ConfigValueSet_t CONFIG_VALUES_TEL_MODE = {
+    sizeof(CONFIG_VALUES_TEL_MODE_LIST), 0, 0, 0, CONFIG_VALUES_TEL_MODE_LIST
+};
+const ConfigValueSet_t CONFIG_VALUES_TEL_VOL = {
+    0, 0, CONFIG_SETTING_TEL_VOL_OFFSET_MAX, 1, 0
+};
+
 /**
  * ConfigGetByte()
  *     Description:
@@ -87,6 +148,9 @@ void ConfigSetByte(uint8_t address, uint8_t value)
         CONFIG_SETTING_CACHE[address] = value;
     }
     EEPROMWriteByte(address, value);
+    if (address == CONFIG_SETTING_LANGUAGE) {
+        LocaleSetLanguage(value);
+    }
 }
 
 /**
@@ -280,7 +344,7 @@ uint8_t ConfigGetFirmwareVersionPatch()
  */
 void ConfigGetFirmwareVersionString(char *version)
 {
-    snprintf(
+    UtilsFormat(
         version,
         9,
         "%d.%d.%d",
@@ -1083,3 +1147,85 @@ void ConfigSetVehicleIdentity(uint8_t *vin)
         ConfigSetByte(vinAddress[i], vin[i]);
     }
 }
+
+/**
+ * ConfigValueSetGetIndex()
+ *     Description:
+ *         Find the position of a value in the list of a value set. Values
+ *         that are not in the list are treated as the first entry.
+ *     Params:
+ *         const ConfigValueSet_t *set - The value set
+ *         uint8_t value - The value to look up
+ *     Returns:
+ *         uint8_t - The position of the value
+ */
+uint8_t ConfigValueSetGetIndex(const ConfigValueSet_t *set, uint8_t value)
+{
+    uint8_t idx;
+    for (idx = 0; idx < set->count; idx++) {
+        if (set->values[idx] == value) {
+            return idx;
+        }
+    }
+    return 0;
+}
+
+/**
+ * ConfigValueSetGetNext()
+ *     Description:
+ *         Get the value that follows the given one, wrapping around at
+ *         either end of the set
+ *     Params:
+ *         const ConfigValueSet_t *set - The value set
+ *         uint8_t value - The current value
+ *         uint8_t reverse - Non-zero to step backwards
+ *     Returns:
+ *         uint8_t - The next value
+ */
+uint8_t ConfigValueSetGetNext(
+    const ConfigValueSet_t *set,
+    uint8_t value,
+    uint8_t reverse
+) {
+    value = ConfigValueSetGetValid(set, value);
+    if (set->count > 0) {
+        uint8_t idx = ConfigValueSetGetIndex(set, value);
+        if (reverse != 0) {
+            idx = (idx == 0) ? set->count - 1 : idx - 1;
+        } else {
+            idx = (idx + 1 == set->count) ? 0 : idx + 1;
+        }
+        return set->values[idx];
+    }
+    if (reverse != 0) {
+        if (value < (uint16_t) set->min + set->step) {
+            return set->max;
+        }
+        return value - set->step;
+    }
+    if ((uint16_t) value + set->step > set->max) {
+        return set->min;
+    }
+    return value + set->step;
+}
+
+/**
+ * ConfigValueSetGetValid()
+ *     Description:
+ *         Replace a value that the set cannot hold with the first value of it
+ *     Params:
+ *         const ConfigValueSet_t *set - The value set
+ *         uint8_t value - The value to check
+ *     Returns:
+ *         uint8_t - The value, or the first value of the set
+ */
+uint8_t ConfigValueSetGetValid(const ConfigValueSet_t *set, uint8_t value)
+{
+    if (set->count > 0) {
+        return set->values[ConfigValueSetGetIndex(set, value)];
+    }
+    if (value < set->min || value > set->max) {
+        return set->min;
+    }
+    return value;
+}
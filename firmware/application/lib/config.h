@@ -82,6 +82,8 @@
 
 /* EEPROM 0x100 - 0x237: Bluetooth Paired Devices Storage */
 #define CONFIG_BT_DEVICE_EEPROM_BASE 0x100
+/* EEPROM 0x400 - 0x34FF: PBAP Phonebook Cache (fits the 16kB HW2 part) */
+#define CONFIG_BT_PBAP_CACHE_EEPROM_BASE 0x400
 
 #define CONFIG_DEVICE_LOG_BT 2
 #define CONFIG_DEVICE_LOG_IBUS 3
@@ -214,6 +216,30 @@
 #define CONFIG_SETTING_CACHE_SIZE CONFIG_SETTING_END_ADDRESS
 #define CONFIG_VALUE_CACHE_SIZE (CONFIG_VALUE_END_ADDRESS - CONFIG_VALUE_START_ADDRESS + 1)
 
+/*
+ * ConfigValueSet_t
+ *  This is a struct to describe the values that a setting can hold
+ *  count: The number of entries in values, or 0 when the setting is a range
+ *  min, max, step: The range when there is no values list
+ *  values: The values, in the order that they are offered to the user
+ */
+typedef struct ConfigValueSet_t {
+    uint8_t count;
+    uint8_t min;
+    uint8_t max;
+    uint8_t step;
+    const uint8_t *values;
+} ConfigValueSet_t;
+
+extern const ConfigValueSet_t CONFIG_VALUES_OFF_ON;
+extern const ConfigValueSet_t CONFIG_VALUES_COMFORT_BLINKERS;
+extern const ConfigValueSet_t CONFIG_VALUES_COMFORT_LOCK;
+extern const ConfigValueSet_t CONFIG_VALUES_COMFORT_UNLOCK;
+extern const ConfigValueSet_t CONFIG_VALUES_DSP_INPUT;
+extern const ConfigValueSet_t CONFIG_VALUES_PDC;
+extern const ConfigValueSet_t CONFIG_VALUES_TEL_MODE;
+extern const ConfigValueSet_t CONFIG_VALUES_TEL_VOL;
+
 uint16_t ConfigGetBC127BootFailures();
 uint8_t ConfigGetBuildWeek();
 uint8_t ConfigGetBuildYear();
@@ -273,4 +299,7 @@ void ConfigSetUIMode(uint8_t);
 void ConfigSetValue(uint8_t, uint8_t);
 void ConfigSetVehicleType(uint8_t);
 void ConfigSetVehicleIdentity(uint8_t *);
+uint8_t ConfigValueSetGetIndex(const ConfigValueSet_t *, uint8_t);
+uint8_t ConfigValueSetGetNext(const ConfigValueSet_t *, uint8_t, uint8_t);
+uint8_t ConfigValueSetGetValid(const ConfigValueSet_t *, uint8_t);
 #endif /* CONFIG_H */
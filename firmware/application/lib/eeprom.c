@@ -151,6 +151,36 @@ unsigned char EEPROMReadByte(uint32_t address)
     return data;
 }
 
+/**
+ * EEPROMReadBytes()
+ *     Description:
+ *         Read a run of bytes starting at the given address. The EEPROM
+ *         advances its address pointer on its own, so the whole run is read
+ *         with a single read sequence.
+ *     Params:
+ *         uint32_t address - The memory address of the first byte
+ *         uint8_t *data - The buffer to read the bytes into
+ *         uint16_t length - The number of bytes to read
+ *     Returns:
+ *         void
+ */
+void EEPROMReadBytes(uint32_t address, uint8_t *data, uint16_t length)
+{
+    EEPROMIsReady();
+    EEPROM_CS_PIN = 0;
+    EEPROMSend(EEPROM_COMMAND_READ);
+    if (UtilsGetBoardVersion() == BOARD_VERSION_ONE) {
+        EEPROMSend(address >> 16 & 0xFF);
+    }
+    EEPROMSend(address >> 8 & 0xFF);
+    EEPROMSend(address & 0xFF);
+    uint16_t i;
+    for (i = 0; i < length; i++) {
+        data[i] = (uint8_t) EEPROMSend(EEPROM_COMMAND_GET);
+    }
+    EEPROM_CS_PIN = 1;
+}
+
 /**
  * EEPROMWriteByte()
  *     Description:
@@ -177,3 +207,34 @@ void EEPROMWriteByte(uint32_t address, unsigned char data)
     EEPROMSend(data);
     EEPROM_CS_PIN = 1;
 }
+
+/**
+ * EEPROMWriteBytes()
+ *     Description:
+ *         Write a run of bytes with a single page write, so that it costs one
+ *         write cycle instead of one per byte. The run must not cross an
+ *         EEPROM_PAGE_SIZE boundary, or the part wraps around to the start
+ *         of the page.
+ *     Params:
+ *         uint32_t address - The memory address of the first byte
+ *         const uint8_t *data - The bytes to write
+ *         uint8_t length - The number of bytes to write
+ *     Returns:
+ *         void
+ */
+void EEPROMWriteBytes(uint32_t address, const uint8_t *data, uint8_t length)
+{
+    EEPROMEnableWrite();
+    EEPROM_CS_PIN = 0;
+    EEPROMSend(EEPROM_COMMAND_WRITE);
+    if (UtilsGetBoardVersion() == BOARD_VERSION_ONE) {
+        EEPROMSend(address >> 16 & 0xFF);
+    }
+    EEPROMSend(address >> 8 & 0xFF);
+    EEPROMSend(address & 0xFF);
+    uint8_t i;
+    for (i = 0; i < length; i++) {
+        EEPROMSend(data[i]);
+    }
+    EEPROM_CS_PIN = 1;
+}
@@ -19,10 +19,14 @@
 #define EEPROM_COMMAND_RDSR 0x05 // Read the status register
 #define EEPROM_COMMAND_GET 0x00 // Dummy byte used to retrieve data
 #define EEPROM_STATUS_BUSY 0x01 // EEPROM Busy status response
+// The smallest write page of the fitted parts. A page write may not cross it
+#define EEPROM_PAGE_SIZE 64
 
 void EEPROMInit();
 void EEPROMErase();
 void EEPROMIsReady();
 unsigned char EEPROMReadByte(uint32_t);
+void EEPROMReadBytes(uint32_t, uint8_t *, uint16_t);
 void EEPROMWriteByte(uint32_t, unsigned char);
+void EEPROMWriteBytes(uint32_t, const uint8_t *, uint8_t);
 #endif /* EEPROM_H */
@@ -6,8 +6,6 @@
  */
 #include "ibus.h"
 #include <ctype.h>
-#include <math.h>
-#include <stdio.h>
 #include <string.h>
 #include "../mappings.h"
 #include "char_queue.h"
@@ -64,6 +62,10 @@ IBus_t IBusInit()
     ibus.ambientTemperature = IBUS_TEMP_UNSET;
     ibus.coolantTemperature = 0;
     ibus.txLastStamp = 0;
+    ibus.txPriority = IBUS_MSG_PRIORITY_INTERACTIVE;
+    ibus.txCaptureBuffer = 0;
+    ibus.txCaptureSize = 0;
+    ibus.txCaptureLength = 0;
     memset(ibus.ambientTemperatureCalculated, 0, 7);
     memset(ibus.telematicsLocale, 0, sizeof(ibus.telematicsLocale));
     memset(ibus.telematicsStreet, 0, sizeof(ibus.telematicsStreet));
@@ -575,12 +577,23 @@ static void IBusHandleLCMMessage(IBus_t *ibus, uint8_t *pkt)
             pkt[23] != 0x00
         ) {
             // Oil Temp calculation
-            uint16_t offset = 310;
+            int32_t offset = IBUS_LM_OIL_TEMP_OFFSET_DEFAULT;
             if (ibus->lmVariant == IBUS_LM_LCM_IV) {
-                offset = 510;
+                offset = IBUS_LM_OIL_TEMP_OFFSET_LCM_IV;
             }
-            float rawTemperature = (pkt[23] * 0.00005) + (pkt[24] * 0.01275);
-            uint8_t oilTemperature = 67.2529 * log(rawTemperature) + offset;
+            // The raw value is (pkt[23] + pkt[24] * 255) * 0.00005
+            uint16_t rawTemperature = pkt[23] + (uint16_t) pkt[24] * 255;
+            int32_t oilTemperatureScaled = (int32_t) (
+                ((uint32_t) UtilsLog2(rawTemperature) * IBUS_LM_OIL_TEMP_LOG2_SCALE) >>
+                UTILS_LOG2_FRACTION_BITS
+            );
+            oilTemperatureScaled += (offset << 8) - IBUS_LM_OIL_TEMP_RAW_SCALE;
+            if (oilTemperatureScaled < 0) {
+                oilTemperatureScaled = 0;
+            } else if (oilTemperatureScaled > 0xFFFF) {
+                oilTemperatureScaled = 0xFFFF;
+            }
+            uint8_t oilTemperature = (uint8_t) (oilTemperatureScaled >> 8);
             if (oilTemperature != ibus->oilTemperature) {
                 ibus->oilTemperature = oilTemperature;
                 uint8_t valueType = IBUS_SENSOR_VALUE_OIL_TEMP;
@@ -857,7 +870,7 @@ static void IBusHandleTELMessage(IBus_t *ibus, uint8_t *pkt)
         EventTriggerCallback(IBUS_EVENT_TEL_VOLUME_CHANGE, pkt);
     } else if (pkt[IBUS_PKT_CMD] == IBUS_CMD_GT_TELEMATICS_COORDINATES) {
         // Store latitude and longitude for emergency display
-        snprintf(
+        UtilsFormat(
             ibus->telematicsLatitude,
             IBUS_TELEMATICS_COORDS_LEN,
             "%i\xB0%02X'%02X.%01X\" %c",
@@ -867,7 +880,7 @@ static void IBusHandleTELMessage(IBus_t *ibus, uint8_t *pkt)
             pkt[IBUS_PKT_DB6] >> 4,
             ((pkt[IBUS_PKT_DB6] & 0x01) == 0) ? 'N' : 'S'
         );
-        snprintf(
+        UtilsFormat(
             ibus->telematicsLongtitude,
             IBUS_TELEMATICS_COORDS_LEN,
             "%i\xB0%02X'%02X.%01X\" %c",
@@ -949,6 +962,33 @@ static uint8_t IBusValidateChecksum(uint8_t *msg)
     }
 }
 
+/**
+ * IBusUpdateTXLatency()
+ *     Description:
+ *         Account the time that the frame in the given slot spent queued
+ *         against the statistics of its priority class. A retransmitted
+ *         frame was already accounted when it first went out.
+ *     Params:
+ *         IBus_t *ibus
+ *         uint8_t idx - The transmit buffer slot that was just sent
+ *     Returns:
+ *         void
+ */
+static void IBusUpdateTXLatency(IBus_t *ibus, uint8_t idx)
+{
+    if (ibus->txBufferSent[idx] != 0) {
+        return;
+    }
+    ibus->txBufferSent[idx] = 1;
+    uint8_t priority = ibus->txBufferPriority[idx];
+    uint16_t latency = (uint16_t) TimerGetMillis() - ibus->txBufferStamp[idx];
+    if (latency > ibus->txLatencyMax[priority]) {
+        ibus->txLatencyMax[priority] = latency;
+    }
+    int32_t delta = (int32_t) latency - ibus->txLatencyAvg[priority];
+    ibus->txLatencyAvg[priority] += delta / (1 << IBUS_TX_LATENCY_AVG_SHIFT);
+}
+
 /**
  * IBusProcess()
  *     Description:
@@ -1121,6 +1161,7 @@ void IBusProcess(IBus_t *ibus)
                     if (txTimeout != IBUS_TX_TIMEOUT_ON) {
                         ibus->txLastStamp = TimerGetMillis();
                         txTimeout = IBUS_TX_TIMEOUT_DATA_SENT;
+                        IBusUpdateTXLatency(ibus, ibus->txBufferReadIdx);
                         if (ibus->txBufferReadIdx + 1 == IBUS_TX_BUFFER_SIZE) {
                             ibus->txBufferReadIdx = 0;
                         } else {
@@ -1172,30 +1213,213 @@ void IBusProcess(IBus_t *ibus)
             LogRaw("IBus: ERR_RTX[%d]\r\n", ibus->txRetries);
             ibus->txBufferReadIdx = ibus->txBufferReadbackIdx;
         } else {
-            ibus->txBufferReadbackIdx = ibus->txBufferReadIdx;
+            // Give up on the frames that never came back
+            while (ibus->txBufferReadbackIdx != ibus->txBufferReadIdx) {
+                EventTriggerCallback(
+                    IBUS_EVENT_TX_FRAME_DROPPED,
+                    ibus->txBuffer[ibus->txBufferReadbackIdx]
+                );
+                if (ibus->txBufferReadbackIdx + 1 == IBUS_TX_BUFFER_SIZE) {
+                    ibus->txBufferReadbackIdx = 0;
+                } else {
+                    ibus->txBufferReadbackIdx++;
+                }
+            }
             ibus->txRetries = 0;
         }
     }
     UARTReportErrors(&ibus->uart);
 }
 
+/**
+ * IBusGetTXBufferUsed()
+ *     Description:
+ *         Get the number of frames waiting in the transmit ring buffer
+ *     Params:
+ *         IBus_t *ibus
+ *     Returns:
+ *         uint8_t - The number of used slots
+ */
+uint8_t IBusGetTXBufferUsed(IBus_t *ibus)
+{
+    if (ibus->txBufferWriteIdx >= ibus->txBufferReadIdx) {
+        return ibus->txBufferWriteIdx - ibus->txBufferReadIdx;
+    }
+    return (IBUS_TX_BUFFER_SIZE - ibus->txBufferReadIdx) + ibus->txBufferWriteIdx;
+}
+
+/**
+ * IBusGetTXLatency()
+ *     Description:
+ *         Get the moving average of the time that frames of the given class
+ *         waited in the transmit buffer. The worst case seen is kept in
+ *         txLatencyMax.
+ *     Params:
+ *         IBus_t *ibus
+ *         uint8_t priority - One of the IBUS_MSG_PRIORITY_* classes
+ *     Returns:
+ *         uint16_t - The average latency in milliseconds
+ */
+uint16_t IBusGetTXLatency(IBus_t *ibus, uint8_t priority)
+{
+    if (priority >= IBUS_MSG_PRIORITY_COUNT) {
+        return 0;
+    }
+    return ibus->txLatencyAvg[priority];
+}
+
+/**
+ * IBusTXBufferHasSpace()
+ *     Description:
+ *         Check if the given number of frames can be queued while leaving
+ *         IBUS_TX_BUFFER_RESERVED slots free. Display writes call this first
+ *         and try again later if it fails, so that they never crowd out the
+ *         replies the radio and phone expect from us.
+ *     Params:
+ *         IBus_t *ibus
+ *         uint8_t frames - The number of frames the caller wants to queue
+ *     Returns:
+ *         uint8_t - 1 if the frames fit, 0 otherwise
+ */
+uint8_t IBusTXBufferHasSpace(IBus_t *ibus, uint8_t frames)
+{
+    uint8_t freeSlots = (IBUS_TX_BUFFER_SIZE - 1) - IBusGetTXBufferUsed(ibus);
+    if (freeSlots < IBUS_TX_BUFFER_RESERVED) {
+        return 0;
+    }
+    if (frames > freeSlots - IBUS_TX_BUFFER_RESERVED) {
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * IBusGetTXBufferPriority()
+ *     Description:
+ *         Get the class that a queued frame currently competes in. Frames
+ *         move up one class for every IBUS_TX_AGING_TIME that they wait, so
+ *         a steady stream of interactive frames cannot starve the background
+ *         ones. Aging stops short of the critical class because the radio
+ *         drops the CD changer if its replies are late.
+ *     Params:
+ *         IBus_t *ibus
+ *         uint8_t idx - The transmit buffer slot
+ *         uint16_t now - The current time in milliseconds
+ *     Returns:
+ *         uint8_t - The effective priority class
+ */
+static uint8_t IBusGetTXBufferPriority(IBus_t *ibus, uint8_t idx, uint16_t now)
+{
+    uint8_t priority = ibus->txBufferPriority[idx];
+    if (priority <= IBUS_MSG_PRIORITY_INTERACTIVE) {
+        return priority;
+    }
+    uint16_t steps = (uint16_t) (now - ibus->txBufferStamp[idx]) / IBUS_TX_AGING_TIME;
+    if (steps >= priority - IBUS_MSG_PRIORITY_INTERACTIVE) {
+        return IBUS_MSG_PRIORITY_INTERACTIVE;
+    }
+    return priority - steps;
+}
+
+/**
+ * IBusQueueFrame()
+ *     Description:
+ *         Place a fully built frame in the transmit buffer. The frame is
+ *         queued behind every waiting frame that is at least as urgent, once
+ *         aging is accounted for, and ahead of the rest. If the buffer is
+ *         full, the newest background frame makes way for a more urgent one.
+ *         Frames that are lost that way fire IBUS_EVENT_TX_FRAME_DROPPED.
+ *     Params:
+ *         IBus_t *ibus
+ *         const uint8_t *msg - The frame, including length and checksum
+ *         const uint8_t msgSize - The size of the frame
+ *         const uint8_t priority - One of the IBUS_MSG_PRIORITY_* classes
+ *     Returns:
+ *         uint8_t - 1 if the frame was queued, 0 if it was refused
+ */
+static uint8_t IBusQueueFrame(
+    IBus_t *ibus,
+    const uint8_t *msg,
+    const uint8_t msgSize,
+    const uint8_t priority
+) {
+    uint8_t lastIdx = IBUS_TX_BUFFER_SIZE - 1;
+    if (ibus->txBufferWriteIdx != 0) {
+        lastIdx = ibus->txBufferWriteIdx - 1;
+    }
+    // Check if buffer is full (one slot must remain empty to distinguish full from empty)
+    if (IBusGetTXBufferUsed(ibus) >= IBUS_TX_BUFFER_SIZE - 1) {
+        if (
+            priority == IBUS_MSG_PRIORITY_BACKGROUND ||
+            ibus->txBufferPriority[lastIdx] != IBUS_MSG_PRIORITY_BACKGROUND
+        ) {
+            long long unsigned int ts = (long long unsigned int) TimerGetMillis();
+            LogRaw("[%llu] ERROR: IBus: TX Buffer Overflow.\r\n", ts);
+            return 0;
+        }
+        // Give up the newest background frame to make room
+        EventTriggerCallback(IBUS_EVENT_TX_FRAME_DROPPED, ibus->txBuffer[lastIdx]);
+        ibus->txBufferWriteIdx = lastIdx;
+        LogRaw("IBus: TX Buffer Full, dropped background frame\r\n");
+    }
+    // Find the first waiting frame that is less urgent than this one
+    uint16_t now = (uint16_t) TimerGetMillis();
+    uint8_t bufferIdx = ibus->txBufferReadIdx;
+    while (
+        bufferIdx != ibus->txBufferWriteIdx &&
+        IBusGetTXBufferPriority(ibus, bufferIdx, now) <= priority
+    ) {
+        if (bufferIdx + 1 == IBUS_TX_BUFFER_SIZE) {
+            bufferIdx = 0;
+        } else {
+            bufferIdx++;
+        }
+    }
+    // Move the less urgent frames back by one slot
+    uint8_t idx = ibus->txBufferWriteIdx;
+    while (idx != bufferIdx) {
+        uint8_t prevIdx = IBUS_TX_BUFFER_SIZE - 1;
+        if (idx != 0) {
+            prevIdx = idx - 1;
+        }
+        memcpy(ibus->txBuffer[idx], ibus->txBuffer[prevIdx], IBUS_MAX_MSG_LENGTH);
+        ibus->txBufferPriority[idx] = ibus->txBufferPriority[prevIdx];
+        ibus->txBufferStamp[idx] = ibus->txBufferStamp[prevIdx];
+        ibus->txBufferSent[idx] = ibus->txBufferSent[prevIdx];
+        idx = prevIdx;
+    }
+    if (ibus->txBufferWriteIdx + 1 == IBUS_TX_BUFFER_SIZE) {
+        ibus->txBufferWriteIdx = 0;
+    } else {
+        ibus->txBufferWriteIdx++;
+    }
+    // Reset the buffer prior to writing into it
+    memset(ibus->txBuffer[bufferIdx], 0, IBUS_MAX_MSG_LENGTH);
+    memcpy(ibus->txBuffer[bufferIdx], msg, msgSize);
+    ibus->txBufferPriority[bufferIdx] = priority;
+    ibus->txBufferStamp[bufferIdx] = now;
+    ibus->txBufferSent[bufferIdx] = 0;
+    return 1;
+}
+
 /**
  * IBusSendCommandInternal()
  *     Description:
  *         This function exists to implement message priority without changing
- *         every existing call to IBusSendCommand()
- *
- *         Priority high shoves the message into the front of the ring buffer
- *         Priortiy normal queues it to the end of the buffer
+ *         every existing call to IBusSendCommand(). It builds the frame and
+ *         hands it to IBusQueueFrame(). While a capture is running the frame
+ *         is also appended to the capture buffer.
  *     Params:
  *         IBus_t *ibus
  *         const uint8_t src
  *         const uint8_t dst
  *         const uint8_t *data
+ *         const size_t dataSize
+ *         const uint8_t priority - One of the IBUS_MSG_PRIORITY_* classes
  *     Returns:
- *         void
+ *         uint8_t - 1 if the frame was queued, 0 if it was refused
  */
-static void IBusSendCommandInternal(
+static uint8_t IBusSendCommandInternal(
     IBus_t *ibus,
     const uint8_t src,
     const uint8_t dst,
@@ -1205,20 +1429,7 @@ static void IBusSendCommandInternal(
 ) {
     if (dataSize + 4 >= IBUS_MAX_MSG_LENGTH) {
         LogWarning("IBus: Refuse to transmit frame of length %d", dataSize + 4);
-        return;
-    }
-    // Calculate number of used slots in the ring buffer
-    uint8_t usedSlots = 0;
-    if (ibus->txBufferWriteIdx >= ibus->txBufferReadIdx) {
-        usedSlots = ibus->txBufferWriteIdx - ibus->txBufferReadIdx;
-    } else {
-        usedSlots = (IBUS_TX_BUFFER_SIZE - ibus->txBufferReadIdx) + ibus->txBufferWriteIdx;
-    }
-    // Check if buffer is full (one slot must remain empty to distinguish full from empty)
-    if (usedSlots >= IBUS_TX_BUFFER_SIZE - 1) {
-        long long unsigned int ts = (long long unsigned int) TimerGetMillis();
-        LogRaw("[%llu] ERROR: IBus: TX Buffer Overflow.\r\n", ts);
-        return;
+        return 0;
     }
     uint8_t idx, msgSize;
     msgSize = dataSize + 4;
@@ -1235,51 +1446,128 @@ static void IBusSendCommandInternal(
         crc ^= msg[idx];
     }
     msg[msgSize - 1] = crc;
-    uint8_t bufferIdx = 0;
-    if (priority == IBUS_MSG_PRIORITY_NORMAL) {
-        bufferIdx = ibus->txBufferWriteIdx;
-        if (ibus->txBufferWriteIdx + 1 == IBUS_TX_BUFFER_SIZE) {
-            ibus->txBufferWriteIdx = 0;
-        } else {
-            ibus->txBufferWriteIdx++;
-        }
-    } else {
-        // Priority message, so queue it first
-        // Calculate new read index (decrement with wrap-around)
-        if (ibus->txBufferReadIdx == 0) {
-            bufferIdx = IBUS_TX_BUFFER_SIZE - 1;
+    if (ibus->txCaptureBuffer != 0) {
+        if (ibus->txCaptureLength + msgSize <= ibus->txCaptureSize) {
+            memcpy(ibus->txCaptureBuffer + ibus->txCaptureLength, msg, msgSize);
+            ibus->txCaptureLength += msgSize;
         } else {
-            bufferIdx = ibus->txBufferReadIdx - 1;
+            // Out of room, so the capture can not be replayed
+            ibus->txCaptureSize = 0;
         }
-        ibus->txBufferReadIdx = bufferIdx;
-        ibus->txBufferReadbackIdx = bufferIdx;
     }
-    // Reset the buffer prior to writing into it
-    memset(ibus->txBuffer[bufferIdx], 0, IBUS_MAX_MSG_LENGTH);
-    memcpy(ibus->txBuffer[bufferIdx], msg, msgSize);
+    return IBusQueueFrame(ibus, msg, msgSize, priority);
 }
 
 /**
  * IBusSendCommand()
  *     Description:
  *         Take a Destination, source and message and add it to the transmit
- *         char queue so we can send it later.
+ *         char queue so we can send it later. The frame is queued with the
+ *         class set by IBusSetTXPriority().
  *     Params:
  *         IBus_t *ibus
  *         const uint8_t src
  *         const uint8_t dst
  *         const uint8_t *data
  *     Returns:
- *         void
+ *         uint8_t - 1 if the frame was queued, 0 if it was refused
  */
-void IBusSendCommand(
+uint8_t IBusSendCommand(
     IBus_t *ibus,
     const uint8_t src,
     const uint8_t dst,
     const uint8_t *data,
     const size_t dataSize
 ) {
-    IBusSendCommandInternal(ibus, src, dst, data, dataSize, IBUS_MSG_PRIORITY_NORMAL);
+    return IBusSendCommandInternal(ibus, src, dst, data, dataSize, ibus->txPriority);
+}
+
+/**
+ * IBusSendFrames()
+ *     Description:
+ *         Queue frames that were recorded with IBusStartTXCapture(). The
+ *         frames are already complete, so they are copied as they are. They
+ *         are queued with the class set by IBusSetTXPriority().
+ *     Params:
+ *         IBus_t *ibus
+ *         const uint8_t *frames - The frames, back to back
+ *         uint16_t length - The number of bytes in frames
+ *     Returns:
+ *         uint8_t - 1 if every frame was queued, 0 otherwise
+ */
+uint8_t IBusSendFrames(IBus_t *ibus, const uint8_t *frames, uint16_t length)
+{
+    uint8_t queued = 1;
+    uint16_t offset = 0;
+    while (offset + 4 <= length) {
+        uint8_t msgSize = frames[offset + 1] + 2;
+        if (offset + msgSize > length) {
+            break;
+        }
+        if (IBusQueueFrame(ibus, frames + offset, msgSize, ibus->txPriority) == 0) {
+            queued = 0;
+        }
+        offset += msgSize;
+    }
+    return queued;
+}
+
+/**
+ * IBusStartTXCapture()
+ *     Description:
+ *         Record every frame that is built from now on into the given buffer,
+ *         in addition to queueing it, until IBusStopTXCapture() is called
+ *     Params:
+ *         IBus_t *ibus
+ *         uint8_t *buffer - Where to place the frames
+ *         uint16_t size - The size of the buffer
+ *     Returns:
+ *         void
+ */
+void IBusStartTXCapture(IBus_t *ibus, uint8_t *buffer, uint16_t size)
+{
+    ibus->txCaptureBuffer = buffer;
+    ibus->txCaptureSize = size;
+    ibus->txCaptureLength = 0;
+}
+
+/**
+ * IBusStopTXCapture()
+ *     Description:
+ *         Stop recording frames
+ *     Params:
+ *         IBus_t *ibus
+ *     Returns:
+ *         uint16_t - The number of bytes recorded, or 0 if the frames did
+ *             not fit into the buffer
+ */
+uint16_t IBusStopTXCapture(IBus_t *ibus)
+{
+    uint16_t length = ibus->txCaptureLength;
+    if (ibus->txCaptureSize == 0) {
+        length = 0;
+    }
+    ibus->txCaptureBuffer = 0;
+    ibus->txCaptureSize = 0;
+    ibus->txCaptureLength = 0;
+    return length;
+}
+
+/**
+ * IBusSetTXPriority()
+ *     Description:
+ *         Set the class that IBusSendCommand() queues frames with. Producers
+ *         of cosmetic frames lower it to IBUS_MSG_PRIORITY_BACKGROUND around
+ *         their writes and restore IBUS_MSG_PRIORITY_INTERACTIVE afterwards.
+ *     Params:
+ *         IBus_t *ibus
+ *         uint8_t priority - One of the IBUS_MSG_PRIORITY_* classes
+ *     Returns:
+ *         void
+ */
+void IBusSetTXPriority(IBus_t *ibus, uint8_t priority)
+{
+    ibus->txPriority = priority;
 }
 
 
@@ -1736,7 +2024,7 @@ void IBusCommandCDCPollResponse(IBus_t *ibus)
         IBUS_DEVICE_RAD,
         cdcPing,
         sizeof(cdcPing),
-        IBUS_MSG_PRIORITY_HIGH
+        IBUS_MSG_PRIORITY_CRITICAL
     );
 }
 
@@ -1786,7 +2074,7 @@ void IBusCommandCDCStatus(
         IBUS_DEVICE_RAD,
         cdcStatus,
         sizeof(cdcStatus),
-        IBUS_MSG_PRIORITY_HIGH
+        IBUS_MSG_PRIORITY_CRITICAL
     );
 }
 
@@ -1948,7 +2236,14 @@ void IBusCommandGetModuleStatus(
     uint8_t system
 ) {
     uint8_t msg[] = {0x01};
-    IBusSendCommand(ibus, source, system, msg, 1);
+    IBusSendCommandInternal(
+        ibus,
+        source,
+        system,
+        msg,
+        1,
+        IBUS_MSG_PRIORITY_BACKGROUND
+    );
 }
 
 /**
@@ -1969,7 +2264,12 @@ void IBusCommandSetModuleStatus(
     uint8_t status
 ) {
     uint8_t msg[] = {IBUS_CMD_MOD_STATUS_RESP, status};
-    IBusSendCommand(ibus, source, system, msg, 2);
+    // Announcements can wait, but a module that polled us expects an answer
+    uint8_t priority = IBUS_MSG_PRIORITY_CRITICAL;
+    if (system == IBUS_DEVICE_LOC) {
+        priority = IBUS_MSG_PRIORITY_BACKGROUND;
+    }
+    IBusSendCommandInternal(ibus, source, system, msg, 2, priority);
 }
 
 /**
@@ -2246,7 +2546,7 @@ void IBusCommandGTUpdate(IBus_t *ibus, uint8_t updateType)
     IBusSendCommand(ibus, IBUS_DEVICE_RAD, IBUS_DEVICE_GT, msg, 4);
 }
 
-static void IBusInternalCommandGTWriteIndex(
+static uint8_t IBusInternalCommandGTWriteIndex(
     IBus_t *ibus,
     uint8_t index,
     char *message,
@@ -2266,10 +2566,10 @@ static void IBusInternalCommandGTWriteIndex(
     text[2] = 0x00;
     text[3] = index;
     memcpy(text + 4, message, length);
-    IBusSendCommand(ibus, IBUS_DEVICE_RAD, IBUS_DEVICE_GT, text, pktLenght);
+    return IBusSendCommand(ibus, IBUS_DEVICE_RAD, IBUS_DEVICE_GT, text, pktLenght);
 }
 
-static void IBusCommandGTWriteIndexStaticInternal(
+static uint8_t IBusCommandGTWriteIndexStaticInternal(
     IBus_t *ibus,
     uint8_t index,
     char *message,
@@ -2283,7 +2583,7 @@ static void IBusCommandGTWriteIndexStaticInternal(
     text[2] = cursorPos;
     text[3] = index;
     memcpy(text + 4, message, length);
-    IBusSendCommand(ibus, IBUS_DEVICE_RAD, IBUS_DEVICE_GT, text, pktLenght);
+    return IBusSendCommand(ibus, IBUS_DEVICE_RAD, IBUS_DEVICE_GT, text, pktLenght);
 }
 
 /**
@@ -2312,12 +2612,12 @@ void IBusCommandGTWriteBusinessNavTitle(IBus_t *ibus, char *message) {
     IBusSendCommand(ibus, IBUS_DEVICE_RAD, IBUS_DEVICE_GT, text, packetLength);
 }
 
-void IBusCommandGTWriteIndex(
+uint8_t IBusCommandGTWriteIndex(
     IBus_t *ibus,
     uint8_t index,
     char *message
 ) {
-    IBusInternalCommandGTWriteIndex(
+    return IBusInternalCommandGTWriteIndex(
         ibus,
         index,
         message,
@@ -2325,12 +2625,12 @@ void IBusCommandGTWriteIndex(
     );
 }
 
-void IBusCommandGTWriteIndexTMC(
+uint8_t IBusCommandGTWriteIndexTMC(
     IBus_t *ibus,
     uint8_t index,
     char *message
 ) {
-    IBusInternalCommandGTWriteIndex(
+    return IBusInternalCommandGTWriteIndex(
         ibus,
         index,
         message,
@@ -2390,12 +2690,13 @@ void IBusCommandGTWriteIndexTitleNGUI(IBus_t *ibus, char *message) {
     IBusSendCommand(ibus, IBUS_DEVICE_RAD, IBUS_DEVICE_GT, text, pktLenght);
 }
 
-void IBusCommandGTWriteIndexStatic(IBus_t *ibus, uint8_t index, char *message)
+uint8_t IBusCommandGTWriteIndexStatic(IBus_t *ibus, uint8_t index, char *message)
 {
     uint8_t length = strlen(message);
     if (length > 40) {
         length = 40;
     }
+    uint8_t queued = 1;
     uint8_t cursorPos = 0;
     uint8_t currentIdx = 0;
     while (currentIdx < length) {
@@ -2408,14 +2709,15 @@ void IBusCommandGTWriteIndexStatic(IBus_t *ibus, uint8_t index, char *message)
         memcpy(msg, message + currentIdx, textLength);
         currentIdx += textLength;
         if (cursorPos == 0) {
-            IBusCommandGTWriteIndexStaticInternal(ibus, index, msg, 1);
+            queued &= IBusCommandGTWriteIndexStaticInternal(ibus, index, msg, 1);
         } else {
-            IBusCommandGTWriteIndexStaticInternal(ibus, index, msg, cursorPos);
+            queued &= IBusCommandGTWriteIndexStaticInternal(ibus, index, msg, cursorPos);
         }
         // Make sure we do not write over the
         // last character of the previous string
         cursorPos = cursorPos + textLength + 1;
     }
+    return queued;
 }
 
 /**
@@ -3561,7 +3863,7 @@ void IBusCommandTELBodyText(
 void IBusCommandTELCallTime(IBus_t *ibus, uint8_t dest, uint8_t minutes, uint8_t seconds)
 {
     char minStr[4] = {0};
-    snprintf(minStr, sizeof(minStr), "%3d", minutes);
+    UtilsFormat(minStr, sizeof(minStr), "%3d", minutes);
     uint8_t minMsg[6];
     minMsg[0] = IBUS_TEL_CMD_PROPERTY_TEXT;
     minMsg[1] = IBUS_TEL_PROP_CALL_TIME_MINUTES;
@@ -3570,7 +3872,7 @@ void IBusCommandTELCallTime(IBus_t *ibus, uint8_t dest, uint8_t minutes, uint8_t
     IBusSendCommand(ibus, IBUS_DEVICE_TEL, dest, minMsg, 6);
 
     char secStr[3] = {0};
-    snprintf(secStr, sizeof(secStr), "%02d", seconds % 60);
+    UtilsFormat(secStr, sizeof(secStr), "%02d", seconds % 60);
     uint8_t secMsg[5];
     secMsg[0] = IBUS_TEL_CMD_PROPERTY_TEXT;
     secMsg[1] = IBUS_TEL_PROP_CALL_TIME_SECONDS;
@@ -3778,7 +4080,14 @@ void IBusCommandTELSMSIcon(IBus_t *ibus, uint8_t show)
 void IBusCommandTELStatus(IBus_t *ibus, uint8_t status)
 {
     const uint8_t msg[] = {IBUS_TEL_CMD_STATUS, status};
-    IBusSendCommand(ibus, IBUS_DEVICE_TEL, IBUS_DEVICE_ANZV, msg, sizeof(msg));
+    IBusSendCommandInternal(
+        ibus,
+        IBUS_DEVICE_TEL,
+        IBUS_DEVICE_ANZV,
+        msg,
+        sizeof(msg),
+        IBUS_MSG_PRIORITY_CRITICAL
+    );
 }
 
 /**
@@ -65,9 +65,11 @@
 #define IBUS_PKT_DB13 16
 #define IBUS_PKT_DB14 17
 
-// IBus Message Priorities
-#define IBUS_MSG_PRIORITY_NORMAL 0
-#define IBUS_MSG_PRIORITY_HIGH 1
+// IBus Message Priorities, most urgent first
+#define IBUS_MSG_PRIORITY_CRITICAL 0
+#define IBUS_MSG_PRIORITY_INTERACTIVE 1
+#define IBUS_MSG_PRIORITY_BACKGROUND 2
+#define IBUS_MSG_PRIORITY_COUNT 3
 
 // IBus Commands
 #define IBUS_COMMAND_CDC_REQUEST 0x38
@@ -343,6 +345,12 @@
 
 #define IBUS_LM_BATTERY_SCALE_DEFAULT 136
 #define IBUS_LM_BATTERY_SCALE_E46_E8X 132
+// Oil temperature is 67.2529 * ln(raw * 0.00005) + offset, which is computed
+// from log2(raw) in fixed point with 8 fraction bits
+#define IBUS_LM_OIL_TEMP_LOG2_SCALE 11934 // 67.2529 * ln(2)
+#define IBUS_LM_OIL_TEMP_RAW_SCALE 170506 // -67.2529 * ln(0.00005)
+#define IBUS_LM_OIL_TEMP_OFFSET_DEFAULT 310
+#define IBUS_LM_OIL_TEMP_OFFSET_LCM_IV 510
 
 // Light Module variants
 #define IBUS_LM_LME38 1
@@ -614,6 +622,7 @@
 #define IBUS_EVENT_GT_SCREEN_MODE_SET 78
 #define IBUS_EVENT_RAD_PLAYBACK_CTRL 79
 #define IBUS_EVENT_GT_SCREEN_BUFFER_WRITE 80
+#define IBUS_EVENT_TX_FRAME_DROPPED 81
 
 // Configuration and protocol definitions
 // Src Len Dest Cmd Data[42 Byte Max] XOR
@@ -621,6 +630,13 @@
 #define IBUS_RAD_MAIN_AREA_WATERMARK 0x10
 #define IBUS_RX_BUFFER_SIZE 255
 #define IBUS_TX_BUFFER_SIZE 24
+// Frames that are only cosmetic, like scrolling text, back off above this
+#define IBUS_TX_BUFFER_WATERMARK 8
+// Slots that UI writes leave free so that protocol replies always fit
+#define IBUS_TX_BUFFER_RESERVED 6
+// A queued frame counts as one class more urgent for every period it waits
+#define IBUS_TX_AGING_TIME 100
+#define IBUS_TX_LATENCY_AVG_SHIFT 3
 // 9600 baud = ~1.1 = 1.5 bytes/ms - IBUS_MAX_MSG_LENGTH * 2
 #define IBUS_RX_BUFFER_TIMEOUT 71
 // This is the time we wait before transmitting. Any faster than this, and the
@@ -696,10 +712,19 @@ typedef struct IBus_t {
     uint8_t rxBuffer[IBUS_RX_BUFFER_SIZE];
     uint8_t rxBufferIdx;
     uint8_t txBuffer[IBUS_TX_BUFFER_SIZE][IBUS_MAX_MSG_LENGTH];
+    uint8_t txBufferPriority[IBUS_TX_BUFFER_SIZE];
+    uint16_t txBufferStamp[IBUS_TX_BUFFER_SIZE];
+    uint8_t txBufferSent[IBUS_TX_BUFFER_SIZE];
     uint8_t txBufferReadbackIdx;
     uint8_t txBufferReadIdx;
     uint8_t txBufferWriteIdx;
+    uint8_t txPriority;
     uint8_t txRetries: 2;
+    uint8_t *txCaptureBuffer;
+    uint16_t txCaptureSize;
+    uint16_t txCaptureLength;
+    uint16_t txLatencyAvg[IBUS_MSG_PRIORITY_COUNT];
+    uint16_t txLatencyMax[IBUS_MSG_PRIORITY_COUNT];
     uint32_t rxLastStamp;
     uint32_t txLastStamp;
     int8_t ambientTemperature;
@@ -731,8 +756,15 @@ typedef struct IBus_t {
 
 IBus_t IBusInit();
 void IBusProcess(IBus_t *);
-void IBusSendCommand(IBus_t *, const uint8_t, const uint8_t, const uint8_t *, const size_t);
+uint8_t IBusSendCommand(IBus_t *, const uint8_t, const uint8_t, const uint8_t *, const size_t);
 void IBusSetInternalIgnitionStatus(IBus_t *, uint8_t);
+uint8_t IBusGetTXBufferUsed(IBus_t *);
+uint16_t IBusGetTXLatency(IBus_t *, uint8_t);
+uint8_t IBusSendFrames(IBus_t *, const uint8_t *, uint16_t);
+void IBusSetTXPriority(IBus_t *, uint8_t);
+void IBusStartTXCapture(IBus_t *, uint8_t *, uint16_t);
+uint16_t IBusStopTXCapture(IBus_t *);
+uint8_t IBusTXBufferHasSpace(IBus_t *, uint8_t);
 uint32_t IBusGetDateTimeAsEpoch(IBusDateTime_t *);
 IBusDateTime_t IBusGetEpochAsDateTime(uint32_t);
 uint8_t IBusGetLMCodingIndex(uint8_t *);
@@ -769,11 +801,11 @@ void IBusCommandGMDoorLockAll(IBus_t *);
 void IBusCommandGTBMBTControl(IBus_t *, uint8_t);
 void IBusCommandGTUpdate(IBus_t *, uint8_t);
 void IBusCommandGTWriteBusinessNavTitle(IBus_t *, char *);
-void IBusCommandGTWriteIndex(IBus_t *, uint8_t, char *);
-void IBusCommandGTWriteIndexTMC(IBus_t *, uint8_t, char *);
+uint8_t IBusCommandGTWriteIndex(IBus_t *, uint8_t, char *);
+uint8_t IBusCommandGTWriteIndexTMC(IBus_t *, uint8_t, char *);
 void IBusCommandGTWriteIndexTitle(IBus_t *, char *);
 void IBusCommandGTWriteIndexTitleNGUI(IBus_t *, char *);
-void IBusCommandGTWriteIndexStatic(IBus_t *, uint8_t, char *);
+uint8_t IBusCommandGTWriteIndexStatic(IBus_t *, uint8_t, char *);
 void IBusCommandGTWriteTitleArea(IBus_t *, char *);
 void IBusCommandGTWriteTitleIndex(IBus_t *, char *);
 void IBusCommandGTWriteTitleC43(IBus_t *, char *);
@@ -7,7 +7,7 @@
 #include "locale.h"
 #include "config.h"
 
-static char *LOCALE_LANG_ENGLISH[] = {
+static const char * const LOCALE_LANG_ENGLISH[] = {
     "- Not Playing -",
     "About",
     "Audio",
@@ -100,7 +100,7 @@ static char *LOCALE_LANG_ENGLISH[] = {
     "True Speed: Off",
 };
 
-static char *LOCALE_LANG_FRENCH[] = {
+static const char * const LOCALE_LANG_FRENCH[] = {
     "- Pas de lecture -",
     "\xC0 propos",
     "Audio",
@@ -193,7 +193,7 @@ static char *LOCALE_LANG_FRENCH[] = {
     "V. R\xE9""elle: Non",
 };
 
-static char *LOCALE_LANG_ITALIAN[] = {
+static const char * const LOCALE_LANG_ITALIAN[] = {
     "- In Pausa -",
     "Info su...",
     "Audio",
@@ -286,7 +286,7 @@ static char *LOCALE_LANG_ITALIAN[] = {
     "Vel. Reale: No",
 };
 
-static char *LOCALE_LANG_DUTCH[] = {
+static const char * const LOCALE_LANG_DUTCH[] = {
     "- Geen weergave -",
     "Info",
     "Audio",
@@ -379,7 +379,7 @@ static char *LOCALE_LANG_DUTCH[] = {
     "W. Snelh.: Uit",
 };
 
-static char *LOCALE_LANG_ESTONIAN[] = {
+static const char * const LOCALE_LANG_ESTONIAN[] = {
     "- Ei mängi -",
     "Teave",
     "Audio",
@@ -472,62 +472,62 @@ static char *LOCALE_LANG_ESTONIAN[] = {
     "T. Kiirus: V\xe4lj",
 };
 
-static char LOCALE_LANG_RUSSIAN[][24] = {
-    {205,229,' ',226,238,241,239,240,238,232,231,226,238,228,232,242,241,255,0},
-    {206,' ',239,240,238,227,240,224,236,236,229,0},
-    {192,243,228,232,238,0},
-    {192,226,242,238,226,238,241,239,':',' ',194,251,234,235,0},
-    {192,226,242,238,226,238,241,239,':',' ',194,234,235,0},
-    {205,224,231,224,228,0},
-    {207,238,226,238,240,238,242,237,232,234,232,':',' ','%','d',0},
+static const char * const LOCALE_LANG_RUSSIAN[] = {
+    "\xcd\xe5 \xe2\xee\xf1\xef\xf0\xee\xe8\xe7\xe2\xee\xe4\xe8\xf2\xf1\xff",
+    "\xce \xef\xf0\xee\xe3\xf0\xe0\xec\xec\xe5",
+    "\xc0\xf3\xe4\xe8\xee",
+    "\xc0\xe2\xf2\xee\xe2\xee\xf1\xef: \xc2\xfb\xea\xeb",
+    "\xc0\xe2\xf2\xee\xe2\xee\xf1\xef: \xc2\xea\xeb",
+    "\xcd\xe0\xe7\xe0\xe4",
+    "\xcf\xee\xe2\xee\xf0\xee\xf2\xed\xe8\xea\xe8: %d",
     "Bluetooth",
-    {209,225,238,240,234,224,':',' ','%','d','/','%','d',0},
-    {199,226,238,237,234,232,0},
-    {206,247,232,241,242,232,242,252,' ',241,226,255,231,232,0},
-    {202,238,236,244,238,240,242,0},
-    {206,225,231,238,240,237,238,229,' ',236,229,237,254,0},
-    {211,241,242,240,238,233,241,242,226,224,0},
+    "\xd1\xe1\xee\xf0\xea\xe0: %d/%d",
+    "\xc7\xe2\xee\xed\xea\xe8",
+    "\xce\xf7\xe8\xf1\xf2\xe8\xf2\xfc \xf1\xe2\xff\xe7\xe8",
+    "\xca\xee\xec\xf4\xee\xf0\xf2",
+    "\xce\xe1\xe7\xee\xf0\xed\xee\xe5 \xec\xe5\xed\xfe",
+    "\xd3\xf1\xf2\xf0\xee\xe9\xf1\xf2\xe2\xe0",
     "DSP: Default",
-    {'D','S','P',':',' ',192,237,224,235,238,227,238,226,251,233,0},
-    {'D','S','P',':',' ',214,232,244,240,238,226,238,233,0},
-    {'F','W',':',' ','%','s',0},
-    {195,240,' ',241,226,255,231,252,':',' ',194,251,234,235,0},
-    {195,240,' ',241,226,255,231,252,':',' ',194,234,235,0},
-    {199,224,234,240,':',' ','1','0',' ',234,236,'/',247,0},
-    {199,224,234,240,':',' ','2','0',' ',234,236,'/',247,0},
-    {199,224,234,240,':',' ',194,251,234,235,0},
-    {195,235,224,226,237,238,229,' ',236,229,237,254,0},
-    {204,229,237,254,':',' ',206,225,231,238,240,237,238,229,0},
-    {204,229,237,254,':',' ',195,235,224,226,237,238,229,0},
-    {204,'.',228,224,237,237,251,229,':',' ',215,224,241,242,252,0},
-    {204,'.',228,224,237,237,251,229,':',' ',194,251,234,235,0},
-    {204,'.',228,224,237,237,251,229,':',' ',193,229,227,0},
-    {211,241,232,235,' ',236,232,234,240,':',' ','%','i','d','B',0},
-    {205,229,242,' ',243,241,242,240,238,233,241,242,226,224,0},
-    {209,238,239,240,255,230,':',' ',194,251,234,235,0},
-    {209,238,239,240,255,230,':',' ',194,234,235,0},
-    {'S','/','N',':',' ','%','u',0},
-    {205,224,241,242,240,238,233,234,232,0},
-    {205,224,241,242,240,238,233,234,232,' ','>',' ',206,' ',239,240,238,227,240,224,236,236,229,0},
-    {205,224,241,242,240,238,233,234,232,' ','>',' ',192,243,228,232,238,0},
-    {205,224,241,242,240,238,233,234,232,' ','>',' ',199,226,238,237,234,232,0},
-    {205,224,241,242,240,238,233,234,232,' ','>',' ',202,238,236,244,238,240,242,0},
-    {205,224,241,242,240,238,233,234,232,' ','>',' ',200,237,242,229,240,244,229,233,241,0},
-    {210,229,236,239,'-',240,224,':',' ',206,198,0},
-    {210,229,236,239,'-',240,224,':',' ',194,251,234,235,0},
+    "DSP: \xc0\xed\xe0\xeb\xee\xe3\xee\xe2\xfb\xe9",
+    "DSP: \xd6\xe8\xf4\xf0\xee\xe2\xee\xe9",
+    "FW: %s",
+    "\xc3\xf0 \xf1\xe2\xff\xe7\xfc: \xc2\xfb\xea\xeb",
+    "\xc3\xf0 \xf1\xe2\xff\xe7\xfc: \xc2\xea\xeb",
+    "\xc7\xe0\xea\xf0: 10 \xea\xec/\xf7",
+    "\xc7\xe0\xea\xf0: 20 \xea\xec/\xf7",
+    "\xc7\xe0\xea\xf0: \xc2\xfb\xea\xeb",
+    "\xc3\xeb\xe0\xe2\xed\xee\xe5 \xec\xe5\xed\xfe",
+    "\xcc\xe5\xed\xfe: \xce\xe1\xe7\xee\xf0\xed\xee\xe5",
+    "\xcc\xe5\xed\xfe: \xc3\xeb\xe0\xe2\xed\xee\xe5",
+    "\xcc.\xe4\xe0\xed\xed\xfb\xe5: \xd7\xe0\xf1\xf2\xfc",
+    "\xcc.\xe4\xe0\xed\xed\xfb\xe5: \xc2\xfb\xea\xeb",
+    "\xcc.\xe4\xe0\xed\xed\xfb\xe5: \xc1\xe5\xe3",
+    "\xd3\xf1\xe8\xeb \xec\xe8\xea\xf0: %idB",
+    "\xcd\xe5\xf2 \xf3\xf1\xf2\xf0\xee\xe9\xf1\xf2\xe2\xe0",
+    "\xd1\xee\xef\xf0\xff\xe6: \xc2\xfb\xea\xeb",
+    "\xd1\xee\xef\xf0\xff\xe6: \xc2\xea\xeb",
+    "S/N: %u",
+    "\xcd\xe0\xf1\xf2\xf0\xee\xe9\xea\xe8",
+    "\xcd\xe0\xf1\xf2\xf0\xee\xe9\xea\xe8 > \xce \xef\xf0\xee\xe3\xf0\xe0\xec\xec\xe5",
+    "\xcd\xe0\xf1\xf2\xf0\xee\xe9\xea\xe8 > \xc0\xf3\xe4\xe8\xee",
+    "\xcd\xe0\xf1\xf2\xf0\xee\xe9\xea\xe8 > \xc7\xe2\xee\xed\xea\xe8",
+    "\xcd\xe0\xf1\xf2\xf0\xee\xe9\xea\xe8 > \xca\xee\xec\xf4\xee\xf0\xf2",
+    "\xcd\xe0\xf1\xf2\xf0\xee\xe9\xea\xe8 > \xc8\xed\xf2\xe5\xf0\xf4\xe5\xe9\xf1",
+    "\xd2\xe5\xec\xef-\xf0\xe0: \xce\xc6",
+    "\xd2\xe5\xec\xef-\xf0\xe0: \xc2\xfb\xea\xeb",
     "Temp: Ambient",
     "Temp: Oil",
-    {200,237,242,229,240,244,229,233,241,0},
-    {205,229,232,231,226,229,241,242,237,251,233,' ',232,241,239,238,235,237,232,242,229,235,252,0},
-    {205,229,232,231,226,229,241,242,237,238,229,' ',237,224,231,226,224,237,232,229,0},
-    {206,242,234,240,':',' ',194,251,234,235,0},
-    {206,242,234,240,':',' ',207,238,235,238,230,' ','0',0},
-    {206,242,234,240,':',' ',207,238,235,238,230,' ','1',0},
-    {195,240,238,236,234,':',' ','-','%','d','d','B',0},
-    {195,240,238,236,234,':',' ','+','%','d','d','B',0},
-    {195,240,238,236,234,':',' ','+','2','4','d','B',0},
-    {195,240,238,236,234,':',' ','0','d','B',0},
-    {223,231,251,234,':',' ','%','s',0},
+    "\xc8\xed\xf2\xe5\xf0\xf4\xe5\xe9\xf1",
+    "\xcd\xe5\xe8\xe7\xe2\xe5\xf1\xf2\xed\xfb\xe9 \xe8\xf1\xef\xee\xeb\xed\xe8\xf2\xe5\xeb\xfc",
+    "\xcd\xe5\xe8\xe7\xe2\xe5\xf1\xf2\xed\xee\xe5 \xed\xe0\xe7\xe2\xe0\xed\xe8\xe5",
+    "\xce\xf2\xea\xf0: \xc2\xfb\xea\xeb",
+    "\xce\xf2\xea\xf0: \xcf\xee\xeb\xee\xe6 0",
+    "\xce\xf2\xea\xf0: \xcf\xee\xeb\xee\xe6 1",
+    "\xc3\xf0\xee\xec\xea: -%ddB",
+    "\xc3\xf0\xee\xec\xea: +%ddB",
+    "\xc3\xf0\xee\xec\xea: +24dB",
+    "\xc3\xf0\xee\xec\xea: 0dB",
+    "\xdf\xe7\xfb\xea: %s",
     "Park Lts.: Off",
     "Park Lts.: On",
     "Vol. Rev: Off",
@@ -565,7 +565,7 @@ static char LOCALE_LANG_RUSSIAN[][24] = {
     "True Spd: Off",
 };
 
-static char *LOCALE_LANG_GERMAN[] = {
+static const char * const LOCALE_LANG_GERMAN[] = {
     "- Keine Wiedergabe -",
     "\xdc""ber",
     "Audio",
@@ -658,7 +658,7 @@ static char *LOCALE_LANG_GERMAN[] = {
     "W. Geschw: Aus",
 };
 
-static char *LOCALE_LANG_SPANISH[] = {
+static const char * const LOCALE_LANG_SPANISH[] = {
     "- En Pausa -",
     "Informaci\xf3""n",
     "Audio",
@@ -751,7 +751,7 @@ static char *LOCALE_LANG_SPANISH[] = {
     "V. Real: Apg.",
 };
 
-static char *LOCALE_LANG_POLISH[] = {
+static const char * const LOCALE_LANG_POLISH[] = {
     "- Nie odtwarza -",
     "Informacje",
     "Dzwiek",
@@ -844,57 +844,79 @@ static char *LOCALE_LANG_POLISH[] = {
     "Pred. Rz.: Wyl.",
 };
 
+static const char * const *LocaleActiveTable = 0;
+
 /**
- * LocaleGetText()
+ * LocaleGetTable()
  *     Description:
- *         Returns localized string
+ *         Get the string table of a language
  *     Params:
- *         uint16_t stringIndex - string identifier
+ *         uint8_t language - The CONFIG_SETTING_LANGUAGE_* to get the table of
  *     Returns:
- *         char *
+ *         const char * const * - The string table
  */
-char *LocaleGetText(uint16_t stringIndex)
+static const char * const *LocaleGetTable(uint8_t language)
 {
-    if (stringIndex>LOCALE_STRING_MAX_INDEX) {
-        return "i18n Missing";
-    }
-
-    char *text = 0;
-    unsigned char language = ConfigGetSetting(CONFIG_SETTING_LANGUAGE) & 0x0F;
-
-    switch (language) {
+    switch (language & 0x0F) {
         case CONFIG_SETTING_LANGUAGE_DUTCH:
-            text = LOCALE_LANG_DUTCH[stringIndex];
-            break;
+            return LOCALE_LANG_DUTCH;
         case CONFIG_SETTING_LANGUAGE_ESTONIAN:
-            text = LOCALE_LANG_ESTONIAN[stringIndex];
-            break;
+            return LOCALE_LANG_ESTONIAN;
         case CONFIG_SETTING_LANGUAGE_GERMAN:
-            text = LOCALE_LANG_GERMAN[stringIndex];
-            break;
+            return LOCALE_LANG_GERMAN;
         case CONFIG_SETTING_LANGUAGE_ITALIAN:
-            text = LOCALE_LANG_ITALIAN[stringIndex];
-            break;
+            return LOCALE_LANG_ITALIAN;
         case CONFIG_SETTING_LANGUAGE_RUSSIAN:
-            text = LOCALE_LANG_RUSSIAN[stringIndex];
-            break;
+            return LOCALE_LANG_RUSSIAN;
         case CONFIG_SETTING_LANGUAGE_SPANISH:
-            text = LOCALE_LANG_SPANISH[stringIndex];
-            break;
+            return LOCALE_LANG_SPANISH;
         case CONFIG_SETTING_LANGUAGE_POLISH:
-            text = LOCALE_LANG_POLISH[stringIndex];
-            break;
+            return LOCALE_LANG_POLISH;
         case CONFIG_SETTING_LANGUAGE_FRENCH:
-            text = LOCALE_LANG_FRENCH[stringIndex];
-            break;
+            return LOCALE_LANG_FRENCH;
         case CONFIG_SETTING_LANGUAGE_ENGLISH:
         default:
-            text = LOCALE_LANG_ENGLISH[stringIndex];
+            return LOCALE_LANG_ENGLISH;
     }
+}
 
+/**
+ * LocaleGetText()
+ *     Description:
+ *         Returns localized string
+ *     Params:
+ *         uint16_t stringIndex - string identifier
+ *     Returns:
+ *         char *
+ */
+char *LocaleGetText(uint16_t stringIndex)
+{
+    if (stringIndex>LOCALE_STRING_MAX_INDEX) {
+        return "i18n Missing";
+    }
+    if (LocaleActiveTable == 0) {
+        LocaleActiveTable = LocaleGetTable(ConfigGetSetting(CONFIG_SETTING_LANGUAGE));
+    }
+    const char *text = LocaleActiveTable[stringIndex];
     if (text == 0) {
         text = LOCALE_LANG_ENGLISH[stringIndex];
     }
+    // The strings live in program memory, callers only ever read them
+    return (char *) text;
+}
 
-    return text;
+/**
+ * LocaleSetLanguage()
+ *     Description:
+ *         Switch the active string table. This is called whenever the
+ *         language setting is written so that LocaleGetText() does not have
+ *         to read the setting on every lookup.
+ *     Params:
+ *         uint8_t language - The new CONFIG_SETTING_LANGUAGE value
+ *     Returns:
+ *         void
+ */
+void LocaleSetLanguage(uint8_t language)
+{
+    LocaleActiveTable = LocaleGetTable(language);
 }
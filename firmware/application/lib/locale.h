@@ -102,4 +102,5 @@
 #define LOCALE_STRING_MAX_INDEX 89
 
 char *LocaleGetText(uint16_t);
+void LocaleSetLanguage(uint8_t);
 #endif /* LOCALE_H */
@@ -7,10 +7,10 @@
 #include "log.h"
 #include "uart.h"
 #include <stdarg.h>
-#include <stdio.h>
 #include "../mappings.h"
 #include "config.h"
 #include "timer.h"
+#include "utils.h"
 
 /**
  * LogMessage()
@@ -29,7 +29,7 @@ void LogMessage(const char *type, const char *data)
     if (debugger != 0) {
         char output[LOG_MESSAGE_SIZE] = {0};
         long long unsigned int ts = (long long unsigned int) TimerGetMillis();
-        snprintf(output, LOG_MESSAGE_SIZE - 1 , "[%llu] %s: %s\r\n", ts, type, data);
+        UtilsFormat(output, LOG_MESSAGE_SIZE - 1 , "[%llu] %s: %s\r\n", ts, type, data);
         UARTSendString(debugger, output);
     }
 }
@@ -51,7 +51,7 @@ void LogRaw(const char *format, ...)
         char buffer[LOG_MESSAGE_SIZE] = {0};
         va_list args;
         va_start(args, format);
-        vsnprintf(buffer, LOG_MESSAGE_SIZE - 1, format, args);
+        UtilsFormatV(buffer, LOG_MESSAGE_SIZE - 1, format, args);
         va_end(args);
         UARTSendString(debugger, buffer);
     }
@@ -76,7 +76,7 @@ void LogRawDebug(uint8_t source, const char *format, ...)
         char buffer[LOG_MESSAGE_SIZE] = {0};
         va_list args;
         va_start(args, format);
-        vsnprintf(buffer, LOG_MESSAGE_SIZE - 1, format, args);
+        UtilsFormatV(buffer, LOG_MESSAGE_SIZE - 1, format, args);
         va_end(args);
         UARTSendString(debugger, buffer);
     }
@@ -100,7 +100,7 @@ void LogDebug(uint8_t source, const char *format, ...)
         char buffer[LOG_MESSAGE_SIZE] = {0};
         va_list args;
         va_start(args, format);
-        vsnprintf(buffer, LOG_MESSAGE_SIZE - 1, format, args);
+        UtilsFormatV(buffer, LOG_MESSAGE_SIZE - 1, format, args);
         va_end(args);
         LogMessage("DEBUG", buffer);
     }
@@ -122,7 +122,7 @@ void LogError(const char *format, ...)
     char buffer[LOG_MESSAGE_SIZE] = {0};
     va_list args;
     va_start(args, format);
-    vsnprintf(buffer, LOG_MESSAGE_SIZE - 1, format, args);
+    UtilsFormatV(buffer, LOG_MESSAGE_SIZE - 1, format, args);
     va_end(args);
     LogMessage("ERROR", buffer);
 }
@@ -146,7 +146,7 @@ void LogInfo(uint8_t source, const char *format, ...)
         char buffer[LOG_MESSAGE_SIZE] = {0};
         va_list args;
         va_start(args, format);
-        vsnprintf(buffer, LOG_MESSAGE_SIZE - 1, format, args);
+        UtilsFormatV(buffer, LOG_MESSAGE_SIZE - 1, format, args);
         va_end(args);
         LogMessage("INFO", buffer);
     }
@@ -167,7 +167,7 @@ void LogWarning(const char *format, ...)
     char buffer[LOG_MESSAGE_SIZE] = {0};
     va_list args;
     va_start(args, format);
-    vsnprintf(buffer, LOG_MESSAGE_SIZE - 1, format, args);
+    UtilsFormatV(buffer, LOG_MESSAGE_SIZE - 1, format, args);
     va_end(args);
     LogMessage("WARNING", buffer);
 }
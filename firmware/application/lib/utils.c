@@ -12,19 +12,148 @@
 #include "config.h"
 #include "log.h"
 
-static const char UTILS_CHARS_LATIN[] =
-    "AAAA\xa1""AACEEEEIIII" /* 00C0-00CF */
-    "D\xaf""OOOO\xa2*\xa7UUU\xa3Yp\xa0" /* 00D0-00DF */
-    "aaaa\xa4""aaceeeeiiii" /* 00E0-00EF */
-    "dnoooo\xa5/\xa9uuu\xa6yby" /* 00F0-00FF */
-    "AaAaAaCcCcCcCcDd" /* 0100-010F */
-    "DdEeEeEeEeEeGgGg" /* 0110-011F */
-    "GgGgHhHhIiIiIiIi" /* 0120-012F */
-    "IiJjJjKkkLlLlLlL" /* 0130-013F */
-    "lLlNnNnNnnNnOoOo" /* 0140-014F */
-    "OoOoRrRrRrSsSsSs" /* 0150-015F */
-    "SsTtTtTtUuUuUuUu" /* 0160-016F */
-    "UuUuWwYyYZzZzZzF"; /* 0170-017F */
+/* Display codes of U+00A0 - U+017F for each UTILS_CHARSET_*, where 0 marks a
+   character that the display cannot show */
+static const char UTILS_CHARSET_MAPS[][UTILS_CHARSET_MAP_SIZE] = {
+    {
+        "\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0" /* 00A0-00AF */
+        "\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0" /* 00B0-00BF */
+        "AAAA\xa1""AACEEEEIIII" /* 00C0-00CF */
+        "D\xafOOOO\xa2*\xa7UUU\xa3Yp\xa0" /* 00D0-00DF */
+        "aaaa\xa4""aaceeeeiiii" /* 00E0-00EF */
+        "dnoooo\xa5/\xa9uuu\xa6yby" /* 00F0-00FF */
+        "AaAaAaCcCcCcCcDd" /* 0100-010F */
+        "DdEeEeEeEeEeGgGg" /* 0110-011F */
+        "GgGgHhHhIiIiIiIi" /* 0120-012F */
+        "IiJjJjKkkLlLlLlL" /* 0130-013F */
+        "lLlNnNnNnnNnOoOo" /* 0140-014F */
+        "OoOoRrRrRrSsSsSs" /* 0150-015F */
+        "SsTtTtTtUuUuUuUu" /* 0160-016F */
+        "UuUuWwYyYZzZzZzF" /* 0170-017F */
+    },
+    {
+        "\xa0\xa1\xa2\xa3\xa4\xa5\xa6\xa7\xa8\xa9\xaa\xab\xac\xad\xae\xaf" /* 00A0-00AF */
+        "\xb0\xb1\xb2\xb3\xb4\xb5\xb6\xb7\xb8\xb9\xba\xbb\xbc\xbd\xbe\xbf" /* 00B0-00BF */
+        "\xc0\xc1\xc2\xc3\xc4\xc5\xc6\xc7\xc8\xc9\xca\xcb\xcc\xcd\xce\xcf" /* 00C0-00CF */
+        "\xd0\xd1\xd2\xd3\xd4\xd5\xd6\xd7\xd8\xd9\xda\xdb\xdc\xdd\xde\xdf" /* 00D0-00DF */
+        "\xe0\xe1\xe2\xe3\xe4\xe5\xe6\xe7\xe8\xe9\xea\xeb\xec\xed\xee\xef" /* 00E0-00EF */
+        "\xf0\xf1\xf2\xf3\xf4\xf5\xf6\xf7\xf8\xf9\xfa\xfb\xfcyby" /* 00F0-00FF */
+        "AaAaAaCcCcCcCcDd" /* 0100-010F */
+        "DdEeEeEeEeEeGgGg" /* 0110-011F */
+        "GgGgHhHhIiIiIiIi" /* 0120-012F */
+        "IiJjJjKkkLlLlLlL" /* 0130-013F */
+        "lLlNnNnNnnNnOoOo" /* 0140-014F */
+        "OoOoRrRrRrSsSsSs" /* 0150-015F */
+        "SsTtTtTtUuUuUuUu" /* 0160-016F */
+        "UuUuWwYyYZzZzZzF" /* 0170-017F */
+    }
+};
+
+/* Transliterations of U+00C0 - U+00FF for the Russian nav software, which
+   uses the upper half of the extended ASCII range for Cyrillic instead */
+static const char * const UTILS_TRANSLIT_LATIN1[] = {
+    "A", "A", "A", "A", "A", "A", "Ae", "C", /* 00C0-00C7 */
+    "E", "E", "E", "E", "I", "I", "I", "I", /* 00C8-00CF */
+    "Eth", "N", "O", "O", "O", "O", "O", "x", /* 00D0-00D7 */
+    "O", "U", "U", "U", "U", "Y", "Th", "ss", /* 00D8-00DF */
+    "a", "a", "a", "a", "a", "a", "ae", "c", /* 00E0-00E7 */
+    "e", "e", "e", "e", "i", "i", "i", "i", /* 00E8-00EF */
+    "eth", "n", "o", "o", "o", "o", "o", "%", /* 00F0-00F7 */
+    "o", "u", "u", "u", "u", "y", "th", "y" /* 00F8-00FF */
+};
+
+/* Transliterations and Russian nav extended ASCII codes, sorted by the UTF-8
+   bytes of the character so that they can be binary searched */
+static const UtilsTransliteration_t UTILS_TRANSLIT_UNICODE[] = {
+    {UTILS_CHAR_LATIN_SMALL_CAPITAL_R, "R", 0},
+    {UTILS_CHAR_CYRILLIC_CAPITAL_IO, "Yo", 197},
+    {UTILS_CHAR_CYRILLIC_UA_CAPITAL_IE, "E", 197},
+    {UTILS_CHAR_CYRILLIC_BY_UA_CAPITAL_I, "I", 0},
+    {UTILS_CHAR_CYRILLIC_CAPITAL_YI, "I", 0},
+    {UTILS_CHAR_CYRILLIC_CAPITAL_SHORT_U, "U", 211},
+    {UTILS_CHAR_CYRILLIC_CAPITAL_A, "A", 192},
+    {UTILS_CHAR_CYRILLIC_CAPITAL_BE, "B", 193},
+    {UTILS_CHAR_CYRILLIC_CAPITAL_VE, "V", 194},
+    {UTILS_CHAR_CYRILLIC_CAPITAL_GHE, "G", 195},
+    {UTILS_CHAR_CYRILLIC_CAPITAL_DE, "D", 196},
+    {UTILS_CHAR_CYRILLIC_CAPITAL_YE, "Ye", 197},
+    {UTILS_CHAR_CYRILLIC_CAPITAL_ZHE, "Zh", 198},
+    {UTILS_CHAR_CYRILLIC_CAPITAL_ZE, "Z", 199},
+    {UTILS_CHAR_CYRILLIC_CAPITAL_I, "I", 200},
+    {UTILS_CHAR_CYRILLIC_CAPITAL_SHORT_I, "Y", 201},
+    {UTILS_CHAR_CYRILLIC_CAPITAL_KA, "K", 202},
+    {UTILS_CHAR_CYRILLIC_CAPITAL_EL, "L", 203},
+    {UTILS_CHAR_CYRILLIC_CAPITAL_EM, "M", 204},
+    {UTILS_CHAR_CYRILLIC_CAPITAL_EN, "N", 205},
+    {UTILS_CHAR_CYRILLIC_CAPITAL_O, "O", 206},
+    {UTILS_CHAR_CYRILLIC_CAPITAL_PE, "P", 207},
+    {UTILS_CHAR_CYRILLIC_CAPITAL_ER, "R", 208},
+    {UTILS_CHAR_CYRILLIC_CAPITAL_ES, "S", 209},
+    {UTILS_CHAR_CYRILLIC_CAPITAL_TE, "T", 210},
+    {UTILS_CHAR_CYRILLIC_CAPITAL_U, "U", 211},
+    {UTILS_CHAR_CYRILLIC_CAPITAL_EF, "F", 212},
+    {UTILS_CHAR_CYRILLIC_CAPITAL_HA, "Kh", 213},
+    {UTILS_CHAR_CYRILLIC_CAPITAL_TSE, "Ts", 214},
+    {UTILS_CHAR_CYRILLIC_CAPITAL_CHE, "Ch", 215},
+    {UTILS_CHAR_CYRILLIC_CAPITAL_SHA, "Sh", 216},
+    {UTILS_CHAR_CYRILLIC_CAPITAL_SCHA, "Shch", 217},
+    {UTILS_CHAR_CYRILLIC_CAPITAL_HARD_SIGN, "\"", 218},
+    {UTILS_CHAR_CYRILLIC_CAPITAL_YERU, "Y", 219},
+    {UTILS_CHAR_CYRILLIC_CAPITAL_SOFT_SIGN, "'", 220},
+    {UTILS_CHAR_CYRILLIC_CAPITAL_E, "E", 221},
+    {UTILS_CHAR_CYRILLIC_CAPITAL_YU, "Yu", 222},
+    {UTILS_CHAR_CYRILLIC_CAPITAL_YA, "Ya", 223},
+    {UTILS_CHAR_CYRILLIC_SMALL_A, "a", 224},
+    {UTILS_CHAR_CYRILLIC_SMALL_BE, "b", 225},
+    {UTILS_CHAR_CYRILLIC_SMALL_VE, "v", 226},
+    {UTILS_CHAR_CYRILLIC_SMALL_GHE, "g", 227},
+    {UTILS_CHAR_CYRILLIC_SMALL_DE, "d", 228},
+    {UTILS_CHAR_CYRILLIC_SMALL_IE, "ye", 229},
+    {UTILS_CHAR_CYRILLIC_SMALL_ZHE, "zh", 230},
+    {UTILS_CHAR_CYRILLIC_SMALL_ZE, "z", 231},
+    {UTILS_CHAR_CYRILLIC_SMALL_I, "i", 232},
+    {UTILS_CHAR_CYRILLIC_SMALL_SHORT_I, "y", 233},
+    {UTILS_CHAR_CYRILLIC_SMALL_KA, "k", 234},
+    {UTILS_CHAR_CYRILLIC_SMALL_EL, "l", 235},
+    {UTILS_CHAR_CYRILLIC_SMALL_EM, "m", 236},
+    {UTILS_CHAR_CYRILLIC_SMALL_EN, "n", 237},
+    {UTILS_CHAR_CYRILLIC_SMALL_O, "o", 238},
+    {UTILS_CHAR_CYRILLIC_SMALL_PE, "p", 239},
+    {UTILS_CHAR_CYRILLIC_SMALL_ER, "r", 240},
+    {UTILS_CHAR_CYRILLIC_SMALL_ES, "s", 241},
+    {UTILS_CHAR_CYRILLIC_SMALL_TE, "t", 242},
+    {UTILS_CHAR_CYRILLIC_SMALL_U, "u", 243},
+    {UTILS_CHAR_CYRILLIC_SMALL_EF, "f", 244},
+    {UTILS_CHAR_CYRILLIC_SMALL_HA, "kh", 245},
+    {UTILS_CHAR_CYRILLIC_SMALL_TSE, "ts", 246},
+    {UTILS_CHAR_CYRILLIC_SMALL_CHE, "ch", 247},
+    {UTILS_CHAR_CYRILLIC_SMALL_SHA, "sh", 248},
+    {UTILS_CHAR_CYRILLIC_SMALL_SHCHA, "shch", 249},
+    {UTILS_CHAR_CYRILLIC_SMALL_LEFT_HARD_SIGN, "\"", 250},
+    {UTILS_CHAR_CYRILLIC_SMALL_YERU, "y", 251},
+    {UTILS_CHAR_CYRILLIC_SMALL_SOFT_SIGN, "'", 252},
+    {UTILS_CHAR_CYRILLIC_SMALL_E, "e", 253},
+    {UTILS_CHAR_CYRILLIC_SMALL_YU, "yu", 254},
+    {UTILS_CHAR_CYRILLIC_SMALL_YA, "ya", 255},
+    {UTILS_CHAR_CYRILLIC_SMALL_IO, "yo", 229},
+    {UTILS_CHAR_CYRILLIC_UA_SMALL_IE, "ye", 229},
+    {UTILS_CHAR_CYRILLIC_BY_UA_SMALL_I, "i", 0},
+    {UTILS_CHAR_CYRILLIC_SMALL_YI, "i", 0},
+    {UTILS_CHAR_CYRILLIC_SMALL_SHORT_U, "u", 243},
+    {UTILS_CHAR_HYPHEN, "-", 0},
+    {UTILS_CHAR_LEFT_SINGLE_QUOTATION_MARK, "'", 0},
+    {UTILS_CHAR_RIGHT_SINGLE_QUOTATION_MARK, "'", 0},
+    {UTILS_CHAR_HORIZONTAL_ELLIPSIS, "...", 0}
+};
+
+/* log2(1 + i / 32) for i = 0 - 32, with UTILS_LOG2_FRACTION_BITS fraction bits */
+static const uint16_t UTILS_LOG2_TABLE[] = {
+    0, 182, 358, 530, 696, 858, 1016, 1169,
+    1319, 1465, 1607, 1746, 1882, 2015, 2145, 2272,
+    2396, 2518, 2637, 2754, 2869, 2982, 3092, 3200,
+    3307, 3412, 3514, 3615, 3715, 3812, 3908, 4003,
+    4096
+};
 
 static int8_t BOARD_VERSION = -1;
 
@@ -90,8 +219,45 @@ void UtilsCheckRCON()
  */
 uint8_t UtilsConvertCmToIn(uint8_t cm)
 {
-    float impVal = cm / 2.54;
-    return (int)(impVal < 0 ? (impVal - 0.5) : (impVal + 0.5));
+    // cm / 2.54 is cm * 50 / 127, which never falls exactly on a half
+    return ((uint16_t) cm * 50 + 63) / 127;
+}
+
+/**
+ * UtilsConvertTextCharset()
+ *     Description:
+ *         Convert normalized text, which is in the GT character set, to the
+ *         character set of another display. This is a single table lookup
+ *         per byte, so UIs can run it once when they take on new text. The
+ *         Cyrillic codes of the Russian nav software are left as they are.
+ *     Params:
+ *         char *string - The text to convert in place
+ *         uint8_t charset - The UTILS_CHARSET_* of the display
+ *     Returns:
+ *         void
+ */
+void UtilsConvertTextCharset(char *string, uint8_t charset)
+{
+    if (charset == UTILS_CHARSET_LATIN1) {
+        return;
+    }
+    uint8_t isRussian = 0;
+    if (ConfigGetSetting(CONFIG_SETTING_LANGUAGE) == CONFIG_SETTING_LANGUAGE_RUSSIAN) {
+        isRussian = 1;
+    }
+    uint16_t idx = 0;
+    uint16_t strIdx = 0;
+    while (string[idx] != '\0') {
+        uint8_t currentChar = (uint8_t) string[idx++];
+        if (currentChar >= 0xA0 && (isRussian == 0 || currentChar < 0xC0)) {
+            currentChar = (uint8_t) UTILS_CHARSET_MAPS[charset][currentChar - 0xA0];
+            if (currentChar == 0) {
+                continue;
+            }
+        }
+        string[strIdx++] = (char) currentChar;
+    }
+    string[strIdx] = '\0';
 }
 
 /**
@@ -114,6 +280,280 @@ UtilsAbstractDisplayValue_t UtilsDisplayValueInit(char *text, uint8_t status)
     return value;
 }
 
+/**
+ * UtilsDisplayValueScroll()
+ *     Description:
+ *         Copy the frame of a scrolling display value that starts at its
+ *         current index and move the index on to the next frame. The text is
+ *         stored in the display character set already, so every byte is one
+ *         character and the frame bounds follow from the stored length
+ *         without walking the text.
+ *     Params:
+ *         UtilsAbstractDisplayValue_t *value - The display value to scroll
+ *         char *frame - The output buffer, at least width + 1 bytes long
+ *         uint8_t width - The number of characters the display shows
+ *         uint8_t step - How far to advance: 1 to scroll, the width to
+ *             page through the text in chunks or 0 to hold
+ *     Returns:
+ *         uint8_t - UTILS_DISPLAY_SCROLL_START and / or
+ *             UTILS_DISPLAY_SCROLL_END if this frame is the first and / or
+ *             last of the text, UTILS_DISPLAY_SCROLL_MIDDLE otherwise
+ */
+uint8_t UtilsDisplayValueScroll(
+    UtilsAbstractDisplayValue_t *value,
+    char *frame,
+    uint8_t width,
+    uint8_t step
+) {
+    uint8_t position = UTILS_DISPLAY_SCROLL_MIDDLE;
+    if (value->index >= value->length) {
+        value->index = 0;
+    }
+    if (value->index == 0) {
+        position |= UTILS_DISPLAY_SCROLL_START;
+    }
+    uint8_t frameLength = width;
+    if ((uint16_t) value->index + width >= value->length) {
+        frameLength = value->length - value->index;
+        position |= UTILS_DISPLAY_SCROLL_END;
+    }
+    memcpy(frame, &value->text[value->index], frameLength);
+    frame[frameLength] = '\0';
+    if ((position & UTILS_DISPLAY_SCROLL_END) != 0) {
+        value->index = 0;
+    } else {
+        value->index += step;
+    }
+    return position;
+}
+
+/**
+ * UtilsFormatPutChar()
+ *     Description:
+ *         Write a character of formatted output if it fits, counting it either
+ *         way so that the returned length matches snprintf()
+ *     Params:
+ *         char *string - The output buffer
+ *         uint16_t size - The size of the output buffer
+ *         uint16_t *length - The length of the output so far
+ *         char character - The character to write
+ *     Returns:
+ *         void
+ */
+static void UtilsFormatPutChar(
+    char *string,
+    uint16_t size,
+    uint16_t *length,
+    char character
+) {
+    if (*length + 1 < size) {
+        string[*length] = character;
+    }
+    (*length)++;
+}
+
+/**
+ * UtilsFormat()
+ *     Description:
+ *         A small replacement for snprintf() that covers the conversions this
+ *         firmware uses, so that the printf family does not need to be linked.
+ *         The format attribute on the prototype lets the compiler check the
+ *         arguments against the format string.
+ *     Params:
+ *         char *string - The output buffer
+ *         uint16_t size - The size of the output buffer
+ *         const char *format - The format, see UtilsFormatV()
+ *         ... - The values to format
+ *     Returns:
+ *         uint16_t - The length of the full output, as snprintf() returns
+ */
+uint16_t UtilsFormat(char *string, uint16_t size, const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    uint16_t length = UtilsFormatV(string, size, format, args);
+    va_end(args);
+    return length;
+}
+
+/**
+ * UtilsFormatV()
+ *     Description:
+ *         Format values into a string. The conversions are %c, %s, %d, %i,
+ *         %u, %x and %X with the "l" and "ll" length modifiers, the "0" and
+ *         "+" flags, a width and a precision. Output is truncated to the
+ *         buffer and always terminated.
+ *     Params:
+ *         char *string - The output buffer
+ *         uint16_t size - The size of the output buffer
+ *         const char *format - The format
+ *         va_list args - The values to format
+ *     Returns:
+ *         uint16_t - The length of the full output, as vsnprintf() returns
+ */
+uint16_t UtilsFormatV(
+    char *string,
+    uint16_t size,
+    const char *format,
+    va_list args
+) {
+    uint16_t length = 0;
+    while (*format != '\0') {
+        char character = *format++;
+        if (character != '%') {
+            UtilsFormatPutChar(string, size, &length, character);
+            continue;
+        }
+        uint8_t flags = 0;
+        while (*format == '0' || *format == '+') {
+            if (*format == '0') {
+                flags |= UTILS_FORMAT_FLAG_ZERO;
+            } else {
+                flags |= UTILS_FORMAT_FLAG_PLUS;
+            }
+            format++;
+        }
+        uint8_t width = 0;
+        while (*format >= '0' && *format <= '9') {
+            width = (width * 10) + (*format++ - '0');
+        }
+        int8_t precision = -1;
+        if (*format == '.') {
+            format++;
+            precision = 0;
+            while (*format >= '0' && *format <= '9') {
+                precision = (precision * 10) + (*format++ - '0');
+            }
+        }
+        uint8_t longCount = 0;
+        while (*format == 'l') {
+            longCount++;
+            format++;
+        }
+        char conversion = *format;
+        if (conversion == '\0') {
+            break;
+        }
+        format++;
+        if (conversion == 'c' || conversion == '%') {
+            if (conversion == 'c') {
+                character = (char) va_arg(args, int);
+            }
+            while (width > 1) {
+                UtilsFormatPutChar(string, size, &length, ' ');
+                width--;
+            }
+            UtilsFormatPutChar(string, size, &length, character);
+        } else if (conversion == 's') {
+            const char *text = va_arg(args, const char *);
+            uint16_t textLength = strlen(text);
+            while (width > textLength) {
+                UtilsFormatPutChar(string, size, &length, ' ');
+                width--;
+            }
+            while (*text != '\0') {
+                UtilsFormatPutChar(string, size, &length, *text++);
+            }
+        } else {
+            char digits[UTILS_FORMAT_DIGITS_SIZE];
+            uint8_t digitCount = 0;
+            char sign = 0;
+            uint8_t base = 10;
+            const char *digitChars = "0123456789abcdef";
+            if (conversion == 'x' || conversion == 'X') {
+                base = 16;
+                if (conversion == 'X') {
+                    digitChars = "0123456789ABCDEF";
+                }
+            }
+            if (longCount > 1) {
+                // 64-bit division is slow, so only long long values use it
+                unsigned long long value;
+                if (conversion == 'd' || conversion == 'i') {
+                    long long signedValue = va_arg(args, long long);
+                    value = (unsigned long long) signedValue;
+                    if (signedValue < 0) {
+                        value = 0 - value;
+                        sign = '-';
+                    }
+                } else {
+                    value = va_arg(args, unsigned long long);
+                }
+                while (value != 0) {
+                    digits[digitCount++] = digitChars[value % base];
+                    value /= base;
+                }
+            } else {
+                uint32_t value;
+                if (conversion == 'd' || conversion == 'i') {
+                    int32_t signedValue;
+                    if (longCount == 1) {
+                        signedValue = va_arg(args, long);
+                    } else {
+                        signedValue = va_arg(args, int);
+                    }
+                    value = (uint32_t) signedValue;
+                    if (signedValue < 0) {
+                        value = 0 - value;
+                        sign = '-';
+                    }
+                } else if (longCount == 1) {
+                    value = va_arg(args, unsigned long);
+                } else {
+                    value = va_arg(args, unsigned int);
+                }
+                while (value != 0) {
+                    digits[digitCount++] = digitChars[value % base];
+                    value /= base;
+                }
+            }
+            if (sign == 0 && (flags & UTILS_FORMAT_FLAG_PLUS) != 0) {
+                sign = '+';
+            }
+            // A zero is printed as one digit unless the precision is zero
+            uint8_t zeroCount = 0;
+            if (precision < 0) {
+                precision = 1;
+            } else {
+                flags &= ~UTILS_FORMAT_FLAG_ZERO;
+            }
+            if (precision > digitCount) {
+                zeroCount = precision - digitCount;
+            }
+            uint8_t outputLength = digitCount + zeroCount;
+            if (sign != 0) {
+                outputLength++;
+            }
+            if ((flags & UTILS_FORMAT_FLAG_ZERO) != 0 && width > outputLength) {
+                zeroCount += width - outputLength;
+                outputLength = width;
+            }
+            while (width > outputLength) {
+                UtilsFormatPutChar(string, size, &length, ' ');
+                width--;
+            }
+            if (sign != 0) {
+                UtilsFormatPutChar(string, size, &length, sign);
+            }
+            while (zeroCount > 0) {
+                UtilsFormatPutChar(string, size, &length, '0');
+                zeroCount--;
+            }
+            while (digitCount > 0) {
+                UtilsFormatPutChar(string, size, &length, digits[--digitCount]);
+            }
+        }
+    }
+    if (size > 0) {
+        if (length < size) {
+            string[length] = '\0';
+        } else {
+            string[size - 1] = '\0';
+        }
+    }
+    return length;
+}
+
 /**
  * UtilsGetBoardVersion()
  *     Description:
@@ -179,11 +619,195 @@ uint8_t UtilsGetUnicodeByteLength(uint8_t byte)
     return bytesInChar;
 }
 
+/**
+ * UtilsHash()
+ *     Description:
+ *         Compute a 16-bit djb2 (xor) hash over the given bytes. The hash of
+ *         one buffer can be passed as the seed of the next to hash several
+ *         buffers as one. This is meant for change detection and not for
+ *         anything that needs to resist collisions.
+ *     Params:
+ *         uint16_t hash - The seed, UTILS_HASH_SEED for a new hash
+ *         const uint8_t *data - The bytes to hash
+ *         uint16_t length - The number of bytes to hash
+ *     Returns:
+ *         uint16_t - The hash
+ */
+uint16_t UtilsHash(uint16_t hash, const uint8_t *data, uint16_t length)
+{
+    uint16_t i;
+    for (i = 0; i < length; i++) {
+        hash = ((hash << 5) + hash) ^ data[i];
+    }
+    return hash;
+}
+
+/**
+ * UtilsHexToNibble()
+ *     Description:
+ *         Convert a single hex character to its value
+ *     Params:
+ *         char c - The hex character
+ *     Returns:
+ *         uint8_t - The value, or UTILS_HEX_INVALID if c is not a hex character
+ */
+uint8_t UtilsHexToNibble(char c)
+{
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    } else if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    } else if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    return UTILS_HEX_INVALID;
+}
+
+/**
+ * UtilsLog2()
+ *     Description:
+ *         Compute the base 2 logarithm of a value in fixed point, without
+ *         pulling in the soft-float math library. The fraction is
+ *         interpolated from a lookup table and is accurate to within
+ *         0.0005.
+ *     Params:
+ *         uint16_t value - The value, which must be greater than zero
+ *     Returns:
+ *         uint16_t - log2(value) with UTILS_LOG2_FRACTION_BITS fraction bits
+ */
+uint16_t UtilsLog2(uint16_t value)
+{
+    if (value == 0) {
+        return 0;
+    }
+    uint8_t exponent = 15;
+    while ((value & 0x8000) == 0) {
+        value <<= 1;
+        exponent--;
+    }
+    // The 15 bits below the leading one are the mantissa fraction
+    uint8_t tableIdx = (value >> (15 - UTILS_LOG2_TABLE_BITS)) & 0x1F;
+    uint16_t remainder = value & ((1 << (15 - UTILS_LOG2_TABLE_BITS)) - 1);
+    uint16_t low = UTILS_LOG2_TABLE[tableIdx];
+    uint16_t step = UTILS_LOG2_TABLE[tableIdx + 1] - low;
+    uint16_t fraction = low + (uint16_t) (
+        ((uint32_t) step * remainder) >> (15 - UTILS_LOG2_TABLE_BITS)
+    );
+    return ((uint16_t) exponent << UTILS_LOG2_FRACTION_BITS) + fraction;
+}
+
+/**
+ * UtilsNormalizeDecode()
+ *     Description:
+ *         Decode the next character of the input, which is either a plain
+ *         byte, a UTF-8 sequence or a "\XX" escaped UTF-8 sequence
+ *     Params:
+ *         const char *input - The string to decode from
+ *         uint16_t *idx - The position in the input, advanced past the
+ *             character
+ *         uint16_t length - The length of the input
+ *     Returns:
+ *         uint32_t - The UTF-8 bytes of the character, packed from the lead
+ *             byte down, or 0 if the input ended within the sequence
+ */
+static uint32_t UtilsNormalizeDecode(const char *input, uint16_t *idx, uint16_t length)
+{
+    uint8_t currentChar = (uint8_t) input[*idx];
+    uint32_t unicodeChar = 0;
+    uint8_t bytesInChar;
+    if (currentChar == '\\') {
+        char currentByteBuf[] = {input[*idx + 1], input[*idx + 2], '\0'};
+        // Identify number of bytes to read from the first byte
+        bytesInChar = UtilsGetUnicodeByteLength(UtilsStrToHex(currentByteBuf));
+        uint8_t charsToRead = bytesInChar * 3;
+        // Identify if we can read all the bytes
+        if ((*idx + charsToRead) > length) {
+            *idx = length;
+            return 0;
+        }
+        while (bytesInChar != 0) {
+            char buf[] = {input[*idx + 1], input[*idx + 2], '\0'};
+            unicodeChar = unicodeChar << 8 | UtilsStrToHex(buf);
+            bytesInChar--;
+            *idx += 3;
+        }
+    } else if (currentChar > 0x7F) {
+        bytesInChar = UtilsGetUnicodeByteLength(currentChar);
+        // Identify if we can read all the bytes
+        if ((*idx + bytesInChar) > length) {
+            *idx = length;
+            return 0;
+        }
+        while (bytesInChar != 0) {
+            unicodeChar = unicodeChar << 8 | (uint8_t) input[*idx];
+            bytesInChar--;
+            (*idx)++;
+        }
+    } else {
+        unicodeChar = currentChar;
+        (*idx)++;
+    }
+    return unicodeChar;
+}
+
+/**
+ * UtilsNormalizeTransliteration()
+ *     Description:
+ *         Look a character up in the transliteration table
+ *     Params:
+ *         uint32_t unicodeChar - The UTF-8 bytes of the character
+ *     Returns:
+ *         const UtilsTransliteration_t * - The table entry, or 0 if there is
+ *             none for the character
+ */
+static const UtilsTransliteration_t *UtilsNormalizeTransliteration(uint32_t unicodeChar)
+{
+    uint8_t low = 0;
+    uint8_t high = sizeof(UTILS_TRANSLIT_UNICODE) / sizeof(UTILS_TRANSLIT_UNICODE[0]);
+    while (low < high) {
+        uint8_t mid = (low + high) / 2;
+        if (UTILS_TRANSLIT_UNICODE[mid].character < unicodeChar) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    if (
+        low < sizeof(UTILS_TRANSLIT_UNICODE) / sizeof(UTILS_TRANSLIT_UNICODE[0]) &&
+        UTILS_TRANSLIT_UNICODE[low].character == unicodeChar
+    ) {
+        return &UTILS_TRANSLIT_UNICODE[low];
+    }
+    return 0;
+}
+
+/**
+ * UtilsNormalizeCharsetMap()
+ *     Description:
+ *         Look a character up in the display code map of a character set
+ *     Params:
+ *         uint8_t charset - The UTILS_CHARSET_* to map to
+ *         uint32_t character - The Unicode code point of the character
+ *     Returns:
+ *         char - The display code, or 0 if the character set cannot show
+ *             the character
+ */
+static char UtilsNormalizeCharsetMap(uint8_t charset, uint32_t character)
+{
+    if (character < 0xA0 || character >= 0xA0 + UTILS_CHARSET_MAP_SIZE) {
+        return 0;
+    }
+    return UTILS_CHARSET_MAPS[charset][character - 0xA0];
+}
+
 /**
  * UtilsNormalizeText()
  *     Description:
  *         Unescape characters and convert them from UTF-8 to their Unicode
- *         bytes. This is to support extended ASCII.
+ *         bytes. This is to support extended ASCII. The text is normalized
+ *         to ISO-8859-1, which is what the GT shows, with the language taken
+ *         from the configuration. Other displays convert it to their own
+ *         character set with UtilsConvertTextCharset().
  *     Params:
  *         char *string - The subject
  *         const char *input - The string to copy from
@@ -193,116 +817,82 @@ uint8_t UtilsGetUnicodeByteLength(uint8_t byte)
  */
 void UtilsNormalizeText(char *string, const char *input, uint16_t max_len)
 {
+    UtilsNormalizeTextCharset(
+        string,
+        input,
+        max_len,
+        ConfigGetSetting(CONFIG_SETTING_LANGUAGE),
+        UTILS_CHARSET_LATIN1
+    );
+}
+
+/**
+ * UtilsNormalizeTextCharset()
+ *     Description:
+ *         Unescape characters and convert them from UTF-8 to the given
+ *         character set. Characters that the character set lacks are
+ *         replaced by their closest ASCII, or dropped if there is none.
+ *     Params:
+ *         char *string - The subject
+ *         const char *input - The string to copy from
+ *         uint16_t max_len - Max output buffer size
+ *         uint8_t language - The CONFIG_SETTING_LANGUAGE_* of the display
+ *         uint8_t charset - The UTILS_CHARSET_* of the display
+ *     Returns:
+ *         void
+ */
+void UtilsNormalizeTextCharset(
+    char *string,
+    const char *input,
+    uint16_t max_len,
+    uint8_t language,
+    uint8_t charset
+) {
     uint16_t idx = 0;
     uint16_t strIdx = 0;
-    uint32_t unicodeChar;
-
-    char *transStr;
-    uint8_t transIdx;
-    uint8_t transStrLength;
-
     uint16_t strLength = strlen(input);
-    uint8_t bytesInChar = 0;
-    uint8_t language = ConfigGetSetting(CONFIG_SETTING_LANGUAGE);
-
-
-    uint8_t uiMode = ConfigGetUIMode();
-
+    const char *transStr;
     while (idx < strLength && strIdx < (max_len - 1)) {
-        uint8_t currentChar = (uint8_t) input[idx];
-        unicodeChar = currentChar;
-
-        if (currentChar == '\\') {
-            unicodeChar = 0;
-            char currentByteBuf[] = {input[idx + 1], input[idx + 2], '\0'};
-            uint8_t currentByte = UtilsStrToHex(currentByteBuf);
-            // Identify number of bytes to read from the first byte
-            bytesInChar = UtilsGetUnicodeByteLength(currentByte);
-            uint8_t charsToRead = bytesInChar * 3;
-            // Identify if we can read all the bytes
-            if ((idx + charsToRead) <= strLength) {
-                uint8_t byteIdx = idx;
-                while (bytesInChar != 0) {
-                    char buf[] = {input[byteIdx + 1], input[byteIdx + 2], '\0'};
-                    uint8_t byte = UtilsStrToHex(buf);
-                    unicodeChar = unicodeChar << 8 | byte;
-                    bytesInChar--;
-                    byteIdx = byteIdx + 3;
-                }
-                idx = idx + charsToRead;
-            } else {
-                idx = strLength;
-            }
-        } else if (currentChar > 0x7F) {
-            unicodeChar = 0;
-            bytesInChar = UtilsGetUnicodeByteLength(currentChar);
-            // Identify if we can read all the bytes
-            if ((idx + bytesInChar) <= strLength) {
-                while (bytesInChar != 0) {
-                    uint8_t byte = input[idx];
-                    unicodeChar = unicodeChar << 8 | byte;
-                    bytesInChar--;
-                    idx++;
-                }
-            } else {
-                idx = strLength;
-            }
-        } else {
-            idx++;
-        }
-
+        uint32_t unicodeChar = UtilsNormalizeDecode(input, &idx, strLength);
+        // Convert UTF-8 bytes to Unicode, which is only meaningful for
+        // the two byte sequences that cover extended ASCII
+        uint32_t extendedChar = (unicodeChar & 0xFF) + ((unicodeChar >> 8) - 0xC2) * 64;
+        char displayChar = 0;
+        transStr = "";
         if (unicodeChar >= 0x20 && unicodeChar <= 0x7E) {
-            string[strIdx++] = (char) unicodeChar;
-        } else if ((uiMode == CONFIG_UI_BMBT)&&(unicodeChar >= 0xA0)&& (unicodeChar <= 0xFC)) {
-            string[strIdx++] = (char) unicodeChar;
-        } else if (unicodeChar >= 0xC0 && unicodeChar <= 0x017F) {
-            string[strIdx++] = UTILS_CHARS_LATIN[unicodeChar - 0xC0];
+            displayChar = (char) unicodeChar;
+        } else if (unicodeChar <= 0x017F) {
+            displayChar = UtilsNormalizeCharsetMap(charset, unicodeChar);
         } else if (unicodeChar >= 0xC280 && unicodeChar <= 0xC3BF) {
-            if (language == CONFIG_SETTING_LANGUAGE_RUSSIAN &&
-                unicodeChar >= 0xC380
-            ) {
-                transStr = UtilsTransliterateExtendedASCIIToASCII(unicodeChar);
-                transStrLength = strlen(transStr);
-
-                if ((transStrLength != 0)&&(strIdx+transStrLength<(max_len-1))) {
-                    for (transIdx = 0; transIdx < transStrLength; transIdx++) {
-                        string[strIdx++] = (char)transStr[transIdx];
-                    }
-                }
+            if (language == CONFIG_SETTING_LANGUAGE_RUSSIAN && unicodeChar >= 0xC380) {
+                transStr = UTILS_TRANSLIT_LATIN1[unicodeChar - 0xC380];
             } else {
-                // Convert UTF-8 byte to Unicode then check if it falls within
-                // the range of extended ASCII
-                uint32_t extendedChar = (unicodeChar & 0xFF) + ((unicodeChar >> 8) - 0xC2) * 64;
-                if (uiMode == CONFIG_UI_BMBT && extendedChar >= 0xA0 && extendedChar <= 0xFC) {
-                    string[strIdx++] = (char) extendedChar;
-                } else if (extendedChar >= 0xC0 && extendedChar <= 0x017F) {
-                    string[strIdx++] = UTILS_CHARS_LATIN[extendedChar - 0xC0];
-                }
+                displayChar = UtilsNormalizeCharsetMap(charset, extendedChar);
             }
         } else if (unicodeChar > 0xC3BF) {
-            uint8_t transChar = 0;
-            if (language == CONFIG_SETTING_LANGUAGE_RUSSIAN) {
-                transChar = UtilsConvertCyrillicUnicodeToExtendedASCII(unicodeChar);
-            }
-            if (transChar != 0) {
-                string[strIdx++] = transChar;
+            const UtilsTransliteration_t *translit = UtilsNormalizeTransliteration(unicodeChar);
+            if (
+                language == CONFIG_SETTING_LANGUAGE_RUSSIAN &&
+                translit != 0 &&
+                translit->extendedASCII != 0
+            ) {
+                displayChar = translit->extendedASCII;
             } else {
-                uint32_t extendedChar = (unicodeChar & 0xFF) + ((unicodeChar >> 8) - 0xC2) * 64;
-                if (uiMode == CONFIG_UI_BMBT && extendedChar >= 0xA0 && extendedChar <= 0xFC) {
-                    string[strIdx++] = (char) extendedChar;
-                } else if (extendedChar >= 0xC0 && extendedChar <= 0x017F) {
-                    string[strIdx++] = UTILS_CHARS_LATIN[extendedChar - 0xC0];
-                } else {
-                    transStr = UtilsTransliterateUnicodeToASCII(unicodeChar);
-                    transStrLength = strlen(transStr);
-                    if ((transStrLength != 0)&&(strIdx+transStrLength<(max_len-1))) {
-                        for (transIdx = 0; transIdx < transStrLength; transIdx++) {
-                            string[strIdx++] = (char)transStr[transIdx];
-                        }
-                    }
+                displayChar = UtilsNormalizeCharsetMap(charset, extendedChar);
+                if (displayChar == 0 && translit != 0) {
+                    transStr = translit->ascii;
                 }
             }
         }
+        if (displayChar != 0) {
+            string[strIdx++] = displayChar;
+        }
+        // Multi-character replacements are only written if they fit whole
+        uint8_t transStrLength = strlen(transStr);
+        if (transStrLength != 0 && strIdx + transStrLength < (max_len - 1)) {
+            memcpy(string + strIdx, transStr, transStrLength);
+            strIdx += transStrLength;
+        }
     }
     string[strIdx] = '\0';
 }
@@ -470,6 +1060,31 @@ int8_t UtilsStricmp(const char *string, const char *compare)
     return result;
 }
 
+/**
+ * UtilsStrnicmp()
+ *     Description:
+ *         Case-Insensitive comparison of at most the given number of
+ *         characters, so that a string can be checked for a prefix
+ *     Params:
+ *         const char *string - The subject
+ *         const char *compare - The string to compare the subject against
+ *         size_t length - The maximum number of characters to compare
+ *     Returns:
+ *         int8_t -
+ *             Negative 1 when string is less than compare
+ *             Zero when string matches compare
+ *             Positive 1 when string is greater than compare
+ */
+int8_t UtilsStrnicmp(const char *string, const char *compare, size_t length)
+{
+    int8_t result = 0;
+    while (length-- > 0 && !(result = toupper(*string) - toupper(*compare)) && *string) {
+        string++;
+        compare++;
+    }
+    return result;
+}
+
 /**
  * UtilsStrncpy()
  *     Description:
@@ -539,593 +1154,3 @@ int16_t UtilsCharIndex(char *string, uint8_t needle)
     }
     return -1;
 }
-
-/**
- * UtilsTransliterateUnicodeToASCII()
- *     Description:
- *         Transliterates Unicode character to the corresponding ASCII string.
- *         Extend this mapping to add new characters support.
- *     Params:
- *         uint32_t input - Representation of the Unicode character
- *     Returns:
- *         char * - Corresponding Extended ASCII characters
- */
-char * UtilsTransliterateUnicodeToASCII(uint32_t input)
-{
-    switch (input) {
-        case UTILS_CHAR_LATIN_SMALL_CAPITAL_R:
-            return "R";
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_IO:
-            return "Yo";
-            break;
-        case UTILS_CHAR_CYRILLIC_UA_CAPITAL_IE:
-            return "E";
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_I:
-        case UTILS_CHAR_CYRILLIC_BY_UA_CAPITAL_I:
-        case UTILS_CHAR_CYRILLIC_CAPITAL_YI:
-            return "I";
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_A:
-            return "A";
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_BE:
-            return "B";
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_VE:
-            return "V";
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_GHE:
-            return "G";
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_DE:
-            return "D";
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_YE:
-            return "Ye";
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_ZHE:
-            return "Zh";
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_ZE:
-            return "Z";
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_SHORT_I:
-            return "Y";
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_KA:
-            return "K";
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_EL:
-            return "L";
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_EM:
-            return "M";
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_EN:
-            return "N";
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_O:
-            return "O";
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_PE:
-            return "P";
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_ER:
-            return "R";
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_ES:
-            return "S";
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_TE:
-            return "T";
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_U:
-        case UTILS_CHAR_CYRILLIC_CAPITAL_SHORT_U:
-            return "U";
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_EF:
-            return "F";
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_HA:
-            return "Kh";
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_TSE:
-            return "Ts";
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_CHE:
-            return "Ch";
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_SHA:
-            return "Sh";
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_SCHA:
-            return "Shch";
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_HARD_SIGN:
-            return "\"";
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_YERU:
-            return "Y";
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_SOFT_SIGN:
-            return "'";
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_E:
-            return "E";
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_YU:
-            return "Yu";
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_YA:
-            return "Ya";
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_A:
-            return "a";
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_BE:
-            return "b";
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_VE:
-            return "v";
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_GHE:
-            return "g";
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_DE:
-            return "d";
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_IE:
-        case UTILS_CHAR_CYRILLIC_UA_SMALL_IE:
-            return "ye";
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_ZHE:
-            return "zh";
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_ZE:
-            return "z";
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_I:
-        case UTILS_CHAR_CYRILLIC_BY_UA_SMALL_I:
-        case UTILS_CHAR_CYRILLIC_SMALL_YI:
-            return "i";
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_SHORT_I:
-            return "y";
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_KA:
-            return "k";
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_EL:
-            return "l";
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_EM:
-            return "m";
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_EN:
-            return "n";
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_O:
-            return "o";
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_PE:
-            return "p";
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_ER:
-            return "r";
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_ES:
-            return "s";
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_TE:
-            return "t";
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_U:
-        case UTILS_CHAR_CYRILLIC_SMALL_SHORT_U:
-            return "u";
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_EF:
-            return "f";
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_HA:
-            return "kh";
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_TSE:
-            return "ts";
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_CHE:
-            return "ch";
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_SHA:
-            return "sh";
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_SHCHA:
-            return "shch";
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_LEFT_HARD_SIGN:
-            return "\"";
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_YERU:
-            return "y";
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_SOFT_SIGN:
-            return "'";
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_YU:
-            return "yu";
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_YA:
-            return "ya";
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_IO:
-            return "yo";
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_E:
-            return "e";
-            break;
-        case UTILS_CHAR_HYPHEN:
-            return "-";
-            break;
-        case UTILS_CHAR_LEFT_SINGLE_QUOTATION_MARK:
-        case UTILS_CHAR_RIGHT_SINGLE_QUOTATION_MARK:
-            return "'";
-            break;
-        case UTILS_CHAR_HORIZONTAL_ELLIPSIS:
-            return "...";
-            break;
-        default:
-            return "";
-            break;
-    }
-}
-
-/**
- * UtilsTransliterateExtendedASCIIToASCII()
- *     Description:
- *         Converts 192-255 range of extended ASCII symbols to common ASCII symbols
- *         Only for modified nav software.
- *     Params:
- *         uint32_t input - Representation of the Unicode character
- *     Returns:
- *         char * - Corresponding Extended ASCII characters
- */
-char * UtilsTransliterateExtendedASCIIToASCII(uint32_t input)
-{
-    switch (input) {
-        case UTILS_CHAR_LATIN_CAPITAL_A_WITH_GRAVE:
-        case UTILS_CHAR_LATIN_CAPITAL_A_WITH_ACUTE:
-        case UTILS_CHAR_LATIN_CAPITAL_A_WITH_CIRCUMFLEX:
-        case UTILS_CHAR_LATIN_CAPITAL_A_WITH_TILDE:
-        case UTILS_CHAR_LATIN_CAPITAL_A_WITH_DIAERESIS:
-        case UTILS_CHAR_LATIN_CAPITAL_A_WITH_RING_ABOVE:
-            return "A";
-            break;
-        case UTILS_CHAR_LATIN_CAPITAL_AE:
-            return "Ae";
-            break;
-        case UTILS_CHAR_LATIN_CAPITAL_C_WITH_CEDILLA:
-            return "C";
-            break;
-        case UTILS_CHAR_LATIN_CAPITAL_E_WITH_GRAVE:
-        case UTILS_CHAR_LATIN_CAPITAL_E_WITH_ACUTE:
-        case UTILS_CHAR_LATIN_CAPITAL_E_WITH_CIRCUMFLEX:
-        case UTILS_CHAR_LATIN_CAPITAL_E_WITH_DIAERESIS:
-            return "E";
-            break;
-        case UTILS_CHAR_LATIN_CAPITAL_I_WITH_GRAVE:
-        case UTILS_CHAR_LATIN_CAPITAL_I_WITH_ACUTE:
-        case UTILS_CHAR_LATIN_CAPITAL_I_WITH_CIRCUMFLEX:
-        case UTILS_CHAR_LATIN_CAPITAL_I_WITH_DIAERESIS:
-            return "I";
-            break;
-        case UTILS_CHAR_LATIN_CAPITAL_ETH:
-            return "Eth";
-            break;
-        case UTILS_CHAR_LATIN_CAPITAL_N_WITH_TILDE:
-            return "N";
-            break;
-        case UTILS_CHAR_LATIN_CAPITAL_O_WITH_GRAVE:
-        case UTILS_CHAR_LATIN_CAPITAL_O_WITH_ACUTE:
-        case UTILS_CHAR_LATIN_CAPITAL_O_WITH_CIRCUMFLEX:
-        case UTILS_CHAR_LATIN_CAPITAL_O_WITH_TILDE:
-        case UTILS_CHAR_LATIN_CAPITAL_O_WITH_DIAERESIS:
-        case UTILS_CHAR_LATIN_CAPITAL_O_WITH_STROKE:
-            return "O";
-            break;
-        case UTILS_CHAR_MULTIPLICATION_SIGN:
-            return "x";
-            break;
-        case UTILS_CHAR_LATIN_CAPITAL_U_WITH_GRAVE:
-        case UTILS_CHAR_LATIN_CAPITAL_U_WITH_ACUTE:
-        case UTILS_CHAR_LATIN_CAPITAL_U_WITH_CIRCUMFLEX:
-        case UTILS_CHAR_LATIN_CAPITAL_U_WITH_DIAERESIS:
-            return "U";
-            break;
-        case UTILS_CHAR_LATIN_CAPITAL_Y_WITH_ACUTE:
-            return "Y";
-            break;
-        case UTILS_CHAR_LATIN_CAPITAL_THORN:
-            return "Th";
-            break;
-        case UTILS_CHAR_LATIN_SMALL_SHARP_S:
-            return "ss";
-            break;
-        case UTILS_CHAR_LATIN_SMALL_A_WITH_GRAVE:
-        case UTILS_CHAR_LATIN_SMALL_A_WITH_ACUTE:
-        case UTILS_CHAR_LATIN_SMALL_A_WITH_CIRCUMFLEX:
-        case UTILS_CHAR_LATIN_SMALL_A_WITH_TILDE:
-        case UTILS_CHAR_LATIN_SMALL_A_WITH_DIAERESIS:
-        case UTILS_CHAR_LATIN_SMALL_A_WITH_RING_ABOVE:
-            return "a";
-            break;
-        case UTILS_CHAR_LATIN_SMALL_AE:
-            return "ae";
-            break;
-        case UTILS_CHAR_LATIN_SMALL_C_WITH_CEDILLA:
-            return "c";
-            break;
-        case UTILS_CHAR_LATIN_SMALL_E_WITH_GRAVE:
-        case UTILS_CHAR_LATIN_SMALL_E_WITH_ACUTE:
-        case UTILS_CHAR_LATIN_SMALL_E_WITH_CIRCUMFLEX:
-        case UTILS_CHAR_LATIN_SMALL_E_WITH_DIAERESIS:
-            return "e";
-            break;
-        case UTILS_CHAR_LATIN_SMALL_I_WITH_GRAVE:
-        case UTILS_CHAR_LATIN_SMALL_I_WITH_ACUTE:
-        case UTILS_CHAR_LATIN_SMALL_I_WITH_CIRCUMFLEX:
-        case UTILS_CHAR_LATIN_SMALL_I_WITH_DIAERESIS:
-            return "i";
-            break;
-        case UTILS_CHAR_LATIN_SMALL_ETH:
-            return "eth";
-            break;
-        case UTILS_CHAR_LATIN_SMALL_N_WITH_TILDE:
-            return "n";
-            break;
-        case UTILS_CHAR_LATIN_SMALL_O_WITH_GRAVE:
-        case UTILS_CHAR_LATIN_SMALL_O_WITH_ACUTE:
-        case UTILS_CHAR_LATIN_SMALL_O_WITH_CIRCUMFLEX:
-        case UTILS_CHAR_LATIN_SMALL_O_WITH_TILDE:
-        case UTILS_CHAR_LATIN_SMALL_O_WITH_DIAERESIS:
-        case UTILS_CHAR_LATIN_SMALL_O_WITH_STROKE:
-            return "o";
-            break;
-        case UTILS_CHAR_DIVISION_SIGN:
-            return "%";
-            break;
-        case UTILS_CHAR_LATIN_SMALL_U_WITH_GRAVE:
-        case UTILS_CHAR_LATIN_SMALL_U_WITH_ACUTE:
-        case UTILS_CHAR_LATIN_SMALL_U_WITH_CIRCUMFLEX:
-        case UTILS_CHAR_LATIN_SMALL_U_WITH_DIAERESIS:
-            return "u";
-            break;
-        case UTILS_CHAR_LATIN_SMALL_Y_WITH_ACUTE:
-        case UTILS_CHAR_LATIN_SMALL_Y_WITH_DIAERESIS:
-            return "y";
-            break;
-        case UTILS_CHAR_LATIN_SMALL_THORN:
-            return "th";
-            break;
-        default:
-            return "";
-            break;
-    }
-}
-
-/**
- * UtilsConvertCyrillicUnicodeToExtendedASCII()
- *     Description:
- *         Translates Cyrillic Unicode symbols to the corresponding Extended ASCII symbols (192-255).
- *         Only for modified nav software.
- *     Params:
- *         uint32_t - Representation of the Cyrillic Unicode character
- *     Returns:
- *         uint8_t - Corresponding Extended ASCII characters
- */
-uint8_t UtilsConvertCyrillicUnicodeToExtendedASCII(uint32_t input)
-{
-    switch (input) {
-        case UTILS_CHAR_CYRILLIC_CAPITAL_A:
-            return 192;
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_BE:
-            return 193;
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_VE:
-            return 194;
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_GHE:
-            return 195;
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_DE:
-            return 196;
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_IO:
-        case UTILS_CHAR_CYRILLIC_UA_CAPITAL_IE:
-        case UTILS_CHAR_CYRILLIC_CAPITAL_YE:
-            return 197;
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_ZHE:
-            return 198;
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_ZE:
-            return 199;
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_I:
-            return 200;
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_SHORT_I:
-            return 201;
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_KA:
-            return 202;
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_EL:
-            return 203;
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_EM:
-            return 204;
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_EN:
-            return 205;
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_O:
-            return 206;
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_PE:
-            return 207;
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_ER:
-            return 208;
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_ES:
-            return 209;
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_TE:
-            return 210;
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_U:
-        case UTILS_CHAR_CYRILLIC_CAPITAL_SHORT_U:
-            return 211;
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_EF:
-            return 212;
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_HA:
-            return 213;
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_TSE:
-            return 214;
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_CHE:
-            return 215;
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_SHA:
-            return 216;
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_SCHA:
-            return 217;
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_HARD_SIGN:
-            return 218;
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_YERU:
-            return 219;
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_SOFT_SIGN:
-            return 220;
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_E:
-            return 221;
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_YU:
-            return 222;
-            break;
-        case UTILS_CHAR_CYRILLIC_CAPITAL_YA:
-            return 223;
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_A:
-            return 224;
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_BE:
-            return 225;
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_VE:
-            return 226;
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_GHE:
-            return 227;
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_DE:
-            return 228;
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_IE:
-        case UTILS_CHAR_CYRILLIC_SMALL_IO:
-        case UTILS_CHAR_CYRILLIC_UA_SMALL_IE:
-            return 229;
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_ZHE:
-            return 230;
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_ZE:
-            return 231;
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_I:
-            return 232;
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_SHORT_I:
-            return 233;
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_KA:
-            return 234;
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_EL:
-            return 235;
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_EM:
-            return 236;
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_EN:
-            return 237;
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_O:
-            return 238;
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_PE:
-            return 239;
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_ER:
-            return 240;
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_ES:
-            return 241;
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_TE:
-            return 242;
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_U:
-        case UTILS_CHAR_CYRILLIC_SMALL_SHORT_U:
-            return 243;
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_EF:
-            return 244;
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_HA:
-            return 245;
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_TSE:
-            return 246;
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_CHE:
-            return 247;
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_SHA:
-            return 248;
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_SHCHA:
-            return 249;
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_LEFT_HARD_SIGN:
-            return 250;
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_YERU:
-            return 251;
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_SOFT_SIGN:
-            return 252;
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_E:
-            return 253;
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_YU:
-            return 254;
-            break;
-        case UTILS_CHAR_CYRILLIC_SMALL_YA:
-            return 255;
-            break;
-        default:
-            return 0;
-            break;
-    }
-}
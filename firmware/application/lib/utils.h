@@ -6,6 +6,7 @@
  */
 #ifndef UTILS_H
 #define UTILS_H
+#include <stdarg.h>
 #include <stdint.h>
 #include <stdlib.h>
 
@@ -153,6 +154,10 @@
 #define UTILS_CHAR_RIGHT_SINGLE_QUOTATION_MARK 0xE28099
 #define UTILS_CHAR_HORIZONTAL_ELLIPSIS 0xE280A6
 
+#define UTILS_CHARSET_IBUS 0
+#define UTILS_CHARSET_LATIN1 1
+#define UTILS_CHARSET_MAP_SIZE 224
+
 #define UTILS_DATETIME_YEAR 0
 #define UTILS_DATETIME_MONTH 1
 #define UTILS_DATETIME_DAY 2
@@ -161,7 +166,17 @@
 #define UTILS_DATETIME_SEC 5
 
 #define UTILS_MAX_RPOR_PIN 31
+#define UTILS_DISPLAY_SCROLL_MIDDLE 0x00
+#define UTILS_DISPLAY_SCROLL_START 0x01
+#define UTILS_DISPLAY_SCROLL_END 0x02
 #define UTILS_DISPLAY_TEXT_SIZE 255
+#define UTILS_FORMAT_FLAG_ZERO 0x01
+#define UTILS_FORMAT_FLAG_PLUS 0x02
+#define UTILS_FORMAT_DIGITS_SIZE 20
+#define UTILS_HASH_SEED 0x1505
+#define UTILS_HEX_INVALID 0xFF
+#define UTILS_LOG2_FRACTION_BITS 12
+#define UTILS_LOG2_TABLE_BITS 5
 #define UTILS_PIN_TEL_MUTE 0
 #define UTILS_PIN_TEL_ON 1
 
@@ -191,24 +206,45 @@ typedef struct UtilsAbstractDisplayValue_t {
     uint8_t status;
     int8_t timeout;
 } UtilsAbstractDisplayValue_t;
+/*
+ * UtilsTransliteration_t
+ *  This is a struct to hold the replacements for a character that the
+ *  displays cannot show
+ *  character: The UTF-8 bytes of the character, packed from the lead byte
+ *  ascii: The closest ASCII text
+ *  extendedASCII: The code of the character for the Russian nav software,
+ *      or 0 if it has none
+ */
+typedef struct UtilsTransliteration_t {
+    uint32_t character;
+    const char *ascii;
+    uint8_t extendedASCII;
+} UtilsTransliteration_t;
 void UtilsCheckRCON();
 uint8_t UtilsConvertCmToIn(uint8_t);
+void UtilsConvertTextCharset(char *, uint8_t);
 UtilsAbstractDisplayValue_t UtilsDisplayValueInit(char *, uint8_t);
+uint8_t UtilsDisplayValueScroll(UtilsAbstractDisplayValue_t *, char *, uint8_t, uint8_t);
+uint16_t UtilsFormat(char *, uint16_t, const char *, ...)
+    __attribute__((format(printf, 3, 4)));
+uint16_t UtilsFormatV(char *, uint16_t, const char *, va_list);
 uint8_t UtilsGetBoardVersion();
 uint8_t UtilsGetMinByte(uint8_t *, uint8_t);
 uint8_t UtilsGetUnicodeByteLength(uint8_t);
+uint16_t UtilsHash(uint16_t, const uint8_t *, uint16_t);
+uint8_t UtilsHexToNibble(char);
+uint16_t UtilsLog2(uint16_t);
 void UtilsNormalizeText(char *, const char *, uint16_t);
+void UtilsNormalizeTextCharset(char *, const char *, uint16_t, uint8_t, uint8_t);
 uint8_t UtilsSubstrExists(const char *, uint8_t, const char *, char);
 void UtilsSubstrRemove(char *, const char *);
 void UtilsReset();
 void UtilsSetRPORMode(uint8_t, uint16_t);
 void UtilsSetPinMode(uint8_t, uint8_t);
 int8_t UtilsStricmp(const char *, const char *);
+int8_t UtilsStrnicmp(const char *, const char *, size_t);
 char * UtilsStrncpy(char *, const char *, size_t);
 unsigned char UtilsStrToHex(char *);
 uint8_t UtilsStrToInt(char *);
 int16_t UtilsCharIndex(char *, uint8_t);
-char * UtilsTransliterateUnicodeToASCII(uint32_t);
-char * UtilsTransliterateExtendedASCIIToASCII(uint32_t);
-unsigned char UtilsConvertCyrillicUnicodeToExtendedASCII(uint32_t);
 #endif /* UTILS_H */
@@ -5,7 +5,6 @@
  *     Implement the BoardMonitor UI Mode handler
  */
 #include "bmbt.h"
-#include <stdio.h>
 #include <string.h>
 #include "../lib/config.h"
 #include "../lib/event.h"
@@ -82,6 +81,14 @@ void BMBTInit(BT_t *bt, IBus_t *ibus)
     Context.bt = bt;
     Context.ibus = ibus;
     Context.menu = BMBT_MENU_NONE;
+    Context.menuCache[0].frames = Context.menuCacheFrames;
+    Context.menuCache[0].size = BMBT_MENU_CACHE_MAIN_SIZE;
+    Context.menuCache[1].frames = Context.menuCache[0].frames +
+        BMBT_MENU_CACHE_MAIN_SIZE;
+    Context.menuCache[1].size = BMBT_MENU_CACHE_SETTINGS_SIZE;
+    Context.menuCache[2].frames = Context.menuCache[1].frames +
+        BMBT_MENU_CACHE_SETTINGS_SIZE;
+    Context.menuCache[2].size = BMBT_MENU_CACHE_ABOUT_SIZE;
     Context.status.playerMode = BMBT_MODE_INACTIVE;
     Context.status.displayMode = BMBT_DISPLAY_OFF;
     Context.status.navState = BMBT_NAV_STATE_ON;
@@ -185,6 +192,11 @@ void BMBTInit(BT_t *bt, IBus_t *ibus)
         &BMBTIBusSensorValueUpdate,
         &Context
     );
+    EventRegisterCallback(
+        IBUS_EVENT_TX_FRAME_DROPPED,
+        &BMBTIBusTXFrameDropped,
+        &Context
+    );
     EventRegisterCallback(
         IBUS_EVENT_RAD_DISPLAY_MENU,
         &BMBTRADDisplayMenu,
@@ -306,6 +318,10 @@ void BMBTDestroy()
         IBUS_EVENT_SENSOR_VALUE_UPDATE,
         &BMBTIBusSensorValueUpdate
     );
+    EventUnregisterCallback(
+        IBUS_EVENT_TX_FRAME_DROPPED,
+        &BMBTIBusTXFrameDropped
+    );
     EventUnregisterCallback(
         IBUS_EVENT_GT_CHANGE_UI_REQUEST,
         &BMBTIBusGTChangeUIRequest
@@ -369,6 +385,22 @@ static void BMBTGTBufferFlush(BMBTContext_t *context)
     }
 }
 
+/**
+ * BMBTGTIndexInvalidate()
+ *     Description:
+ *         Forget what the GT menu indices hold, so that the next menu draw
+ *         writes every index. This is needed whenever something other than
+ *         BMBTGTWriteIndex() may have changed the GT buffer.
+ *     Params:
+ *         BMBTContext_t *context - The BMBT context
+ *     Returns:
+ *         void
+ */
+static void BMBTGTIndexInvalidate(BMBTContext_t *context)
+{
+    context->menuIndexValid = 0;
+}
+
 /**
  * BMBTMainAreaRefresh()
  *     Description:
@@ -495,6 +527,8 @@ static void BMBTTriggerWriteHeader(BMBTContext_t *context)
  */
 static void BMBTTriggerWriteMenu(BMBTContext_t *context, uint8_t force)
 {
+    // The menu is being brought back, so the GT may no longer hold our text
+    BMBTGTIndexInvalidate(context);
     // If we can refresh the last menu back onto the screen,
     // do so immediately. Otherwise, trigger the menu write timer
     if (
@@ -638,7 +672,7 @@ static void BMBTHeaderWriteTemperature(BMBTContext_t *context, uint8_t updateTyp
         ) {
             if (context->ibus->ambientTemperatureCalculated[0] != 0) {
                 tempValue = 0;
-                snprintf(
+                UtilsFormat(
                     temperature,
                     8,
                     "%s\xB0%c",
@@ -681,12 +715,12 @@ static void BMBTHeaderWriteTemperature(BMBTContext_t *context, uint8_t updateTyp
             }
             if (tempDisplayConfig == CONFIG_SETTING_TEMP_AMBIENT) {
                 if (units == 'F') {
-                    snprintf(temperature, 7, "%+d\xB0%c", tempValue, units);
+                    UtilsFormat(temperature, 7, "%+d\xB0%c", tempValue, units);
                 } else {
-                    snprintf(temperature, 8, "%+d.0\xB0%c", tempValue, units);
+                    UtilsFormat(temperature, 8, "%+d.0\xB0%c", tempValue, units);
                 }
             } else if (tempValue > 0){
-                snprintf(temperature, 6, "%d\xB0%c", tempValue, units);
+                UtilsFormat(temperature, 6, "%d\xB0%c", tempValue, units);
             } else {
                 return;
             }
@@ -712,7 +746,7 @@ static void BMBTHeaderWriteSpeed(BMBTContext_t *context)
         speed = (speed * 5) / 8;
     }
     char speedStr[5] = {0};
-    snprintf(speedStr, 5, "%3d", speed);
+    UtilsFormat(speedStr, 5, "%3d", speed);
     IBusCommandGTWriteZone(context->ibus, BMBT_HEADER_SPEED, speedStr);
 }
 
@@ -765,7 +799,11 @@ static void BMBTHeaderWrite(BMBTContext_t *context)
  * BMBTGTWriteIndex()
  *     Description:
  *         Wrapper to automatically push the nav type into the I-Bus Library
- *         Command so that we can save verbosity in these calls
+ *         Command so that we can save verbosity in these calls. A hash of
+ *         every index that we write is kept, and writes of the text that the
+ *         index already holds are skipped so that redraws only send the
+ *         indices that changed. The hash is only kept once the frame was
+ *         queued, so a write that was refused is sent again next time.
  *     Params:
  *         BMBTContext_t *context - The context
  *         uint8_t index - The index to write to
@@ -781,7 +819,7 @@ static void BMBTGTWriteIndex(
     char *text,
     uint8_t clearIdxs
 ) {
-
+    uint8_t shadowIdx = index;
     uint8_t stringLength = strlen(text);
     uint8_t newTextLength = stringLength + clearIdxs + 1;
     if (context->ibus->gtVersion < IBUS_GT_MKIII_NEW_UI) {
@@ -796,6 +834,10 @@ static void BMBTGTWriteIndex(
     } else {
         index = index + 0x40;
     }
+    // The shadow only describes the TMC layout
+    if (context->status.navIndexType != IBUS_CMD_GT_WRITE_INDEX_TMC) {
+        BMBTGTIndexInvalidate(context);
+    }
     context->status.navIndexType = IBUS_CMD_GT_WRITE_INDEX_TMC;
     char newText[newTextLength + 1];
     memset(&newText, 0x20, newTextLength);
@@ -806,220 +848,583 @@ static void BMBTGTWriteIndex(
         stringLength++;
     }
     newText[newTextLength] = '\0';
+    if (shadowIdx < BMBT_MENU_INDEX_COUNT) {
+        uint16_t hash = UtilsHash(UTILS_HASH_SEED, (uint8_t *) newText, newTextLength);
+        uint16_t indexBit = 1 << shadowIdx;
+        if (
+            (context->menuIndexValid & indexBit) != 0 &&
+            context->menuIndexHash[shadowIdx] == hash
+        ) {
+            return;
+        }
+        // The rows that this write clears no longer hold what we wrote
+        context->menuIndexValid &= ~indexBit;
+        while (clearIdxs > 0 && shadowIdx + clearIdxs < BMBT_MENU_INDEX_COUNT) {
+            context->menuIndexValid &= ~(1 << (shadowIdx + clearIdxs));
+            clearIdxs--;
+        }
+        if (IBusCommandGTWriteIndexTMC(context->ibus, index, newText) == 1) {
+            context->menuIndexHash[shadowIdx] = hash;
+            context->menuIndexValid |= indexBit;
+        }
+        return;
+    }
     IBusCommandGTWriteIndexTMC(context->ibus, index, newText);
 }
 
+/**
+ * BMBTMenuCacheGet()
+ *     Description:
+ *         Get the cache entry that holds the frames for the given menu
+ *     Params:
+ *         BMBTContext_t *context - The BMBT context
+ *         uint8_t menu - The BMBT_MENU_* to look up
+ *     Returns:
+ *         BMBTMenuCache_t * - The entry, or 0 if the menu is not cached
+ */
+static BMBTMenuCache_t *BMBTMenuCacheGet(BMBTContext_t *context, uint8_t menu)
+{
+    switch (menu) {
+        case BMBT_MENU_MAIN:
+            return &context->menuCache[0];
+        case BMBT_MENU_SETTINGS:
+            return &context->menuCache[1];
+        case BMBT_MENU_SETTINGS_ABOUT:
+            return &context->menuCache[2];
+    }
+    return 0;
+}
+
+/**
+ * BMBTMenuCacheBegin()
+ *     Description:
+ *         Draw a static menu from its cached frames if they were built for
+ *         the current language and GT. Otherwise start recording the frames
+ *         that the caller is about to write. Redrawing the menu that is
+ *         already shown takes the normal path, so unchanged rows are skipped.
+ *     Params:
+ *         BMBTContext_t *context - The BMBT context
+ *         uint8_t menu - The BMBT_MENU_* to draw
+ *     Returns:
+ *         uint8_t - 1 if the menu was drawn from the cache, 0 otherwise
+ */
+static uint8_t BMBTMenuCacheBegin(BMBTContext_t *context, uint8_t menu)
+{
+    BMBTMenuCache_t *cache = BMBTMenuCacheGet(context, menu);
+    if (cache == 0) {
+        return 0;
+    }
+    if (
+        cache->menu == menu &&
+        cache->language == ConfigGetSetting(CONFIG_SETTING_LANGUAGE) &&
+        cache->gtVersion == context->ibus->gtVersion &&
+        cache->nav == context->ibus->moduleStatus.NAV
+    ) {
+        if (context->menu == menu) {
+            return 0;
+        }
+        if (IBusSendFrames(context->ibus, cache->frames, cache->length) == 1) {
+            // The frames leave the GT buffer exactly as the first draw did
+            memcpy(context->menuIndexHash, cache->indexHash, sizeof(cache->indexHash));
+            context->menuIndexValid = cache->indexValid;
+        } else {
+            BMBTGTIndexInvalidate(context);
+        }
+        context->status.navIndexType = IBUS_CMD_GT_WRITE_INDEX_TMC;
+        if (
+            context->ibus->gtVersion < IBUS_GT_MKIII_NEW_UI &&
+            context->ibus->moduleStatus.NAV == 0
+        ) {
+            context->status.headerBufferStatus = BMBT_MENU_BUFFER_FLUSH;
+        }
+        BMBTGTBufferFlush(context);
+        context->menu = menu;
+        return 1;
+    }
+    cache->menu = BMBT_MENU_NONE;
+    // Every row has to be written for the recording to be complete
+    BMBTGTIndexInvalidate(context);
+    IBusStartTXCapture(context->ibus, cache->frames, cache->size);
+    return 0;
+}
+
+/**
+ * BMBTMenuCacheEnd()
+ *     Description:
+ *         Finish the recording started by BMBTMenuCacheBegin() and keep it
+ *         for the next time the menu is opened
+ *     Params:
+ *         BMBTContext_t *context - The BMBT context
+ *         uint8_t menu - The BMBT_MENU_* that was drawn
+ *     Returns:
+ *         void
+ */
+static void BMBTMenuCacheEnd(BMBTContext_t *context, uint8_t menu)
+{
+    BMBTMenuCache_t *cache = BMBTMenuCacheGet(context, menu);
+    if (cache == 0 || context->ibus->txCaptureBuffer != cache->frames) {
+        return;
+    }
+    cache->length = IBusStopTXCapture(context->ibus);
+    if (cache->length == 0) {
+        return;
+    }
+    cache->language = ConfigGetSetting(CONFIG_SETTING_LANGUAGE);
+    cache->gtVersion = context->ibus->gtVersion;
+    cache->nav = context->ibus->moduleStatus.NAV;
+    memcpy(cache->indexHash, context->menuIndexHash, sizeof(cache->indexHash));
+    cache->indexValid = context->menuIndexValid;
+    cache->menu = menu;
+}
+
 static void BMBTMenuMain(BMBTContext_t *context)
 {
+    if (BMBTMenuCacheBegin(context, BMBT_MENU_MAIN) == 1) {
+        return;
+    }
     BMBTGTWriteTitleIndex(context, LocaleGetText(LOCALE_STRING_MAIN_MENU));
     BMBTGTWriteIndex(context, BMBT_MENU_IDX_DASHBOARD, LocaleGetText(LOCALE_STRING_DASHBOARD), 0);
     BMBTGTWriteIndex(context, BMBT_MENU_IDX_DEVICE_SELECTION, LocaleGetText(LOCALE_STRING_DEVICES), 0);
     BMBTGTWriteIndex(context, BMBT_MENU_IDX_SETTINGS, LocaleGetText(LOCALE_STRING_SETTINGS), 5);
+    BMBTMenuCacheEnd(context, BMBT_MENU_MAIN);
     BMBTGTBufferFlush(context);
     context->menu = BMBT_MENU_MAIN;
 }
 
-static void BMBTMenuDashboardUpdateOBCValues(BMBTContext_t *context)
+/**
+ * BMBTMenuDashboardConvertTemp()
+ *     Description:
+ *         Convert a temperature to the configured unit
+ *     Params:
+ *         int16_t temperature - The temperature in Celsius
+ *     Returns:
+ *         int16_t - The temperature in the configured unit
+ */
+static int16_t BMBTMenuDashboardConvertTemp(int16_t temperature)
 {
-    if (ConfigGetSetting(CONFIG_SETTING_BMBT_DASHBOARD_OBC) == CONFIG_SETTING_OFF) {
-        if (context->ibus->gtVersion == IBUS_GT_MKIV_STATIC) {
-           IBusCommandGTWriteIndexStatic(context->ibus, 0x44, "\x06");
-           IBusCommandGTWriteIndexStatic(context->ibus, 0x45, "\x06");
-        }
-        return;
+    if (ConfigGetTempUnit() == CONFIG_SETTING_TEMP_FAHRENHEIT) {
+        // Same as (temperature * 1.8 + 32.5) without pulling in float math
+        return (temperature * 18 + 325) / 10;
     }
-    char tempUnit = 'C';
-    char ambtempstr[14] = {0};
-    char oiltempstr[14] = {0};
-    char cooltempstr[14] = {0};
-    char battstr[14] = {0};
+    return temperature;
+}
 
-    if (ConfigGetTempUnit() == CONFIG_SETTING_TEMP_FAHRENHEIT) {
-        tempUnit = 'F';
+/**
+ * BMBTMenuDashboardFormatOBCField()
+ *     Description:
+ *         Format one OBC value into its slot of the dashboard cache. Values
+ *         that are not known leave the slot empty.
+ *     Params:
+ *         BMBTContext_t *context - The BMBT context
+ *         uint8_t field - The BMBT_DASHBOARD_OBC_* field to format
+ *     Returns:
+ *         void
+ */
+static void BMBTMenuDashboardFormatOBCField(BMBTContext_t *context, uint8_t field)
+{
+    char *text = context->dashboardOBC[field];
+    IBus_t *ibus = context->ibus;
+    text[0] = '\0';
+    switch (field) {
+        case BMBT_DASHBOARD_OBC_BATTERY:
+            if (ibus->batteryVoltage > 0) {
+                UtilsFormat(
+                    text,
+                    BMBT_DASHBOARD_OBC_FIELD_SIZE,
+                    "B:%d.%dv",
+                    ibus->batteryVoltage / 10,
+                    ibus->batteryVoltage % 10
+                );
+            }
+            break;
+        case BMBT_DASHBOARD_OBC_AMBIENT:
+            if (ibus->ambientTemperatureCalculated[0] != 0x00) {
+                UtilsFormat(
+                    text,
+                    BMBT_DASHBOARD_OBC_FIELD_SIZE,
+                    "A:%s",
+                    ibus->ambientTemperatureCalculated
+                );
+            } else if (ibus->ambientTemperature != IBUS_TEMP_UNSET) {
+                UtilsFormat(
+                    text,
+                    BMBT_DASHBOARD_OBC_FIELD_SIZE,
+                    "A:%+d",
+                    BMBTMenuDashboardConvertTemp(ibus->ambientTemperature)
+                );
+            }
+            break;
+        case BMBT_DASHBOARD_OBC_COOLANT:
+            if (ibus->coolantTemperature > 0) {
+                UtilsFormat(
+                    text,
+                    BMBT_DASHBOARD_OBC_FIELD_SIZE,
+                    "C:%d",
+                    BMBTMenuDashboardConvertTemp(ibus->coolantTemperature)
+                );
+            }
+            break;
+        case BMBT_DASHBOARD_OBC_OIL:
+            if (ibus->oilTemperature > 0) {
+                UtilsFormat(
+                    text,
+                    BMBT_DASHBOARD_OBC_FIELD_SIZE,
+                    "O:%d",
+                    BMBTMenuDashboardConvertTemp(ibus->oilTemperature)
+                );
+            }
+            break;
     }
+}
 
-    int ambtemp = context->ibus->ambientTemperature;
-    int oiltemp = context->ibus->oilTemperature;
-    int cooltemp = context->ibus->coolantTemperature;
-    uint8_t battVolt = context->ibus->batteryVoltage;
-    if (
-        ambtemp == IBUS_TEMP_UNSET &&
-        context->ibus->ambientTemperatureCalculated[0] == 0x00 &&
-        cooltemp == 0 &&
-        oiltemp == 0 &&
-        battVolt == 0
+/**
+ * BMBTMenuDashboardWriteOBCIndex()
+ *     Description:
+ *         Write an OBC index of the dashboard unless it already holds the
+ *         given text. The hash is only kept once the frames were queued.
+ *     Params:
+ *         BMBTContext_t *context - The BMBT context
+ *         uint8_t slot - The position of the index in the OBC area
+ *         uint8_t index - The GT index to write
+ *         const char *text - The text to write
+ *     Returns:
+ *         uint8_t - 1 if the index was written, 0 otherwise
+ */
+static uint8_t BMBTMenuDashboardWriteOBCIndex(
+    BMBTContext_t *context,
+    uint8_t slot,
+    uint8_t index,
+    char *text
+) {
+    uint16_t hash = UtilsHash(UTILS_HASH_SEED, (uint8_t *) text, strlen(text));
+    if ((context->dashboardOBCValid & (1 << slot)) != 0 &&
+        context->dashboardOBCHash[slot] == hash
     ) {
-        return;
+        return 0;
+    }
+    uint8_t queued = 0;
+    if (context->ibus->gtVersion >= IBUS_GT_MKIV_STATIC) {
+        queued = IBusCommandGTWriteIndexStatic(context->ibus, index, text);
+    } else {
+        queued = IBusCommandGTWriteIndex(context->ibus, index, text);
     }
+    context->dashboardOBCValid &= ~(1 << slot);
+    if (queued == 1) {
+        context->dashboardOBCHash[slot] = hash;
+        context->dashboardOBCValid |= 1 << slot;
+    }
+    return 1;
+}
 
-    if (tempUnit == 'F') {
-        ambtemp = (ambtemp * 1.8 + 32 + 0.5);
-        if (oiltemp > 0) {
-            oiltemp = (oiltemp * 1.8 + 32 + 0.5);
+/**
+ * BMBTMenuDashboardUpdateOBCValues()
+ *     Description:
+ *         Refresh the OBC area of the dashboard. Only the given field is
+ *         formatted again and only the indices whose text changed are sent,
+ *         so a sensor update does not touch the rest of the screen.
+ *     Params:
+ *         BMBTContext_t *context - The BMBT context
+ *         uint8_t field - The BMBT_DASHBOARD_OBC_* field that changed, or
+ *             BMBT_DASHBOARD_OBC_ALL to format every field
+ *         uint8_t writeAll - Write every index, as the screen was redrawn
+ *     Returns:
+ *         uint8_t - The number of indices written
+ */
+static uint8_t BMBTMenuDashboardUpdateOBCValues(
+    BMBTContext_t *context,
+    uint8_t field,
+    uint8_t writeAll
+) {
+    uint8_t written = 0;
+    if (writeAll != 0) {
+        context->dashboardOBCValid = 0;
+        field = BMBT_DASHBOARD_OBC_ALL;
+    }
+    if (ConfigGetSetting(CONFIG_SETTING_BMBT_DASHBOARD_OBC) == CONFIG_SETTING_OFF) {
+        if (context->ibus->gtVersion == IBUS_GT_MKIV_STATIC) {
+            written += BMBTMenuDashboardWriteOBCIndex(context, 0, 0x44, "\x06");
+            written += BMBTMenuDashboardWriteOBCIndex(context, 1, 0x45, "\x06");
         }
-        if (cooltemp > 0) {
-            cooltemp = (cooltemp * 1.8 + 32 + 0.5);
+        return written;
+    }
+    if (field == BMBT_DASHBOARD_OBC_ALL) {
+        for (field = 0; field < BMBT_DASHBOARD_OBC_FIELDS; field++) {
+            BMBTMenuDashboardFormatOBCField(context, field);
         }
+    } else {
+        BMBTMenuDashboardFormatOBCField(context, field);
+    }
+    char *battery = context->dashboardOBC[BMBT_DASHBOARD_OBC_BATTERY];
+    char *ambient = context->dashboardOBC[BMBT_DASHBOARD_OBC_AMBIENT];
+    char *coolant = context->dashboardOBC[BMBT_DASHBOARD_OBC_COOLANT];
+    char *oil = context->dashboardOBC[BMBT_DASHBOARD_OBC_OIL];
+    if (
+        battery[0] == '\0' &&
+        ambient[0] == '\0' &&
+        coolant[0] == '\0' &&
+        oil[0] == '\0'
+    ) {
+        return written;
     }
-    if (battVolt > 0) {
-        snprintf(battstr, 14, "B:%d.%dv", battVolt / 10, battVolt % 10);
+    char tempUnit = 'C';
+    if (ConfigGetTempUnit() == CONFIG_SETTING_TEMP_FAHRENHEIT) {
+        tempUnit = 'F';
     }
     if (context->ibus->gtVersion >= IBUS_GT_MKIV_STATIC) {
-        char temperature[29] = {0};
-        if (context->ibus->ambientTemperatureCalculated[0] != 0x00) {
-            snprintf(ambtempstr, 8, "A:%s", context->ibus->ambientTemperatureCalculated);
-        } else if (context->ibus->ambientTemperature != IBUS_TEMP_UNSET) {
-            snprintf(ambtempstr, 8, "A:%+d", ambtemp);
-        }
-        if (cooltemp > 0) {
-            snprintf(cooltempstr, 7, "C:%d,", cooltemp);
-        }
-        if (battVolt > 0) {
-            IBusCommandGTWriteIndexStatic(context->ibus, 0x44, battstr);
+        if (battery[0] != '\0') {
+            written += BMBTMenuDashboardWriteOBCIndex(context, 0, 0x44, battery);
         } else {
-            IBusCommandGTWriteIndexStatic(context->ibus, 0x44, "\x06");
+            written += BMBTMenuDashboardWriteOBCIndex(context, 0, 0x44, "\x06");
         }
-        if (oiltemp > 0) {
-            snprintf(oiltempstr, 7, "O:%d,", oiltemp);
-            snprintf(temperature, 29, "%s%s%s\xB0%c", oiltempstr, cooltempstr, ambtempstr, tempUnit);
-        } else {
-            snprintf(temperature, 29, "Temp\xB0%c: %s%s", tempUnit, cooltempstr, ambtempstr);
-        }
-        IBusCommandGTWriteIndexStatic(context->ibus, 0x45, temperature);
-    } else {
-        uint8_t currentIdx = 5;
-        if (battVolt > 0) {
-            IBusCommandGTWriteIndex(context->ibus, currentIdx++, battstr);
+        char *coolantSeparator = "";
+        if (coolant[0] != '\0') {
+            coolantSeparator = ",";
         }
-        char header[9] = {0};
-        snprintf(header, 9, "Temp\xB0%c:", tempUnit);
-        IBusCommandGTWriteIndex(context->ibus, currentIdx++, header);
-        if (context->ibus->ambientTemperatureCalculated[0] != 0x00) {
-            snprintf(ambtempstr, 8, "A:%s", context->ibus->ambientTemperatureCalculated);
-            IBusCommandGTWriteIndex(
-                context->ibus,
-                currentIdx++,
-                ambtempstr
-            );
-        } else if (context->ibus->ambientTemperature != IBUS_TEMP_UNSET) {
-            snprintf(ambtempstr, 8, "A:%+d", ambtemp);
-            IBusCommandGTWriteIndex(
-                context->ibus,
-                currentIdx++,
-                ambtempstr
+        char temperature[29] = {0};
+        if (oil[0] != '\0') {
+            UtilsFormat(
+                temperature,
+                29,
+                "%s,%s%s%s\xB0%c",
+                oil,
+                coolant,
+                coolantSeparator,
+                ambient,
+                tempUnit
             );
-        }
-        if (cooltemp > 0) {
-            snprintf(cooltempstr, 7, "C:%d", cooltemp);
-            IBusCommandGTWriteIndex(
-                context->ibus,
-                currentIdx++,
-                cooltempstr
+        } else {
+            UtilsFormat(
+                temperature,
+                29,
+                "Temp\xB0%c: %s%s%s",
+                tempUnit,
+                coolant,
+                coolantSeparator,
+                ambient
             );
         }
-        if (oiltemp > 0) {
-            snprintf(oiltempstr, 7, "O:%d", oiltemp);
-            IBusCommandGTWriteIndex(
-                context->ibus,
-                currentIdx++,
-                oiltempstr
+        written += BMBTMenuDashboardWriteOBCIndex(context, 1, 0x45, temperature);
+    } else {
+        // The values follow each other, so a value that comes or goes moves
+        // the ones after it. Those are caught by the per-index comparison.
+        char header[9] = {0};
+        UtilsFormat(header, 9, "Temp\xB0%c:", tempUnit);
+        char *values[BMBT_DASHBOARD_OBC_INDEX_COUNT] = {
+            battery,
+            header,
+            ambient,
+            coolant,
+            oil
+        };
+        uint8_t slot = 0;
+        uint8_t idx;
+        for (idx = 0; idx < BMBT_DASHBOARD_OBC_INDEX_COUNT; idx++) {
+            if (values[idx][0] == '\0') {
+                continue;
+            }
+            written += BMBTMenuDashboardWriteOBCIndex(
+                context,
+                slot,
+                BMBT_DASHBOARD_OBC_INDEX_START + slot,
+                values[idx]
             );
+            slot++;
         }
     }
+    return written;
 }
 
-static void BMBTMenuDashboardUpdate(BMBTContext_t *context, char *f1, char *f2, char *f3)
-{
-    if (strlen(f1) == 0) {
-        strncpy(f1, " ", 2);
+/**
+ * BMBTMenuDashboardFieldChanged()
+ *     Description:
+ *         Check whether a dashboard field needs to be written. That is the
+ *         case when it now shows something else than before, or when the
+ *         metadata field that it shows has changed.
+ *     Params:
+ *         BMBTContext_t *context - The BMBT context
+ *         uint8_t field - The dashboard field (0 - 2)
+ *         uint8_t source - The BMBT_DASHBOARD_SOURCE_* the field shows
+ *         uint8_t changed - The BT_METADATA_FIELD_* mask of changed fields
+ *     Returns:
+ *         uint8_t - 1 if the text differs from what is on screen
+ */
+static uint8_t BMBTMenuDashboardFieldChanged(
+    BMBTContext_t *context,
+    uint8_t field,
+    uint8_t source,
+    uint8_t changed
+) {
+    uint8_t isChanged = 0;
+    if (context->dashboardSource[field] != source) {
+        isChanged = 1;
+    } else if (
+        source < BT_METADATA_FIELD_COUNT &&
+        UTILS_CHECK_BIT(changed, source) != 0
+    ) {
+        isChanged = 1;
+    }
+    context->dashboardSource[field] = source;
+    return isChanged;
+}
+
+static void BMBTMenuDashboardUpdate(
+    BMBTContext_t *context,
+    char *f1,
+    char *f2,
+    char *f3,
+    uint8_t f1Source,
+    uint8_t changed,
+    uint8_t writeAll
+) {
+    // The fields may point straight into the metadata arena, so blank
+    // them by pointing them at our own space rather than writing to them
+    char *blank = " ";
+    uint8_t f2Source = BMBT_DASHBOARD_SOURCE_ARTIST;
+    uint8_t f3Source = BMBT_DASHBOARD_SOURCE_ALBUM;
+    if (f1[0] == '\0') {
+        f1 = blank;
+        f1Source = BMBT_DASHBOARD_SOURCE_BLANK;
     }
 
     // Prevent duplication of fields
-    if (strlen(f2) == 0 && strlen(f3) == 0) {
-        strncpy(f2, " ", 2);
-        strncpy(f3, " ", 2);
-    } else if (strlen(f2) == 0 && strlen(f3) != 0) {
-        char *tmp = f2;
+    if (f2[0] == '\0' && f3[0] == '\0') {
+        f2 = blank;
+        f3 = blank;
+        f2Source = BMBT_DASHBOARD_SOURCE_BLANK;
+        f3Source = BMBT_DASHBOARD_SOURCE_BLANK;
+    } else if (f2[0] == '\0' && f3[0] != '\0') {
         f2 = f3;
-        f3 = tmp;
-        strncpy(f3, " ", 2);
-        if (strncmp(f1, f2, BT_METADATA_FIELD_SIZE) == 0) {
-            strncpy(f2, " ", 2);
+        f3 = blank;
+        f2Source = f3Source;
+        f3Source = BMBT_DASHBOARD_SOURCE_BLANK;
+        if (strcmp(f1, f2) == 0) {
+            f2 = blank;
+            f2Source = BMBT_DASHBOARD_SOURCE_BLANK;
         }
-    } else if (strlen(f3) == 0) {
-        strncpy(f3, " ", 2);
-        if (strncmp(f1, f2, BT_METADATA_FIELD_SIZE) == 0) {
-            strncpy(f2, " ", 2);
+    } else if (f3[0] == '\0') {
+        f3 = blank;
+        f3Source = BMBT_DASHBOARD_SOURCE_BLANK;
+        if (strcmp(f1, f2) == 0) {
+            f2 = blank;
+            f2Source = BMBT_DASHBOARD_SOURCE_BLANK;
         }
-    } else if (strlen(f2) != 0 && strncmp(f2, f3, BT_METADATA_FIELD_SIZE) == 0) {
-        strncpy(f3, " ", 2);
-        if (strncmp(f1, f2, BT_METADATA_FIELD_SIZE) == 0) {
-            strncpy(f2, " ", 2);
+    } else if (strcmp(f2, f3) == 0) {
+        f3 = blank;
+        f3Source = BMBT_DASHBOARD_SOURCE_BLANK;
+        if (strcmp(f1, f2) == 0) {
+            f2 = blank;
+            f2Source = BMBT_DASHBOARD_SOURCE_BLANK;
         }
     }
 
+    // Work out which fields differ from what is on screen. Only those need
+    // to be written when this is a metadata update to a drawn dashboard
+    uint8_t writeF1 = BMBTMenuDashboardFieldChanged(context, 0, f1Source, changed) | writeAll;
+    uint8_t writeF2 = BMBTMenuDashboardFieldChanged(context, 1, f2Source, changed) | writeAll;
+    uint8_t writeF3 = BMBTMenuDashboardFieldChanged(context, 2, f3Source, changed) | writeAll;
     if (context->ibus->gtVersion == IBUS_GT_MKIV_STATIC) {
-        IBusCommandGTWriteIndexStatic(context->ibus, 0x41, f1);
-        IBusCommandGTWriteIndexStatic(context->ibus, 0x42, f2);
-        IBusCommandGTWriteIndexStatic(context->ibus, 0x43, f3);
-        BMBTMenuDashboardUpdateOBCValues(context);
+        if (writeF1 != 0) {
+            IBusCommandGTWriteIndexStatic(context->ibus, 0x41, f1);
+        }
+        if (writeF2 != 0) {
+            IBusCommandGTWriteIndexStatic(context->ibus, 0x42, f2);
+        }
+        if (writeF3 != 0) {
+            IBusCommandGTWriteIndexStatic(context->ibus, 0x43, f3);
+        }
+        if (writeAll != 0) {
+            BMBTMenuDashboardUpdateOBCValues(context, BMBT_DASHBOARD_OBC_ALL, 1);
+        }
         context->status.navIndexType = IBUS_CMD_GT_WRITE_STATIC;
         BMBTGTBufferFlush(context);
     } else {
-        IBusCommandGTWriteIndex(context->ibus, 0, f1);
-        IBusCommandGTWriteIndex(context->ibus, 1, f2);
-        // Clear the rest of the screen by adding seven 0x06 chars to the end
-        // of the last message written to the screen, so the GT clears those
-        // seven indices. The 8th index is simply to hold the null terminator.
-        uint8_t f3Len = strlen(f3);
-        uint8_t newLength = f3Len + 8;
-        char newF3[newLength];
-        memset(newF3, 0x06, newLength);
-        strncpy(newF3, f3, f3Len);
-        newF3[newLength - 1] = 0x00;
-        IBusCommandGTWriteIndex(context->ibus, 2, newF3);
-        BMBTMenuDashboardUpdateOBCValues(context);
+        if (writeF1 != 0) {
+            IBusCommandGTWriteIndex(context->ibus, 0, f1);
+        }
+        if (writeF2 != 0) {
+            IBusCommandGTWriteIndex(context->ibus, 1, f2);
+        }
+        if (writeAll != 0) {
+            // Clear the rest of the screen by adding seven 0x06 chars to the end
+            // of the last message written to the screen, so the GT clears those
+            // seven indices. The 8th index is simply to hold the null terminator.
+            uint8_t f3Len = strlen(f3);
+            uint8_t newLength = f3Len + 8;
+            char newF3[newLength];
+            memset(newF3, 0x06, newLength);
+            strncpy(newF3, f3, f3Len);
+            newF3[newLength - 1] = 0x00;
+            IBusCommandGTWriteIndex(context->ibus, 2, newF3);
+        } else if (writeF3 != 0) {
+            IBusCommandGTWriteIndex(context->ibus, 2, f3);
+        }
+        if (writeAll != 0) {
+            BMBTMenuDashboardUpdateOBCValues(context, BMBT_DASHBOARD_OBC_ALL, 1);
+        }
         context->status.navIndexType = IBUS_CMD_GT_WRITE_INDEX;
         BMBTGTBufferFlush(context);
     }
 }
 
-static void BMBTMenuDashboard(BMBTContext_t *context)
-{
-    char title[BT_METADATA_FIELD_SIZE] = {0};
-    char artist[BT_METADATA_FIELD_SIZE] = {0};
-    char album[BT_METADATA_FIELD_SIZE] = {0};
-    UtilsStrncpy(title, context->bt->title, BT_METADATA_FIELD_SIZE);
+/**
+ * BMBTMenuDashboardDraw()
+ *     Description:
+ *         Lay out the metadata on the dashboard
+ *     Params:
+ *         BMBTContext_t *context - The BMBT context
+ *         uint8_t changed - The BT_METADATA_FIELD_* mask of the fields that
+ *             changed since the dashboard was last drawn
+ *         uint8_t writeAll - Write every field rather than only the ones
+ *             that differ from what is on screen
+ *     Returns:
+ *         void
+ */
+static void BMBTMenuDashboardDraw(
+    BMBTContext_t *context,
+    uint8_t changed,
+    uint8_t writeAll
+) {
+    char *title = BTMetadataGet(context->bt, BT_METADATA_FIELD_TITLE);
+    char *artist = "";
+    char *album = "";
+    uint8_t titleSource = BMBT_DASHBOARD_SOURCE_TITLE;
     uint8_t metadataKnown = 1;
     if (context->bt->playbackStatus == BT_AVRCP_STATUS_PAUSED) {
-        if (strlen(title) == 0) {
-            UtilsStrncpy(
-                title,
-                LocaleGetText(LOCALE_STRING_NOT_PLAYING),
-                BT_METADATA_FIELD_SIZE
-            );
+        if (title[0] == '\0') {
+            title = LocaleGetText(LOCALE_STRING_NOT_PLAYING);
+            titleSource = BMBT_DASHBOARD_SOURCE_NOT_PLAYING;
             metadataKnown = 0;
         }
     } else {
         // Set "Unknown" text for title and artist when missing but ignore
         // missing album or artist information as many streaming apps do not provide it
-        if (strlen(title) == 0) {
-            UtilsStrncpy(
-                title,
-                LocaleGetText(LOCALE_STRING_UNKNOWN_TITLE),
-                BT_METADATA_FIELD_SIZE
-            );
+        if (title[0] == '\0') {
+            title = LocaleGetText(LOCALE_STRING_UNKNOWN_TITLE);
+            titleSource = BMBT_DASHBOARD_SOURCE_UNKNOWN_TITLE;
         }
     }
-    // Only copy the data if we need it
+    // Only show the rest of the data if we know what is playing
     if (metadataKnown == 1) {
-        UtilsStrncpy(artist, context->bt->artist, BT_METADATA_FIELD_SIZE);
-        UtilsStrncpy(album, context->bt->album, BT_METADATA_FIELD_SIZE);
+        artist = BTMetadataGet(context->bt, BT_METADATA_FIELD_ARTIST);
+        album = BTMetadataGet(context->bt, BT_METADATA_FIELD_ALBUM);
     }
-    BMBTMenuDashboardUpdate(context, title, artist, album);
+    BMBTMenuDashboardUpdate(
+        context,
+        title,
+        artist,
+        album,
+        titleSource,
+        changed,
+        writeAll
+    );
     context->menu = BMBT_MENU_DASHBOARD;
 }
 
+static void BMBTMenuDashboard(BMBTContext_t *context)
+{
+    BMBTMenuDashboardDraw(context, BT_METADATA_FIELD_ALL, 1);
+}
+
 static void BMBTMenuDeviceSelection(BMBTContext_t *context)
 {
     BMBTGTWriteTitleIndex(context, LocaleGetText(LOCALE_STRING_DEVICES));
@@ -1072,6 +1477,9 @@ static void BMBTMenuDeviceSelection(BMBTContext_t *context)
 
 static void BMBTMenuSettings(BMBTContext_t *context)
 {
+    if (BMBTMenuCacheBegin(context, BMBT_MENU_SETTINGS) == 1) {
+        return;
+    }
     BMBTGTWriteTitleIndex(context, LocaleGetText(LOCALE_STRING_SETTINGS));
     uint8_t menuSettingsSize = sizeof(menuSettings);
     uint8_t idx;
@@ -1088,17 +1496,21 @@ static void BMBTMenuSettings(BMBTContext_t *context)
         );
     }
     BMBTGTWriteIndex(context, BMBT_MENU_IDX_BACK, LocaleGetText(LOCALE_STRING_BACK), 0);
+    BMBTMenuCacheEnd(context, BMBT_MENU_SETTINGS);
     BMBTGTBufferFlush(context);
     context->menu = BMBT_MENU_SETTINGS;
 }
 
 static void BMBTMenuSettingsAbout(BMBTContext_t *context)
 {
+    if (BMBTMenuCacheBegin(context, BMBT_MENU_SETTINGS_ABOUT) == 1) {
+        return;
+    }
     BMBTGTWriteTitleIndex(context, LocaleGetText(LOCALE_STRING_SETTINGS_ABOUT));
     char version[9] = {0};
     ConfigGetFirmwareVersionString(version);
     char versionString[BMBT_MENU_STRING_MAX_SIZE] = {0};
-    snprintf(versionString, BMBT_MENU_STRING_MAX_SIZE, LocaleGetText(LOCALE_STRING_FW), version);
+    UtilsFormat(versionString, BMBT_MENU_STRING_MAX_SIZE, LocaleGetText(LOCALE_STRING_FW), version);
     BMBTGTWriteIndex(
         context,
         BMBT_MENU_IDX_SETTINGS_ABOUT_FW_VERSION,
@@ -1106,7 +1518,7 @@ static void BMBTMenuSettingsAbout(BMBTContext_t *context)
         0
     );
     char buildString[BMBT_MENU_STRING_MAX_SIZE] = {0};
-    snprintf(buildString, BMBT_MENU_STRING_MAX_SIZE, LocaleGetText(LOCALE_STRING_BUILT), ConfigGetBuildWeek(), ConfigGetBuildYear());
+    UtilsFormat(buildString, BMBT_MENU_STRING_MAX_SIZE, LocaleGetText(LOCALE_STRING_BUILT), ConfigGetBuildWeek(), ConfigGetBuildYear());
     BMBTGTWriteIndex(
         context,
         BMBT_MENU_IDX_SETTINGS_ABOUT_BUILD_DATE,
@@ -1114,7 +1526,7 @@ static void BMBTMenuSettingsAbout(BMBTContext_t *context)
         0
     );
     char serialNumberString[BMBT_MENU_STRING_MAX_SIZE] = {0};
-    snprintf(serialNumberString, BMBT_MENU_STRING_MAX_SIZE, LocaleGetText(LOCALE_STRING_SN), ConfigGetSerialNumber());
+    UtilsFormat(serialNumberString, BMBT_MENU_STRING_MAX_SIZE, LocaleGetText(LOCALE_STRING_SN), ConfigGetSerialNumber());
     BMBTGTWriteIndex(
         context,
         BMBT_MENU_IDX_SETTINGS_ABOUT_SERIAL,
@@ -1122,291 +1534,756 @@ static void BMBTMenuSettingsAbout(BMBTContext_t *context)
         4
     );
     BMBTGTWriteIndex(context, BMBT_MENU_IDX_BACK, LocaleGetText(LOCALE_STRING_BACK), 0);
+    BMBTMenuCacheEnd(context, BMBT_MENU_SETTINGS_ABOUT);
     BMBTGTBufferFlush(context);
     context->menu = BMBT_MENU_SETTINGS_ABOUT;
 }
 
-static void BMBTMenuSettingsAudio(BMBTContext_t *context)
-{
-    BMBTGTWriteTitleIndex(context, LocaleGetText(LOCALE_STRING_SETTINGS_AUDIO));
-    if (ConfigGetSetting(CONFIG_SETTING_AUTOPLAY) == CONFIG_SETTING_OFF) {
-        BMBTGTWriteIndex(
-            context,
-            BMBT_MENU_IDX_SETTINGS_AUDIO_AUTOPLAY,
-            LocaleGetText(LOCALE_STRING_AUTOPLAY_OFF),
-            0
-        );
-    } else {
-        BMBTGTWriteIndex(
-            context,
-            BMBT_MENU_IDX_SETTINGS_AUDIO_AUTOPLAY,
-            LocaleGetText(LOCALE_STRING_AUTOPLAY_ON),
-            0
-        );
-    }
-    uint8_t currentVolume = ConfigGetSetting(CONFIG_SETTING_DAC_AUDIO_VOL);
-    char volText[BMBT_MENU_STRING_MAX_SIZE] = {0};
-    if (currentVolume > 0x30) {
-        uint8_t gain = (currentVolume - 0x30) / 2;
-        snprintf(volText, BMBT_MENU_STRING_MAX_SIZE, LocaleGetText(LOCALE_STRING_VOLUME_NEG_DB), gain);
-    } else if (currentVolume == 0) {
-        snprintf(volText, BMBT_MENU_STRING_MAX_SIZE, "%s", LocaleGetText(LOCALE_STRING_VOLUME_24_DB));
-    } else if (currentVolume == 0x30) {
-        snprintf(volText, BMBT_MENU_STRING_MAX_SIZE, "%s", LocaleGetText(LOCALE_STRING_VOLUME_0_DB));
-    } else {
-        uint8_t gain = (0x30 - currentVolume) / 2;
-        snprintf(volText, BMBT_MENU_STRING_MAX_SIZE, LocaleGetText(LOCALE_STRING_VOLUME_POS_DB), gain);
-    }
-    BMBTGTWriteIndex(
-        context,
-        BMBT_MENU_IDX_SETTINGS_AUDIO_DAC_GAIN,
-        volText,
-        0
-    );
-    uint8_t dspInput = ConfigGetSetting(CONFIG_SETTING_DSP_INPUT_SRC);
-    if (dspInput == CONFIG_SETTING_DSP_INPUT_SPDIF) {
-        BMBTGTWriteIndex(
-            context,
-            BMBT_MENU_IDX_SETTINGS_AUDIO_DSP_INPUT,
-            LocaleGetText(LOCALE_STRING_DSP_DIGITAL),
-            0
-        );
-    } else if (dspInput == CONFIG_SETTING_DSP_INPUT_ANALOG) {
-        BMBTGTWriteIndex(
-            context,
-            BMBT_MENU_IDX_SETTINGS_AUDIO_DSP_INPUT,
-            LocaleGetText(LOCALE_STRING_DSP_ANALOG),
-            0
-        );
-    } else {
-        BMBTGTWriteIndex(
-            context,
-            BMBT_MENU_IDX_SETTINGS_AUDIO_DSP_INPUT,
-            LocaleGetText(LOCALE_STRING_DSP_DEFAULT),
-            0
-        );
-    }
-    if (ConfigGetSetting(CONFIG_SETTING_VOLUME_LOWER_ON_REV) == CONFIG_SETTING_ON) {
-        BMBTGTWriteIndex(
-            context,
-            BMBT_MENU_IDX_SETTINGS_AUDIO_REV_VOL,
-            LocaleGetText(LOCALE_STRING_REV_VOL_LOW_ON),
-            3
-        );
+static void BMBTSettingsFormatDACGain(
+    BMBTContext_t *context,
+    uint8_t value,
+    char *text
+) {
+    if (value > 0x30) {
+        uint8_t gain = (value - 0x30) / 2;
+        UtilsFormat(text, BMBT_MENU_STRING_MAX_SIZE, LocaleGetText(LOCALE_STRING_VOLUME_NEG_DB), gain);
+    } else if (value == 0) {
+        UtilsFormat(text, BMBT_MENU_STRING_MAX_SIZE, "%s", LocaleGetText(LOCALE_STRING_VOLUME_24_DB));
+    } else if (value == 0x30) {
+        UtilsFormat(text, BMBT_MENU_STRING_MAX_SIZE, "%s", LocaleGetText(LOCALE_STRING_VOLUME_0_DB));
     } else {
-        BMBTGTWriteIndex(
-            context,
-            BMBT_MENU_IDX_SETTINGS_AUDIO_REV_VOL,
-            LocaleGetText(LOCALE_STRING_REV_VOL_LOW_OFF),
-            3
-        );
+        uint8_t gain = (0x30 - value) / 2;
+        UtilsFormat(text, BMBT_MENU_STRING_MAX_SIZE, LocaleGetText(LOCALE_STRING_VOLUME_POS_DB), gain);
     }
-    BMBTGTWriteIndex(context, BMBT_MENU_IDX_BACK, LocaleGetText(LOCALE_STRING_BACK), 0);
-    BMBTGTBufferFlush(context);
-    context->menu = BMBT_MENU_SETTINGS_AUDIO;
 }
 
-static void BMBTMenuSettingsComfort(BMBTContext_t *context)
+static void BMBTSettingsApplyDACGain(BMBTContext_t *context, uint8_t value)
 {
-    BMBTGTWriteTitleIndex(context, LocaleGetText(LOCALE_STRING_SETTINGS_COMFORT));
-    uint8_t comfortLock = ConfigGetComfortLock();
-    if (comfortLock == CONFIG_SETTING_COMFORT_LOCK_10KM) {
-        BMBTGTWriteIndex(
-            context,
-            BMBT_MENU_IDX_SETTINGS_COMFORT_LOCK,
-            LocaleGetText(LOCALE_STRING_LOCK_10KMH),
-            0
-        );
-    } else if (comfortLock == CONFIG_SETTING_COMFORT_LOCK_20KM) {
-        BMBTGTWriteIndex(
-            context,
-            BMBT_MENU_IDX_SETTINGS_COMFORT_LOCK,
-            LocaleGetText(LOCALE_STRING_LOCK_20KMH),
-            0
-        );
-    } else {
-        BMBTGTWriteIndex(
-            context,
-            BMBT_MENU_IDX_SETTINGS_COMFORT_LOCK,
-            LocaleGetText(LOCALE_STRING_LOCK_OFF),
-            0
-        );
+    PCM51XXSetVolume(value);
+}
+
+static void BMBTSettingsApplyDSPInput(BMBTContext_t *context, uint8_t value)
+{
+    if (value == CONFIG_SETTING_DSP_INPUT_SPDIF) {
+        IBusCommandDSPSetMode(context->ibus, IBUS_DSP_CONFIG_SET_INPUT_SPDIF);
+    } else if (value == CONFIG_SETTING_DSP_INPUT_ANALOG) {
+        IBusCommandDSPSetMode(context->ibus, IBUS_DSP_CONFIG_SET_INPUT_RADIO);
     }
-    uint8_t comfortUnlock = ConfigGetComfortUnlock();
-    if (comfortUnlock == CONFIG_SETTING_COMFORT_UNLOCK_POS_1) {
-        BMBTGTWriteIndex(
-            context,
-            BMBT_MENU_IDX_SETTINGS_COMFORT_UNLOCK,
-            LocaleGetText(LOCALE_STRING_UNLOCK_POS_1),
-            0
-        );
-    } else if (comfortUnlock == CONFIG_SETTING_COMFORT_UNLOCK_POS_0) {
-        BMBTGTWriteIndex(
-            context,
-            BMBT_MENU_IDX_SETTINGS_COMFORT_UNLOCK,
-            LocaleGetText(LOCALE_STRING_UNLOCK_POS_0),
-            0
-        );
+}
+
+static void BMBTSettingsFormatBlinkers(
+    BMBTContext_t *context,
+    uint8_t value,
+    char *text
+) {
+    UtilsFormat(text, BMBT_MENU_STRING_MAX_SIZE, LocaleGetText(LOCALE_STRING_BLINKERS), value);
+}
+
+static void BMBTSettingsApplyParkingLamps(BMBTContext_t *context, uint8_t value)
+{
+    // Request cluster indicators so we can trigger the new light setting
+    // when the response (0x5B) is received
+    IBusCommandLMGetClusterIndicators(context->ibus);
+}
+
+static void BMBTSettingsFormatVisualPDC(
+    BMBTContext_t *context,
+    uint8_t value,
+    char *text
+) {
+    UtilsFormat(
+        text,
+        BMBT_MENU_STRING_MAX_SIZE,
+        LocaleGetText(LOCALE_STRING_PDC),
+        (
+            (value == CONFIG_SETTING_PDC_CLUSTER) ? "Cluster":
+            (value == CONFIG_SETTING_PDC_RADIO) ? "Screen":
+            (value == CONFIG_SETTING_PDC_BOTH) ? "Dual":
+            LocaleGetText(LOCALE_STRING_OFF)
+        )
+    );
+}
+
+static void BMBTSettingsApplyHFP(BMBTContext_t *context, uint8_t value)
+{
+    BTPairedDevice_t *dev = &context->bt->pairedDevices[
+        context->bt->activeDevice.deviceIndex
+    ];
+    if (context->bt->type == BT_BTM_TYPE_BC127) {
+        if (value == CONFIG_SETTING_ON) {
+            BC127CommandProfileOpen(context->bt, dev, "HFP");
+        } else {
+            BC127CommandClose(context->bt, context->bt->activeDevice.hfpId);
+        }
     } else {
-        BMBTGTWriteIndex(
-            context,
-            BMBT_MENU_IDX_SETTINGS_COMFORT_UNLOCK,
-            LocaleGetText(LOCALE_STRING_UNLOCK_OFF),
-            0
-        );
+        if (value == CONFIG_SETTING_ON) {
+            BM83CommandConnect(
+                context->bt,
+                dev,
+                BM83_DATA_LINK_BACK_PROFILES_HF
+            );
+        } else {
+            BM83CommandDisconnect(context->bt, BM83_CMD_DISCONNECT_PARAM_HF);
+        }
+    }
+}
+
+static uint8_t BMBTSettingsGetMicGainMax(BMBTContext_t *context)
+{
+    if (context->bt->type == BT_BTM_TYPE_BC127) {
+        return 21;
     }
-    uint8_t blinkCount = ConfigGetSetting(CONFIG_SETTING_COMFORT_BLINKERS);
-    if (blinkCount == 0) {
-        blinkCount = 1;
+    return 0x0F;
+}
+
+static uint8_t BMBTSettingsNextMicGain(BMBTContext_t *context, uint8_t value)
+{
+    if (value >= BMBTSettingsGetMicGainMax(context)) {
+        return 0;
     }
-    char blinkerText[BMBT_MENU_STRING_MAX_SIZE] = {0};
-    snprintf(blinkerText, BMBT_MENU_STRING_MAX_SIZE, LocaleGetText(LOCALE_STRING_BLINKERS), blinkCount);
-    BMBTGTWriteIndex(
-        context,
-        BMBT_MENU_IDX_SETTINGS_COMFORT_BLINKERS,
-        blinkerText,
-        0
-    );
-    if (ConfigGetSetting(CONFIG_SETTING_COMFORT_PARKING_LAMPS) == CONFIG_SETTING_ON) {
-        BMBTGTWriteIndex(
-            context,
-            BMBT_MENU_IDX_SETTINGS_COMFORT_PARKING_LAMPS,
-            LocaleGetText(LOCALE_STRING_PARK_LAMPS_ON),
-            0
+    return value + 1;
+}
+
+static void BMBTSettingsFormatMicGain(
+    BMBTContext_t *context,
+    uint8_t value,
+    char *text
+) {
+    if (value > BMBTSettingsGetMicGainMax(context)) {
+        value = 0;
+    }
+    int8_t gain = (int8_t) BTBM83MicGainTable[value];
+    if (context->bt->type == BT_BTM_TYPE_BC127) {
+        gain = (int8_t) BTBC127MicGainTable[value];
+    }
+    UtilsFormat(text, BMBT_MENU_STRING_MAX_SIZE, LocaleGetText(LOCALE_STRING_MIC_GAIN), gain);
+}
+
+static void BMBTSettingsApplyMicGain(BMBTContext_t *context, uint8_t value)
+{
+    if (context->bt->type == BT_BTM_TYPE_BC127) {
+        BC127CommandSetMicGain(
+            context->bt,
+            value,
+            ConfigGetSetting(CONFIG_SETTING_MIC_BIAS),
+            ConfigGetSetting(CONFIG_SETTING_MIC_PREAMP)
         );
+    } else if (value == 0x00) {
+        // Reset the gain
+        uint8_t start = 0x0F;
+        while (start > 0) {
+            BM83CommandMicGainDown(context->bt);
+            start--;
+        }
     } else {
-        BMBTGTWriteIndex(
+        BM83CommandMicGainUp(context->bt);
+    }
+}
+
+static void BMBTSettingsFormatVolOffset(
+    BMBTContext_t *context,
+    uint8_t value,
+    char *text
+) {
+    UtilsFormat(text, BMBT_MENU_STRING_MAX_SIZE, LocaleGetText(LOCALE_STRING_VOL_OFFSET), (int8_t) value);
+}
+
+static void BMBTSettingsApplyMetadataMode(BMBTContext_t *context, uint8_t value)
+{
+    if (value != BMBT_METADATA_MODE_OFF &&
+        BTMetadataGetLength(context->bt, BT_METADATA_FIELD_TITLE) > 0 &&
+        context->bt->playbackStatus == BT_AVRCP_STATUS_PLAYING
+    ) {
+        BMBTSetMainDisplayText(
             context,
-            BMBT_MENU_IDX_SETTINGS_COMFORT_PARKING_LAMPS,
-            LocaleGetText(LOCALE_STRING_PARK_LAMPS_OFF),
+            BTMetadataGetDisplayText(context->bt),
+            0,
             0
         );
+    } else if (value == BMBT_METADATA_MODE_OFF) {
+        BMBTGTBufferFlush(context);
+        BMBTGTWriteTitle(context, LocaleGetText(LOCALE_STRING_BLUETOOTH), 1);
+    }
+}
+
+static uint8_t BMBTSettingsNextTemps(BMBTContext_t *context, uint8_t value)
+{
+    if (value == CONFIG_SETTING_OFF) {
+        return CONFIG_SETTING_TEMP_COOLANT;
+    } else if (value == CONFIG_SETTING_TEMP_COOLANT) {
+        return CONFIG_SETTING_TEMP_AMBIENT;
+    } else if (
+        value == CONFIG_SETTING_TEMP_AMBIENT &&
+        context->ibus->vehicleType != IBUS_VEHICLE_TYPE_E46 &&
+        context->ibus->vehicleType != IBUS_VEHICLE_TYPE_E8X
+    ) {
+        return CONFIG_SETTING_TEMP_OIL;
     }
-    uint8_t pdc = ConfigGetSetting(CONFIG_SETTING_VISUAL_PDC);
-    char pdcText[BMBT_MENU_STRING_MAX_SIZE] = {0};
-    snprintf(
-        pdcText,
+    return CONFIG_SETTING_OFF;
+}
+
+static void BMBTSettingsApplyTemps(BMBTContext_t *context, uint8_t value)
+{
+    uint8_t valueType = IBUS_SENSOR_VALUE_COOLANT_TEMP;
+    if (value == CONFIG_SETTING_OFF) {
+        // Clear the header area
+        IBusCommandGTWriteZone(context->ibus, BMBT_HEADER_TEMPS, "      ");
+        BMBTGTFlushHeaderWrite(context);
+        return;
+    } else if (value == CONFIG_SETTING_TEMP_AMBIENT) {
+        valueType = IBUS_SENSOR_VALUE_AMBIENT_TEMP;
+    } else if (value == CONFIG_SETTING_TEMP_OIL) {
+        valueType = IBUS_SENSOR_VALUE_OIL_TEMP;
+    }
+    BMBTIBusSensorValueUpdate((void *) context, &valueType);
+}
+
+static const uint8_t BMBT_SETTINGS_LANGUAGE_LIST[] = {
+    CONFIG_SETTING_LANGUAGE_AUTO,
+    CONFIG_SETTING_LANGUAGE_ENGLISH,
+    CONFIG_SETTING_LANGUAGE_ESTONIAN,
+    CONFIG_SETTING_LANGUAGE_GERMAN,
+    CONFIG_SETTING_LANGUAGE_ITALIAN,
+    CONFIG_SETTING_LANGUAGE_RUSSIAN,
+    CONFIG_SETTING_LANGUAGE_SPANISH,
+    CONFIG_SETTING_LANGUAGE_POLISH,
+    CONFIG_SETTING_LANGUAGE_FRENCH,
+    CONFIG_SETTING_LANGUAGE_DUTCH
+};
+
+static const ConfigValueSet_t BMBT_SETTINGS_VALUES_LANGUAGE = {
+    sizeof(BMBT_SETTINGS_LANGUAGE_LIST), 0, 0, 0, BMBT_SETTINGS_LANGUAGE_LIST
+};
+
+static const char * const BMBT_SETTINGS_LANGUAGE_CODES[] = {
+    "Auto",
+    "EN",
+    "ET",
+    "DE",
+    "IT",
+    "RU",
+    "ES",
+    "PL",
+    "FR",
+    "NL"
+};
+
+static void BMBTSettingsFormatLanguage(
+    BMBTContext_t *context,
+    uint8_t value,
+    char *text
+) {
+    uint8_t idx = ConfigValueSetGetIndex(&BMBT_SETTINGS_VALUES_LANGUAGE, value);
+    UtilsFormat(
+        text,
         BMBT_MENU_STRING_MAX_SIZE,
-        LocaleGetText(LOCALE_STRING_PDC),
-        (
-            (pdc == CONFIG_SETTING_PDC_CLUSTER) ? "Cluster":
-            (pdc == CONFIG_SETTING_PDC_RADIO) ? "Screen":
-            (pdc == CONFIG_SETTING_PDC_BOTH) ? "Dual":
-            LocaleGetText(LOCALE_STRING_OFF)
-        )
-    );
-    BMBTGTWriteIndex(
-        context,
-        BMBT_MENU_IDX_SETTINGS_COMFORT_VISUAL_PDC,
-        pdcText,
-        2
+        LocaleGetText(LOCALE_STRING_LANG),
+        BMBT_SETTINGS_LANGUAGE_CODES[idx]
     );
-    BMBTGTWriteIndex(context, BMBT_MENU_IDX_BACK, LocaleGetText(LOCALE_STRING_BACK), 0);
-    BMBTGTBufferFlush(context);
-    context->menu = BMBT_MENU_SETTINGS_COMFORT;
 }
 
-static void BMBTMenuSettingsCalling(BMBTContext_t *context)
+static void BMBTSettingsApplyLanguage(BMBTContext_t *context, uint8_t value)
 {
-    BMBTGTWriteTitleIndex(context, LocaleGetText(LOCALE_STRING_SETTINGS_CALLING));
-    if (ConfigGetSetting(CONFIG_SETTING_HFP) == CONFIG_SETTING_OFF) {
-        BMBTGTWriteIndex(
-            context,
-            BMBT_MENU_IDX_SETTINGS_CALLING_HFP,
-            LocaleGetText(LOCALE_STRING_HANDSFREE_OFF),
-            0
-        );
+    BMBTTriggerWriteHeader(context);
+}
+
+static void BMBTSettingsApplyTrueSpeed(BMBTContext_t *context, uint8_t value)
+{
+    if (value == CONFIG_SETTING_ON) {
+        BMBTHeaderWriteSpeed(context);
     } else {
-        BMBTGTWriteIndex(
-            context,
-            BMBT_MENU_IDX_SETTINGS_CALLING_HFP,
-            LocaleGetText(LOCALE_STRING_HANDSFREE_ON),
-            0
+        IBusCommandGTWriteZone(context->ibus, BMBT_HEADER_SPEED, "    ");
+    }
+    BMBTGTFlushHeaderWrite(context);
+}
+
+static const ConfigValueSet_t BMBT_SETTINGS_VALUES_DAC_GAIN = {0, 0, 96, 2, 0};
+
+static const uint16_t BMBT_SETTINGS_LABELS_AUTOPLAY[] = {
+    LOCALE_STRING_AUTOPLAY_OFF,
+    LOCALE_STRING_AUTOPLAY_ON
+};
+
+static const uint16_t BMBT_SETTINGS_LABELS_DSP_INPUT[] = {
+    LOCALE_STRING_DSP_DEFAULT,
+    LOCALE_STRING_DSP_DIGITAL,
+    LOCALE_STRING_DSP_ANALOG
+};
+
+static const uint16_t BMBT_SETTINGS_LABELS_REV_VOL[] = {
+    LOCALE_STRING_REV_VOL_LOW_OFF,
+    LOCALE_STRING_REV_VOL_LOW_ON
+};
+
+static const BMBTMenuSetting_t BMBT_SETTINGS_AUDIO[] = {
+    {
+        .index = BMBT_MENU_IDX_SETTINGS_AUDIO_AUTOPLAY,
+        .setting = CONFIG_SETTING_AUTOPLAY,
+        .values = &CONFIG_VALUES_OFF_ON,
+        .labels = BMBT_SETTINGS_LABELS_AUTOPLAY
+    },
+    {
+        .index = BMBT_MENU_IDX_SETTINGS_AUDIO_DAC_GAIN,
+        .setting = CONFIG_SETTING_DAC_AUDIO_VOL,
+        .values = &BMBT_SETTINGS_VALUES_DAC_GAIN,
+        .format = &BMBTSettingsFormatDACGain,
+        .apply = &BMBTSettingsApplyDACGain
+    },
+    {
+        .index = BMBT_MENU_IDX_SETTINGS_AUDIO_DSP_INPUT,
+        .setting = CONFIG_SETTING_DSP_INPUT_SRC,
+        .values = &CONFIG_VALUES_DSP_INPUT,
+        .labels = BMBT_SETTINGS_LABELS_DSP_INPUT,
+        .apply = &BMBTSettingsApplyDSPInput
+    },
+    {
+        .index = BMBT_MENU_IDX_SETTINGS_AUDIO_REV_VOL,
+        .setting = CONFIG_SETTING_VOLUME_LOWER_ON_REV,
+        .values = &CONFIG_VALUES_OFF_ON,
+        .labels = BMBT_SETTINGS_LABELS_REV_VOL
+    }
+};
+
+static const uint16_t BMBT_SETTINGS_LABELS_LOCK[] = {
+    LOCALE_STRING_LOCK_OFF,
+    LOCALE_STRING_LOCK_10KMH,
+    LOCALE_STRING_LOCK_20KMH
+};
+
+static const uint16_t BMBT_SETTINGS_LABELS_UNLOCK[] = {
+    LOCALE_STRING_UNLOCK_OFF,
+    LOCALE_STRING_UNLOCK_POS_1,
+    LOCALE_STRING_UNLOCK_POS_0
+};
+
+static const uint16_t BMBT_SETTINGS_LABELS_PARK_LAMPS[] = {
+    LOCALE_STRING_PARK_LAMPS_OFF,
+    LOCALE_STRING_PARK_LAMPS_ON
+};
+
+static const BMBTMenuSetting_t BMBT_SETTINGS_COMFORT[] = {
+    {
+        .index = BMBT_MENU_IDX_SETTINGS_COMFORT_LOCK,
+        .values = &CONFIG_VALUES_COMFORT_LOCK,
+        .labels = BMBT_SETTINGS_LABELS_LOCK,
+        .get = &ConfigGetComfortLock,
+        .set = &ConfigSetComfortLock
+    },
+    {
+        .index = BMBT_MENU_IDX_SETTINGS_COMFORT_UNLOCK,
+        .values = &CONFIG_VALUES_COMFORT_UNLOCK,
+        .labels = BMBT_SETTINGS_LABELS_UNLOCK,
+        .get = &ConfigGetComfortUnlock,
+        .set = &ConfigSetComfortUnlock
+    },
+    {
+        .index = BMBT_MENU_IDX_SETTINGS_COMFORT_BLINKERS,
+        .setting = CONFIG_SETTING_COMFORT_BLINKERS,
+        .values = &CONFIG_VALUES_COMFORT_BLINKERS,
+        .format = &BMBTSettingsFormatBlinkers
+    },
+    {
+        .index = BMBT_MENU_IDX_SETTINGS_COMFORT_PARKING_LAMPS,
+        .setting = CONFIG_SETTING_COMFORT_PARKING_LAMPS,
+        .values = &CONFIG_VALUES_OFF_ON,
+        .labels = BMBT_SETTINGS_LABELS_PARK_LAMPS,
+        .apply = &BMBTSettingsApplyParkingLamps
+    },
+    {
+        .index = BMBT_MENU_IDX_SETTINGS_COMFORT_VISUAL_PDC,
+        .setting = CONFIG_SETTING_VISUAL_PDC,
+        .values = &CONFIG_VALUES_PDC,
+        .format = &BMBTSettingsFormatVisualPDC
+    }
+};
+
+static const uint16_t BMBT_SETTINGS_LABELS_HFP[] = {
+    LOCALE_STRING_HANDSFREE_OFF,
+    LOCALE_STRING_HANDSFREE_ON
+};
+
+static const uint16_t BMBT_SETTINGS_LABELS_TEL_MODE[] = {
+    LOCALE_STRING_MODE_DEFAULT,
+    LOCALE_STRING_MODE_TCU,
+    LOCALE_STRING_MODE_NO_MUTE,
+    LOCALE_STRING_MODE_ANALOG
+};
+
+static const BMBTMenuSetting_t BMBT_SETTINGS_CALLING[] = {
+    {
+        .index = BMBT_MENU_IDX_SETTINGS_CALLING_HFP,
+        .setting = CONFIG_SETTING_HFP,
+        .values = &CONFIG_VALUES_OFF_ON,
+        .labels = BMBT_SETTINGS_LABELS_HFP,
+        .apply = &BMBTSettingsApplyHFP
+    },
+    {
+        .index = BMBT_MENU_IDX_SETTINGS_CALLING_MIC_GAIN,
+        .setting = CONFIG_SETTING_MIC_GAIN,
+        .next = &BMBTSettingsNextMicGain,
+        .format = &BMBTSettingsFormatMicGain,
+        .apply = &BMBTSettingsApplyMicGain
+    },
+    {
+        .index = BMBT_MENU_IDX_SETTINGS_CALLING_VOL_OFFSET,
+        .setting = CONFIG_SETTING_TEL_VOL,
+        .values = &CONFIG_VALUES_TEL_VOL,
+        .format = &BMBTSettingsFormatVolOffset
+    },
+    {
+        // TCU Mode is not necessary on HW Version 1
+        .index = BMBT_MENU_IDX_SETTINGS_CALLING_MODE,
+        .setting = CONFIG_SETTING_TEL_MODE,
+        .flags = BMBT_MENU_SETTING_FLAG_HIDE_BC127,
+        .values = &CONFIG_VALUES_TEL_MODE,
+        .labels = BMBT_SETTINGS_LABELS_TEL_MODE
+    }
+};
+
+static const uint16_t BMBT_SETTINGS_LABELS_DEFAULT_MENU[] = {
+    LOCALE_STRING_MENU_MAIN,
+    LOCALE_STRING_MENU_DASHBOARD
+};
+
+static const uint8_t BMBT_SETTINGS_METADATA_MODE_LIST[] = {
+    BMBT_METADATA_MODE_OFF,
+    BMBT_METADATA_MODE_PARTY,
+    BMBT_METADATA_MODE_CHUNK
+};
+
+static const ConfigValueSet_t BMBT_SETTINGS_VALUES_METADATA_MODE = {
+    sizeof(BMBT_SETTINGS_METADATA_MODE_LIST), 0, 0, 0, BMBT_SETTINGS_METADATA_MODE_LIST
+};
+
+static const uint16_t BMBT_SETTINGS_LABELS_METADATA_MODE[] = {
+    LOCALE_STRING_METADATA_OFF,
+    LOCALE_STRING_METADATA_PARTY,
+    LOCALE_STRING_METADATA_CHUNK
+};
+
+static const uint8_t BMBT_SETTINGS_TEMPS_LIST[] = {
+    CONFIG_SETTING_OFF,
+    CONFIG_SETTING_TEMP_COOLANT,
+    CONFIG_SETTING_TEMP_AMBIENT,
+    CONFIG_SETTING_TEMP_OIL
+};
+
+static const ConfigValueSet_t BMBT_SETTINGS_VALUES_TEMPS = {
+    sizeof(BMBT_SETTINGS_TEMPS_LIST), 0, 0, 0, BMBT_SETTINGS_TEMPS_LIST
+};
+
+static const uint16_t BMBT_SETTINGS_LABELS_TEMPS[] = {
+    LOCALE_STRING_TEMPS_OFF,
+    LOCALE_STRING_TEMPS_COOLANT,
+    LOCALE_STRING_TEMPS_AMBIENT,
+    LOCALE_STRING_TEMPS_OIL
+};
+
+static const uint16_t BMBT_SETTINGS_LABELS_DASH_OBC[] = {
+    LOCALE_STRING_DASH_OBC_OFF,
+    LOCALE_STRING_DASH_OBC_ON
+};
+
+static const uint16_t BMBT_SETTINGS_LABELS_MONITOR_OFF[] = {
+    LOCALE_STRING_BMBT_OFF_OFF,
+    LOCALE_STRING_BMBT_OFF_ON
+};
+
+static const uint16_t BMBT_SETTINGS_LABELS_TRUE_SPEED[] = {
+    LOCALE_STRING_SPEED_OFF,
+    LOCALE_STRING_SPEED_ON
+};
+
+static const BMBTMenuSetting_t BMBT_SETTINGS_UI[] = {
+    {
+        .index = BMBT_MENU_IDX_SETTINGS_UI_DEFAULT_MENU,
+        .setting = CONFIG_SETTING_BMBT_DEFAULT_MENU,
+        .values = &CONFIG_VALUES_OFF_ON,
+        .labels = BMBT_SETTINGS_LABELS_DEFAULT_MENU
+    },
+    {
+        .index = BMBT_MENU_IDX_SETTINGS_UI_METADATA_MODE,
+        .setting = CONFIG_SETTING_METADATA_MODE,
+        .values = &BMBT_SETTINGS_VALUES_METADATA_MODE,
+        .labels = BMBT_SETTINGS_LABELS_METADATA_MODE,
+        .apply = &BMBTSettingsApplyMetadataMode
+    },
+    {
+        .index = BMBT_MENU_IDX_SETTINGS_UI_TEMPS,
+        .values = &BMBT_SETTINGS_VALUES_TEMPS,
+        .labels = BMBT_SETTINGS_LABELS_TEMPS,
+        .get = &ConfigGetTempDisplay,
+        .set = &ConfigSetTempDisplay,
+        .next = &BMBTSettingsNextTemps,
+        .apply = &BMBTSettingsApplyTemps
+    },
+    {
+        .index = BMBT_MENU_IDX_SETTINGS_IU_DASH_OBC,
+        .setting = CONFIG_SETTING_BMBT_DASHBOARD_OBC,
+        .values = &CONFIG_VALUES_OFF_ON,
+        .labels = BMBT_SETTINGS_LABELS_DASH_OBC
+    },
+    {
+        .index = BMBT_MENU_IDX_SETTINGS_UI_MONITOR_OFF,
+        .setting = CONFIG_SETTING_MONITOR_OFF,
+        .values = &CONFIG_VALUES_OFF_ON,
+        .labels = BMBT_SETTINGS_LABELS_MONITOR_OFF
+    },
+    {
+        // A new language changes the text of every row
+        .index = BMBT_MENU_IDX_SETTINGS_UI_LANGUAGE,
+        .setting = CONFIG_SETTING_LANGUAGE,
+        .flags = BMBT_MENU_SETTING_FLAG_REDRAW,
+        .values = &BMBT_SETTINGS_VALUES_LANGUAGE,
+        .format = &BMBTSettingsFormatLanguage,
+        .apply = &BMBTSettingsApplyLanguage
+    },
+    {
+        .index = BMBT_MENU_IDX_SETTINGS_UI_TRUE_SPEED,
+        .setting = CONFIG_SETTING_TRUE_SPEED,
+        .values = &CONFIG_VALUES_OFF_ON,
+        .labels = BMBT_SETTINGS_LABELS_TRUE_SPEED,
+        .apply = &BMBTSettingsApplyTrueSpeed
+    }
+};
+
+static const BMBTSettingsMenu_t BMBT_SETTINGS_MENU_AUDIO = {
+    BMBT_MENU_SETTINGS_AUDIO,
+    LOCALE_STRING_SETTINGS_AUDIO,
+    sizeof(BMBT_SETTINGS_AUDIO) / sizeof(BMBTMenuSetting_t),
+    BMBT_SETTINGS_AUDIO
+};
+
+static const BMBTSettingsMenu_t BMBT_SETTINGS_MENU_COMFORT = {
+    BMBT_MENU_SETTINGS_COMFORT,
+    LOCALE_STRING_SETTINGS_COMFORT,
+    sizeof(BMBT_SETTINGS_COMFORT) / sizeof(BMBTMenuSetting_t),
+    BMBT_SETTINGS_COMFORT
+};
+
+static const BMBTSettingsMenu_t BMBT_SETTINGS_MENU_CALLING = {
+    BMBT_MENU_SETTINGS_CALLING,
+    LOCALE_STRING_SETTINGS_CALLING,
+    sizeof(BMBT_SETTINGS_CALLING) / sizeof(BMBTMenuSetting_t),
+    BMBT_SETTINGS_CALLING
+};
+
+static const BMBTSettingsMenu_t BMBT_SETTINGS_MENU_UI = {
+    BMBT_MENU_SETTINGS_UI,
+    LOCALE_STRING_SETTINGS_UI,
+    sizeof(BMBT_SETTINGS_UI) / sizeof(BMBTMenuSetting_t),
+    BMBT_SETTINGS_UI
+};
+
+/**
+ * BMBTMenuSettingGetValue()
+ *     Description:
+ *         Read the current value of a setting, replacing anything that its
+ *         value set cannot hold with the first value of the set
+ *     Params:
+ *         const BMBTMenuSetting_t *setting - The setting
+ *     Returns:
+ *         uint8_t - The value
+ */
+static uint8_t BMBTMenuSettingGetValue(const BMBTMenuSetting_t *setting)
+{
+    uint8_t value = 0;
+    if (setting->get != 0) {
+        value = setting->get();
+    } else {
+        value = ConfigGetSetting(setting->setting);
+    }
+    if (setting->values != 0) {
+        return ConfigValueSetGetValid(setting->values, value);
+    }
+    return value;
+}
+
+/**
+ * BMBTMenuSettingGetText()
+ *     Description:
+ *         Get the text of a settings row for the given value
+ *     Params:
+ *         BMBTContext_t *context - The context
+ *         const BMBTMenuSetting_t *setting - The setting
+ *         uint8_t value - The value to describe
+ *         char *text - A buffer of BMBT_MENU_STRING_MAX_SIZE bytes for the
+ *             settings that format their text
+ *     Returns:
+ *         char * - The row text
+ */
+static char *BMBTMenuSettingGetText(
+    BMBTContext_t *context,
+    const BMBTMenuSetting_t *setting,
+    uint8_t value,
+    char *text
+) {
+    if (setting->labels != 0) {
+        return LocaleGetText(
+            setting->labels[ConfigValueSetGetIndex(setting->values, value)]
         );
     }
-    uint8_t micGain = ConfigGetSetting(CONFIG_SETTING_MIC_GAIN);
-    char micGainText[BMBT_MENU_STRING_MAX_SIZE] = {0};
-    if (context->bt->type == BT_BTM_TYPE_BC127) {
-        if (micGain > 21) {
-            micGain = 0;
+    setting->format(context, value, text);
+    return text;
+}
+
+static uint8_t BMBTMenuSettingIsVisible(
+    BMBTContext_t *context,
+    const BMBTMenuSetting_t *setting
+) {
+    if (
+        (setting->flags & BMBT_MENU_SETTING_FLAG_HIDE_BC127) != 0 &&
+        context->bt->type == BT_BTM_TYPE_BC127
+    ) {
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * BMBTMenuSettingsWrite()
+ *     Description:
+ *         Draw a settings menu from its table. The last visible row clears
+ *         the indices between it and the back button.
+ *     Params:
+ *         BMBTContext_t *context - The context
+ *         const BMBTSettingsMenu_t *menu - The menu to draw
+ *     Returns:
+ *         void
+ */
+static void BMBTMenuSettingsWrite(
+    BMBTContext_t *context,
+    const BMBTSettingsMenu_t *menu
+) {
+    BMBTGTWriteTitleIndex(context, LocaleGetText(menu->title));
+    char text[BMBT_MENU_STRING_MAX_SIZE];
+    uint8_t lastIdx = 0;
+    uint8_t idx;
+    for (idx = 0; idx < menu->settingCount; idx++) {
+        if (BMBTMenuSettingIsVisible(context, &menu->settings[idx]) == 1) {
+            lastIdx = menu->settings[idx].index;
         }
-        snprintf(
-            micGainText,
-            BMBT_MENU_STRING_MAX_SIZE,
-            LocaleGetText(LOCALE_STRING_MIC_GAIN),
-            (int8_t) BTBC127MicGainTable[micGain]
-        );
-    } else {
-        if (micGain > 0x0F) {
-            micGain = 0;
+    }
+    for (idx = 0; idx < menu->settingCount; idx++) {
+        const BMBTMenuSetting_t *setting = &menu->settings[idx];
+        if (BMBTMenuSettingIsVisible(context, setting) == 0) {
+            continue;
         }
-        snprintf(
-            micGainText,
-            BMBT_MENU_STRING_MAX_SIZE,
-            LocaleGetText(LOCALE_STRING_MIC_GAIN),
-            (int8_t) BTBM83MicGainTable[micGain]
+        uint8_t clearIdxs = 0;
+        if (setting->index == lastIdx) {
+            clearIdxs = BMBT_MENU_IDX_BACK - lastIdx - 1;
+        }
+        uint8_t value = BMBTMenuSettingGetValue(setting);
+        BMBTGTWriteIndex(
+            context,
+            setting->index,
+            BMBTMenuSettingGetText(context, setting, value, text),
+            clearIdxs
         );
     }
-    BMBTGTWriteIndex(
-        context,
-        BMBT_MENU_IDX_SETTINGS_CALLING_MIC_GAIN,
-        micGainText,
-        0
-    );
-    uint8_t volOffsetSkip = 0;
-    if (context->bt->type == BT_BTM_TYPE_BC127) {
-        volOffsetSkip = 4;
+    BMBTGTWriteIndex(context, BMBT_MENU_IDX_BACK, LocaleGetText(LOCALE_STRING_BACK), 0);
+    BMBTGTBufferFlush(context);
+    context->menu = menu->menu;
+}
+
+/**
+ * BMBTSettingsUpdateTable()
+ *     Description:
+ *         Move the selected row of a settings menu on to its next value,
+ *         store it, redraw the row and let the hardware follow
+ *     Params:
+ *         BMBTContext_t *context - The context
+ *         const BMBTSettingsMenu_t *menu - The menu that is shown
+ *         uint8_t selectedIdx - The selected index
+ *     Returns:
+ *         void
+ */
+static void BMBTSettingsUpdateTable(
+    BMBTContext_t *context,
+    const BMBTSettingsMenu_t *menu,
+    uint8_t selectedIdx
+) {
+    if (selectedIdx == BMBT_MENU_IDX_BACK) {
+        BMBTMenuSettings(context);
+        return;
     }
-    int8_t volumeOffset = ConfigGetSetting(CONFIG_SETTING_TEL_VOL);
-    char volOffsetText[BMBT_MENU_STRING_MAX_SIZE] = {0};
-    snprintf(
-        volOffsetText,
-        BMBT_MENU_STRING_MAX_SIZE,
-        LocaleGetText(LOCALE_STRING_VOL_OFFSET),
-        volumeOffset
-    );
-    BMBTGTWriteIndex(
-        context,
-        BMBT_MENU_IDX_SETTINGS_CALLING_VOL_OFFSET,
-        volOffsetText,
-        volOffsetSkip
-    );
-    // Hide TCU Mode option on HW Version 1. It is not necessary there.
-    if (context->bt->type != BT_BTM_TYPE_BC127) {
-        uint8_t telMode = ConfigGetSetting(CONFIG_SETTING_TEL_MODE);
-        if (telMode == CONFIG_SETTING_TEL_MODE_TCU) {
-            BMBTGTWriteIndex(
-                context,
-                BMBT_MENU_IDX_SETTINGS_CALLING_MODE,
-                LocaleGetText(LOCALE_STRING_MODE_TCU),
-                3
-            );
-        } else if (telMode == CONFIG_SETTING_TEL_MODE_NO_MUTE) {
-            BMBTGTWriteIndex(
-                context,
-                BMBT_MENU_IDX_SETTINGS_CALLING_MODE,
-                LocaleGetText(LOCALE_STRING_MODE_NO_MUTE),
-                3
-            );
-        } else if (telMode == CONFIG_SETTING_TEL_MODE_ANALOG) {
-            BMBTGTWriteIndex(
-                context,
-                BMBT_MENU_IDX_SETTINGS_CALLING_MODE,
-                LocaleGetText(LOCALE_STRING_MODE_ANALOG),
-                3
-            );
+    uint8_t idx;
+    for (idx = 0; idx < menu->settingCount; idx++) {
+        const BMBTMenuSetting_t *setting = &menu->settings[idx];
+        if (
+            setting->index != selectedIdx ||
+            BMBTMenuSettingIsVisible(context, setting) == 0
+        ) {
+            continue;
+        }
+        uint8_t value = BMBTMenuSettingGetValue(setting);
+        if (setting->next != 0) {
+            value = setting->next(context, value);
         } else {
+            value = ConfigValueSetGetNext(setting->values, value, 0);
+        }
+        if (setting->set != 0) {
+            setting->set(value);
+        } else {
+            ConfigSetSetting(setting->setting, value);
+        }
+        if ((setting->flags & BMBT_MENU_SETTING_FLAG_REDRAW) != 0) {
+            BMBTMenuSettingsWrite(context, menu);
+        } else {
+            char text[BMBT_MENU_STRING_MAX_SIZE];
             BMBTGTWriteIndex(
                 context,
-                BMBT_MENU_IDX_SETTINGS_CALLING_MODE,
-                LocaleGetText(LOCALE_STRING_MODE_DEFAULT),
-                3
+                selectedIdx,
+                BMBTMenuSettingGetText(context, setting, value, text),
+                0
             );
         }
+        if (setting->apply != 0) {
+            setting->apply(context, value);
+        }
+        break;
     }
-    BMBTGTWriteIndex(context, BMBT_MENU_IDX_BACK, LocaleGetText(LOCALE_STRING_BACK), 0);
     BMBTGTBufferFlush(context);
-    context->menu = BMBT_MENU_SETTINGS_CALLING;
+}
+
+static void BMBTMenuSettingsAudio(BMBTContext_t *context)
+{
+    BMBTMenuSettingsWrite(context, &BMBT_SETTINGS_MENU_AUDIO);
+}
+
+static void BMBTMenuSettingsComfort(BMBTContext_t *context)
+{
+    BMBTMenuSettingsWrite(context, &BMBT_SETTINGS_MENU_COMFORT);
+}
+
+static void BMBTMenuSettingsCalling(BMBTContext_t *context)
+{
+    BMBTMenuSettingsWrite(context, &BMBT_SETTINGS_MENU_CALLING);
+}
+
+static void BMBTMenuSettingsUI(BMBTContext_t *context)
+{
+    BMBTMenuSettingsWrite(context, &BMBT_SETTINGS_MENU_UI);
+}
+
+static void BMBTSettingsUpdateAudio(BMBTContext_t *context, uint8_t selectedIdx)
+{
+    BMBTSettingsUpdateTable(context, &BMBT_SETTINGS_MENU_AUDIO, selectedIdx);
+}
+
+static void BMBTSettingsUpdateComfort(BMBTContext_t *context, uint8_t selectedIdx)
+{
+    BMBTSettingsUpdateTable(context, &BMBT_SETTINGS_MENU_COMFORT, selectedIdx);
+}
+
+static void BMBTSettingsUpdateCalling(BMBTContext_t *context, uint8_t selectedIdx)
+{
+    BMBTSettingsUpdateTable(context, &BMBT_SETTINGS_MENU_CALLING, selectedIdx);
+}
+
+static void BMBTSettingsUpdateUI(BMBTContext_t *context, uint8_t selectedIdx)
+{
+    BMBTSettingsUpdateTable(context, &BMBT_SETTINGS_MENU_UI, selectedIdx);
 }
 
 static void BMBTMenuSettingsNav(BMBTContext_t *context)
@@ -1418,7 +2295,7 @@ static void BMBTMenuSettingsNav(BMBTContext_t *context)
     }
     char text[BMBT_MENU_STRING_MAX_SIZE] = {0};
     if (autozoom == CONFIG_SETTING_OFF) {
-        snprintf(
+        UtilsFormat(
             text,
             BMBT_MENU_STRING_MAX_SIZE,
             LocaleGetText(LOCALE_STRING_AUTOZOOM),
@@ -1426,14 +2303,14 @@ static void BMBTMenuSettingsNav(BMBTContext_t *context)
         );
     } else {
         if (ConfigGetDistUnit() == 0) {
-            snprintf(
+            UtilsFormat(
                 text,
                 BMBT_MENU_STRING_MAX_SIZE,
                 LocaleGetText(LOCALE_STRING_AUTOZOOM),
                 navZoomScaleMetric[autozoom]
             );
         } else {
-            snprintf(
+            UtilsFormat(
                 text,
                 BMBT_MENU_STRING_MAX_SIZE,
                 LocaleGetText(LOCALE_STRING_AUTOZOOM),
@@ -1449,7 +2326,7 @@ static void BMBTMenuSettingsNav(BMBTContext_t *context)
     );
 
     uint8_t automap = ConfigGetSetting(CONFIG_SETTING_NAV) & 0x0F;
-    snprintf(
+    UtilsFormat(
         text,
         BMBT_MENU_STRING_MAX_SIZE,
         LocaleGetText(LOCALE_STRING_NAV_MAP),
@@ -1469,7 +2346,7 @@ static void BMBTMenuSettingsNav(BMBTContext_t *context)
         0
     );
 
-    snprintf(
+    UtilsFormat(
         text,
         BMBT_MENU_STRING_MAX_SIZE,
         LocaleGetText(LOCALE_STRING_NAV_RANGE),
@@ -1483,7 +2360,7 @@ static void BMBTMenuSettingsNav(BMBTContext_t *context)
         text,
         0
     );
-    snprintf(
+    UtilsFormat(
         text,
         BMBT_MENU_STRING_MAX_SIZE,
         LocaleGetText(LOCALE_STRING_NAV_SILENT),
@@ -1507,7 +2384,7 @@ static void BMBTMenuSettingsTime(BMBTContext_t *context)
     BMBTGTWriteTitleIndex(context, LocaleGetText(LOCALE_STRING_SETTINGS_TIME));
     char text[BMBT_MENU_STRING_MAX_SIZE] = {0};
     uint8_t autotime = ConfigGetTimeSource();
-    snprintf(
+    UtilsFormat(
         text,
         BMBT_MENU_STRING_MAX_SIZE,
         LocaleGetText(LOCALE_STRING_AUTOTIME),
@@ -1529,7 +2406,7 @@ static void BMBTMenuSettingsTime(BMBTContext_t *context)
         uint8_t dst = ConfigGetTimeDST();
         int16_t off = ConfigGetTimeOffset();
 
-        snprintf(
+        UtilsFormat(
             text,
             BMBT_MENU_STRING_MAX_SIZE,
             LocaleGetText(LOCALE_STRING_AUTOTIME_DST),
@@ -1542,532 +2419,70 @@ static void BMBTMenuSettingsTime(BMBTContext_t *context)
             0
         );
 
-        snprintf(
-            text,
-            BMBT_MENU_STRING_MAX_SIZE,
-            LocaleGetText(LOCALE_STRING_AUTOTIME_OFFSET),
-            off / 60,
-            abs(off) % 60
-        );
-        BMBTGTWriteIndex(
-            context,
-            BMBT_MENU_IDX_SETTINGS_TIME_OFFSET,
+        UtilsFormat(
             text,
-            1
-        );
-
-        if (context->ibus->gpsDateTime.year > 0) {
-            snprintf(
-                text,
-                BMBT_MENU_STRING_MAX_SIZE,
-                "%4d-%02d-%02d",
-                context->ibus->gpsDateTime.year,
-                context->ibus->gpsDateTime.month,
-                context->ibus->gpsDateTime.day
-            );
-
-            BMBTGTWriteIndex(
-                context,
-                BMBT_MENU_IDX_SETTINGS_TIME_GPSDATE,
-                text,
-                0
-            );
-
-            snprintf(
-                text,
-                BMBT_MENU_STRING_MAX_SIZE,
-                "%02d:%02d",
-                context->ibus->gpsDateTime.hour,
-                context->ibus->gpsDateTime.min
-            );
-
-            BMBTGTWriteIndex(
-                context,
-                BMBT_MENU_IDX_SETTINGS_TIME_GPSTIME,
-                    text,
-                    1
-                );
-        } else {
-            BMBTGTWriteIndex(
-                context,
-                BMBT_MENU_IDX_SETTINGS_TIME_GPSDATE,
-                LocaleGetText(LOCALE_STRING_AUTOTIME_NOSIGNAL),
-                2
-            );
-        }
-    }
-
-    BMBTGTWriteIndex(context, BMBT_MENU_IDX_BACK, LocaleGetText(LOCALE_STRING_BACK), 0);
-    BMBTGTBufferFlush(context);
-    context->menu = BMBT_MENU_SETTINGS_TIME;
-}
-
-static void BMBTMenuSettingsUI(BMBTContext_t *context)
-{
-    BMBTGTWriteTitleIndex(context, LocaleGetText(LOCALE_STRING_SETTINGS_UI));
-    if (ConfigGetSetting(CONFIG_SETTING_BMBT_DEFAULT_MENU) == CONFIG_SETTING_OFF) {
-        BMBTGTWriteIndex(
-            context,
-            BMBT_MENU_IDX_SETTINGS_UI_DEFAULT_MENU,
-            LocaleGetText(LOCALE_STRING_MENU_MAIN),
-            0
-        );
-    } else {
-        BMBTGTWriteIndex(
-            context,
-            BMBT_MENU_IDX_SETTINGS_UI_DEFAULT_MENU,
-            LocaleGetText(LOCALE_STRING_MENU_DASHBOARD),
-            0
-        );
-    }
-    uint8_t metadataMode = ConfigGetSetting(CONFIG_SETTING_METADATA_MODE);
-    if (metadataMode == BMBT_METADATA_MODE_PARTY) {
-        BMBTGTWriteIndex(
-            context,
-            BMBT_MENU_IDX_SETTINGS_UI_METADATA_MODE,
-            LocaleGetText(LOCALE_STRING_METADATA_PARTY),
-            0
-        );
-    } else if (metadataMode == BMBT_METADATA_MODE_CHUNK) {
-        BMBTGTWriteIndex(
-            context,
-            BMBT_MENU_IDX_SETTINGS_UI_METADATA_MODE,
-            LocaleGetText(LOCALE_STRING_METADATA_CHUNK),
-            0
-        );
-    } else {
-        BMBTGTWriteIndex(
-            context,
-            BMBT_MENU_IDX_SETTINGS_UI_METADATA_MODE,
-            LocaleGetText(LOCALE_STRING_METADATA_OFF),
-            0
-        );
-    }
-    uint8_t tempMode = ConfigGetTempDisplay();
-    if (tempMode == CONFIG_SETTING_OFF) {
-        BMBTGTWriteIndex(
-            context,
-            BMBT_MENU_IDX_SETTINGS_UI_TEMPS,
-            LocaleGetText(LOCALE_STRING_TEMPS_OFF),
-            0
-        );
-    } else if (tempMode == CONFIG_SETTING_TEMP_COOLANT) {
-        BMBTGTWriteIndex(
-            context,
-            BMBT_MENU_IDX_SETTINGS_UI_TEMPS,
-            LocaleGetText(LOCALE_STRING_TEMPS_COOLANT),
-            0
-        );
-    } else if (tempMode == CONFIG_SETTING_TEMP_AMBIENT) {
-        BMBTGTWriteIndex(
-            context,
-            BMBT_MENU_IDX_SETTINGS_UI_TEMPS,
-            LocaleGetText(LOCALE_STRING_TEMPS_AMBIENT),
-            0
-        );
-    } else if (tempMode == CONFIG_SETTING_TEMP_OIL) {
-        BMBTGTWriteIndex(
-            context,
-            BMBT_MENU_IDX_SETTINGS_UI_TEMPS,
-            LocaleGetText(LOCALE_STRING_TEMPS_OIL),
-            0
-        );
-    }
-    uint8_t dashboardOBC = ConfigGetSetting(CONFIG_SETTING_BMBT_DASHBOARD_OBC);
-    if (dashboardOBC == CONFIG_SETTING_ON) {
-        BMBTGTWriteIndex(
-            context,
-            BMBT_MENU_IDX_SETTINGS_IU_DASH_OBC,
-            LocaleGetText(LOCALE_STRING_DASH_OBC_ON),
-            0
-        );
-    } else if (dashboardOBC == CONFIG_SETTING_OFF) {
-        BMBTGTWriteIndex(
-            context,
-            BMBT_MENU_IDX_SETTINGS_IU_DASH_OBC,
-            LocaleGetText(LOCALE_STRING_DASH_OBC_OFF),
-            0
-        );
-    }
-    if (ConfigGetSetting(CONFIG_SETTING_MONITOR_OFF) == CONFIG_SETTING_ON) {
-        BMBTGTWriteIndex(
-            context,
-            BMBT_MENU_IDX_SETTINGS_UI_MONITOR_OFF,
-            LocaleGetText(LOCALE_STRING_BMBT_OFF_ON),
-            0
-        );
-    } else {
-        BMBTGTWriteIndex(
-            context,
-            BMBT_MENU_IDX_SETTINGS_UI_MONITOR_OFF,
-            LocaleGetText(LOCALE_STRING_BMBT_OFF_OFF),
-            0
-        );
-    }
-    uint8_t selectedLanguage = ConfigGetSetting(CONFIG_SETTING_LANGUAGE);
-    char localeName[5] = {0};
-    switch (selectedLanguage) {
-        case CONFIG_SETTING_LANGUAGE_DUTCH:
-            strncpy(localeName, "NL", 2);
-            break;
-        case CONFIG_SETTING_LANGUAGE_ENGLISH:
-            strncpy(localeName, "EN", 2);
-            break;
-        case CONFIG_SETTING_LANGUAGE_ESTONIAN:
-            strncpy(localeName, "ET", 2);
-            break;
-        case CONFIG_SETTING_LANGUAGE_GERMAN:
-            strncpy(localeName, "DE", 2);
-            break;
-        case CONFIG_SETTING_LANGUAGE_ITALIAN:
-            strncpy(localeName, "IT", 2);
-            break;
-        case CONFIG_SETTING_LANGUAGE_RUSSIAN:
-            strncpy(localeName, "RU", 2);
-            break;
-        case CONFIG_SETTING_LANGUAGE_SPANISH:
-            strncpy(localeName, "ES", 2);
-            break;
-        case CONFIG_SETTING_LANGUAGE_POLISH:
-            strncpy(localeName, "PL", 2);
-            break;
-        case CONFIG_SETTING_LANGUAGE_FRENCH:
-            strncpy(localeName, "FR", 2);
-            break;
-        case CONFIG_SETTING_LANGUAGE_AUTO:
-        default:
-            strncpy(localeName, "Auto", 4);
-            break;
-    }
-    char langStr[BMBT_MENU_STRING_MAX_SIZE] = {0};
-    snprintf(
-        langStr,
-        BMBT_MENU_STRING_MAX_SIZE,
-        LocaleGetText(LOCALE_STRING_LANG),
-        localeName
-    );
-    BMBTGTWriteIndex(
-        context,
-        BMBT_MENU_IDX_SETTINGS_UI_LANGUAGE,
-        langStr,
-        0
-    );
-    if (ConfigGetSetting(CONFIG_SETTING_TRUE_SPEED) == CONFIG_SETTING_ON) {
-        BMBTGTWriteIndex(
-            context,
-            BMBT_MENU_IDX_SETTINGS_UI_TRUE_SPEED,
-            LocaleGetText(LOCALE_STRING_SPEED_ON),
-            0
-        );
-    } else {
-        BMBTGTWriteIndex(
-            context,
-            BMBT_MENU_IDX_SETTINGS_UI_TRUE_SPEED,
-            LocaleGetText(LOCALE_STRING_SPEED_OFF),
-            0
-        );
-    }
-    BMBTGTWriteIndex(context, BMBT_MENU_IDX_BACK, LocaleGetText(LOCALE_STRING_BACK), 0);
-    BMBTGTBufferFlush(context);
-    context->menu = BMBT_MENU_SETTINGS_UI;
-}
-
-static void BMBTSettingsUpdateAbout(BMBTContext_t *context, uint8_t selectedIdx)
-{
-    if (selectedIdx == BMBT_MENU_IDX_BACK) {
-        BMBTMenuSettings(context);
-    }
-}
-
-static void BMBTSettingsUpdateAudio(BMBTContext_t *context, uint8_t selectedIdx)
-{
-    if (selectedIdx == BMBT_MENU_IDX_SETTINGS_AUDIO_DAC_GAIN) {
-        uint8_t currentVolume = ConfigGetSetting(CONFIG_SETTING_DAC_AUDIO_VOL);
-        currentVolume = currentVolume + 2;
-        if (currentVolume > 96) {
-            currentVolume = 0;
-        }
-        ConfigSetSetting(CONFIG_SETTING_DAC_AUDIO_VOL, currentVolume);
-        char volText[BMBT_MENU_STRING_MAX_SIZE] = {0};
-        if (currentVolume > 0x30) {
-            uint8_t gain = (currentVolume - 0x30) / 2;
-            snprintf(volText, BMBT_MENU_STRING_MAX_SIZE, LocaleGetText(LOCALE_STRING_VOLUME_NEG_DB), gain);
-        } else if (currentVolume == 0) {
-            snprintf(volText, BMBT_MENU_STRING_MAX_SIZE, "%s", LocaleGetText(LOCALE_STRING_VOLUME_24_DB));
-        } else if (currentVolume == 0x30) {
-            snprintf(volText, BMBT_MENU_STRING_MAX_SIZE, "%s", LocaleGetText(LOCALE_STRING_VOLUME_0_DB));
-        } else {
-            uint8_t gain = (0x30 - currentVolume) / 2;
-            snprintf(volText, BMBT_MENU_STRING_MAX_SIZE, LocaleGetText(LOCALE_STRING_VOLUME_POS_DB), gain);
-        }
-        BMBTGTWriteIndex(context, selectedIdx, volText, 0);
-        PCM51XXSetVolume(currentVolume);
-    } else if (selectedIdx == BMBT_MENU_IDX_SETTINGS_AUDIO_DSP_INPUT) {
-        uint8_t dspInput = ConfigGetSetting(CONFIG_SETTING_DSP_INPUT_SRC);
-        if (dspInput == CONFIG_SETTING_OFF) {
-            ConfigSetSetting(CONFIG_SETTING_DSP_INPUT_SRC, CONFIG_SETTING_DSP_INPUT_SPDIF);
-            IBusCommandDSPSetMode(context->ibus, IBUS_DSP_CONFIG_SET_INPUT_SPDIF);
-            BMBTGTWriteIndex(context, selectedIdx, LocaleGetText(LOCALE_STRING_DSP_DIGITAL), 0);
-        } else if (dspInput == CONFIG_SETTING_DSP_INPUT_SPDIF) {
-            ConfigSetSetting(CONFIG_SETTING_DSP_INPUT_SRC, CONFIG_SETTING_DSP_INPUT_ANALOG);
-            IBusCommandDSPSetMode(context->ibus, IBUS_DSP_CONFIG_SET_INPUT_RADIO);
-            BMBTGTWriteIndex(context, selectedIdx, LocaleGetText(LOCALE_STRING_DSP_ANALOG), 0);
-        } else {
-            ConfigSetSetting(CONFIG_SETTING_DSP_INPUT_SRC, CONFIG_SETTING_OFF);
-            BMBTGTWriteIndex(context, selectedIdx, LocaleGetText(LOCALE_STRING_DSP_DEFAULT), 0);
-        }
-    } else if (selectedIdx == BMBT_MENU_IDX_SETTINGS_AUDIO_AUTOPLAY) {
-        if (ConfigGetSetting(CONFIG_SETTING_AUTOPLAY) == CONFIG_SETTING_OFF) {
-            ConfigSetSetting(CONFIG_SETTING_AUTOPLAY, CONFIG_SETTING_ON);
-            BMBTGTWriteIndex(context, selectedIdx, LocaleGetText(LOCALE_STRING_AUTOPLAY_ON), 0);
-        } else {
-            ConfigSetSetting(CONFIG_SETTING_AUTOPLAY, CONFIG_SETTING_OFF);
-            BMBTGTWriteIndex(context, selectedIdx, LocaleGetText(LOCALE_STRING_AUTOPLAY_OFF), 0);
-        }
-    } else if (selectedIdx == BMBT_MENU_IDX_SETTINGS_AUDIO_REV_VOL) {
-        if (ConfigGetSetting(CONFIG_SETTING_VOLUME_LOWER_ON_REV) == CONFIG_SETTING_OFF) {
-            ConfigSetSetting(CONFIG_SETTING_VOLUME_LOWER_ON_REV, CONFIG_SETTING_ON);
-            BMBTGTWriteIndex(context, selectedIdx, LocaleGetText(LOCALE_STRING_REV_VOL_LOW_ON), 0);
-        } else {
-            ConfigSetSetting(CONFIG_SETTING_VOLUME_LOWER_ON_REV, CONFIG_SETTING_OFF);
-            BMBTGTWriteIndex(context, selectedIdx, LocaleGetText(LOCALE_STRING_REV_VOL_LOW_OFF), 0);
-        }
-    } else if (selectedIdx == BMBT_MENU_IDX_BACK) {
-        BMBTMenuSettings(context);
-    }
-    if (selectedIdx != BMBT_MENU_IDX_BACK) {
-        BMBTGTBufferFlush(context);
-    }
-}
-
-static void BMBTSettingsUpdateComfort(BMBTContext_t *context, uint8_t selectedIdx)
-{
-    if (selectedIdx == BMBT_MENU_IDX_SETTINGS_COMFORT_BLINKERS) {
-        uint8_t value = ConfigGetSetting(CONFIG_SETTING_COMFORT_BLINKERS);
-        if (value == 0) {
-            value = 1;
-        } else if (value == 8) {
-            value = 0;
-        }
-        value = value + 1;
-        ConfigSetSetting(CONFIG_SETTING_COMFORT_BLINKERS, value);
-        char blinkerText[BMBT_MENU_STRING_MAX_SIZE] = {0};
-        snprintf(blinkerText, BMBT_MENU_STRING_MAX_SIZE, LocaleGetText(LOCALE_STRING_BLINKERS), value);
-        BMBTGTWriteIndex(context, selectedIdx, blinkerText, 0);
-    } else if (selectedIdx == BMBT_MENU_IDX_SETTINGS_COMFORT_PARKING_LAMPS) {
-        uint8_t value = ConfigGetSetting(CONFIG_SETTING_COMFORT_PARKING_LAMPS);
-        if (value == CONFIG_SETTING_OFF) {
-            value = CONFIG_SETTING_ON;
-            BMBTGTWriteIndex(context, selectedIdx, LocaleGetText(LOCALE_STRING_PARK_LAMPS_ON), 0);
-        } else {
-            value = CONFIG_SETTING_OFF;
-            BMBTGTWriteIndex(context, selectedIdx, LocaleGetText(LOCALE_STRING_PARK_LAMPS_OFF), 0);
-        }
-        // Request cluster indicators so we can trigger the new light setting
-        // when the response (0x5B) is received
-        IBusCommandLMGetClusterIndicators(context->ibus);
-        ConfigSetSetting(CONFIG_SETTING_COMFORT_PARKING_LAMPS, value);
-    } else if (selectedIdx == BMBT_MENU_IDX_SETTINGS_COMFORT_LOCK) {
-        uint8_t comfortLock = ConfigGetComfortLock();
-        if (comfortLock == CONFIG_SETTING_OFF ||
-            comfortLock > CONFIG_SETTING_COMFORT_LOCK_20KM
-        ) {
-            ConfigSetComfortLock(CONFIG_SETTING_COMFORT_LOCK_10KM);
-            BMBTGTWriteIndex(context, selectedIdx, LocaleGetText(LOCALE_STRING_LOCK_10KMH), 0);
-        } else if (comfortLock == CONFIG_SETTING_COMFORT_LOCK_10KM) {
-            ConfigSetComfortLock(CONFIG_SETTING_COMFORT_LOCK_20KM);
-            BMBTGTWriteIndex(context, selectedIdx, LocaleGetText(LOCALE_STRING_LOCK_20KMH), 0);
-        } else {
-            ConfigSetComfortLock(CONFIG_SETTING_OFF);
-            BMBTGTWriteIndex(context, selectedIdx, LocaleGetText(LOCALE_STRING_LOCK_OFF), 0);
-        }
-    } else if (selectedIdx == BMBT_MENU_IDX_SETTINGS_COMFORT_UNLOCK) {
-        uint8_t comfortUnlock = ConfigGetComfortUnlock();
-        if (comfortUnlock == CONFIG_SETTING_OFF ||
-            comfortUnlock > CONFIG_SETTING_COMFORT_UNLOCK_POS_0
-        ) {
-            ConfigSetComfortUnlock(CONFIG_SETTING_COMFORT_UNLOCK_POS_1);
-            BMBTGTWriteIndex(context, selectedIdx, LocaleGetText(LOCALE_STRING_UNLOCK_POS_1), 0);
-        } else if (comfortUnlock == CONFIG_SETTING_COMFORT_UNLOCK_POS_1) {
-            ConfigSetComfortUnlock(CONFIG_SETTING_COMFORT_UNLOCK_POS_0);
-            BMBTGTWriteIndex(context, selectedIdx, LocaleGetText(LOCALE_STRING_UNLOCK_POS_0), 0);
-        } else {
-            ConfigSetComfortUnlock(CONFIG_SETTING_OFF);
-            BMBTGTWriteIndex(context, selectedIdx, LocaleGetText(LOCALE_STRING_UNLOCK_OFF), 0);
-        }
-    } else if (selectedIdx == BMBT_MENU_IDX_SETTINGS_COMFORT_VISUAL_PDC) {
-        uint8_t pdc = ConfigGetSetting(CONFIG_SETTING_VISUAL_PDC);
-        if (pdc == CONFIG_SETTING_OFF) {
-            pdc = CONFIG_SETTING_PDC_CLUSTER;
-        } else if (pdc == CONFIG_SETTING_PDC_CLUSTER) {
-            pdc = CONFIG_SETTING_PDC_RADIO;
-        } else if (pdc == CONFIG_SETTING_PDC_RADIO) {
-            pdc = CONFIG_SETTING_PDC_BOTH;
-        } else {
-            pdc = CONFIG_SETTING_OFF;
-        }
-        ConfigSetSetting(CONFIG_SETTING_VISUAL_PDC, pdc);
-        char pdcText[BMBT_MENU_STRING_MAX_SIZE] = {0};
-        snprintf(
-            pdcText,
-            BMBT_MENU_STRING_MAX_SIZE,
-            LocaleGetText(LOCALE_STRING_PDC),
-            (
-                (pdc == CONFIG_SETTING_OFF) ? LocaleGetText(LOCALE_STRING_OFF) :
-                (pdc == CONFIG_SETTING_PDC_CLUSTER) ? "Cluster" :
-                (pdc == CONFIG_SETTING_PDC_RADIO) ? "Screen" :
-                "Dual"
-            )
-        );
-
-        BMBTGTWriteIndex(
-            context,
-            BMBT_MENU_IDX_SETTINGS_COMFORT_VISUAL_PDC,
-            pdcText,
-            1
-        );
-    } else if (selectedIdx == BMBT_MENU_IDX_BACK) {
-        BMBTMenuSettings(context);
-    }
-    if (selectedIdx != BMBT_MENU_IDX_BACK) {
-        BMBTGTBufferFlush(context);
-    }
-}
-
-static void BMBTSettingsUpdateCalling(BMBTContext_t *context, uint8_t selectedIdx)
-{
-    if (selectedIdx == BMBT_MENU_IDX_SETTINGS_CALLING_HFP) {
-        uint8_t value = ConfigGetSetting(CONFIG_SETTING_HFP);
-        if (context->bt->type == BT_BTM_TYPE_BC127) {
-            if (value == 0x00) {
-                BTPairedDevice_t *dev = &context->bt->pairedDevices[
-                    context->bt->activeDevice.deviceIndex
-                ];
-                ConfigSetSetting(CONFIG_SETTING_HFP, CONFIG_SETTING_ON);
-                BMBTGTWriteIndex(context, selectedIdx, LocaleGetText(LOCALE_STRING_HANDSFREE_ON), 0);
-                BC127CommandProfileOpen(context->bt, dev, "HFP");
-            } else {
-                ConfigSetSetting(CONFIG_SETTING_HFP, CONFIG_SETTING_OFF);
-                BC127CommandClose(context->bt, context->bt->activeDevice.hfpId);
-                BMBTGTWriteIndex(context, selectedIdx, LocaleGetText(LOCALE_STRING_HANDSFREE_OFF), 0);
-            }
-        } else {
-            if (value == 0x01) {
-                BM83CommandDisconnect(context->bt, BM83_CMD_DISCONNECT_PARAM_HF);
-                ConfigSetSetting(CONFIG_SETTING_HFP, 0x00);
-                BMBTGTWriteIndex(context, selectedIdx, LocaleGetText(LOCALE_STRING_HANDSFREE_OFF), 0);
-            } else {
-                BTPairedDevice_t *device = &context->bt->pairedDevices[context->bt->activeDevice.deviceIndex];
-                BM83CommandConnect(
-                    context->bt,
-                    device,
-                    BM83_DATA_LINK_BACK_PROFILES_HF
-                );
-                ConfigSetSetting(CONFIG_SETTING_HFP, 0x01);
-                BMBTGTWriteIndex(context, selectedIdx, LocaleGetText(LOCALE_STRING_HANDSFREE_ON), 0);
-            }
-        }
-    } else if (selectedIdx == BMBT_MENU_IDX_SETTINGS_CALLING_MIC_GAIN) {
-        uint8_t micGain = ConfigGetSetting(CONFIG_SETTING_MIC_GAIN);
-        micGain = micGain + 1;
-        char micGainText[BMBT_MENU_STRING_MAX_SIZE] = {0};
-        if (context->bt->type == BT_BTM_TYPE_BC127) {
-            if (micGain > 21) {
-                micGain = 0;
-            }
-
-            uint8_t micBias = ConfigGetSetting(CONFIG_SETTING_MIC_BIAS);
-            uint8_t micPreamp = ConfigGetSetting(CONFIG_SETTING_MIC_PREAMP);
-            BC127CommandSetMicGain(
-                context->bt,
-                micGain,
-                micBias,
-                micPreamp
-            );
-            snprintf(micGainText, BMBT_MENU_STRING_MAX_SIZE, LocaleGetText(LOCALE_STRING_MIC_GAIN), (int8_t) BTBC127MicGainTable[micGain]);
-        } else {
-            if (micGain > 0x0F) {
-                micGain = 0;
-            }
-            if (micGain == 0x00) {
-                // Reset the gain
-                uint8_t start = 0x0F;
-                while (start > 0) {
-                    BM83CommandMicGainDown(context->bt);
-                    start--;
-                }
-            } else {
-                BM83CommandMicGainUp(context->bt);
-            }
-            snprintf(micGainText, BMBT_MENU_STRING_MAX_SIZE, LocaleGetText(LOCALE_STRING_MIC_GAIN), (int8_t) BTBM83MicGainTable[micGain]);
-        }
-        ConfigSetSetting(CONFIG_SETTING_MIC_GAIN, micGain);
-        BMBTGTWriteIndex(
-            context,
-            BMBT_MENU_IDX_SETTINGS_CALLING_MIC_GAIN,
-            micGainText,
-            0
-        );
-    } else if (selectedIdx == BMBT_MENU_IDX_SETTINGS_CALLING_VOL_OFFSET) {
-        int8_t volumeOffset = ConfigGetSetting(CONFIG_SETTING_TEL_VOL);
-        volumeOffset = volumeOffset + 1;
-        char volOffsetText[BMBT_MENU_STRING_MAX_SIZE] = {0};
-        if (volumeOffset > CONFIG_SETTING_TEL_VOL_OFFSET_MAX || volumeOffset < 0) {
-            volumeOffset = 0;
-        }
-        ConfigSetSetting(CONFIG_SETTING_TEL_VOL, volumeOffset);
-        snprintf(
-            volOffsetText,
             BMBT_MENU_STRING_MAX_SIZE,
-            LocaleGetText(LOCALE_STRING_VOL_OFFSET),
-            volumeOffset
+            LocaleGetText(LOCALE_STRING_AUTOTIME_OFFSET),
+            off / 60,
+            abs(off) % 60
         );
         BMBTGTWriteIndex(
             context,
-            BMBT_MENU_IDX_SETTINGS_CALLING_VOL_OFFSET,
-            volOffsetText,
-            0
+            BMBT_MENU_IDX_SETTINGS_TIME_OFFSET,
+            text,
+            1
         );
-    } else if (selectedIdx == BMBT_MENU_IDX_SETTINGS_CALLING_MODE) {
-        uint8_t telMode = ConfigGetSetting(CONFIG_SETTING_TEL_MODE);
-        if (telMode == CONFIG_SETTING_TEL_MODE_DEFAULT) {
-            ConfigSetSetting(CONFIG_SETTING_TEL_MODE, CONFIG_SETTING_TEL_MODE_TCU);
-            BMBTGTWriteIndex(
-                context,
-                BMBT_MENU_IDX_SETTINGS_CALLING_MODE,
-                LocaleGetText(LOCALE_STRING_MODE_TCU),
-                0
+
+        if (context->ibus->gpsDateTime.year > 0) {
+            UtilsFormat(
+                text,
+                BMBT_MENU_STRING_MAX_SIZE,
+                "%4d-%02d-%02d",
+                context->ibus->gpsDateTime.year,
+                context->ibus->gpsDateTime.month,
+                context->ibus->gpsDateTime.day
             );
-        } else if (telMode == CONFIG_SETTING_TEL_MODE_TCU) {
-            ConfigSetSetting(CONFIG_SETTING_TEL_MODE, CONFIG_SETTING_TEL_MODE_NO_MUTE);
+
             BMBTGTWriteIndex(
                 context,
-                BMBT_MENU_IDX_SETTINGS_CALLING_MODE,
-                LocaleGetText(LOCALE_STRING_MODE_NO_MUTE),
+                BMBT_MENU_IDX_SETTINGS_TIME_GPSDATE,
+                text,
                 0
             );
-        } else if (telMode == CONFIG_SETTING_TEL_MODE_NO_MUTE) {
-            ConfigSetSetting(CONFIG_SETTING_TEL_MODE, CONFIG_SETTING_TEL_MODE_ANALOG);
+
+            UtilsFormat(
+                text,
+                BMBT_MENU_STRING_MAX_SIZE,
+                "%02d:%02d",
+                context->ibus->gpsDateTime.hour,
+                context->ibus->gpsDateTime.min
+            );
+
             BMBTGTWriteIndex(
                 context,
-                BMBT_MENU_IDX_SETTINGS_CALLING_MODE,
-                LocaleGetText(LOCALE_STRING_MODE_ANALOG),
-                0
-            );
+                BMBT_MENU_IDX_SETTINGS_TIME_GPSTIME,
+                    text,
+                    1
+                );
         } else {
-            ConfigSetSetting(CONFIG_SETTING_TEL_MODE, CONFIG_SETTING_TEL_MODE_DEFAULT);
             BMBTGTWriteIndex(
                 context,
-                BMBT_MENU_IDX_SETTINGS_CALLING_MODE,
-                LocaleGetText(LOCALE_STRING_MODE_DEFAULT),
-                0
+                BMBT_MENU_IDX_SETTINGS_TIME_GPSDATE,
+                LocaleGetText(LOCALE_STRING_AUTOTIME_NOSIGNAL),
+                2
             );
         }
-    } else if (selectedIdx == BMBT_MENU_IDX_BACK) {
-        BMBTMenuSettings(context);
     }
-    if (selectedIdx != BMBT_MENU_IDX_BACK) {
-        BMBTGTBufferFlush(context);
+
+    BMBTGTWriteIndex(context, BMBT_MENU_IDX_BACK, LocaleGetText(LOCALE_STRING_BACK), 0);
+    BMBTGTBufferFlush(context);
+    context->menu = BMBT_MENU_SETTINGS_TIME;
+}
+
+static void BMBTSettingsUpdateAbout(BMBTContext_t *context, uint8_t selectedIdx)
+{
+    if (selectedIdx == BMBT_MENU_IDX_BACK) {
+        BMBTMenuSettings(context);
     }
 }
 
@@ -2082,7 +2497,7 @@ static void BMBTSettingsUpdateNav(BMBTContext_t *context, uint8_t selectedIdx)
         ConfigSetSetting(CONFIG_SETTING_COMFORT_AUTOZOOM, autozoom);
         char autoZoomText[BMBT_MENU_STRING_MAX_SIZE] = {0};
         if (autozoom == CONFIG_SETTING_OFF) {
-            snprintf(
+            UtilsFormat(
                 autoZoomText,
                 BMBT_MENU_STRING_MAX_SIZE,
                 LocaleGetText(LOCALE_STRING_AUTOZOOM),
@@ -2090,14 +2505,14 @@ static void BMBTSettingsUpdateNav(BMBTContext_t *context, uint8_t selectedIdx)
             );
         } else {
             if (ConfigGetDistUnit() == 0) {
-                snprintf(
+                UtilsFormat(
                     autoZoomText,
                     BMBT_MENU_STRING_MAX_SIZE,
                     LocaleGetText(LOCALE_STRING_AUTOZOOM),
                     navZoomScaleMetric[autozoom]
                 );
             } else {
-                snprintf(
+                UtilsFormat(
                     autoZoomText,
                     BMBT_MENU_STRING_MAX_SIZE,
                     LocaleGetText(LOCALE_STRING_AUTOZOOM),
@@ -2185,199 +2600,6 @@ static void BMBTSettingsUpdateTime(BMBTContext_t *context, uint8_t selectedIdx)
     }
 }
 
-static void BMBTSettingsUpdateUI(BMBTContext_t *context, uint8_t selectedIdx)
-{
-    if (selectedIdx == BMBT_MENU_IDX_SETTINGS_UI_METADATA_MODE) {
-        uint8_t value = ConfigGetSetting(CONFIG_SETTING_METADATA_MODE);
-        if (value == 0x00) {
-            value = BMBT_METADATA_MODE_PARTY;
-            BMBTGTWriteIndex(context, selectedIdx, LocaleGetText(LOCALE_STRING_METADATA_PARTY), 0);
-        } else if (value == 0x01) {
-            value = BMBT_METADATA_MODE_CHUNK;
-            BMBTGTWriteIndex(context, selectedIdx, LocaleGetText(LOCALE_STRING_METADATA_CHUNK), 0);
-        } else {
-            value = BMBT_METADATA_MODE_OFF;
-            BMBTGTWriteIndex(context, selectedIdx, LocaleGetText(LOCALE_STRING_METADATA_OFF), 0);
-        }
-        ConfigSetSetting(CONFIG_SETTING_METADATA_MODE, value);
-        if (value != BMBT_METADATA_MODE_OFF &&
-            strlen(context->bt->title) > 0 &&
-            context->bt->playbackStatus == BT_AVRCP_STATUS_PLAYING
-        ) {
-            char text[UTILS_DISPLAY_TEXT_SIZE] = {0};
-            snprintf(
-                text,
-                UTILS_DISPLAY_TEXT_SIZE,
-                "%s - %s - %s",
-                context->bt->title,
-                context->bt->artist,
-                context->bt->album
-            );
-            BMBTSetMainDisplayText(context, text, 0, 0);
-        } else if (value == BMBT_METADATA_MODE_OFF) {
-            BMBTGTBufferFlush(context);
-            BMBTGTWriteTitle(context, LocaleGetText(LOCALE_STRING_BLUETOOTH), 1);
-        }
-    } else if (selectedIdx == BMBT_MENU_IDX_SETTINGS_UI_DEFAULT_MENU) {
-        if (ConfigGetSetting(CONFIG_SETTING_BMBT_DEFAULT_MENU) == 0x00) {
-            ConfigSetSetting(CONFIG_SETTING_BMBT_DEFAULT_MENU, 0x01);
-            BMBTGTWriteIndex(context, selectedIdx, LocaleGetText(LOCALE_STRING_MENU_DASHBOARD), 0);
-        } else {
-            ConfigSetSetting(CONFIG_SETTING_BMBT_DEFAULT_MENU, 0x00);
-            BMBTGTWriteIndex(context, selectedIdx, LocaleGetText(LOCALE_STRING_MENU_MAIN), 0);
-        }
-    } else if (selectedIdx == BMBT_MENU_IDX_SETTINGS_UI_TEMPS) {
-        uint8_t tempMode = ConfigGetTempDisplay();
-        if (tempMode == CONFIG_SETTING_OFF) {
-            ConfigSetTempDisplay(CONFIG_SETTING_TEMP_COOLANT);
-            uint8_t valueType = IBUS_SENSOR_VALUE_COOLANT_TEMP;
-            BMBTIBusSensorValueUpdate((void *)context, &valueType);
-            BMBTGTWriteIndex(context, selectedIdx, LocaleGetText(LOCALE_STRING_TEMPS_COOLANT), 0);
-        } else if (tempMode == CONFIG_SETTING_TEMP_COOLANT) {
-            ConfigSetTempDisplay(CONFIG_SETTING_TEMP_AMBIENT);
-            uint8_t valueType = IBUS_SENSOR_VALUE_AMBIENT_TEMP;
-            BMBTIBusSensorValueUpdate((void *)context, &valueType);
-            BMBTGTWriteIndex(context, selectedIdx, LocaleGetText(LOCALE_STRING_TEMPS_AMBIENT), 0);
-        } else if (
-            tempMode == CONFIG_SETTING_TEMP_AMBIENT &&
-            context->ibus->vehicleType != IBUS_VEHICLE_TYPE_E46 &&
-            context->ibus->vehicleType != IBUS_VEHICLE_TYPE_E8X
-        ) {
-            ConfigSetTempDisplay(CONFIG_SETTING_TEMP_OIL);
-            uint8_t valueType = IBUS_SENSOR_VALUE_OIL_TEMP;
-            BMBTIBusSensorValueUpdate((void *)context, &valueType);
-            BMBTGTWriteIndex(context, selectedIdx, LocaleGetText(LOCALE_STRING_TEMPS_OIL), 0);
-        } else {
-            // Clear the header area
-            IBusCommandGTWriteZone(context->ibus, BMBT_HEADER_TEMPS, "      ");
-            BMBTGTFlushHeaderWrite(context);
-            ConfigSetTempDisplay(CONFIG_SETTING_OFF);
-            BMBTGTWriteIndex(context, selectedIdx, LocaleGetText(LOCALE_STRING_TEMPS_OFF), 0);
-        }
-    } else if (selectedIdx == BMBT_MENU_IDX_SETTINGS_IU_DASH_OBC) {
-        if (ConfigGetSetting(CONFIG_SETTING_BMBT_DASHBOARD_OBC) == CONFIG_SETTING_ON) {
-            BMBTGTWriteIndex(
-                context,
-                BMBT_MENU_IDX_SETTINGS_IU_DASH_OBC,
-                LocaleGetText(LOCALE_STRING_DASH_OBC_OFF),
-                0
-            );
-            ConfigSetSetting(
-                CONFIG_SETTING_BMBT_DASHBOARD_OBC,
-                CONFIG_SETTING_OFF
-            );
-        } else {
-            BMBTGTWriteIndex(
-                context,
-                BMBT_MENU_IDX_SETTINGS_IU_DASH_OBC,
-                LocaleGetText(LOCALE_STRING_DASH_OBC_ON),
-                0
-            );
-            ConfigSetSetting(
-                CONFIG_SETTING_BMBT_DASHBOARD_OBC,
-                CONFIG_SETTING_ON
-            );
-        }
-    } else if (selectedIdx == BMBT_MENU_IDX_SETTINGS_UI_MONITOR_OFF) {
-        if (ConfigGetSetting(CONFIG_SETTING_MONITOR_OFF) == CONFIG_SETTING_ON) {
-            BMBTGTWriteIndex(
-                context,
-                BMBT_MENU_IDX_SETTINGS_UI_MONITOR_OFF,
-                LocaleGetText(LOCALE_STRING_BMBT_OFF_OFF),
-                0
-            );
-            ConfigSetSetting(CONFIG_SETTING_MONITOR_OFF, CONFIG_SETTING_OFF);
-        } else {
-            BMBTGTWriteIndex(
-                context,
-                BMBT_MENU_IDX_SETTINGS_UI_MONITOR_OFF,
-                LocaleGetText(LOCALE_STRING_BMBT_OFF_ON),
-                0
-            );
-            ConfigSetSetting(CONFIG_SETTING_MONITOR_OFF, CONFIG_SETTING_ON);
-        }
-    } else if (selectedIdx == BMBT_MENU_IDX_SETTINGS_UI_TRUE_SPEED) {
-        if (ConfigGetSetting(CONFIG_SETTING_TRUE_SPEED) == CONFIG_SETTING_ON) {
-            ConfigSetSetting(CONFIG_SETTING_TRUE_SPEED, CONFIG_SETTING_OFF);
-            IBusCommandGTWriteZone(context->ibus, BMBT_HEADER_SPEED, "    ");
-            BMBTGTFlushHeaderWrite(context);
-            BMBTGTWriteIndex(
-                context,
-                selectedIdx,
-                LocaleGetText(LOCALE_STRING_SPEED_OFF),
-                0
-            );
-        } else {
-            ConfigSetSetting(CONFIG_SETTING_TRUE_SPEED, CONFIG_SETTING_ON);
-            BMBTHeaderWriteSpeed(context);
-            BMBTGTFlushHeaderWrite(context);
-            BMBTGTWriteIndex(
-                context,
-                selectedIdx,
-                LocaleGetText(LOCALE_STRING_SPEED_ON),
-                0
-            );
-        }
-    } else if (selectedIdx == BMBT_MENU_IDX_SETTINGS_UI_LANGUAGE) {
-        uint8_t selectedLanguage = ConfigGetSetting(CONFIG_SETTING_LANGUAGE);
-        if (selectedLanguage == CONFIG_SETTING_LANGUAGE_AUTO) {
-            selectedLanguage = CONFIG_SETTING_LANGUAGE_ENGLISH;
-        } else if (selectedLanguage == CONFIG_SETTING_LANGUAGE_ENGLISH) {
-            selectedLanguage = CONFIG_SETTING_LANGUAGE_ESTONIAN;
-        } else if (selectedLanguage == CONFIG_SETTING_LANGUAGE_ESTONIAN) {
-            selectedLanguage = CONFIG_SETTING_LANGUAGE_GERMAN;
-        } else if (selectedLanguage == CONFIG_SETTING_LANGUAGE_GERMAN) {
-            selectedLanguage = CONFIG_SETTING_LANGUAGE_ITALIAN;
-        } else if (selectedLanguage == CONFIG_SETTING_LANGUAGE_ITALIAN) {
-            selectedLanguage = CONFIG_SETTING_LANGUAGE_RUSSIAN;
-        } else if (selectedLanguage == CONFIG_SETTING_LANGUAGE_RUSSIAN) {
-            selectedLanguage = CONFIG_SETTING_LANGUAGE_SPANISH;
-        } else if (selectedLanguage == CONFIG_SETTING_LANGUAGE_SPANISH) {
-            selectedLanguage = CONFIG_SETTING_LANGUAGE_POLISH;
-        } else if (selectedLanguage == CONFIG_SETTING_LANGUAGE_POLISH) {
-            selectedLanguage = CONFIG_SETTING_LANGUAGE_FRENCH;
-        } else if (selectedLanguage == CONFIG_SETTING_LANGUAGE_FRENCH) {
-            selectedLanguage = CONFIG_SETTING_LANGUAGE_DUTCH;
-        } else if (selectedLanguage == CONFIG_SETTING_LANGUAGE_DUTCH) {
-            selectedLanguage = CONFIG_SETTING_LANGUAGE_AUTO;
-        } else {
-            selectedLanguage = CONFIG_SETTING_LANGUAGE_ENGLISH;
-        }
-        ConfigSetSetting(CONFIG_SETTING_LANGUAGE, selectedLanguage);
-        // Change the UI Language
-        BMBTMenuSettingsUI(context);
-        BMBTTriggerWriteHeader(context);
-    } else if (selectedIdx == BMBT_MENU_IDX_BACK) {
-        BMBTMenuSettings(context);
-    }
-    if (selectedIdx != BMBT_MENU_IDX_BACK) {
-        BMBTGTBufferFlush(context);
-    }
-}
-
-/**
- * BMBTTELRequestPBAP
- *     Description:
- *         Wrapper to request contacts or try to open a PBAP session
- *     Params:
- *         void *context - A void pointer to the BMBTContext_t struct
- *         uint8_t *tmp - The data from the event
- *     Returns:
- *         void
- */
-static void BMBTTELRequestPBAP(BMBTContext_t *context) {
-    if (context->bt->pbap.active || context->bt->activeDevice.pbapId > 0) {
-        BTCommandPBAPGetPhonebook(
-            context->bt,
-            context->tel.phonebookType,
-            context->tel.page,
-            BT_PBAP_MAX_CONTACTS
-        );
-    } else {
-        BTCommandPBAPOpen(context->bt);
-    }
-}
-
 /**
  * BMBTTELMenuDial()
  *     Description:
@@ -2391,6 +2613,7 @@ static void BMBTTELRequestPBAP(BMBTContext_t *context) {
 static void BMBTTELMenuDial(BMBTContext_t *context)
 {
     memset(context->bt->dialBuffer, 0, sizeof(context->bt->dialBuffer));
+    memset(context->tel.search, 0, sizeof(context->tel.search));
     IBusCommandTELMenuText(
         context->ibus,
         IBUS_DEVICE_GT,
@@ -2470,10 +2693,68 @@ static void BMBTTELMenuContactList(BMBTContext_t *context, uint8_t pbType)
     }
 }
 
+/**
+ * BMBTTELRequestPBAP
+ *     Description:
+ *         Wrapper to request contacts or try to open a PBAP session. The
+ *         phonebook pages come straight from the phonebook cache once it
+ *         holds the whole phonebook of the device, and the cache is synced
+ *         in the background instead. A phonebook too large for the cache is
+ *         paged over PBAP, so that every contact can be reached. A T9 search from the dial menu limits the
+ *         pages to the contacts that match it. Other pages are served from
+ *         the prefetch pages when they were pulled ahead of time.
+ *     Params:
+ *         void *context - A void pointer to the BMBTContext_t struct
+ *         uint8_t *tmp - The data from the event
+ *     Returns:
+ *         void
+ */
+static void BMBTTELRequestPBAP(BMBTContext_t *context) {
+    uint8_t sessionOpen = context->bt->pbap.active || context->bt->activeDevice.pbapId > 0;
+    if (context->tel.phonebookType == BT_PBAP_OBJ_PHONEBOOK) {
+        BTPBAPCacheSyncStart(context->bt);
+        if (BTPBAPCacheHasPhonebook(context->bt) == 1) {
+            if (context->tel.search[0] != '\0') {
+                BTPBAPCacheLoadSearchPage(
+                    context->bt,
+                    context->tel.search,
+                    context->tel.page
+                );
+            } else {
+                BTPBAPCacheLoadPage(context->bt, context->tel.page);
+            }
+            BMBTTELMenuContactList(context, IBUS_TEL_LAYOUT_DIRECTORY);
+            if (!sessionOpen) {
+                BTCommandPBAPOpen(context->bt);
+            }
+            return;
+        }
+    }
+    if (sessionOpen) {
+        uint8_t prefetched = BTPBAPPrefetchLoadPage(
+            context->bt,
+            context->tel.phonebookType,
+            context->tel.page
+        );
+        if (prefetched == 0) {
+            BTCommandPBAPGetPhonebook(
+                context->bt,
+                context->tel.phonebookType,
+                context->tel.page,
+                BT_PBAP_MAX_CONTACTS
+            );
+        }
+    } else {
+        BTCommandPBAPOpen(context->bt);
+    }
+}
+
 /**
  * BMBTTELMenuDialUpdate()
  *     Description:
- *         Handle All inputs on the Dial Menu
+ *         Handle All inputs on the Dial Menu. The digits entered are also
+ *         looked up as T9 letters in the phonebook cache, so that the title
+ *         suggests a contact and the directory opens on the matches.
  *     Params:
  *         void *context - A void pointer to the BMBTContext_t struct
  *         uint8_t *tmp - The data from the event
@@ -2504,8 +2785,27 @@ static void BMBTTELMenuDialUpdate(BMBTContext_t *context, uint8_t *pkt)
             len++;
         }
         if (len > 0) {
-            char display[BT_DIAL_BUFFER_FIELD_SIZE + 1];
-            snprintf(display, sizeof(display), "%s_", context->bt->dialBuffer);
+            // Suggest the first cached contact that the digits spell out
+            char display[BT_DIAL_BUFFER_FIELD_SIZE + BT_PBAP_CONTACT_NAME_LEN + 1];
+            uint8_t match = BT_PBAP_CACHE_SEARCH_NONE;
+            BTPBAPContact_t contact;
+            if (len < BMBT_TEL_SEARCH_LEN && BTPBAPCacheHasPhonebook(context->bt) == 1) {
+                match = BTPBAPCacheSearchT9(context->bt, context->bt->dialBuffer, 0);
+            }
+            if (
+                match != BT_PBAP_CACHE_SEARCH_NONE &&
+                BTPBAPCacheGetContact(context->bt, match, &contact) == 1
+            ) {
+                UtilsFormat(
+                    display,
+                    sizeof(display),
+                    "%s_ %s",
+                    context->bt->dialBuffer,
+                    contact.name
+                );
+            } else {
+                UtilsFormat(display, sizeof(display), "%s_", context->bt->dialBuffer);
+            }
             IBusCommandTELTitleText(
                 context->ibus,
                 IBUS_DEVICE_GT,
@@ -2530,6 +2830,19 @@ static void BMBTTELMenuDialUpdate(BMBTContext_t *context, uint8_t *pkt)
         context->tel.state = BMBT_TEL_STATE_DIRECTORY;
         context->tel.phonebookType = BT_PBAP_OBJ_PHONEBOOK;
         context->tel.page = 0;
+        // Open the directory on the contacts that the digits entered match
+        memset(context->tel.search, 0, sizeof(context->tel.search));
+        if (
+            strlen(context->bt->dialBuffer) < BMBT_TEL_SEARCH_LEN &&
+            BTPBAPCacheHasPhonebook(context->bt) == 1 &&
+            BTPBAPCacheSearchT9(
+                context->bt,
+                context->bt->dialBuffer,
+                0
+            ) != BT_PBAP_CACHE_SEARCH_NONE
+        ) {
+            strcpy(context->tel.search, context->bt->dialBuffer);
+        }
         BMBTTELRequestPBAP(context);
     } else if (db1 == 0x00 && pkt[IBUS_PKT_DB2] == 0x00 && pkt[IBUS_PKT_DB3] == BMBT_TEL_NAV_NEXT) {
         context->tel.state = BMBT_TEL_STATE_LAST_DIALED;
@@ -2572,7 +2885,7 @@ static void BMBTTELMenuNumberList(BMBTContext_t *context, uint8_t contactIdx)
                 typeLabel = "Tel:";
                 break;
         }
-        snprintf(lineBuffer, 31, "\x06%s\x06%s", typeLabel, phoneStr);
+        UtilsFormat(lineBuffer, 31, "\x06%s\x06%s", typeLabel, phoneStr);
         uint8_t options = BMBT_TEL_CONTACT_IDX[i];
         if (i == 0) {
             options = IBUS_TEL_OPT_CLEAR | options;
@@ -2850,33 +3163,34 @@ void BMBTBTDeviceDisconnected(void *ctx, uint8_t *data)
  *         Handle metadata updates from the BT module
  *     Params:
  *         void *context - A void pointer to the BMBTContext_t struct
- *         uint8_t *tmp - The data from the event
+ *         uint8_t *data - The BT_METADATA_FIELD_* mask of the changed fields
  *     Returns:
  *         void
  */
 void BMBTBTMetadata(void *ctx, uint8_t *data)
 {
     BMBTContext_t *context = (BMBTContext_t *) ctx;
+    uint8_t changed = BT_METADATA_FIELD_ALL;
+    if (data != 0) {
+        changed = *data;
+    }
     if (
         context->status.playerMode == BMBT_MODE_ACTIVE &&
-        context->status.displayMode == BMBT_DISPLAY_ON
+        context->status.displayMode == BMBT_DISPLAY_ON &&
+        changed != 0
     ) {
         if (ConfigGetSetting(CONFIG_SETTING_METADATA_MODE) != CONFIG_SETTING_OFF) {
-            char text[UTILS_DISPLAY_TEXT_SIZE] = {0};
-            snprintf(
-                text,
-                UTILS_DISPLAY_TEXT_SIZE,
-                "%s - %s - %s",
-                context->bt->title,
-                context->bt->artist,
-                context->bt->album
+            BMBTSetMainDisplayText(
+                context,
+                BTMetadataGetDisplayText(context->bt),
+                0,
+                1
             );
-            BMBTSetMainDisplayText(context, text, 0, 1);
         }
-        if (
-            context->menu == BMBT_MENU_DASHBOARD ||
-            context->menu == BMBT_MENU_DASHBOARD_FRESH
-        ) {
+        if (context->menu == BMBT_MENU_DASHBOARD) {
+            // Only rewrite the fields that changed
+            BMBTMenuDashboardDraw(context, changed, 0);
+        } else if (context->menu == BMBT_MENU_DASHBOARD_FRESH) {
             BMBTMenuDashboard(context);
         }
     }
@@ -2885,6 +3199,10 @@ void BMBTBTMetadata(void *ctx, uint8_t *data)
 void BMBTBTPBAPContactReceived(void *ctx, uint8_t *data)
 {
     BMBTContext_t *context = (BMBTContext_t *) ctx;
+    // Pages pulled by the cache sync are not for the menu on screen
+    if (context->bt->pbap.requestSync) {
+        return;
+    }
     switch (context->tel.state) {
         case BMBT_TEL_STATE_DIRECTORY:
             BMBTTELMenuContactList(context, IBUS_TEL_LAYOUT_DIRECTORY);
@@ -2908,6 +3226,20 @@ void BMBTBTPBAPContactReceived(void *ctx, uint8_t *data)
             }
             break;
         }
+        default:
+            return;
+    }
+    // Pull the pages either side while this one is read, unless the
+    // phonebook cache already serves them
+    if (
+        context->tel.phonebookType != BT_PBAP_OBJ_PHONEBOOK ||
+        BTPBAPCacheHasPhonebook(context->bt) == 0
+    ) {
+        BTPBAPPrefetchSchedule(
+            context->bt,
+            context->tel.phonebookType,
+            context->tel.page
+        );
     }
 }
 
@@ -2915,6 +3247,13 @@ void BMBTBTPBAPSessionStatus(void *ctx, uint8_t *data)
 {
     BMBTContext_t *context = (BMBTContext_t *) ctx;
     if (context->bt->pbap.active) {
+        // The directory is already showing the cached phonebook
+        if (
+            context->tel.phonebookType == BT_PBAP_OBJ_PHONEBOOK &&
+            BTPBAPCacheHasPhonebook(context->bt) == 1
+        ) {
+            return;
+        }
         if (
             context->tel.state == BMBT_TEL_STATE_DIRECTORY ||
             context->tel.state == BMBT_TEL_STATE_TOP_8 ||
@@ -3074,6 +3413,10 @@ void BMBTIBusBMBTButtonPress(void *ctx, uint8_t *pkt)
         }
     }
     if (pkt[IBUS_PKT_DB1] == IBUS_DEVICE_BMBT_BUTTON_MENU_RELEASE) {
+        if (context->tel.state != BMBT_TEL_STATE_NONE) {
+            // The call lists are pulled again on the next visit
+            BTPBAPPrefetchClearHistory(context->bt);
+        }
         context->tel.state = BMBT_TEL_STATE_NONE;
     }
 }
@@ -3511,6 +3854,8 @@ void BMBTIBusPlaybackCtrl(void *ctx, uint8_t *pkt)
 void BMBTIBusScreenModeSet(void *ctx, uint8_t *pkt)
 {
     BMBTContext_t *context = (BMBTContext_t *) ctx;
+    // Any change of screen mode may leave the GT buffer with other contents
+    BMBTGTIndexInvalidate(context);
     switch (pkt[IBUS_PKT_DB1]) {
         case 0x00:
         case 0x01:
@@ -3553,6 +3898,7 @@ void BMBTIBusScreenBufferFlush(void *ctx, uint8_t *pkt)
         }
     } else if (pkt[IBUS_PKT_DB1] != context->status.navIndexType) {
         // If the update does not match our current menu state, override it
+        BMBTGTIndexInvalidate(context);
         IBusCommandGTUpdate(context->ibus, context->status.navIndexType);
     } else if (
         context->status.menuState != BMBT_MENU_STATE_PRESS &&
@@ -3590,6 +3936,7 @@ void BMBTIBusScreenBufferWrite(void *ctx, uint8_t *pkt)
         // to time. Other such updates can also occur especially for Euro-spec
         // cars
         context->status.screenCleared = 1;
+        BMBTGTIndexInvalidate(context);
     }
 }
 
@@ -3629,26 +3976,57 @@ void BMBTIBusSensorValueUpdate(void *ctx, uint8_t *type)
         }
         BMBTHeaderWriteTemperature(context, updateType);
         BMBTGTFlushHeaderWrite(context);
-        if (
-            context->menu == BMBT_MENU_DASHBOARD ||
-            context->menu == BMBT_MENU_DASHBOARD_FRESH
-        ) {
-            BMBTMenuDashboardUpdateOBCValues(context);
-            BMBTGTBufferFlush(context);
-        }
+    } else if (updateType != IBUS_SENSOR_VALUE_BATTERY_VOLTAGE) {
+        return;
+    }
+    if (
+        context->status.displayMode == BMBT_DISPLAY_OFF ||
+        (
+            context->menu != BMBT_MENU_DASHBOARD &&
+            context->menu != BMBT_MENU_DASHBOARD_FRESH
+        )
+    ) {
+        return;
     }
+    uint8_t field = BMBT_DASHBOARD_OBC_ALL;
     if (updateType == IBUS_SENSOR_VALUE_BATTERY_VOLTAGE) {
-        if (context->status.displayMode == BMBT_DISPLAY_OFF) {
-            return;
-        }
-        if (
-            context->menu == BMBT_MENU_DASHBOARD ||
-            context->menu == BMBT_MENU_DASHBOARD_FRESH
-        ) {
-            BMBTMenuDashboardUpdateOBCValues(context);
-            BMBTGTBufferFlush(context);
-        }
+        field = BMBT_DASHBOARD_OBC_BATTERY;
+    } else if (
+        updateType == IBUS_SENSOR_VALUE_AMBIENT_TEMP ||
+        updateType == IBUS_SENSOR_VALUE_AMBIENT_TEMP_CALCULATED
+    ) {
+        field = BMBT_DASHBOARD_OBC_AMBIENT;
+    } else if (updateType == IBUS_SENSOR_VALUE_COOLANT_TEMP) {
+        field = BMBT_DASHBOARD_OBC_COOLANT;
+    } else if (updateType == IBUS_SENSOR_VALUE_OIL_TEMP) {
+        field = BMBT_DASHBOARD_OBC_OIL;
+    }
+    // Only the OBC indices that changed are sent, so the metadata stays put
+    if (BMBTMenuDashboardUpdateOBCValues(context, field, 0) > 0) {
+        BMBTGTBufferFlush(context);
+    }
+}
+
+/**
+ * BMBTIBusTXFrameDropped()
+ *     Description:
+ *         Forget what the GT indices hold when one of our writes to the GT
+ *         was lost after it was queued, so that the next draw sends every
+ *         index again
+ *     Params:
+ *         void *context - A void pointer to the BMBTContext_t struct
+ *         uint8_t *pkt - The frame that was dropped
+ *     Returns:
+ *         void
+ */
+void BMBTIBusTXFrameDropped(void *ctx, uint8_t *pkt)
+{
+    BMBTContext_t *context = (BMBTContext_t *) ctx;
+    if (pkt[IBUS_PKT_DST] != IBUS_DEVICE_GT) {
+        return;
     }
+    BMBTGTIndexInvalidate(context);
+    context->dashboardOBCValid = 0;
 }
 
 /**
@@ -3845,6 +4223,7 @@ void BMBTGTScreenModeSet(void *ctx, uint8_t *pkt)
     BMBTContext_t *context = (BMBTContext_t *) ctx;
     if (pkt[IBUS_PKT_DB1] == BMBT_NAV_BOOT) {
         context->menu = BMBT_MENU_NONE;
+        BMBTGTIndexInvalidate(context);
         if (context->status.playerMode == BMBT_MODE_ACTIVE) {
             context->status.navState = BMBT_NAV_STATE_BOOT;
         }
@@ -3948,6 +4327,10 @@ void BMBTTimerHeaderWrite(void *ctx)
     }
     uint16_t time = context->timerHeaderIntervals * BMBT_HEADER_TIMER_WRITE_INT;
     if (time >= BMBT_HEADER_TIMER_WRITE_TIMEOUT) {
+        // Try again on the next interval if the bus is backed up
+        if (IBusTXBufferHasSpace(context->ibus, BMBT_HEADER_TX_FRAMES) == 0) {
+            return;
+        }
         BMBTHeaderWrite(context);
         // Increment the intervals so we aren't called again
         context->timerHeaderIntervals = BMBT_MENU_HEADER_TIMER_OFF;
@@ -4012,6 +4395,10 @@ void BMBTTimerMenuWrite(void *ctx)
         if (context->timerMenuIntervals != BMBT_MENU_HEADER_TIMER_OFF) {
             uint16_t time = context->timerMenuIntervals * BMBT_MENU_TIMER_WRITE_INT;
             if (time == BMBT_MENU_TIMER_WRITE_TIMEOUT) {
+                // Try again on the next interval if the bus is backed up
+                if (IBusTXBufferHasSpace(context->ibus, BMBT_MENU_TX_FRAMES) == 0) {
+                    return;
+                }
                 switch (context->menu) {
                     case BMBT_MENU_MAIN:
                         BMBTMenuMain(context);
@@ -4080,38 +4467,31 @@ void BMBTTimerScrollDisplay(void *ctx)
             context->mainDisplay.timeout--;
         } else {
             if (context->mainDisplay.length > BMBT_MAIN_AREA_LEN) {
-                char text[BMBT_DISPLAY_TEXT_LEN + 1] = {0};
-                uint8_t textLength = BMBT_DISPLAY_TEXT_LEN;
-                uint8_t idxEnd = context->mainDisplay.index + textLength;
-                // Prevent strncpy() from going out of bounds
-                if (idxEnd >= context->mainDisplay.length) {
-                    textLength = context->mainDisplay.length - context->mainDisplay.index;
-                    idxEnd = context->mainDisplay.index + textLength;
+                // Scrolling is cosmetic, so let a busy bus drain first
+                if (
+                    context->mainDisplay.index != 0 &&
+                    IBusGetTXBufferUsed(context->ibus) >= IBUS_TX_BUFFER_WATERMARK
+                ) {
+                    return;
                 }
-                UtilsStrncpy(
+                char text[BMBT_DISPLAY_TEXT_LEN + 1];
+                uint8_t chunk = ConfigGetSetting(CONFIG_SETTING_METADATA_MODE) ==
+                    BMBT_METADATA_MODE_CHUNK;
+                uint8_t position = UtilsDisplayValueScroll(
+                    &context->mainDisplay,
                     text,
-                    &context->mainDisplay.text[context->mainDisplay.index],
-                    textLength + 1
+                    BMBT_DISPLAY_TEXT_LEN,
+                    chunk == 1 ? BMBT_MAIN_AREA_LEN : 1
                 );
+                IBusSetTXPriority(context->ibus, IBUS_MSG_PRIORITY_BACKGROUND);
                 BMBTGTWriteTitle(context, text, 1);
-                // Pause at the beginning of the text
-                if (context->mainDisplay.index == 0) {
-                    context->mainDisplay.timeout = 5;
-                }
-                if (idxEnd >= context->mainDisplay.length) {
-                    // Pause at the end of the text
+                IBusSetTXPriority(context->ibus, IBUS_MSG_PRIORITY_INTERACTIVE);
+                if ((position & UTILS_DISPLAY_SCROLL_END) != 0 || chunk == 1) {
+                    // Pause at the end of the text and between chunks
                     context->mainDisplay.timeout = 2;
-                    context->mainDisplay.index = 0;
-                } else {
-                    if (
-                        ConfigGetSetting(CONFIG_SETTING_METADATA_MODE) ==
-                        BMBT_METADATA_MODE_CHUNK
-                    ) {
-                        context->mainDisplay.timeout = 2;
-                        context->mainDisplay.index += BMBT_MAIN_AREA_LEN;
-                    } else {
-                        context->mainDisplay.index++;
-                    }
+                } else if ((position & UTILS_DISPLAY_SCROLL_START) != 0) {
+                    // Pause at the beginning of the text
+                    context->mainDisplay.timeout = 5;
                 }
             } else {
                 if (context->mainDisplay.index == 0) {
@@ -7,6 +7,7 @@
 #ifndef BMBT_H
 #define BMBT_H
 #include "../lib/bt/bt_common.h"
+#include "../lib/config.h"
 #include "../lib/ibus.h"
 #include "../lib/utils.h"
 
@@ -91,6 +92,7 @@
 #define BMBT_TEL_STATE_NUMBER_SELECT 5
 
 #define BMBT_TEL_PAGE_SIZE 8
+#define BMBT_TEL_SEARCH_LEN 16
 
 #define BMBT_TEL_DIGIT_BACKSPACE 0x0A
 #define BMBT_TEL_DIGIT_STAR 0x1A
@@ -109,20 +111,56 @@
 #define BMBT_MENU_STATE_REL 0
 #define BMBT_MENU_STATE_PRESS 1
 
+#define BMBT_DASHBOARD_SOURCE_TITLE 0
+#define BMBT_DASHBOARD_SOURCE_ARTIST 1
+#define BMBT_DASHBOARD_SOURCE_ALBUM 2
+#define BMBT_DASHBOARD_SOURCE_BLANK 3
+#define BMBT_DASHBOARD_SOURCE_NOT_PLAYING 4
+#define BMBT_DASHBOARD_SOURCE_UNKNOWN_TITLE 5
+
+#define BMBT_DASHBOARD_OBC_BATTERY 0
+#define BMBT_DASHBOARD_OBC_AMBIENT 1
+#define BMBT_DASHBOARD_OBC_COOLANT 2
+#define BMBT_DASHBOARD_OBC_OIL 3
+#define BMBT_DASHBOARD_OBC_FIELDS 4
+#define BMBT_DASHBOARD_OBC_ALL 0xFF
+#define BMBT_DASHBOARD_OBC_FIELD_SIZE 8
+#define BMBT_DASHBOARD_OBC_INDEX_COUNT 5
+#define BMBT_DASHBOARD_OBC_INDEX_START 5
+
 #define BMBT_MAIN_AREA_LEN 9
 #define BMBT_MENU_IDX_PAIRING_MODE 0
 #define BMBT_MENU_IDX_CLEAR_PAIRING 1
 #define BMBT_MENU_IDX_FIRST_DEVICE 2
 #define BMBT_MENU_TIMER_WRITE_INT 100
 #define BMBT_MENU_TIMER_WRITE_TIMEOUT 500
+#define BMBT_MENU_TX_FRAMES 12
 #define BMBT_HEADER_TIMER_WRITE_INT 100
 #define BMBT_HEADER_TIMER_WRITE_TIMEOUT 500
+#define BMBT_HEADER_TX_FRAMES 7
 #define BMBT_MENU_HEADER_TIMER_OFF 0xFF
+#define BMBT_MENU_INDEX_COUNT 10
+#define BMBT_MENU_CACHE_COUNT 3
+// Each menu only has room for its own frames at their longest: a title of up
+// to 38 bytes, including the header update of the old UI, and rows of up to
+// 31 bytes. Together they take 579 bytes.
+#define BMBT_MENU_CACHE_TITLE_SIZE 38
+#define BMBT_MENU_CACHE_ROW_SIZE 31
+#define BMBT_MENU_CACHE_MAIN_SIZE (BMBT_MENU_CACHE_TITLE_SIZE + \
+    (3 * BMBT_MENU_CACHE_ROW_SIZE))
+#define BMBT_MENU_CACHE_SETTINGS_SIZE (BMBT_MENU_CACHE_TITLE_SIZE + \
+    (8 * BMBT_MENU_CACHE_ROW_SIZE))
+#define BMBT_MENU_CACHE_ABOUT_SIZE (BMBT_MENU_CACHE_TITLE_SIZE + \
+    (4 * BMBT_MENU_CACHE_ROW_SIZE))
+#define BMBT_MENU_CACHE_SIZE (BMBT_MENU_CACHE_MAIN_SIZE + \
+    BMBT_MENU_CACHE_SETTINGS_SIZE + BMBT_MENU_CACHE_ABOUT_SIZE)
 
 #define BMBT_MENU_SELECT_TIMER_OFF 0x07
 #define BMBT_MENU_SELECT_TIMER_INT 75
 #define BMBT_MENU_SELECT_TIMER_TIMEOUT 2
 
+#define BMBT_MENU_SETTING_FLAG_HIDE_BC127 0x01
+#define BMBT_MENU_SETTING_FLAG_REDRAW 0x02
 #define BMBT_MENU_STRING_MAX_SIZE 16
 #define BMBT_METADATA_MODE_OFF 0x00
 #define BMBT_METADATA_MODE_PARTY 0x01
@@ -147,6 +185,7 @@ typedef struct BMBTTELStatus_t {
     uint8_t numberIdx: 2;
     uint8_t phonebookType: 3;
     uint8_t page;
+    char search[BMBT_TEL_SEARCH_LEN];
 } BMBTTELStatus_t;
 
 typedef struct BMBTStatus_t {
@@ -163,6 +202,32 @@ typedef struct BMBTStatus_t {
     uint8_t navIndexType;
 } BMBTStatus_t;
 
+/*
+ * BMBTMenuCache_t
+ *  This is a struct to hold the frames that draw a menu which never changes
+ *  while the language and GT stay the same
+ *  menu: The BMBT_MENU_* that the frames draw, BMBT_MENU_NONE when empty
+ *  language: The language the frames were built in
+ *  gtVersion: The GT version the frames were built for
+ *  nav: Whether the navigation computer was present
+ *  length: The number of bytes in frames
+ *  size: The room for frames, which is the part of menuCacheFrames that
+ *      belongs to this menu
+ *  indexHash, indexValid: The index shadow that the frames leave behind
+ *  frames: The IBus frames, back to back
+ */
+typedef struct BMBTMenuCache_t {
+    uint8_t menu;
+    uint8_t language;
+    uint8_t gtVersion;
+    uint8_t nav;
+    uint16_t length;
+    uint16_t size;
+    uint16_t indexHash[BMBT_MENU_INDEX_COUNT];
+    uint16_t indexValid;
+    uint8_t *frames;
+} BMBTMenuCache_t;
+
 typedef struct BMBTContext_t {
     BT_t *bt;
     IBus_t *ibus;
@@ -184,9 +249,58 @@ typedef struct BMBTContext_t {
     uint8_t navSilenced: 1;
     uint8_t navRange: 1;
     uint32_t navZoomTime;
+    uint8_t dashboardSource[3];
+    char dashboardOBC[BMBT_DASHBOARD_OBC_FIELDS][BMBT_DASHBOARD_OBC_FIELD_SIZE];
+    uint16_t dashboardOBCHash[BMBT_DASHBOARD_OBC_INDEX_COUNT];
+    uint8_t dashboardOBCValid;
+    uint16_t menuIndexHash[BMBT_MENU_INDEX_COUNT];
+    uint16_t menuIndexValid;
+    BMBTMenuCache_t menuCache[BMBT_MENU_CACHE_COUNT];
+    uint8_t menuCacheFrames[BMBT_MENU_CACHE_SIZE];
     UtilsAbstractDisplayValue_t mainDisplay;
 } BMBTContext_t;
 
+/*
+ * BMBTMenuSetting_t
+ *  This is a struct to describe one row of a settings menu
+ *  index: The menu index that the row is written to
+ *  setting: The configuration address, unless get and set are given
+ *  flags: BMBT_MENU_SETTING_FLAG_* bits
+ *  values: The values that selecting the row cycles through
+ *  labels: The locale string for each entry in the values list
+ *  get, set: Accessors for settings that do not fill a whole byte
+ *  next: Picks the next value when the value set does not fit
+ *  format: Writes the row text when there are no labels
+ *  apply: Makes the hardware follow a new value
+ */
+typedef struct BMBTMenuSetting_t {
+    uint8_t index;
+    uint8_t setting;
+    uint8_t flags;
+    const ConfigValueSet_t *values;
+    const uint16_t *labels;
+    uint8_t (*get)(void);
+    void (*set)(uint8_t);
+    uint8_t (*next)(BMBTContext_t *, uint8_t);
+    void (*format)(BMBTContext_t *, uint8_t, char *);
+    void (*apply)(BMBTContext_t *, uint8_t);
+} BMBTMenuSetting_t;
+
+/*
+ * BMBTSettingsMenu_t
+ *  This is a struct to describe a settings menu made of BMBTMenuSetting_t rows
+ *  menu: The BMBT_MENU_* identifier
+ *  title: The locale string of the title
+ *  settingCount: The number of rows
+ *  settings: The rows, in index order
+ */
+typedef struct BMBTSettingsMenu_t {
+    uint8_t menu;
+    uint16_t title;
+    uint8_t settingCount;
+    const BMBTMenuSetting_t *settings;
+} BMBTSettingsMenu_t;
+
 void BMBTInit(BT_t *, IBus_t *);
 void BMBTDestroy();
 void BMBTBTDeviceConnected(void *, uint8_t *);
@@ -208,6 +322,7 @@ void BMBTIBusScreenModeSet(void *, uint8_t *);
 void BMBTIBusScreenBufferFlush(void *, uint8_t *);
 void BMBTIBusScreenBufferWrite(void *, uint8_t *);
 void BMBTIBusSensorValueUpdate(void *, uint8_t *);
+void BMBTIBusTXFrameDropped(void *, uint8_t *);
 void BMBTRADDisplayMenu(void *, uint8_t *);
 void BMBTRADUpdateMainArea(void *, uint8_t *);
 void BMBTRADScreenModeRequest(void *, uint8_t *);
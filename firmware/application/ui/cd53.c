@@ -6,7 +6,6 @@
  */
 #include "cd53.h"
 #include <string.h>
-#include <stdio.h>
 #include "../lib/bt.h"
 #include "../lib/event.h"
 #include "../lib/timer.h"
@@ -171,6 +170,7 @@ static void CD53SetMainDisplayText(
     int8_t timeout
 ) {
     UtilsStrncpy(context->mainDisplay.text, str, UTILS_DISPLAY_TEXT_SIZE);
+    UtilsConvertTextCharset(context->mainDisplay.text, UTILS_CHARSET_IBUS);
     context->mainDisplay.length = strlen(context->mainDisplay.text);
     context->mainDisplay.index = 0;
     TimerResetScheduledTask(context->displayUpdateTaskId);
@@ -183,6 +183,7 @@ static void CD53SetTempDisplayText(
     int8_t timeout
 ) {
     UtilsStrncpy(context->tempDisplay.text, str, UTILS_DISPLAY_TEXT_SIZE);
+    UtilsConvertTextCharset(context->tempDisplay.text, UTILS_CHARSET_IBUS);
     context->tempDisplay.length = strlen(context->tempDisplay.text);
     context->tempDisplay.index = 0;
     context->tempDisplay.status = CD53_DISPLAY_STATUS_NEW;
@@ -433,35 +434,38 @@ void CD53BTMetadata(CD53Context_t *context, uint8_t *data)
         context->displayMetadata == CD53_DISPLAY_METADATA_ON &&
         context->mode == CD53_MODE_ACTIVE
     ) {
-        if (strlen(context->bt->title) > 0) {
+        char *title = BTMetadataGet(context->bt, BT_METADATA_FIELD_TITLE);
+        if (title[0] != '\0') {
+            char *artist = BTMetadataGet(context->bt, BT_METADATA_FIELD_ARTIST);
+            char *album = BTMetadataGet(context->bt, BT_METADATA_FIELD_ALBUM);
             char text[UTILS_DISPLAY_TEXT_SIZE] = {0};
-            if (strlen(context->bt->artist) > 0 && strlen(context->bt->album) > 0) {
-                snprintf(
+            if (artist[0] != '\0' && album[0] != '\0') {
+                UtilsFormat(
                     text,
                     UTILS_DISPLAY_TEXT_SIZE,
                     "%s - %s on %s",
-                    context->bt->title,
-                    context->bt->artist,
-                    context->bt->album
+                    title,
+                    artist,
+                    album
                 );
-            } else if (strlen(context->bt->artist) > 0) {
-                snprintf(
+            } else if (artist[0] != '\0') {
+                UtilsFormat(
                     text,
                     UTILS_DISPLAY_TEXT_SIZE,
                     "%s - %s",
-                    context->bt->title,
-                    context->bt->artist
+                    title,
+                    artist
                 );
-            } else if (strlen(context->bt->album) > 0) {
-                snprintf(
+            } else if (album[0] != '\0') {
+                UtilsFormat(
                     text,
                     UTILS_DISPLAY_TEXT_SIZE,
                     "%s on %s",
-                    context->bt->title,
-                    context->bt->album
+                    title,
+                    album
                 );
             } else {
-                snprintf(text, UTILS_DISPLAY_TEXT_SIZE, "%s", context->bt->title);
+                UtilsFormat(text, UTILS_DISPLAY_TEXT_SIZE, "%s", title);
             }
             context->mainDisplay.timeout = 0;
             CD53SetMainDisplayText(context, text, 3000 / CD53_DISPLAY_SCROLL_SPEED);
@@ -661,7 +665,11 @@ void CD53TimerDisplay(void *ctx)
         } else if (context->tempDisplay.timeout < -1) {
             context->tempDisplay.status = CD53_DISPLAY_STATUS_OFF;
         }
-        if (context->tempDisplay.status == CD53_DISPLAY_STATUS_NEW) {
+        // Leave the text pending until the bus has room for it
+        if (
+            context->tempDisplay.status == CD53_DISPLAY_STATUS_NEW &&
+            IBusTXBufferHasSpace(context->ibus, 1) == 1
+        ) {
             if (context->radioType == CONFIG_UI_CD53) {
                 IBusCommandTELIKEDisplayWrite(
                     context->ibus,
@@ -696,25 +704,39 @@ void CD53TimerDisplay(void *ctx)
                 if (context->scrollTick < 3 && context->mainDisplay.index != 0) {
                     return;
                 }
+                // Scrolling is cosmetic, so let a busy bus drain first
+                if (
+                    context->mainDisplay.index != 0 &&
+                    IBusGetTXBufferUsed(context->ibus) >= IBUS_TX_BUFFER_WATERMARK
+                ) {
+                    return;
+                }
                 context->scrollTick = 0;
-                char text[CD53_DISPLAY_TEXT_LEN + 1] = {0};
-                uint8_t textLength = CD53_DISPLAY_TEXT_LEN;
-                uint8_t idxEnd = context->mainDisplay.index + textLength;
-                // Prevent strncpy() from going out of bounds
-                if (idxEnd >= context->mainDisplay.length) {
-                    textLength = context->mainDisplay.length - context->mainDisplay.index;
-                    idxEnd = context->mainDisplay.index + textLength;
+                char text[CD53_DISPLAY_TEXT_LEN + 1];
+                uint8_t metaMode = ConfigGetSetting(CONFIG_SETTING_METADATA_MODE);
+                // Use Party Scroll for all modes except metadata
+                uint8_t step = 1;
+                if (context->mode == CD53_MODE_ACTIVE) {
+                    if (metaMode == MENU_SINGLELINE_SETTING_METADATA_MODE_CHUNK) {
+                        step = CD53_DISPLAY_TEXT_LEN;
+                    } else if (metaMode != MENU_SINGLELINE_SETTING_METADATA_MODE_PARTY &&
+                        metaMode != MENU_SINGLELINE_SETTING_METADATA_MODE_PARTY_SINGLE
+                    ) {
+                        step = 0;
+                    }
                 }
-                UtilsStrncpy(
+                uint8_t position = UtilsDisplayValueScroll(
+                    &context->mainDisplay,
                     text,
-                    &context->mainDisplay.text[context->mainDisplay.index],
-                    textLength + 1
+                    CD53_DISPLAY_TEXT_LEN,
+                    step
                 );
                 // If we start with a space, it will be ignored by the display
                 // Instead, use 0x9D which results in a true blank being displayed
                 if (text[0] == 0x20) {
                     text[0] = IBUS_RAD_SPACE_CHAR_ALT;
                 }
+                IBusSetTXPriority(context->ibus, IBUS_MSG_PRIORITY_BACKGROUND);
                 if (context->radioType == CONFIG_UI_CD53) {
                     IBusCommandTELIKEDisplayWrite(context->ibus, text);
                 } else if (context->radioType == CONFIG_UI_MIR) {
@@ -722,9 +744,9 @@ void CD53TimerDisplay(void *ctx)
                 } else if (context->radioType == CONFIG_UI_IRIS) {
                     IBusCommandIRISDisplayWrite(context->ibus, text);
                 }
-                uint8_t metaMode = ConfigGetSetting(CONFIG_SETTING_METADATA_MODE);
+                IBusSetTXPriority(context->ibus, IBUS_MSG_PRIORITY_INTERACTIVE);
                 // Pause at the beginning of the text
-                if (context->mainDisplay.index == 0) {
+                if ((position & UTILS_DISPLAY_SCROLL_START) != 0) {
                     if (metaMode == MENU_SINGLELINE_SETTING_METADATA_MODE_STATIC ||
                         context->mainDisplay.timeout == CD53_TIMEOUT_SCROLL_STOP_NEXT_ITR
                     ) {
@@ -733,29 +755,17 @@ void CD53TimerDisplay(void *ctx)
                         context->mainDisplay.timeout = 20;
                     }
                 }
-                if (idxEnd >= context->mainDisplay.length) {
+                if ((position & UTILS_DISPLAY_SCROLL_END) != 0) {
                     // Pause at the end of the text or on the next iteration
                     // if we have Party Single Scroll mode enabled
-                    context->mainDisplay.index = 0;
                     if (metaMode == MENU_SINGLELINE_SETTING_METADATA_MODE_PARTY_SINGLE) {
                         context->mainDisplay.timeout = CD53_TIMEOUT_SCROLL_STOP_NEXT_ITR;
                     } else{
                         context->mainDisplay.timeout = 8;
                     }
-                } else {
-                    if (context->mode == CD53_MODE_ACTIVE) {
-                        if (metaMode == MENU_SINGLELINE_SETTING_METADATA_MODE_CHUNK) {
-                            context->mainDisplay.timeout = 8;
-                            context->mainDisplay.index += CD53_DISPLAY_TEXT_LEN;
-                        } else if (metaMode == MENU_SINGLELINE_SETTING_METADATA_MODE_PARTY ||
-                            metaMode == MENU_SINGLELINE_SETTING_METADATA_MODE_PARTY_SINGLE
-                        ) {
-                            context->mainDisplay.index++;
-                        }
-                    } else {
-                        // Use Party Scroll for all modes except metadata
-                        context->mainDisplay.index++;
-                    }
+                } else if (step == CD53_DISPLAY_TEXT_LEN) {
+                    // Pause between chunks
+                    context->mainDisplay.timeout = 8;
                 }
             } else {
                 if (context->mainDisplay.index == 0) {
@@ -7,7 +7,6 @@
 #include "cli.h"
 #include <stdlib.h>
 #include <string.h>
-#include <stdio.h>
 #include "../mappings.h"
 #include "../lib/bt/bt_bc127.h"
 #include "../lib/bt/bt_bm83.h"
@@ -126,7 +125,7 @@ void CLICommandBTBC127(char **msgBuf, uint8_t *cmdSuccess, uint8_t delimCount)
         ) {
             char license[25];
             memset(license, 0, 25);
-            snprintf(
+            UtilsFormat(
                 license,
                 25,
                 "%s %s %s %s %s",
@@ -230,6 +229,8 @@ void CLICommandBTBC127(char **msgBuf, uint8_t *cmdSuccess, uint8_t delimCount)
         if (*cmdSuccess != 0) {
             BC127CommandSetModuleName(cli.bt, nameBuf);
         }
+    } else if (UtilsStricmp(msgBuf[1], "RXSTAT") == 0) {
+        LogRaw("BC127 RX Overflows: %u\r\n", BC127GetRxOverflows());
     } else if (UtilsStricmp(msgBuf[1], "VERSION") == 0) {
         BC127CommandVersion(cli.bt);
     } else {
@@ -330,6 +331,21 @@ void CLICommandBTBM83(char **msgBuf, uint8_t *cmdSuccess, uint8_t delimCount)
         BM83CommandMusicControl(cli.bt, BM83_CMD_ACTION_PAUSE);
     } else if (UtilsStricmp(msgBuf[1], "RESTORE") == 0) {
         BM83CommandRestore(cli.bt);
+    } else if (UtilsStricmp(msgBuf[1], "RXSTAT") == 0) {
+        LogRaw("BM83 RX Checksum Errors: %u\r\n", BM83GetRxChecksumErrors());
+        LogRaw("BM83 RX Resyncs: %u\r\n", BM83GetRxResyncs());
+    } else if (UtilsStricmp(msgBuf[1], "TXSTAT") == 0) {
+        BM83TxStats_t *stats = BM83GetTxStats();
+        LogRaw("BM83 TX ACKs: %u (%u Rejected)\r\n", stats->acks, stats->rejects);
+        LogRaw("BM83 TX Retries: %u\r\n", stats->retries);
+        LogRaw("BM83 TX Timeouts: %u\r\n", stats->timeouts);
+        LogRaw("BM83 TX Dropped: %u\r\n", stats->overflows);
+        LogRaw(
+            "BM83 TX Latency: %ums (%02X), Max %ums\r\n",
+            stats->lastLatency,
+            stats->lastOpcode,
+            stats->maxLatency
+        );
     } else {
         *cmdSuccess = 0;
     }
@@ -371,7 +387,7 @@ void CLIEventBTBTMAddress(void *ctx, uint8_t *data)
 void CLIEventPBAPContactReceived(void *ctx, uint8_t *data)
 {
     CLI_t *cli = (CLI_t *)ctx;
-    if (cli->terminalReady == 1) {
+    if (cli->terminalReady == 1 || cli->bt->pbap.requestSync) {
         return;
     }
     if (cli->bt->pbap.contactCount == 0) {
@@ -516,6 +532,43 @@ void CLIProcess()
                     BTCommandPBAPOpen(cli.bt);
                 } else if (UtilsStricmp(msgBuf[1], "PBCLOSE") == 0) {
                     BTCommandPBAPClose(cli.bt);
+                } else if (UtilsStricmp(msgBuf[1], "PBCACHE") == 0) {
+                    uint8_t count = BTPBAPCacheGetCount(cli.bt);
+                    LogRaw(
+                        "Phonebook Cache: %d contacts, status %d, truncated %d\r\n",
+                        count,
+                        cli.bt->pbap.cache.status,
+                        cli.bt->pbap.cache.truncated
+                    );
+                    uint8_t i = 0;
+                    BTPBAPContact_t contact;
+                    if (delimCount >= 3) {
+                        // Search by T9 digits, or by the start of the name
+                        if (msgBuf[2][0] >= '0' && msgBuf[2][0] <= '9') {
+                            i = BTPBAPCacheSearchT9(cli.bt, msgBuf[2], 0);
+                            while (i != BT_PBAP_CACHE_SEARCH_NONE) {
+                                BTPBAPCacheGetContact(cli.bt, i, &contact);
+                                LogRaw("    %s (%d)\r\n", contact.name, contact.numberCount);
+                                i = BTPBAPCacheSearchT9(cli.bt, msgBuf[2], i + 1);
+                            }
+                        } else {
+                            i = BTPBAPCacheSearchName(cli.bt, msgBuf[2]);
+                            while (
+                                i != BT_PBAP_CACHE_SEARCH_NONE &&
+                                BTPBAPCacheGetContact(cli.bt, i, &contact) == 1 &&
+                                UtilsStrnicmp(contact.name, msgBuf[2], strlen(msgBuf[2])) == 0
+                            ) {
+                                LogRaw("    %s (%d)\r\n", contact.name, contact.numberCount);
+                                i++;
+                            }
+                        }
+                    } else {
+                        for (i = 0; i < count; i++) {
+                            if (BTPBAPCacheGetContact(cli.bt, i, &contact) == 1) {
+                                LogRaw("    %s (%d)\r\n", contact.name, contact.numberCount);
+                            }
+                        }
+                    }
                 } else if (UtilsStricmp(msgBuf[1], "PBGET") == 0) {
                     if (delimCount >= 3) {
                         if (cli.bt->pbap.active) {
@@ -982,10 +1035,14 @@ void CLIProcess()
                     LogRaw("    BT PLAY - Send the AVRCP Play Command\r\n");
                     LogRaw("    BT PAUSE - Send the AVRCP Pause Command\r\n");
                     LogRaw("    BT RESTORE - Reset the BM83\r\n");
+                    LogRaw("    BT RXSTAT - Show the BM83 RX checksum error and resync counts\r\n");
+                    LogRaw("    BT TXSTAT - Show the BM83 command queue counters and ACK latency\r\n");
                 }
                 LogRaw("    BT PBOPEN - Open a PBAP session with the connected device\r\n");
                 LogRaw("    BT PBCLOSE - Close the PBAP session\r\n");
                 LogRaw("    BT PBGET <offset> - Get phonebook contacts starting at offset\r\n");
+                LogRaw("    BT PBCACHE - List the cached phonebook in name order\r\n");
+                LogRaw("    BT PBCACHE <text> - List the cached contacts that start with the text, or its T9 digits\r\n");
                 LogRaw("    BT AT command> - Send raw AT command\r\n");
                 LogRaw("    BT DIAL <number> <name> - Dial a number and display name\r\n");
                 LogRaw("    BT REDIAL - Dial last number\r\n");
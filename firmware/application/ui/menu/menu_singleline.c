@@ -9,45 +9,366 @@
 #include "../../lib/bt/bt_bm83.h"
 #include "../../lib/config.h"
 #include "../../lib/event.h"
-#include <stdio.h>
+#include "../../lib/utils.h"
 #include <string.h>
 
-static uint8_t SETTINGS_MENU[] = {
-    MENU_SINGLELINE_SETTING_IDX_METADATA_MODE,
-    MENU_SINGLELINE_SETTING_IDX_AUTOPLAY,
-    MENU_SINGLELINE_SETTING_IDX_AUDIO_DSP,
-    MENU_SINGLELINE_SETTING_IDX_LOWER_VOL_REV,
-    MENU_SINGLELINE_SETTING_IDX_AUDIO_DAC_GAIN,
-    MENU_SINGLELINE_SETTING_IDX_TEL_HFP,
-    MENU_SINGLELINE_SETTING_IDX_TEL_MIC_GAIN,
-    MENU_SINGLELINE_SETTING_IDX_TEL_VOL_OFFSET,
-    MENU_SINGLELINE_SETTING_IDX_TEL_TCU_MODE,
-    MENU_SINGLELINE_SETTING_IDX_BLINKERS,
-    MENU_SINGLELINE_SETTING_IDX_PARK_LIGHTS,
-    MENU_SINGLELINE_SETTING_IDX_COMFORT_LOCKS,
-    MENU_SINGLELINE_SETTING_IDX_COMFORT_UNLOCK,
-    MENU_SINGLELINE_SETTING_IDX_VISUAL_PDC,
-    MENU_SINGLELINE_SETTING_IDX_ABOUT,
-    MENU_SINGLELINE_SETTING_IDX_PAIRINGS
+static const char * const MENU_SINGLELINE_LABELS_OFF_ON[] = {
+    "Off",
+    "On"
 };
 
-static uint8_t SETTINGS_TO_CONFIG_MAP[] = {
-    CONFIG_SETTING_METADATA_MODE,
-    CONFIG_SETTING_AUTOPLAY,
-    CONFIG_SETTING_DSP_INPUT_SRC,
-    CONFIG_SETTING_VOLUME_LOWER_ON_REV,
-    CONFIG_SETTING_DAC_AUDIO_VOL,
-    CONFIG_SETTING_HFP,
-    CONFIG_SETTING_MIC_GAIN,
-    CONFIG_SETTING_TEL_VOL,
-    CONFIG_SETTING_TEL_MODE,
-    CONFIG_SETTING_COMFORT_BLINKERS,
-    CONFIG_SETTING_COMFORT_PARKING_LAMPS,
-    CONFIG_SETTING_COMFORT_LOCKS,
-    CONFIG_SETTING_COMFORT_UNLOCK,
-    CONFIG_SETTING_VISUAL_PDC
+static const uint8_t MENU_SINGLELINE_METADATA_MODE_LIST[] = {
+    MENU_SINGLELINE_SETTING_METADATA_MODE_OFF,
+    MENU_SINGLELINE_SETTING_METADATA_MODE_PARTY,
+    MENU_SINGLELINE_SETTING_METADATA_MODE_CHUNK
 };
 
+static const ConfigValueSet_t MENU_SINGLELINE_VALUES_METADATA_MODE = {
+    sizeof(MENU_SINGLELINE_METADATA_MODE_LIST),
+    0,
+    0,
+    0,
+    MENU_SINGLELINE_METADATA_MODE_LIST
+};
+
+static const char * const MENU_SINGLELINE_LABELS_METADATA_MODE[] = {
+    "Off",
+    "Party",
+    "Chunk"
+};
+
+static const char * const MENU_SINGLELINE_LABELS_DSP_INPUT[] = {
+    "Default",
+    "Digital",
+    "Analog"
+};
+
+// Limit to minimum of 24 (+12dB)
+static const ConfigValueSet_t MENU_SINGLELINE_VALUES_DAC_GAIN = {0, 24, 96, 2, 0};
+
+static const char * const MENU_SINGLELINE_LABELS_TEL_MODE[] = {
+    "Default (Rec.)",
+    "TCU",
+    "No Mute",
+    "Analog"
+};
+
+static const char * const MENU_SINGLELINE_LABELS_COMFORT_LOCK[] = {
+    "Off",
+    "10km/h",
+    "20km/h"
+};
+
+static const char * const MENU_SINGLELINE_LABELS_COMFORT_UNLOCK[] = {
+    "Off",
+    "Pos 1",
+    "Pos 0"
+};
+
+static const char * const MENU_SINGLELINE_LABELS_PDC[] = {
+    "Off",
+    "Cluster",
+    "Radio",
+    "Both"
+};
+
+static const char * const MENU_SINGLELINE_LABELS_PAIRINGS[] = {
+    "Clear Pairings",
+    "Press Save"
+};
+
+static void MenuSingleLineSettingsSaveDSPInput(
+    MenuSingleLineContext_t *context,
+    uint8_t value
+) {
+    if (value == CONFIG_SETTING_DSP_INPUT_SPDIF) {
+        IBusCommandDSPSetMode(context->ibus, IBUS_DSP_CONFIG_SET_INPUT_SPDIF);
+    } else if (value == CONFIG_SETTING_DSP_INPUT_ANALOG) {
+        IBusCommandDSPSetMode(context->ibus, IBUS_DSP_CONFIG_SET_INPUT_RADIO);
+    }
+}
+
+static void MenuSingleLineSettingsFormatDACGain(
+    MenuSingleLineContext_t *context,
+    uint8_t value,
+    char *text
+) {
+    if (value > 0x30) {
+        uint8_t gain = (value - 0x30) / 2;
+        UtilsFormat(text, MENU_SINGLELINE_SETTING_TEXT_SIZE, "-%ddB", gain);
+    } else if (value == 0x30) {
+        UtilsFormat(text, MENU_SINGLELINE_SETTING_TEXT_SIZE, "0dB");
+    } else {
+        uint8_t gain = (0x30 - value) / 2;
+        UtilsFormat(text, MENU_SINGLELINE_SETTING_TEXT_SIZE, "+%ddB", gain);
+    }
+}
+
+static void MenuSingleLineSettingsSaveDACGain(
+    MenuSingleLineContext_t *context,
+    uint8_t value
+) {
+    // Apply the volume setting to the PCM51XX DAC
+    PCM51XXSetVolume(value);
+}
+
+static void MenuSingleLineSettingsSaveHFP(
+    MenuSingleLineContext_t *context,
+    uint8_t value
+) {
+    if (context->bt->activeDevice.deviceId == 0) {
+        return;
+    }
+    if (value == CONFIG_SETTING_OFF) {
+        if (context->bt->type == BT_BTM_TYPE_BC127) {
+            BC127CommandClose(context->bt, context->bt->activeDevice.hfpId);
+        } else {
+            BM83CommandDisconnect(context->bt, BM83_CMD_DISCONNECT_PARAM_HF);
+        }
+    } else {
+        BTPairedDevice_t *device = &context->bt->pairedDevices[
+            context->bt->activeDevice.deviceIndex
+        ];
+        if (context->bt->type == BT_BTM_TYPE_BC127) {
+            BC127CommandProfileOpen(context->bt, device, "HFP");
+        } else {
+            BM83CommandConnect(
+                context->bt,
+                device,
+                BM83_DATA_LINK_BACK_PROFILES_HF
+            );
+        }
+    }
+}
+
+static uint8_t MenuSingleLineSettingsGetMicGainMax(MenuSingleLineContext_t *context)
+{
+    if (context->bt->type == BT_BTM_TYPE_BC127) {
+        return 21;
+    }
+    return 0x0F;
+}
+
+static uint8_t MenuSingleLineSettingsNextMicGain(
+    MenuSingleLineContext_t *context,
+    uint8_t value,
+    uint8_t direction
+) {
+    ConfigValueSet_t gains = {
+        0,
+        0,
+        MenuSingleLineSettingsGetMicGainMax(context),
+        1,
+        0
+    };
+    return ConfigValueSetGetNext(&gains, value, direction);
+}
+
+static void MenuSingleLineSettingsFormatMicGain(
+    MenuSingleLineContext_t *context,
+    uint8_t value,
+    char *text
+) {
+    if (value > MenuSingleLineSettingsGetMicGainMax(context)) {
+        value = 0;
+    }
+    int8_t gain = (int8_t) BTBM83MicGainTable[value];
+    if (context->bt->type == BT_BTM_TYPE_BC127) {
+        gain = (int8_t) BTBC127MicGainTable[value];
+    }
+    UtilsFormat(text, MENU_SINGLELINE_SETTING_TEXT_SIZE, "%idB", gain);
+}
+
+static void MenuSingleLineSettingsSaveMicGain(
+    MenuSingleLineContext_t *context,
+    uint8_t value
+) {
+    if (context->bt->type == BT_BTM_TYPE_BC127) {
+        BC127CommandSetMicGain(
+            context->bt,
+            value,
+            ConfigGetSetting(CONFIG_SETTING_MIC_BIAS),
+            ConfigGetSetting(CONFIG_SETTING_MIC_PREAMP)
+        );
+    } else {
+        // The BM83 only steps its gain, so move it by the difference to
+        // the gain that is still stored
+        int8_t offset = ConfigGetSetting(CONFIG_SETTING_MIC_GAIN) - value;
+        while (offset < 0) {
+            BM83CommandMicGainUp(context->bt);
+            offset++;
+        }
+        while (offset > 0) {
+            BM83CommandMicGainDown(context->bt);
+            offset--;
+        }
+    }
+}
+
+static void MenuSingleLineSettingsFormatVolOffset(
+    MenuSingleLineContext_t *context,
+    uint8_t value,
+    char *text
+) {
+    UtilsFormat(text, MENU_SINGLELINE_SETTING_TEXT_SIZE, "%+d", (int8_t) value);
+}
+
+static void MenuSingleLineSettingsFormatBlinkers(
+    MenuSingleLineContext_t *context,
+    uint8_t value,
+    char *text
+) {
+    UtilsFormat(text, MENU_SINGLELINE_SETTING_TEXT_SIZE, "%d", value);
+}
+
+static void MenuSingleLineSettingsFormatAbout(
+    MenuSingleLineContext_t *context,
+    uint8_t value,
+    char *text
+) {
+    char firmwareVersion[9] = {0};
+    ConfigGetFirmwareVersionString(firmwareVersion);
+    UtilsFormat(
+        text,
+        MENU_SINGLELINE_SETTING_TEXT_SIZE,
+        "FW: %s Serial: %d Built: %02d/%d",
+        firmwareVersion,
+        ConfigGetSerialNumber(),
+        ConfigGetBuildWeek(),
+        ConfigGetBuildYear()
+    );
+}
+
+static void MenuSingleLineSettingsSavePairings(
+    MenuSingleLineContext_t *context,
+    uint8_t value
+) {
+    if (value != CONFIG_SETTING_ON) {
+        return;
+    }
+    if (context->bt->type == BT_BTM_TYPE_BC127) {
+        BC127CommandUnpair(context->bt);
+    } else {
+        BM83CommandRestore(context->bt);
+        BTPairedDeviceClearRecords();
+        ConfigSetSetting(CONFIG_SETTING_MIC_GAIN, 0x00);
+        ConfigSetSetting(CONFIG_SETTING_LAST_CONNECTED_DEVICE, 0x00);
+    }
+    MenuSingleLineSetDisplayText(
+        context,
+        "Unpaired",
+        1,
+        MENU_SINGLELINE_DISPLAY_UPDATE_TEMP
+    );
+}
+
+// Entries are in MENU_SINGLELINE_SETTING_IDX_* order
+static const MenuSingleLineSetting_t MENU_SINGLELINE_SETTINGS[] = {
+    {
+        .title = "Metadata",
+        .setting = CONFIG_SETTING_METADATA_MODE,
+        .values = &MENU_SINGLELINE_VALUES_METADATA_MODE,
+        .labels = MENU_SINGLELINE_LABELS_METADATA_MODE
+    },
+    {
+        .title = "Autoplay",
+        .setting = CONFIG_SETTING_AUTOPLAY,
+        .values = &CONFIG_VALUES_OFF_ON,
+        .labels = MENU_SINGLELINE_LABELS_OFF_ON
+    },
+    {
+        .title = "DSP",
+        .setting = CONFIG_SETTING_DSP_INPUT_SRC,
+        .flags = MENU_SINGLELINE_SETTING_FLAG_REQUIRES_DSP,
+        .values = &CONFIG_VALUES_DSP_INPUT,
+        .labels = MENU_SINGLELINE_LABELS_DSP_INPUT,
+        .save = &MenuSingleLineSettingsSaveDSPInput
+    },
+    {
+        .title = "Lower Vol. On Reverse",
+        .setting = CONFIG_SETTING_VOLUME_LOWER_ON_REV,
+        .values = &CONFIG_VALUES_OFF_ON,
+        .labels = MENU_SINGLELINE_LABELS_OFF_ON
+    },
+    {
+        .title = "DAC Volume",
+        .setting = CONFIG_SETTING_DAC_AUDIO_VOL,
+        .values = &MENU_SINGLELINE_VALUES_DAC_GAIN,
+        .format = &MenuSingleLineSettingsFormatDACGain,
+        .save = &MenuSingleLineSettingsSaveDACGain
+    },
+    {
+        .title = "Handsfree",
+        .setting = CONFIG_SETTING_HFP,
+        .values = &CONFIG_VALUES_OFF_ON,
+        .labels = MENU_SINGLELINE_LABELS_OFF_ON,
+        .save = &MenuSingleLineSettingsSaveHFP
+    },
+    {
+        .title = "Mic Gain",
+        .setting = CONFIG_SETTING_MIC_GAIN,
+        .next = &MenuSingleLineSettingsNextMicGain,
+        .format = &MenuSingleLineSettingsFormatMicGain,
+        .save = &MenuSingleLineSettingsSaveMicGain
+    },
+    {
+        .title = "Call Vol. Offset",
+        .setting = CONFIG_SETTING_TEL_VOL,
+        .values = &CONFIG_VALUES_TEL_VOL,
+        .format = &MenuSingleLineSettingsFormatVolOffset
+    },
+    {
+        // TCU Mode is not necessary on HW Version 1
+        .title = "Call Mode",
+        .setting = CONFIG_SETTING_TEL_MODE,
+        .flags = MENU_SINGLELINE_SETTING_FLAG_HIDE_BC127,
+        .values = &CONFIG_VALUES_TEL_MODE,
+        .labels = MENU_SINGLELINE_LABELS_TEL_MODE
+    },
+    {
+        .title = "Comfort Blinks",
+        .setting = CONFIG_SETTING_COMFORT_BLINKERS,
+        .values = &CONFIG_VALUES_COMFORT_BLINKERS,
+        .format = &MenuSingleLineSettingsFormatBlinkers
+    },
+    {
+        .title = "Parking Lamps",
+        .setting = CONFIG_SETTING_COMFORT_PARKING_LAMPS,
+        .values = &CONFIG_VALUES_OFF_ON,
+        .labels = MENU_SINGLELINE_LABELS_OFF_ON
+    },
+    {
+        .title = "Comfort Lock",
+        .values = &CONFIG_VALUES_COMFORT_LOCK,
+        .labels = MENU_SINGLELINE_LABELS_COMFORT_LOCK,
+        .get = &ConfigGetComfortLock,
+        .set = &ConfigSetComfortLock
+    },
+    {
+        .title = "Comfort Unlock",
+        .values = &CONFIG_VALUES_COMFORT_UNLOCK,
+        .labels = MENU_SINGLELINE_LABELS_COMFORT_UNLOCK,
+        .get = &ConfigGetComfortUnlock,
+        .set = &ConfigSetComfortUnlock
+    },
+    {
+        .title = "PDC",
+        .setting = CONFIG_SETTING_VISUAL_PDC,
+        .values = &CONFIG_VALUES_PDC,
+        .labels = MENU_SINGLELINE_LABELS_PDC
+    },
+    {
+        .flags = MENU_SINGLELINE_SETTING_FLAG_READ_ONLY,
+        .format = &MenuSingleLineSettingsFormatAbout
+    },
+    {
+        .values = &CONFIG_VALUES_OFF_ON,
+        .labels = MENU_SINGLELINE_LABELS_PAIRINGS,
+        .save = &MenuSingleLineSettingsSavePairings
+    }
+};
+
+
 /**
  * MenuSingleLineInit()
  *     Description:
@@ -217,12 +538,12 @@ void MenuSingleLineOBC(MenuSingleLineContext_t *context)
     if (context->uiMode == CONFIG_UI_MID) {
         // MID: 24 chars max
         if (oil != 0) {
-            snprintf(text, 24, "C:%d O:%d S:%u", coolant, oil, context->vehicleSpeed);
+            UtilsFormat(text, 24, "C:%d O:%d S:%u", coolant, oil, context->vehicleSpeed);
         } else {
-            snprintf(text, 24, "Coolant:%d Speed:%u", coolant, context->vehicleSpeed);
+            UtilsFormat(text, 24, "Coolant:%d Speed:%u", coolant, context->vehicleSpeed);
         }
     } else {
-        snprintf(text, 12, "C:%d S:%u", coolant, context->vehicleSpeed);
+        UtilsFormat(text, 12, "C:%d S:%u", coolant, context->vehicleSpeed);
     }
     MenuSingleLineSetDisplayText(
         context,
@@ -259,6 +580,103 @@ void MenuSingleLineSetUIView(MenuSingleLineContext_t *context, uint8_t view)
     }
 }
 
+/**
+ * MenuSingleLineSettingIsVisible()
+ *     Description:
+ *         Check if a settings entry is offered on this hardware
+ *     Params:
+ *         MenuSingleLineContext_t *context - Pointer to the context
+ *         const MenuSingleLineSetting_t *setting - The entry
+ *     Returns:
+ *         uint8_t - 1 if the entry is shown, 0 otherwise
+ */
+static uint8_t MenuSingleLineSettingIsVisible(
+    MenuSingleLineContext_t *context,
+    const MenuSingleLineSetting_t *setting
+) {
+    if ((setting->flags & MENU_SINGLELINE_SETTING_FLAG_HIDE_BC127) != 0 &&
+        context->bt->type == BT_BTM_TYPE_BC127
+    ) {
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * MenuSingleLineSettingIsAvailable()
+ *     Description:
+ *         Check if the hardware that a settings entry controls is present
+ *     Params:
+ *         MenuSingleLineContext_t *context - Pointer to the context
+ *         const MenuSingleLineSetting_t *setting - The entry
+ *     Returns:
+ *         uint8_t - 1 if the entry can be used, 0 otherwise
+ */
+static uint8_t MenuSingleLineSettingIsAvailable(
+    MenuSingleLineContext_t *context,
+    const MenuSingleLineSetting_t *setting
+) {
+    if ((setting->flags & MENU_SINGLELINE_SETTING_FLAG_REQUIRES_DSP) != 0 &&
+        context->ibus->moduleStatus.DSP == 0
+    ) {
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * MenuSingleLineSettingGetValue()
+ *     Description:
+ *         Read the stored value of a settings entry. Entries that are not
+ *         stored start out as off.
+ *     Params:
+ *         const MenuSingleLineSetting_t *setting - The entry
+ *     Returns:
+ *         uint8_t - The value
+ */
+static uint8_t MenuSingleLineSettingGetValue(const MenuSingleLineSetting_t *setting)
+{
+    uint8_t value = CONFIG_SETTING_OFF;
+    if (setting->get != 0) {
+        value = setting->get();
+    } else if (setting->setting != 0) {
+        value = ConfigGetSetting(setting->setting);
+    }
+    if (setting->values != 0) {
+        value = ConfigValueSetGetValid(setting->values, value);
+    }
+    return value;
+}
+
+/**
+ * MenuSingleLineSettingGetText()
+ *     Description:
+ *         Write the text for the given value of a settings entry
+ *     Params:
+ *         MenuSingleLineContext_t *context - Pointer to the context
+ *         const MenuSingleLineSetting_t *setting - The entry
+ *         uint8_t value - The value to describe
+ *         char *text - A buffer of MENU_SINGLELINE_SETTING_TEXT_SIZE bytes
+ *     Returns:
+ *         void
+ */
+static void MenuSingleLineSettingGetText(
+    MenuSingleLineContext_t *context,
+    const MenuSingleLineSetting_t *setting,
+    uint8_t value,
+    char *text
+) {
+    if (setting->labels != 0) {
+        UtilsStrncpy(
+            text,
+            setting->labels[ConfigValueSetGetIndex(setting->values, value)],
+            MENU_SINGLELINE_SETTING_TEXT_SIZE
+        );
+    } else {
+        setting->format(context, value, text);
+    }
+}
+
 /**
  * MenuSingleLineSettings()
  *     Description:
@@ -270,34 +688,11 @@ void MenuSingleLineSetUIView(MenuSingleLineContext_t *context, uint8_t view)
  */
 void MenuSingleLineSettings(MenuSingleLineContext_t *context)
 {
-    uint8_t value = ConfigGetSetting(
-        CONFIG_SETTING_METADATA_MODE
-    );
-    if (value == MENU_SINGLELINE_SETTING_METADATA_MODE_OFF) {
-        MenuSingleLineSetDisplayText(
-            context,
-            "Metadata: Off",
-            0,
-            MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-        );
-    } else if (value == MENU_SINGLELINE_SETTING_METADATA_MODE_PARTY) {
-        MenuSingleLineSetDisplayText(
-            context,
-            "Metadata: Party",
-            0,
-            MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-        );
-    } else if (value == MENU_SINGLELINE_SETTING_METADATA_MODE_CHUNK) {
-        MenuSingleLineSetDisplayText(
-            context,
-            "Metadata: Chunk",
-            0,
-            MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-        );
-    }
-    context->settingIdx = MENU_SINGLELINE_SETTING_IDX_METADATA_MODE;
-    context->settingValue = value;
     context->settingMode = MENU_SINGLELINE_SETTING_MODE_SCROLL_SETTINGS;
+    MenuSingleLineSettingsNextSetting(
+        context,
+        MENU_SINGLELINE_SETTING_IDX_METADATA_MODE
+    );
 }
 
 /**
@@ -311,10 +706,12 @@ void MenuSingleLineSettings(MenuSingleLineContext_t *context)
  */
 void MenuSingleLineSettingsEditSave(MenuSingleLineContext_t *context)
 {
-    // Ignore the Edit / Save button for the about index
-    if (context->settingIdx == MENU_SINGLELINE_SETTING_IDX_ABOUT ||
-        (context->settingIdx == MENU_SINGLELINE_SETTING_IDX_AUDIO_DSP &&
-        context->ibus->moduleStatus.DSP == 0)
+    const MenuSingleLineSetting_t *setting = &MENU_SINGLELINE_SETTINGS[
+        context->settingIdx
+    ];
+    // Ignore the Edit / Save button for entries that cannot be changed
+    if ((setting->flags & MENU_SINGLELINE_SETTING_FLAG_READ_ONLY) != 0 ||
+        MenuSingleLineSettingIsAvailable(context, setting) == 0
     ) {
         return;
     }
@@ -327,132 +724,21 @@ void MenuSingleLineSettingsEditSave(MenuSingleLineContext_t *context)
     } else if (context->settingMode == MENU_SINGLELINE_SETTING_MODE_SCROLL_VALUES) {
         context->settingMode = MENU_SINGLELINE_SETTING_MODE_SCROLL_SETTINGS;
         // Save Setting
-        if (context->settingIdx == MENU_SINGLELINE_SETTING_IDX_PAIRINGS) {
-            if (context->settingValue == CONFIG_SETTING_ON) {
-                if (context->bt->type == BT_BTM_TYPE_BC127) {
-                    BC127CommandUnpair(context->bt);
-                } else {
-                    BM83CommandRestore(context->bt);
-                    BTPairedDeviceClearRecords();
-                    ConfigSetSetting(CONFIG_SETTING_MIC_GAIN, 0x00);
-                    ConfigSetSetting(CONFIG_SETTING_LAST_CONNECTED_DEVICE, 0x00);
-                }
-                MenuSingleLineSetDisplayText(
-                    context,
-                    "Unpaired",
-                    1,
-                    MENU_SINGLELINE_DISPLAY_UPDATE_TEMP
-                );
-            }
-        } else if (context->settingIdx == MENU_SINGLELINE_SETTING_IDX_COMFORT_LOCKS) {
-            ConfigSetComfortLock(context->settingValue);
-            MenuSingleLineSetDisplayText(
-                context,
-                "Saved",
-                1,
-                MENU_SINGLELINE_DISPLAY_UPDATE_TEMP
-            );
-        } else if (context->settingIdx == MENU_SINGLELINE_SETTING_IDX_COMFORT_UNLOCK) {
-            ConfigSetComfortUnlock(context->settingValue);
-            MenuSingleLineSetDisplayText(
-                context,
-                "Saved",
-                1,
-                MENU_SINGLELINE_DISPLAY_UPDATE_TEMP
-            );
-        } else if (context->settingIdx == MENU_SINGLELINE_SETTING_IDX_AUDIO_DSP) {
-            ConfigSetSetting(CONFIG_SETTING_DSP_INPUT_SRC, context->settingValue);
-            MenuSingleLineSetDisplayText(
-                context,
-                "Saved",
-                1,
-                MENU_SINGLELINE_DISPLAY_UPDATE_TEMP
-            );
-            if (context->settingValue == CONFIG_SETTING_DSP_INPUT_SPDIF) {
-                IBusCommandDSPSetMode(context->ibus, IBUS_DSP_CONFIG_SET_INPUT_SPDIF);
-            } else if (context->settingValue == CONFIG_SETTING_DSP_INPUT_ANALOG) {
-                IBusCommandDSPSetMode(context->ibus, IBUS_DSP_CONFIG_SET_INPUT_RADIO);
-            }
-        } else if (context->settingIdx == MENU_SINGLELINE_SETTING_IDX_AUDIO_DAC_GAIN) {
-            // Limit to minimum of 24 (+12dB)
-            if (context->settingValue < 24) {
-                context->settingValue = 24;
-            }
-            ConfigSetSetting(CONFIG_SETTING_DAC_AUDIO_VOL, context->settingValue);
-            // Apply the volume setting to the PCM51XX DAC
-            PCM51XXSetVolume(context->settingValue);
+        if (setting->set != 0 || setting->setting != 0) {
             MenuSingleLineSetDisplayText(
                 context,
                 "Saved",
                 1,
                 MENU_SINGLELINE_DISPLAY_UPDATE_TEMP
             );
-        } else if (context->settingIdx == MENU_SINGLELINE_SETTING_IDX_TEL_MIC_GAIN) {
-            MenuSingleLineSetDisplayText(
-                context,
-                "Saved",
-                1,
-                MENU_SINGLELINE_DISPLAY_UPDATE_TEMP
-            );
-            uint8_t micGain = ConfigGetSetting(CONFIG_SETTING_MIC_GAIN);
-            if (context->bt->type == BT_BTM_TYPE_BC127) {
-                uint8_t micBias = ConfigGetSetting(CONFIG_SETTING_MIC_BIAS);
-                uint8_t micPreamp = ConfigGetSetting(CONFIG_SETTING_MIC_PREAMP);
-                BC127CommandSetMicGain(
-                    context->bt,
-                    micGain,
-                    micBias,
-                    micPreamp
-                );
-            } else {
-                int8_t offset = micGain - context->settingValue;
-                while (offset < 0) {
-                    BM83CommandMicGainUp(context->bt);
-                    offset++;
-                }
-                while (offset > 0) {
-                    BM83CommandMicGainDown(context->bt);
-                    offset--;
-                }
-            }
-            ConfigSetSetting(CONFIG_SETTING_MIC_GAIN, context->settingValue);
-        } else {
-            ConfigSetSetting(
-                SETTINGS_TO_CONFIG_MAP[context->settingIdx],
-                context->settingValue
-            );
-            MenuSingleLineSetDisplayText(
-                context,
-                "Saved",
-                1,
-                MENU_SINGLELINE_DISPLAY_UPDATE_TEMP
-            );
-            if (context->settingIdx == MENU_SINGLELINE_SETTING_IDX_TEL_HFP &&
-                context->bt->activeDevice.deviceId != 0
-            ) {
-                if (context->settingValue == 0x00) {
-                    if (context->bt->type == BT_BTM_TYPE_BC127) {
-                        BC127CommandClose(context->bt, context->bt->activeDevice.hfpId);
-                    } else {
-                        BM83CommandDisconnect(context->bt, BM83_CMD_DISCONNECT_PARAM_HF);
-                    }
-                } else {
-                    BTPairedDevice_t *device = &context->bt->pairedDevices[
-                        context->bt->activeDevice.deviceIndex
-                    ];
-                    if (context->bt->type == BT_BTM_TYPE_BC127) {
-                        BC127CommandProfileOpen(context->bt, device, "HFP");
-                    } else {
-                        if (device != 0) {
-                            BM83CommandConnect(
-                                context->bt,
-                                device,
-                                BM83_DATA_LINK_BACK_PROFILES_HF
-                            );
-                        }
-                    }
-                }
-            }
+        }
+        if (setting->save != 0) {
+            setting->save(context, context->settingValue);
+        }
+        if (setting->set != 0) {
+            setting->set(context->settingValue);
+        } else if (setting->setting != 0) {
+            ConfigSetSetting(setting->setting, context->settingValue);
         }
         MenuSingleLineSettingsNextSetting(context, context->settingIdx);
     }
@@ -472,28 +758,26 @@ void MenuSingleLineSettingsEditSave(MenuSingleLineContext_t *context)
 void MenuSingleLineSettingsScroll(MenuSingleLineContext_t *context, uint8_t direction)
 {
     if (context->settingMode == MENU_SINGLELINE_SETTING_MODE_SCROLL_SETTINGS) {
-        uint8_t nextOption = 0;
-        if (context->settingIdx == MENU_SINGLELINE_SETTING_IDX_METADATA_MODE && direction == 0x01) {
-            nextOption = SETTINGS_MENU[MENU_SINGLELINE_SETTING_IDX_PAIRINGS];
-        } else if(context->settingIdx == MENU_SINGLELINE_SETTING_IDX_PAIRINGS && direction == 0x00) {
-            nextOption = SETTINGS_MENU[MENU_SINGLELINE_SETTING_IDX_METADATA_MODE];
-        } else {
-            if (direction == 0x00) {
-                nextOption = SETTINGS_MENU[context->settingIdx + 1];
-            } else {
-                nextOption = SETTINGS_MENU[context->settingIdx - 1];
-            }
-        }
-        // Hide TCU Mode option on HW Version 1. It is not necessary there.
-        if (nextOption == MENU_SINGLELINE_SETTING_IDX_TEL_TCU_MODE &&
-            context->bt->type == BT_BTM_TYPE_BC127
-        ) {
-            if (direction == 0x00) {
+        uint8_t settingsCount = sizeof(MENU_SINGLELINE_SETTINGS) /
+            sizeof(MenuSingleLineSetting_t);
+        uint8_t nextOption = context->settingIdx;
+        do {
+            if (direction == MENU_SINGLELINE_DIRECTION_FORWARD) {
                 nextOption++;
+                if (nextOption >= settingsCount) {
+                    nextOption = 0;
+                }
+            } else if (nextOption == 0) {
+                nextOption = settingsCount - 1;
             } else {
                 nextOption--;
             }
-        }
+        } while (
+            MenuSingleLineSettingIsVisible(
+                context,
+                &MENU_SINGLELINE_SETTINGS[nextOption]
+            ) == 0
+        );
         MenuSingleLineSettingsNextSetting(context, nextOption);
     } else if (context->settingMode == MENU_SINGLELINE_SETTING_MODE_SCROLL_VALUES) {
         MenuSingleLineSettingsNextValue(context, direction);
@@ -512,366 +796,43 @@ void MenuSingleLineSettingsScroll(MenuSingleLineContext_t *context, uint8_t dire
  */
 void MenuSingleLineSettingsNextSetting(MenuSingleLineContext_t *context, uint8_t nextMenu)
 {
+    const MenuSingleLineSetting_t *setting = &MENU_SINGLELINE_SETTINGS[nextMenu];
+    char valueText[MENU_SINGLELINE_SETTING_TEXT_SIZE] = {0};
+    char text[MENU_SINGLELINE_SETTING_TEXT_SIZE] = {0};
     context->settingIdx = nextMenu;
-    if (nextMenu == MENU_SINGLELINE_SETTING_IDX_METADATA_MODE) {
-        uint8_t value = ConfigGetSetting(
-            CONFIG_SETTING_METADATA_MODE
+    if (MenuSingleLineSettingIsAvailable(context, setting) == 0) {
+        UtilsFormat(
+            text,
+            MENU_SINGLELINE_SETTING_TEXT_SIZE,
+            "%s: Not Equipped",
+            setting->title
         );
-        if (value == MENU_SINGLELINE_SETTING_METADATA_MODE_OFF) {
-            MenuSingleLineSetDisplayText(
-                context,
-                "Metadata: Off",
-                0,
-                MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-            );
-        } else if (value == MENU_SINGLELINE_SETTING_METADATA_MODE_PARTY) {
-            MenuSingleLineSetDisplayText(
-                context,
-                "Metadata: Party",
-                0,
-                MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-            );
-        } else if (value == MENU_SINGLELINE_SETTING_METADATA_MODE_CHUNK) {
-            MenuSingleLineSetDisplayText(
-                context,
-                "Metadata: Chunk",
-                0,
-                MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-            );
-        }
-        context->settingValue = value;
-    }
-    if (nextMenu == MENU_SINGLELINE_SETTING_IDX_AUTOPLAY) {
-        if (ConfigGetSetting(CONFIG_SETTING_AUTOPLAY) == 0x00) {
-            MenuSingleLineSetDisplayText(
-                context,
-                "Autoplay: Off",
-                0,
-                MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-            );
-            context->settingValue = CONFIG_SETTING_OFF;
-        } else {
-            MenuSingleLineSetDisplayText(
-                context,
-                "Autoplay: On",
-                0,
-                MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-            );
-            context->settingValue = CONFIG_SETTING_ON;
-        }
-        context->settingIdx = MENU_SINGLELINE_SETTING_IDX_AUTOPLAY;
-    }
-    if (nextMenu == MENU_SINGLELINE_SETTING_IDX_AUDIO_DSP) {
-        if (context->ibus->moduleStatus.DSP == 0) {
-            MenuSingleLineSetDisplayText(
-                context,
-                "DSP: Not Equipped",
-                0,
-                MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
+    } else {
+        context->settingValue = MenuSingleLineSettingGetValue(setting);
+        MenuSingleLineSettingGetText(
+            context,
+            setting,
+            context->settingValue,
+            valueText
+        );
+        if (setting->title != 0) {
+            UtilsFormat(
+                text,
+                MENU_SINGLELINE_SETTING_TEXT_SIZE,
+                "%s: %s",
+                setting->title,
+                valueText
             );
         } else {
-            context->settingValue = ConfigGetSetting(CONFIG_SETTING_DSP_INPUT_SRC);
-            if (context->settingValue == CONFIG_SETTING_DSP_INPUT_SPDIF) {
-                MenuSingleLineSetDisplayText(
-                    context,
-                    "DSP: Digital",
-                    0,
-                    MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-                );
-            } else if (context->settingValue == CONFIG_SETTING_DSP_INPUT_ANALOG) {
-                MenuSingleLineSetDisplayText(
-                    context,
-                    "DSP: Analog",
-                    0,
-                    MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-                );
-            } else {
-                MenuSingleLineSetDisplayText(
-                    context,
-                    "DSP: Default",
-                    0,
-                    MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-                );
-            }
+            UtilsStrncpy(text, valueText, MENU_SINGLELINE_SETTING_TEXT_SIZE);
         }
     }
-    if (nextMenu == MENU_SINGLELINE_SETTING_IDX_LOWER_VOL_REV) {
-        if (ConfigGetSetting(CONFIG_SETTING_VOLUME_LOWER_ON_REV) == CONFIG_SETTING_OFF) {
-            MenuSingleLineSetDisplayText(
-                context,
-                "Lower Vol. On Reverse: Off",
-                0,
-                MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-            );
-            context->settingValue = CONFIG_SETTING_OFF;
-        } else {
-            MenuSingleLineSetDisplayText(
-                context,
-                "Lower Vol. On Reverse: On",
-                0,
-                MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-            );
-            context->settingValue = CONFIG_SETTING_ON;
-        }
-    }
-    if (nextMenu == MENU_SINGLELINE_SETTING_IDX_AUDIO_DAC_GAIN) {
-        uint8_t currentVolume = ConfigGetSetting(CONFIG_SETTING_DAC_AUDIO_VOL);
-        // Limit to minimum of 24 (+12dB)
-        if (currentVolume < 24) {
-            currentVolume = 24;
-        }
-        context->settingValue = currentVolume;
-        char volText[19] = {0};
-        if (currentVolume > 0x30) {
-            uint8_t gain = (currentVolume - 0x30) / 2;
-            snprintf(volText, 18, "DAC Volume: -%ddB", gain);
-        } else if (currentVolume == 0x30) {
-            snprintf(volText, 18, "DAC Volume: 0dB");
-        } else {
-            uint8_t gain = (0x30 - currentVolume) / 2;
-            snprintf(volText, 18, "DAC Volume: +%ddB", gain);
-        }
-        MenuSingleLineSetDisplayText(
-            context,
-            volText,
-            0,
-            MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-        );
-    }
-    if (nextMenu == MENU_SINGLELINE_SETTING_IDX_TEL_HFP) {
-        if (ConfigGetSetting(CONFIG_SETTING_HFP) == 0x00) {
-            MenuSingleLineSetDisplayText(
-                context,
-                "Handsfree: Off",
-                0,
-                MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-            );
-            context->settingValue = CONFIG_SETTING_OFF;
-        } else {
-            MenuSingleLineSetDisplayText(
-                context,
-                "Handsfree: On",
-                0,
-                MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-            );
-            context->settingValue = CONFIG_SETTING_ON;
-        }
-    }
-    if (nextMenu == MENU_SINGLELINE_SETTING_IDX_TEL_MIC_GAIN) {
-        uint8_t micGain = ConfigGetSetting(CONFIG_SETTING_MIC_GAIN);
-        context->settingValue = micGain;
-        char micGainText[17] = {0};
-        if (context->bt->type == BT_BTM_TYPE_BC127) {
-            if (micGain > 21) {
-                micGain = 0;
-            }
-            snprintf(micGainText, 16, "Mic Gain: %idB", (int8_t) BTBC127MicGainTable[micGain]);
-        } else {
-            if (micGain > 0x0F) {
-                micGain = 0;
-            }
-            snprintf(micGainText, 16, "Mic Gain: %idB", (int8_t) BTBM83MicGainTable[micGain]);
-        }
-        MenuSingleLineSetDisplayText(
-            context,
-            micGainText,
-            0,
-            MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-        );
-    }
-    if (nextMenu == MENU_SINGLELINE_SETTING_IDX_TEL_VOL_OFFSET) {
-        int8_t telephoneVolume = ConfigGetSetting(CONFIG_SETTING_TEL_VOL);
-        if (telephoneVolume > CONFIG_SETTING_TEL_VOL_OFFSET_MAX) {
-            telephoneVolume = CONFIG_SETTING_TEL_VOL_OFFSET_MAX;
-        }
-        char telephoneVolumeText[21] = {0};
-        snprintf(telephoneVolumeText, 21, "Call Vol. Offset: %+d", telephoneVolume);
-        MenuSingleLineSetDisplayText(
-            context,
-            telephoneVolumeText,
-            0,
-            MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-        );
-        context->settingValue = telephoneVolume;
-    }
-    if (nextMenu == MENU_SINGLELINE_SETTING_IDX_TEL_TCU_MODE) {
-        context->settingValue = ConfigGetSetting(CONFIG_SETTING_TEL_MODE);
-        if (context->settingValue == CONFIG_SETTING_TEL_MODE_TCU) {
-            MenuSingleLineSetDisplayText(
-                context,
-                "Call Mode: TCU",
-                0,
-                MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-            );
-        } else if (context->settingValue == CONFIG_SETTING_TEL_MODE_NO_MUTE) {
-            MenuSingleLineSetDisplayText(
-                context,
-                "Call Mode: No Mute",
-                0,
-                MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-            );
-        } else if (context->settingValue == CONFIG_SETTING_TEL_MODE_ANALOG) {
-            MenuSingleLineSetDisplayText(
-                context,
-                "Call Mode: Analog",
-                0,
-                MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-            );
-        } else {
-            MenuSingleLineSetDisplayText(
-                context,
-                "Call Mode: Default (Rec.)",
-                0,
-                MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-            );
-        }
-    }
-    if (nextMenu == MENU_SINGLELINE_SETTING_IDX_BLINKERS) {
-        uint8_t blinkCount = ConfigGetSetting(CONFIG_SETTING_COMFORT_BLINKERS);
-        if (blinkCount > 8 || blinkCount == 0) {
-            blinkCount = 1;
-        }
-        context->settingValue = blinkCount;
-        char blinkerText[19] = {0};
-        snprintf(blinkerText, 19, "Comfort Blinks: %d", context->settingValue);
-        MenuSingleLineSetDisplayText(
-            context,
-            blinkerText,
-            0,
-            MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-        );
-    }
-    if (nextMenu == MENU_SINGLELINE_SETTING_IDX_PARK_LIGHTS) {
-        if (ConfigGetSetting(CONFIG_SETTING_COMFORT_PARKING_LAMPS) == CONFIG_SETTING_OFF) {
-            MenuSingleLineSetDisplayText(
-                context,
-                "Parking Lamps: Off",
-                0,
-                MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-            );
-            context->settingValue = CONFIG_SETTING_OFF;
-        } else {
-            MenuSingleLineSetDisplayText(
-                context,
-                "Parking Lamps: On",
-                0,
-                MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-            );
-            context->settingValue = CONFIG_SETTING_ON;
-        }
-    }
-    if (nextMenu == MENU_SINGLELINE_SETTING_IDX_COMFORT_LOCKS) {
-        context->settingValue = ConfigGetComfortLock();
-        if (context->settingValue == CONFIG_SETTING_COMFORT_LOCK_10KM) {
-            MenuSingleLineSetDisplayText(
-                context,
-                "Comfort Lock: 10km/h",
-                0,
-                MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-            );
-        } else if (context->settingValue == CONFIG_SETTING_COMFORT_LOCK_20KM) {
-            MenuSingleLineSetDisplayText(
-                context,
-                "Comfort Lock: 20km/h",
-                0,
-                MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-            );
-        } else {
-            MenuSingleLineSetDisplayText(
-                context,
-                "Comfort Lock: Off",
-                0,
-                MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-            );
-        }
-    }
-    if (nextMenu == MENU_SINGLELINE_SETTING_IDX_COMFORT_UNLOCK) {
-        context->settingValue = ConfigGetComfortUnlock();
-        if (context->settingValue == CONFIG_SETTING_COMFORT_UNLOCK_POS_1) {
-            MenuSingleLineSetDisplayText(
-                context,
-                "Comfort Unlock: Pos 1",
-                0,
-                MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-            );
-        } else if (context->settingValue == CONFIG_SETTING_COMFORT_UNLOCK_POS_0) {
-            MenuSingleLineSetDisplayText(
-                context,
-                "Comfort Unlock: Pos 0",
-                0,
-                MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-            );
-        } else {
-            MenuSingleLineSetDisplayText(
-                context,
-                "Comfort Unlock: Off",
-                0,
-                MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-            );
-        }
-    }
-    if (nextMenu == MENU_SINGLELINE_SETTING_IDX_VISUAL_PDC) {
-        context->settingValue = ConfigGetSetting(CONFIG_SETTING_VISUAL_PDC);
-        if (context->settingValue == CONFIG_SETTING_PDC_CLUSTER) {
-            MenuSingleLineSetDisplayText(
-                context,
-                "PDC: Cluster",
-                0,
-                MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-            );
-        } else if (context->settingValue == CONFIG_SETTING_PDC_RADIO) {
-            MenuSingleLineSetDisplayText(
-                context,
-                "PDC: Radio",
-                0,
-                MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-            );
-        } else if (context->settingValue == CONFIG_SETTING_PDC_BOTH) {
-            MenuSingleLineSetDisplayText(
-                context,
-                "PDC: Both",
-                0,
-                MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-            );
-        } else {
-            MenuSingleLineSetDisplayText(
-                context,
-                "PDC: Off",
-                0,
-                MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-            );
-        }
-    }
-    if (nextMenu == MENU_SINGLELINE_SETTING_IDX_ABOUT) {
-        char firmwareVersion[6] = {0};
-        ConfigGetFirmwareVersionString(firmwareVersion);
-        char aboutText[37] = {0};
-        snprintf(
-            aboutText,
-            36,
-            "FW: %s Serial: %d Built: %02d/%d",
-            firmwareVersion,
-            ConfigGetSerialNumber(),
-            ConfigGetBuildWeek(),
-            ConfigGetBuildYear()
-        );
-        MenuSingleLineSetDisplayText(
-            context,
-            aboutText,
-            0,
-            MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-        );
-        context->settingValue = CONFIG_SETTING_OFF;
-    }
-    if (nextMenu == MENU_SINGLELINE_SETTING_IDX_PAIRINGS) {
-        MenuSingleLineSetDisplayText(
-            context,
-            "Clear Pairings",
-            0,
-            MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-        );
-        context->settingValue = CONFIG_SETTING_OFF;
-    }
+    MenuSingleLineSetDisplayText(
+        context,
+        text,
+        0,
+        MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
+    );
 }
 
 /**
@@ -886,348 +847,35 @@ void MenuSingleLineSettingsNextSetting(MenuSingleLineContext_t *context, uint8_t
  */
 void MenuSingleLineSettingsNextValue(MenuSingleLineContext_t *context, uint8_t direction)
 {
-    // Select different configuration options
-    if (context->settingIdx == MENU_SINGLELINE_SETTING_IDX_METADATA_MODE) {
-        if (context->settingValue == MENU_SINGLELINE_SETTING_METADATA_MODE_OFF) {
-            MenuSingleLineSetDisplayText(
-                context,
-                "Party",
-                0,
-                MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-            );
-            context->settingValue = MENU_SINGLELINE_SETTING_METADATA_MODE_PARTY;
-        } else if (context->settingValue == MENU_SINGLELINE_SETTING_METADATA_MODE_PARTY) {
-            MenuSingleLineSetDisplayText(
-                context,
-                "Chunk",
-                0,
-                MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-            );
-            context->settingValue = MENU_SINGLELINE_SETTING_METADATA_MODE_CHUNK;
-        } else if (context->settingValue == MENU_SINGLELINE_SETTING_METADATA_MODE_CHUNK) {
-            MenuSingleLineSetDisplayText(
-                context,
-                "Off",
-                0,
-                MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-            );
-            context->settingValue = MENU_SINGLELINE_SETTING_METADATA_MODE_OFF;
-        }
-    }
-    if (context->settingIdx == MENU_SINGLELINE_SETTING_IDX_AUTOPLAY) {
-        if (context->settingValue == CONFIG_SETTING_OFF) {
-            MenuSingleLineSetDisplayText(
-                context,
-                "On",
-                0,
-                MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-            );
-            context->settingValue = CONFIG_SETTING_ON;
-        } else {
-            MenuSingleLineSetDisplayText(
-                context,
-                "Off",
-                0,
-                MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-            );
-            context->settingValue = CONFIG_SETTING_OFF;
-        }
-    }
-    if (context->settingIdx == MENU_SINGLELINE_SETTING_IDX_AUDIO_DSP &&
-        context->ibus->moduleStatus.DSP == 1
-    ) {
-        if (context->settingValue == CONFIG_SETTING_OFF) {
-            MenuSingleLineSetDisplayText(
-                context,
-                "Digital",
-                0,
-                MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-            );
-            context->settingValue = CONFIG_SETTING_DSP_INPUT_SPDIF;
-        } else if (context->settingValue == CONFIG_SETTING_DSP_INPUT_SPDIF) {
-            MenuSingleLineSetDisplayText(
-                context,
-                "Analog",
-                0,
-                MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-            );
-            context->settingValue = CONFIG_SETTING_DSP_INPUT_ANALOG;
-        } else {
-            MenuSingleLineSetDisplayText(
-                context,
-                "Default",
-                0,
-                MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-            );
-            context->settingValue = CONFIG_SETTING_OFF;
-        }
-    }
-    if (context->settingIdx == MENU_SINGLELINE_SETTING_IDX_LOWER_VOL_REV ||
-        context->settingIdx == MENU_SINGLELINE_SETTING_IDX_TEL_HFP ||
-        context->settingIdx == MENU_SINGLELINE_SETTING_IDX_PARK_LIGHTS
+    const MenuSingleLineSetting_t *setting = &MENU_SINGLELINE_SETTINGS[
+        context->settingIdx
+    ];
+    if ((setting->flags & MENU_SINGLELINE_SETTING_FLAG_READ_ONLY) != 0 ||
+        MenuSingleLineSettingIsAvailable(context, setting) == 0
     ) {
-        if (context->settingValue == CONFIG_SETTING_OFF) {
-            MenuSingleLineSetDisplayText(
-                context,
-                "On",
-                0,
-                MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-            );
-            context->settingValue = CONFIG_SETTING_ON;
-        } else {
-            MenuSingleLineSetDisplayText(
-                context,
-                "Off",
-                0,
-                MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-            );
-            context->settingValue = CONFIG_SETTING_OFF;
-        }
-    }
-    if (context->settingIdx == MENU_SINGLELINE_SETTING_IDX_TEL_MIC_GAIN) {
-        if (direction == 0x01) {
-            if (context->settingValue > 0) {
-                context->settingValue--;
-            }
-        } else {
-            context->settingValue++;
-        }
-        char micGainText[6] = {0};
-        if (context->bt->type == BT_BTM_TYPE_BC127) {
-            if (context->settingValue > 21) {
-                context->settingValue = 0;
-            }
-            snprintf(micGainText, 5, "%idB", (int8_t) BTBC127MicGainTable[context->settingValue]);
-        } else {
-            if (context->settingValue > 0x0F) {
-                context->settingValue = 0;
-            }
-            snprintf(micGainText, 5, "%idB", (int8_t) BTBM83MicGainTable[context->settingValue]);
-        }
-        MenuSingleLineSetDisplayText(
-            context,
-            micGainText,
-            0,
-            MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-        );
+        return;
     }
-    if (context->settingIdx == MENU_SINGLELINE_SETTING_IDX_TEL_VOL_OFFSET) {
-        if (direction == 0x01) {
-            if (context->settingValue > 0) {
-                context->settingValue--;
-            }
-        } else {
-            context->settingValue++;
-        }
-        if (context->settingValue > 0xF) {
-            context->settingValue = 1;
-        }
-        char telephoneVolumeText[3] = {0};
-        snprintf(telephoneVolumeText, 3, "%d", context->settingValue);
-        MenuSingleLineSetDisplayText(
+    if (setting->next != 0) {
+        context->settingValue = setting->next(
             context,
-            telephoneVolumeText,
-            0,
-            MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
+            context->settingValue,
+            direction
         );
-    }
-    if (context->settingIdx == MENU_SINGLELINE_SETTING_IDX_AUDIO_DAC_GAIN) {
-        uint8_t currentVolume = context->settingValue;
-        if (direction == MENU_SINGLELINE_DIRECTION_BACK) {
-            if (currentVolume >= 2) {
-                currentVolume = currentVolume - 2;
-            } else {
-                currentVolume = 96;
-            }
-            // Limit to minimum of 24 (+12dB)
-            if (currentVolume < 24) {
-                currentVolume = 24;
-            }
-        } else {
-            currentVolume = currentVolume + 2;
-            if (currentVolume > 96) {
-                currentVolume = 24;  // Wrap around to +12dB instead of 0
-            }
-        }
-        context->settingValue = currentVolume;
-        char volText[18] = {0};
-        if (currentVolume > 0x30) {
-            uint8_t gain = (currentVolume - 0x30) / 2;
-            snprintf(volText, 17, "DAC Volume: -%ddB", gain);
-        } else if (currentVolume == 0x30) {
-            snprintf(volText, 17, "DAC Volume: 0dB");
-        } else {
-            uint8_t gain = (0x30 - currentVolume) / 2;
-            snprintf(volText, 17, "DAC Volume: +%ddB", gain);
-        }
-        MenuSingleLineSetDisplayText(
-            context,
-            volText,
-            0,
-            MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-        );
-    }
-    if (context->settingIdx == MENU_SINGLELINE_SETTING_IDX_TEL_TCU_MODE) {
-        if (context->settingValue == CONFIG_SETTING_TEL_MODE_DEFAULT) {
-            MenuSingleLineSetDisplayText(
-                context,
-                "TCU",
-                0,
-                MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-            );
-            context->settingValue = CONFIG_SETTING_TEL_MODE_TCU;
-        } else if (context->settingValue == CONFIG_SETTING_TEL_MODE_TCU) {
-            MenuSingleLineSetDisplayText(
-                context,
-                "No Mute",
-                0,
-                MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-            );
-            context->settingValue = CONFIG_SETTING_TEL_MODE_NO_MUTE;
-        } else if (context->settingValue == CONFIG_SETTING_TEL_MODE_NO_MUTE) {
-            MenuSingleLineSetDisplayText(
-                context,
-                "Analog",
-                0,
-                MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-            );
-            context->settingValue = CONFIG_SETTING_TEL_MODE_ANALOG;
-        } else {
-            MenuSingleLineSetDisplayText(
-                context,
-                "Default (Recommended)",
-                0,
-                MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-            );
-            context->settingValue = CONFIG_SETTING_TEL_MODE_DEFAULT;
-        }
-    }
-    if (context->settingIdx == MENU_SINGLELINE_SETTING_IDX_BLINKERS) {
-        if (direction == 0x00) {
-            context->settingValue++;
-        } else {
-            context->settingValue--;
-        }
-        if (context->settingValue > 8 || context->settingValue == 0) {
-            context->settingValue = 1;
-        }
-        char blinkerText[2] = {0};
-        snprintf(blinkerText, 2, "%d", context->settingValue);
-        MenuSingleLineSetDisplayText(
-            context,
-            blinkerText,
-            0,
-            MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
+    } else {
+        context->settingValue = ConfigValueSetGetNext(
+            setting->values,
+            context->settingValue,
+            direction
         );
     }
-    if (context->settingIdx == MENU_SINGLELINE_SETTING_IDX_COMFORT_LOCKS) {
-        if (context->settingValue == CONFIG_SETTING_OFF) {
-            MenuSingleLineSetDisplayText(
-                context,
-                "10km/h",
-                0,
-                MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-            );
-            context->settingValue = CONFIG_SETTING_COMFORT_LOCK_10KM;
-        } else if (context->settingValue == CONFIG_SETTING_COMFORT_LOCK_10KM) {
-            MenuSingleLineSetDisplayText(
-                context,
-                "20km/h",
-                0,
-                MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-            );
-            context->settingValue = CONFIG_SETTING_COMFORT_LOCK_20KM;
-        } else {
-            MenuSingleLineSetDisplayText(
-                context,
-                "Off",
-                0,
-                MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-            );
-            context->settingValue = CONFIG_SETTING_OFF;
-        }
-    }
-    if (context->settingIdx == MENU_SINGLELINE_SETTING_IDX_COMFORT_UNLOCK) {
-        if (context->settingValue == CONFIG_SETTING_OFF) {
-            MenuSingleLineSetDisplayText(
-                context,
-                "Pos 1",
-                0,
-                MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-            );
-            context->settingValue = CONFIG_SETTING_COMFORT_UNLOCK_POS_1;
-        } else if (context->settingValue == CONFIG_SETTING_COMFORT_UNLOCK_POS_1) {
-            MenuSingleLineSetDisplayText(
-                context,
-                "Pos 0",
-                0,
-                MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-            );
-            context->settingValue = CONFIG_SETTING_COMFORT_UNLOCK_POS_0;
-        } else {
-            MenuSingleLineSetDisplayText(
-                context,
-                "Off",
-                0,
-                MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-            );
-            context->settingValue = CONFIG_SETTING_OFF;
-        }
-    }
-    if (context->settingIdx == MENU_SINGLELINE_SETTING_IDX_VISUAL_PDC) {
-        if (context->settingValue == CONFIG_SETTING_OFF) {
-            MenuSingleLineSetDisplayText(
-                context,
-                "Cluster",
-                0,
-                MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-            );
-            context->settingValue = CONFIG_SETTING_PDC_CLUSTER;
-        } else if (context->settingValue == CONFIG_SETTING_PDC_CLUSTER) {
-            MenuSingleLineSetDisplayText(
-                context,
-                "Radio",
-                0,
-                MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-            );
-            context->settingValue = CONFIG_SETTING_PDC_RADIO;
-        } else if (context->settingValue == CONFIG_SETTING_PDC_RADIO) {
-            MenuSingleLineSetDisplayText(
-                context,
-                "Both",
-                0,
-                MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-            );
-            context->settingValue = CONFIG_SETTING_PDC_BOTH;
-        } else {
-            MenuSingleLineSetDisplayText(
-                context,
-                "Off",
-                0,
-                MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-            );
-            context->settingValue = CONFIG_SETTING_OFF;
-        }
-    }
-    if (context->settingIdx == MENU_SINGLELINE_SETTING_IDX_PAIRINGS) {
-        if (context->settingValue == CONFIG_SETTING_OFF) {
-            MenuSingleLineSetDisplayText(
-                context,
-                "Press Save",
-                0,
-                MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-            );
-            context->settingValue = CONFIG_SETTING_ON;
-        } else {
-            MenuSingleLineSetDisplayText(
-                context,
-                "Clear Pairings",
-                0,
-                MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
-            );
-            context->settingValue = CONFIG_SETTING_OFF;
-        }
-    }
+    char text[MENU_SINGLELINE_SETTING_TEXT_SIZE] = {0};
+    MenuSingleLineSettingGetText(context, setting, context->settingValue, text);
+    MenuSingleLineSetDisplayText(
+        context,
+        text,
+        0,
+        MENU_SINGLELINE_DISPLAY_UPDATE_MAIN
+    );
 }
 
 void MenuSingleLineDevices(
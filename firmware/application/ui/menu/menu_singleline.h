@@ -8,6 +8,7 @@
 #define MENU_SINGLELINE_H
 
 #include "../../lib/bt/bt_common.h"
+#include "../../lib/config.h"
 #include "../../lib/ibus.h"
 #include "../../lib/pcm51xx.h"
 #include "../../lib/utils.h"
@@ -35,6 +36,12 @@
 #define MENU_SINGLELINE_SETTING_IDX_ABOUT 14
 #define MENU_SINGLELINE_SETTING_IDX_PAIRINGS 15
 
+#define MENU_SINGLELINE_SETTING_FLAG_HIDE_BC127 0x01
+#define MENU_SINGLELINE_SETTING_FLAG_REQUIRES_DSP 0x02
+#define MENU_SINGLELINE_SETTING_FLAG_READ_ONLY 0x04
+
+#define MENU_SINGLELINE_SETTING_TEXT_SIZE 40
+
 #define MENU_SINGLELINE_SETTING_MODE_SCROLL_SETTINGS 1
 #define MENU_SINGLELINE_SETTING_MODE_SCROLL_VALUES 2
 
@@ -74,6 +81,32 @@ typedef struct MenuSingleLineContext_t {
     uint16_t vehicleSpeed;
 } MenuSingleLineContext_t;
 
+/*
+ * MenuSingleLineSetting_t
+ *  This is a struct to describe one entry of the settings menu
+ *  title: The text shown in front of the value, or 0 to show the value alone
+ *  setting: The configuration address, or 0 for entries that are not stored
+ *  flags: MENU_SINGLELINE_SETTING_FLAG_* bits
+ *  values: The values that the entry cycles through
+ *  labels: The text for each entry in the values list
+ *  get, set: Accessors for settings that do not fill a whole byte
+ *  next: Picks the next value when the value set does not fit
+ *  format: Writes the value text when there are no labels
+ *  save: Makes the hardware follow a new value before it is stored
+ */
+typedef struct MenuSingleLineSetting_t {
+    const char *title;
+    uint8_t setting;
+    uint8_t flags;
+    const ConfigValueSet_t *values;
+    const char * const *labels;
+    uint8_t (*get)(void);
+    void (*set)(uint8_t);
+    uint8_t (*next)(MenuSingleLineContext_t *, uint8_t, uint8_t);
+    void (*format)(MenuSingleLineContext_t *, uint8_t, char *);
+    void (*save)(MenuSingleLineContext_t *, uint8_t);
+} MenuSingleLineSetting_t;
+
 void MenuSingleLineInit(MenuSingleLineContext_t *, IBus_t *, BT_t*);
 void MenuSingleLineDestory();
 void MenuSingleLineSetDisplayText(MenuSingleLineContext_t *, const char *, int8_t, uint8_t);
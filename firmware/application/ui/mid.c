@@ -5,7 +5,6 @@
  *     Implement the MID UI Mode handler
  */
 #include "mid.h"
-#include <stdio.h>
 #include <string.h>
 #include "menu/menu_singleline.h"
 #include "../lib/bt/bt_common.h"
@@ -142,7 +141,7 @@ static void MIDSetMainDisplayText(
 ) {
     char text[UTILS_DISPLAY_TEXT_SIZE] = {0};
     if (strlen(context->mainText) != 0) {
-        snprintf(
+        UtilsFormat(
             text,
             UTILS_DISPLAY_TEXT_SIZE,
             "%s %s",
@@ -150,13 +149,14 @@ static void MIDSetMainDisplayText(
             str
         );
     } else {
-        snprintf(
+        UtilsFormat(
             text,
             UTILS_DISPLAY_TEXT_SIZE,
             "%s",
             str
         );
     }
+    UtilsConvertTextCharset(text, UTILS_CHARSET_IBUS);
     memset(context->mainDisplay.text, 0, UTILS_DISPLAY_TEXT_SIZE);
     UtilsStrncpy(context->mainDisplay.text, text, UTILS_DISPLAY_TEXT_SIZE);
     context->mainDisplay.length = strlen(context->mainDisplay.text);
@@ -172,7 +172,7 @@ static void MIDSetTempDisplayText(
 ) {
     char text[UTILS_DISPLAY_TEXT_SIZE] = {0};
     if (strlen(context->mainText) != 0) {
-        snprintf(
+        UtilsFormat(
             text,
             UTILS_DISPLAY_TEXT_SIZE,
             "%s %s",
@@ -180,13 +180,14 @@ static void MIDSetTempDisplayText(
             str
         );
     } else {
-        snprintf(
+        UtilsFormat(
             text,
             UTILS_DISPLAY_TEXT_SIZE,
             "%s",
             str
         );
     }
+    UtilsConvertTextCharset(text, UTILS_CHARSET_IBUS);
     UtilsStrncpy(context->tempDisplay.text, text, UTILS_DISPLAY_TEXT_SIZE);
     context->tempDisplay.length = strlen(context->tempDisplay.text);
     context->tempDisplay.index = 0;
@@ -294,39 +295,52 @@ void MIDBTMetadataUpdate(void *ctx, unsigned char *tmp)
     if (
         context->mode != MID_MODE_ACTIVE ||
         context->displayMetadata != MID_DISPLAY_METADATA_ON ||
-        strlen(context->bt->title) == 0 ||
+        BTMetadataGetLength(context->bt, BT_METADATA_FIELD_TITLE) == 0 ||
         ConfigGetSetting(CONFIG_SETTING_METADATA_MODE) == MENU_SINGLELINE_SETTING_METADATA_MODE_OFF
     ) {
         return;
     }
+    if (ConfigGetUIMode() == CONFIG_UI_MID_BMBT) {
+        // Show the same line as the BMBT, which builds it too
+        MIDSetMainDisplayText(
+            context,
+            BTMetadataGetDisplayText(context->bt),
+            3000 / MID_DISPLAY_SCROLL_SPEED
+        );
+        TimerTriggerScheduledTask(context->displayUpdateTaskId);
+        return;
+    }
+    char *title = BTMetadataGet(context->bt, BT_METADATA_FIELD_TITLE);
+    char *artist = BTMetadataGet(context->bt, BT_METADATA_FIELD_ARTIST);
+    char *album = BTMetadataGet(context->bt, BT_METADATA_FIELD_ALBUM);
     char text[UTILS_DISPLAY_TEXT_SIZE] = {0};
-    if (strlen(context->bt->artist) > 0 && strlen(context->bt->album) > 0) {
-        snprintf(
+    if (artist[0] != '\0' && album[0] != '\0') {
+        UtilsFormat(
             text,
             UTILS_DISPLAY_TEXT_SIZE,
             "%s - %s on %s",
-            context->bt->title,
-            context->bt->artist,
-            context->bt->album
+            title,
+            artist,
+            album
         );
-    } else if (strlen(context->bt->artist) > 0) {
-        snprintf(
+    } else if (artist[0] != '\0') {
+        UtilsFormat(
             text,
             UTILS_DISPLAY_TEXT_SIZE,
             "%s - %s",
-            context->bt->title,
-            context->bt->artist
+            title,
+            artist
         );
-    } else if (strlen(context->bt->album) > 0) {
-        snprintf(
+    } else if (album[0] != '\0') {
+        UtilsFormat(
             text,
-            UTILS_DISPLAY_TEXT_SIZE ,
+            UTILS_DISPLAY_TEXT_SIZE,
             "%s on %s",
-            context->bt->title,
-            context->bt->album
+            title,
+            album
         );
     } else {
-        snprintf(text, UTILS_DISPLAY_TEXT_SIZE, "%s", context->bt->title);
+        UtilsFormat(text, UTILS_DISPLAY_TEXT_SIZE, "%s", title);
     }
     MIDSetMainDisplayText(context, text, 3000 / MID_DISPLAY_SCROLL_SPEED);
     TimerTriggerScheduledTask(context->displayUpdateTaskId);
@@ -656,7 +670,11 @@ void MIDTimerDisplay(void *ctx)
         } else if (context->tempDisplay.timeout < -1) {
             context->tempDisplay.status = MID_DISPLAY_STATUS_OFF;
         }
-        if (context->tempDisplay.status == MID_DISPLAY_STATUS_NEW) {
+        // Leave the text pending until the bus has room for it
+        if (
+            context->tempDisplay.status == MID_DISPLAY_STATUS_NEW &&
+            IBusTXBufferHasSpace(context->ibus, 1) == 1
+        ) {
             IBusCommandMIDDisplayText(
                 context->ibus,
                 context->tempDisplay.text
@@ -672,8 +690,14 @@ void MIDTimerDisplay(void *ctx)
             context->mainDisplay.timeout--;
         } else {
             if (context->mainDisplay.length > IBUS_MID_MAX_CHARS) {
-                char text[IBUS_MID_MAX_CHARS + 1] = {0};
-                uint8_t textLength = IBUS_MID_MAX_CHARS;
+                // Scrolling is cosmetic, so let a busy bus drain first
+                if (
+                    context->mainDisplay.index != 0 &&
+                    IBusGetTXBufferUsed(context->ibus) >= IBUS_TX_BUFFER_WATERMARK
+                ) {
+                    return;
+                }
+                char text[IBUS_MID_MAX_CHARS + 1];
                 // If we start with a space, it will be ignored by the display
                 // Skipping the space allows us to have "smooth" scrolling
                 if (context->mainDisplay.text[context->mainDisplay.index] == 0x20 &&
@@ -681,36 +705,23 @@ void MIDTimerDisplay(void *ctx)
                 ) {
                     context->mainDisplay.index++;
                 }
-                uint8_t idxEnd = context->mainDisplay.index + textLength;
-                // Prevent strncpy() from going out of bounds
-                if (idxEnd >= context->mainDisplay.length) {
-                    textLength = context->mainDisplay.length - context->mainDisplay.index;
-                    idxEnd = context->mainDisplay.index + textLength;
-                }
-                UtilsStrncpy(
+                uint8_t chunk = ConfigGetSetting(CONFIG_SETTING_METADATA_MODE) ==
+                    MENU_SINGLELINE_SETTING_METADATA_MODE_CHUNK;
+                uint8_t position = UtilsDisplayValueScroll(
+                    &context->mainDisplay,
                     text,
-                    &context->mainDisplay.text[context->mainDisplay.index],
-                    textLength + 1
+                    IBUS_MID_MAX_CHARS,
+                    chunk == 1 ? IBUS_MID_MAX_CHARS : 1
                 );
+                IBusSetTXPriority(context->ibus, IBUS_MSG_PRIORITY_BACKGROUND);
                 IBusCommandMIDDisplayText(context->ibus, text);
-                // Pause at the beginning of the text
-                if (context->mainDisplay.index == 0) {
-                    context->mainDisplay.timeout = 5;
-                }
-                if (idxEnd >= context->mainDisplay.length) {
-                    // Pause at the end of the text
+                IBusSetTXPriority(context->ibus, IBUS_MSG_PRIORITY_INTERACTIVE);
+                if ((position & UTILS_DISPLAY_SCROLL_END) != 0 || chunk == 1) {
+                    // Pause at the end of the text and between chunks
                     context->mainDisplay.timeout = 2;
-                    context->mainDisplay.index = 0;
-                } else {
-                    if (
-                        ConfigGetSetting(CONFIG_SETTING_METADATA_MODE) ==
-                        MENU_SINGLELINE_SETTING_METADATA_MODE_CHUNK
-                    ) {
-                        context->mainDisplay.timeout = 2;
-                        context->mainDisplay.index += IBUS_MID_MAX_CHARS;
-                    } else {
-                        context->mainDisplay.index++;
-                    }
+                } else if ((position & UTILS_DISPLAY_SCROLL_START) != 0) {
+                    // Pause at the beginning of the text
+                    context->mainDisplay.timeout = 5;
                 }
             } else {
                 if (context->mainDisplay.index == 0) {